@@ -29,7 +29,7 @@
 /**
  * API version
  */
-#define DBDRV_API_VERSION           31
+#define DBDRV_API_VERSION           32
 
 /**
  * Database driver entry point declaration
@@ -95,6 +95,9 @@ struct DBDriverCallTable
    const char* (*GetColumnNameUnbuffered)(DBDRV_UNBUFFERED_RESULT, int);
    StringBuffer (*PrepareString)(const TCHAR*, size_t);
    int (*IsTableExist)(DBDRV_CONNECTION, const WCHAR*);
+   uint32_t (*CopyBegin)(DBDRV_CONNECTION, const WCHAR*, WCHAR*);
+   uint32_t (*CopyData)(DBDRV_CONNECTION, const char*, size_t, WCHAR*);
+   uint32_t (*CopyEnd)(DBDRV_CONNECTION, bool, WCHAR*);
 };
 
 //
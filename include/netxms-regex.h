@@ -32,35 +32,47 @@
 #ifdef UNICODE_UCS2
 #define PCRE_WCHAR              PCRE_UCHAR16
 #define PCREW                   pcre16
+#define PCREW_EXTRA             pcre16_extra
 #define PCRE_UNICODE_FLAGS      PCRE_UTF16
 #define _pcre_compile_w         pcre16_compile
 #define _pcre_exec_w            pcre16_exec
 #define _pcre_fullinfo_w        pcre16_fullinfo
 #define _pcre_free_w            pcre16_free
+#define _pcre_study_w           pcre16_study
+#define _pcre_free_study_w      pcre16_free_study
 #else
 #define PCRE_WCHAR              PCRE_UCHAR32
 #define PCREW                   pcre32
+#define PCREW_EXTRA             pcre32_extra
 #define PCRE_UNICODE_FLAGS      PCRE_UTF32
 #define _pcre_compile_w         pcre32_compile
 #define _pcre_exec_w            pcre32_exec
 #define _pcre_fullinfo_w        pcre32_fullinfo
 #define _pcre_free_w            pcre32_free
+#define _pcre_study_w           pcre32_study
+#define _pcre_free_study_w      pcre32_free_study
 #endif
 
 #ifdef UNICODE
 #define PCRE_TCHAR              PCRE_WCHAR
 #define PCRE                    PCREW
+#define PCRE_EXTRA_T            PCREW_EXTRA
 #define _pcre_compile_t         _pcre_compile_w
 #define _pcre_exec_t            _pcre_exec_w
 #define _pcre_fullinfo_t        _pcre_fullinfo_w
 #define _pcre_free_t            _pcre_free_w
+#define _pcre_study_t           _pcre_study_w
+#define _pcre_free_study_t      _pcre_free_study_w
 #else   /* UNICODE */
 #define PCRE_TCHAR              char
 #define PCRE                    pcre
+#define PCRE_EXTRA_T            pcre_extra
 #define _pcre_compile_t         pcre_compile
 #define _pcre_exec_t            pcre_exec
 #define _pcre_fullinfo_t        pcre_fullinfo
 #define _pcre_free_t            pcre_free
+#define _pcre_study_t           pcre_study
+#define _pcre_free_study_t      pcre_free_study
 #endif
 
 #define PCRE_COMMON_FLAGS_W     (PCRE_UNICODE_FLAGS | PCRE_DOTALL | PCRE_BSR_UNICODE | PCRE_NEWLINE_ANY)
@@ -25,7 +25,7 @@
 
 #define DB_LEGACY_SCHEMA_VERSION       700
 #define DB_SCHEMA_VERSION_MAJOR        51
-#define DB_SCHEMA_VERSION_MINOR        10
+#define DB_SCHEMA_VERSION_MINOR        23
 
 #define DB_SCHEMA_VERSION_V51_MINOR    DB_SCHEMA_VERSION_MINOR
 
@@ -892,16 +892,22 @@ struct ThreadPoolInfo
    uint32_t queueSizeSD;       // Task queue size standard deviation
 };
 
+/**
+ * Thread pool creation flags
+ */
+#define THREAD_POOL_WORK_STEALING   0x0001
+
 /**
  * Worker function for thread pool
  */
 typedef void (*ThreadPoolWorkerFunction)(void *);
 
 /* Thread pool functions */
-ThreadPool LIBNETXMS_EXPORTABLE *ThreadPoolCreate(const TCHAR *name, int minThreads, int maxThreads, int stackSize = 0);
+ThreadPool LIBNETXMS_EXPORTABLE *ThreadPoolCreate(const TCHAR *name, int minThreads, int maxThreads, int stackSize = 0, uint32_t flags = 0);
 void LIBNETXMS_EXPORTABLE ThreadPoolDestroy(ThreadPool *p);
 void LIBNETXMS_EXPORTABLE ThreadPoolExecute(ThreadPool *p, ThreadPoolWorkerFunction f, void *arg);
 void LIBNETXMS_EXPORTABLE ThreadPoolExecuteSerialized(ThreadPool *p, const TCHAR *key, ThreadPoolWorkerFunction f, void *arg);
+void LIBNETXMS_EXPORTABLE ThreadPoolExecuteSerialized(ThreadPool *p, uint64_t key, ThreadPoolWorkerFunction f, void *arg);
 void LIBNETXMS_EXPORTABLE ThreadPoolScheduleAbsolute(ThreadPool *p, time_t runTime, ThreadPoolWorkerFunction f, void *arg);
 void LIBNETXMS_EXPORTABLE ThreadPoolScheduleAbsoluteMs(ThreadPool *p, int64_t runTime, ThreadPoolWorkerFunction f, void *arg);
 void LIBNETXMS_EXPORTABLE ThreadPoolScheduleRelative(ThreadPool *p, uint32_t delay, ThreadPoolWorkerFunction f, void *arg);
@@ -909,7 +915,9 @@ void LIBNETXMS_EXPORTABLE ThreadPoolGetInfo(ThreadPool *p, ThreadPoolInfo *info)
 bool LIBNETXMS_EXPORTABLE ThreadPoolGetInfo(const TCHAR *name, ThreadPoolInfo *info);
 ThreadPool LIBNETXMS_EXPORTABLE *ThreadPoolGetByName(const TCHAR *name);
 int LIBNETXMS_EXPORTABLE ThreadPoolGetSerializedRequestCount(ThreadPool *p, const TCHAR *key);
+int LIBNETXMS_EXPORTABLE ThreadPoolGetSerializedRequestCount(ThreadPool *p, uint64_t key);
 uint32_t LIBNETXMS_EXPORTABLE ThreadPoolGetSerializedRequestMaxWaitTime(ThreadPool *p, const TCHAR *key);
+uint32_t LIBNETXMS_EXPORTABLE ThreadPoolGetSerializedRequestMaxWaitTime(ThreadPool *p, uint64_t key);
 StringList LIBNETXMS_EXPORTABLE *ThreadPoolGetAllPools();
 void LIBNETXMS_EXPORTABLE ThreadPoolSetResizeParameters(int responsiveness, uint32_t waitTimeHWM, uint32_t waitTimeLWM);
 
@@ -937,6 +945,14 @@ static inline void ThreadPoolExecuteSerialized(ThreadPool *p, const TCHAR *key,
    ThreadPoolExecuteSerialized(p, key, ThreadPoolExecute_NoArg_Wrapper, (void *)f);
 }
 
+/**
+ * Wrapper for ThreadPoolExecuteSerialized with integer key for function without arguments
+ */
+static inline void ThreadPoolExecuteSerialized(ThreadPool *p, uint64_t key, void (*f)())
+{
+   ThreadPoolExecuteSerialized(p, key, ThreadPoolExecute_NoArg_Wrapper, (void *)f);
+}
+
 /**
  * Wrapper for ThreadPoolScheduleAbsolute for function without arguments
  */
@@ -1005,7 +1021,7 @@ template <typename T> static inline void ThreadPoolExecute(ThreadPool *p, void (
 /**
  * Wrapper for ThreadPoolExecuteSerialized to use pointer to given type as argument
  */
-template <typename T> static inline void ThreadPoolExecuteSerialized(ThreadPool *p, const TCHAR *key, void (*f)(T *), T *arg)
+template <typename K, typename T> static inline void ThreadPoolExecuteSerialized(ThreadPool *p, K key, void (*f)(T *), T *arg)
 {
    ThreadPoolExecuteSerialized(p, key, (ThreadPoolWorkerFunction)f, (void *)arg);
 }
@@ -1013,7 +1029,7 @@ template <typename T> static inline void ThreadPoolExecuteSerialized(ThreadPool
 /**
  * Wrapper for ThreadPoolExecuteSerialized to use smart pointer to given type as argument
  */
-template <typename T> static inline void ThreadPoolExecuteSerialized(ThreadPool *p, const TCHAR *key, void (*f)(const shared_ptr<T>&), const shared_ptr<T>& arg)
+template <typename K, typename T> static inline void ThreadPoolExecuteSerialized(ThreadPool *p, K key, void (*f)(const shared_ptr<T>&), const shared_ptr<T>& arg)
 {
    ThreadPoolExecuteSerialized(p, key, __ThreadPoolExecute_SharedPtr_Wrapper<T>, new __ThreadPoolExecute_SharedPtr_WrapperData<T>(arg, f));
 }
@@ -1103,7 +1119,7 @@ template <typename T, typename B> static inline void ThreadPoolExecute(ThreadPoo
 /**
  * Execute serialized task as soon as possible (use class member without arguments)
  */
-template <typename T, typename B> static inline void ThreadPoolExecuteSerialized(ThreadPool *p, const TCHAR *key, T *object, void (B::*f)())
+template <typename K, typename T, typename B> static inline void ThreadPoolExecuteSerialized(ThreadPool *p, K key, T *object, void (B::*f)())
 {
    ThreadPoolExecuteSerialized(p, key, __ThreadPoolExecute_Wrapper_0<B>, new __ThreadPoolExecute_WrapperData_0<B>(object, f));
 }
@@ -1152,7 +1168,7 @@ template <typename T, typename B> static inline void ThreadPoolExecute(ThreadPoo
 /**
  * Execute serialized task as soon as possible (use class member without arguments) using smart pointer to object
  */
-template <typename T, typename B> static inline void ThreadPoolExecuteSerialized(ThreadPool *p, const TCHAR *key, const shared_ptr<T>& object, void (B::*f)())
+template <typename K, typename T, typename B> static inline void ThreadPoolExecuteSerialized(ThreadPool *p, K key, const shared_ptr<T>& object, void (B::*f)())
 {
    ThreadPoolExecuteSerialized(p, key, __ThreadPoolExecute_SharedPtr_Wrapper_0<B>, new __ThreadPoolExecute_SharedPtr_WrapperData_0<B>(object, f));
 }
@@ -1203,7 +1219,7 @@ template <typename T, typename B, typename R> static inline void ThreadPoolExecu
 /**
  * Execute serialized task as soon as possible (use class member with one argument)
  */
-template <typename T, typename B, typename R> static inline void ThreadPoolExecuteSerialized(ThreadPool *p, const TCHAR *key, T *object, void (B::*f)(R), R arg)
+template <typename K, typename T, typename B, typename R> static inline void ThreadPoolExecuteSerialized(ThreadPool *p, K key, T *object, void (B::*f)(R), R arg)
 {
    ThreadPoolExecuteSerialized(p, key, __ThreadPoolExecute_Wrapper_1<B, R>, new __ThreadPoolExecute_WrapperData_1<B, R>(object, f, arg));
 }
@@ -1253,7 +1269,7 @@ template <typename T, typename B, typename R> static inline void ThreadPoolExecu
 /**
  * Execute serialized task as soon as possible (use class member with one argument) using smart pointer to object
  */
-template <typename T, typename B, typename R> static inline void ThreadPoolExecuteSerialized(ThreadPool *p, const TCHAR *key, const shared_ptr<T>& object, void (B::*f)(R), R arg)
+template <typename K, typename T, typename B, typename R> static inline void ThreadPoolExecuteSerialized(ThreadPool *p, K key, const shared_ptr<T>& object, void (B::*f)(R), R arg)
 {
    ThreadPoolExecuteSerialized(p, key, __ThreadPoolExecute_SharedPtr_Wrapper_1<B, R>, new __ThreadPoolExecute_SharedPtr_WrapperData_1<B, R>(object, f, arg));
 }
@@ -1303,7 +1319,7 @@ template <typename R1, typename R2> static inline void ThreadPoolExecute(ThreadP
 /**
  * Execute serialized task as soon as possible (function with two arguments)
  */
-template <typename R1, typename R2> static inline void ThreadPoolExecuteSerialized(ThreadPool *p, const TCHAR *key, void (*f)(R1, R2), R1 arg1, R2 arg2)
+template <typename K, typename R1, typename R2> static inline void ThreadPoolExecuteSerialized(ThreadPool *p, K key, void (*f)(R1, R2), R1 arg1, R2 arg2)
 {
    ThreadPoolExecuteSerialized(p, key, __ThreadPoolExecute_Wrapper_2F<R1, R2>, new __ThreadPoolExecute_WrapperData_2F<R1, R2>(f, arg1, arg2));
 }
@@ -1347,7 +1363,7 @@ template <typename T, typename B, typename R1, typename R2> static inline void T
 /**
  * Execute serialized task as soon as possible (use class member with two argumenta)
  */
-template <typename T, typename B, typename R1, typename R2> static inline void ThreadPoolExecuteSerialized(ThreadPool *p, const TCHAR *key, T *object, void (B::*f)(R1, R2), R1 arg1, R2 arg2)
+template <typename K, typename T, typename B, typename R1, typename R2> static inline void ThreadPoolExecuteSerialized(ThreadPool *p, K key, T *object, void (B::*f)(R1, R2), R1 arg1, R2 arg2)
 {
    ThreadPoolExecuteSerialized(p, key, __ThreadPoolExecute_Wrapper_2<B, R1, R2>, new __ThreadPoolExecute_WrapperData_2<B, R1, R2>(object, f, arg1, arg2));
 }
@@ -1398,7 +1414,7 @@ template <typename T, typename B, typename R1, typename R2> static inline void T
 /**
  * Execute serialized task as soon as possible (use class member with two arguments) using smart pointer to object
  */
-template <typename T, typename B, typename R1, typename R2> static inline void ThreadPoolExecuteSerialized(ThreadPool *p, const TCHAR *key, const shared_ptr<T>& object, void (B::*f)(R1, R2), R1 arg1, R2 arg2)
+template <typename K, typename T, typename B, typename R1, typename R2> static inline void ThreadPoolExecuteSerialized(ThreadPool *p, K key, const shared_ptr<T>& object, void (B::*f)(R1, R2), R1 arg1, R2 arg2)
 {
    ThreadPoolExecuteSerialized(p, key, __ThreadPoolExecute_SharedPtr_Wrapper_2<B, R1, R2>, new __ThreadPoolExecute_SharedPtr_WrapperData_2<B, R1, R2>(object, f, arg1, arg2));
 }
@@ -1486,7 +1502,7 @@ template <typename R1, typename R2, typename R3> static inline void ThreadPoolEx
 /**
  * Execute serialized task as soon as possible (use function with three arguments)
  */
-template <typename R1, typename R2, typename R3> static inline void ThreadPoolExecuteSerialized(ThreadPool *p, const TCHAR *key, void (*f)(R1, R2, R3), R1 arg1, R2 arg2, R3 arg3)
+template <typename K, typename R1, typename R2, typename R3> static inline void ThreadPoolExecuteSerialized(ThreadPool *p, K key, void (*f)(R1, R2, R3), R1 arg1, R2 arg2, R3 arg3)
 {
    ThreadPoolExecuteSerialized(p, key, __ThreadPoolExecute_Wrapper_3F<R1, R2, R3>, new __ThreadPoolExecute_WrapperData_3F<R1, R2, R3>(f, arg1, arg2, arg3));
 }
@@ -1576,7 +1592,7 @@ template <typename R1, typename R2, typename R3, typename R4> static inline void
 /**
  * Execute serialized task as soon as possible (use function with four arguments)
  */
-template <typename R1, typename R2, typename R3, typename R4> static inline void ThreadPoolExecuteSerialized(ThreadPool *p, const TCHAR *key, void (*f)(R1, R2, R3, R4), R1 arg1, R2 arg2, R3 arg3, R4 arg4)
+template <typename K, typename R1, typename R2, typename R3, typename R4> static inline void ThreadPoolExecuteSerialized(ThreadPool *p, K key, void (*f)(R1, R2, R3, R4), R1 arg1, R2 arg2, R3 arg3, R4 arg4)
 {
    ThreadPoolExecuteSerialized(p, key, __ThreadPoolExecute_Wrapper_4F<R1, R2, R3, R4>, new __ThreadPoolExecute_WrapperData_4F<R1, R2, R3, R4>(f, arg1, arg2, arg3, arg4));
 }
@@ -1615,6 +1631,14 @@ static inline void ThreadPoolExecuteSerialized(ThreadPool *p, const TCHAR *key,
    ThreadPoolExecuteSerialized(p, key, __ThreadPoolExecute_Callable_Wrapper, new std::function<void ()>(f));
 }
 
+/**
+ * Wrapper for ThreadPoolExecuteSerialized with integer key to use std::function
+ */
+static inline void ThreadPoolExecuteSerialized(ThreadPool *p, uint64_t key, const std::function<void ()>& f)
+{
+   ThreadPoolExecuteSerialized(p, key, __ThreadPoolExecute_Callable_Wrapper, new std::function<void ()>(f));
+}
+
 /**
  * Wrapper for ThreadPoolScheduleAbsolute to use std::function
  */
@@ -4760,14 +4760,38 @@ enum class BackgroundSocketPollResult
 struct BackgroundSocketPollRequest
 {
    BackgroundSocketPollRequest *next;
+   BackgroundSocketPollRequest *prev;  // Only used by epoll based implementation
    SOCKET socket;
    void (*callback)(BackgroundSocketPollResult, SOCKET, void*);
    void *context;
    int64_t queueTime;
    uint32_t timeout;
+   int32_t wheelSlot;     // Timer wheel slot (-1 if request is not active), only used by epoll based implementation
+   uint32_t generation;   // Request generation used to match epoll events, only used by epoll based implementation
    bool cancelled;
 };
 
+#if HAVE_SYS_EPOLL_H
+
+/**
+ * Maximum number of sockets handled by single background socket poller (including control socket)
+ */
+#define BACKGROUND_SOCKET_POLLER_MAX_SOCKETS    65536
+
+/**
+ * Number of slots in background socket poller timer wheel
+ */
+#define BACKGROUND_SOCKET_POLLER_WHEEL_SIZE     4096
+
+#else
+
+/**
+ * Maximum number of sockets handled by single background socket poller (including control socket)
+ */
+#define BACKGROUND_SOCKET_POLLER_MAX_SOCKETS    SOCKET_POLLER_MAX_SOCKETS
+
+#endif
+
 #ifdef _WIN32
 template class LIBNETXMS_TEMPLATE_EXPORTABLE SynchronizedObjectMemoryPool<BackgroundSocketPollRequest>;
 #endif
@@ -4783,11 +4807,28 @@ class LIBNETXMS_EXPORTABLE BackgroundSocketPoller
    uint32_t m_workerThreadId;
    SOCKET m_controlSockets[2];
    Mutex m_mutex;
+#if HAVE_SYS_EPOLL_H
+   int m_epollFd;
+   BackgroundSocketPollRequest *m_timerWheel[BACKGROUND_SOCKET_POLLER_WHEEL_SIZE];
+   int64_t m_currentTick;
+   int64_t m_wakeupTick;
+   HashMap<SOCKET, BackgroundSocketPollRequest> m_activeRequests;
+   BackgroundSocketPollRequest *m_cancelledRequests;
+   BackgroundSocketPollRequest *m_failedRequests;
+   uint32_t m_requestGeneration;
+#else
    BackgroundSocketPollRequest *m_head;
+#endif
    bool m_shutdown;
 
    void workerThread();
    void notifyWorkerThread(char command = 'W');
+#if HAVE_SYS_EPOLL_H
+   void activateRequest(BackgroundSocketPollRequest *request);
+   void deactivateRequest(BackgroundSocketPollRequest *request);
+   int64_t getNextTimerTick();
+   BackgroundSocketPollRequest *processExpiredTimers(int64_t now);
+#endif
 
 public:
    BackgroundSocketPoller();
@@ -4802,7 +4843,11 @@ class LIBNETXMS_EXPORTABLE BackgroundSocketPoller
    void cancel(SOCKET socket);
    void shutdown();
 
+#if HAVE_SYS_EPOLL_H
+   bool isValid() const { return (m_controlSockets[0] != INVALID_SOCKET) && (m_epollFd != -1) && (m_workerThread != INVALID_THREAD_HANDLE); }
+#else
    bool isValid() const { return (m_controlSockets[0] != INVALID_SOCKET) && (m_workerThread != INVALID_THREAD_HANDLE); }
+#endif
 };
 
 /**
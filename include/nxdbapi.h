@@ -108,6 +108,65 @@ struct LIBNXDB_PERF_COUNTERS
    uint64_t failedQueries;
 };
 
+/**
+ * Data buffer for bulk copy. Rows are encoded in tab separated text format with backslash escapes
+ * (compatible with PostgreSQL COPY text format).
+ */
+class LIBNXDB_EXPORTABLE DBBulkCopyBuffer
+{
+private:
+   ByteStream m_data;
+   int m_rows;
+   bool m_rowStart;
+
+   void startField()
+   {
+      if (m_rowStart)
+         m_rowStart = false;
+      else
+         m_data.write('\t');
+   }
+
+public:
+   DBBulkCopyBuffer(size_t initialSize = 65536) : m_data(initialSize)
+   {
+      m_data.setAllocationStep(initialSize);
+      m_rows = 0;
+      m_rowStart = true;
+   }
+
+   void add(int32_t value);
+   void add(uint32_t value);
+   void add(int64_t value);
+   void add(uint64_t value);
+   void add(double value);
+   void add(const TCHAR *value);
+   void addUTF8(const char *value);
+   void addNull()
+   {
+      startField();
+      m_data.write("\\N", 2);
+   }
+   void endRow()
+   {
+      m_data.write('\n');
+      m_rows++;
+      m_rowStart = true;
+   }
+
+   const char *data() const { return reinterpret_cast<const char*>(m_data.buffer()); }
+   size_t size() const { return m_data.size(); }
+   int rowCount() const { return m_rows; }
+   bool isEmpty() const { return m_rows == 0; }
+
+   void clear()
+   {
+      m_data.clear();
+      m_rows = 0;
+      m_rowStart = true;
+   }
+};
+
 /**
  * Functions
  */
@@ -213,6 +272,12 @@ bool LIBNXDB_EXPORTABLE DBBegin(DB_HANDLE hConn);
 bool LIBNXDB_EXPORTABLE DBCommit(DB_HANDLE hConn);
 bool LIBNXDB_EXPORTABLE DBRollback(DB_HANDLE hConn);
 
+bool LIBNXDB_EXPORTABLE DBIsBulkCopySupported(DB_DRIVER driver);
+bool LIBNXDB_EXPORTABLE DBIsBulkCopySupported(DB_HANDLE hConn);
+bool LIBNXDB_EXPORTABLE DBBulkCopyBegin(DB_HANDLE hConn, const TCHAR *table, TCHAR *errorText);
+bool LIBNXDB_EXPORTABLE DBBulkCopyData(DB_HANDLE hConn, const char *data, size_t size, TCHAR *errorText);
+bool LIBNXDB_EXPORTABLE DBBulkCopyEnd(DB_HANDLE hConn, bool cancel, TCHAR *errorText);
+
 StringList LIBNXDB_EXPORTABLE *DBGetTableList(DB_HANDLE hdb);
 int LIBNXDB_EXPORTABLE DBIsTableExist(DB_HANDLE conn, const TCHAR *table);
 
@@ -238,6 +303,8 @@ void LIBNXDB_EXPORTABLE DBConnectionPoolShutdown();
 void LIBNXDB_EXPORTABLE DBConnectionPoolReset();
 DB_HANDLE LIBNXDB_EXPORTABLE __DBConnectionPoolAcquireConnection(const char *srcFile, int srcLine);
 #define DBConnectionPoolAcquireConnection() __DBConnectionPoolAcquireConnection(__FILE__, __LINE__)
+DB_HANDLE LIBNXDB_EXPORTABLE __DBConnectionPoolTryAcquireConnection(const char *srcFile, int srcLine);
+#define DBConnectionPoolTryAcquireConnection() __DBConnectionPoolTryAcquireConnection(__FILE__, __LINE__)
 void LIBNXDB_EXPORTABLE DBConnectionPoolReleaseConnection(DB_HANDLE connection);
 int LIBNXDB_EXPORTABLE DBConnectionPoolGetSize();
 int LIBNXDB_EXPORTABLE DBConnectionPoolGetAcquiredCount();
@@ -265,7 +332,8 @@ bool LIBNXDB_EXPORTABLE DBDropColumn(DB_HANDLE hdb, const TCHAR *table, const TC
 bool LIBNXDB_EXPORTABLE DBRenameColumn(DB_HANDLE hdb, const TCHAR *tableName, const TCHAR *oldName, const TCHAR *newName);
 bool LIBNXDB_EXPORTABLE DBDropIndex(DB_HANDLE hdb, const TCHAR *table, const TCHAR *index);
 
-DB_HANDLE LIBNXDB_EXPORTABLE DBOpenInMemoryDatabase();
+DB_HANDLE LIBNXDB_EXPORTABLE DBOpenInMemoryDatabase(const TCHAR *name = nullptr);
+bool LIBNXDB_EXPORTABLE DBAttachInMemoryDatabase(DB_HANDLE hdb, const TCHAR *name);
 void LIBNXDB_EXPORTABLE DBCloseInMemoryDatabase(DB_HANDLE hdb);
 bool LIBNXDB_EXPORTABLE DBCacheTable(DB_HANDLE cacheDB, DB_HANDLE sourceDB, const TCHAR *table, const TCHAR *indexColumn, const TCHAR *columns, const TCHAR * const *intColumns = NULL);
 
@@ -175,6 +175,8 @@ template class LIBNXLP_EXPORTABLE std::function<void(const TCHAR*, const TCHAR*,
 #endif
 
 class LIBNXLP_EXPORTABLE LogParser;
+class LogParserPrefilter;
+struct FileChangeWatch;
 
 #ifdef _WIN32
 
@@ -370,6 +372,7 @@ class LIBNXLP_EXPORTABLE LogParser
 	bool (*m_eventResolver)(const TCHAR *, uint32_t *);
 	THREAD m_thread;	// Associated thread
    Condition m_stopCondition;
+   Condition m_changeCondition;
    int m_recordsProcessed;
 	int m_recordsMatched;
 	bool m_preallocatedFile;
@@ -381,6 +384,8 @@ class LIBNXLP_EXPORTABLE LogParser
    bool m_rescan;
 	bool m_processAllRules;
    bool m_suspended;
+   bool m_usePrefilter;
+   LogParserPrefilter *m_prefilter;
 	LogParserStatus m_status;
 #ifdef _WIN32
    TCHAR *m_marker;
@@ -403,6 +408,7 @@ class LIBNXLP_EXPORTABLE LogParser
 
    off_t processNewRecords(int fh, const TCHAR *fileName);
    bool monitorFile2(off_t startOffset);
+   bool waitForFileChange(FileChangeWatch *watch, uint32_t timeout);
 
 #ifdef _WIN32
    bool monitorFileWithSnapshot(off_t startOffset);
@@ -445,6 +451,9 @@ class LIBNXLP_EXPORTABLE LogParser
 	void setProcessAllFlag(bool flag) { m_processAllRules = flag; }
 	bool getProcessAllFlag() const { return m_processAllRules; }
 
+   void setPrefilterEnabled(bool enabled);
+   bool isPrefilterEnabled() const { return m_usePrefilter; }
+
    void setKeepFileOpenFlag(bool flag) { m_keepFileOpen = flag; }
    bool getKeepFileOpenFlag() const { return m_keepFileOpen; }
 
@@ -128,6 +128,17 @@ struct NXSL_FileHeader
  */
 #include <nxsl_classes.h>
 
+/**
+ * Regular expression cache statistics
+ */
+struct NXSL_RegexpCacheStats
+{
+   uint64_t hits;
+   uint64_t misses;
+   int size;
+   int limit;
+};
+
 /**
  * Functions
  */
@@ -135,5 +146,7 @@ NXSL_Program LIBNXSL_EXPORTABLE *NXSLCompile(const TCHAR *source, NXSL_Environme
 NXSL_VM LIBNXSL_EXPORTABLE *NXSLCompileAndCreateVM(const TCHAR *source, NXSL_Environment *env, NXSL_CompilationDiagnostic *diag);
 StringBuffer LIBNXSL_EXPORTABLE NXSLConvertToV5(const TCHAR *source);
 TCHAR LIBNXSL_EXPORTABLE *NXSLLoadFile(const TCHAR *fileName);
+void LIBNXSL_EXPORTABLE NXSLGetRegexpCacheStats(NXSL_RegexpCacheStats *stats);
+void LIBNXSL_EXPORTABLE NXSLSetRegexpCacheSize(int size);
 
 #endif
@@ -343,6 +343,46 @@ struct NXSL_ExtMethod
       m_methods->set(#name, m); \
    }
 
+/**
+ * External attribute getter structure
+ */
+struct NXSL_ExtAttribute
+{
+   NXSL_Value *(*handler)(NXSL_Object *object, NXSL_VM *vm);
+   bool overridable;    // Attribute can be shadowed by object's dynamic attributes, so it should be resolved via getAttr
+};
+
+#define NXSL_ATTRIBUTE_DEFINITION(clazz, name) \
+   static NXSL_Value *A_##clazz##_##name (NXSL_Object *object, NXSL_VM *vm)
+
+#define NXSL_REGISTER_ATTRIBUTE(clazz, name) { \
+      NXSL_ExtAttribute *a = new NXSL_ExtAttribute; \
+      a->handler = A_##clazz##_##name; \
+      a->overridable = false; \
+      m_attributeGetters->set(#name, a); \
+   }
+
+#define NXSL_REGISTER_ATTRIBUTE_ALIAS(clazz, name, alias) { \
+      NXSL_ExtAttribute *a = new NXSL_ExtAttribute; \
+      a->handler = A_##clazz##_##name; \
+      a->overridable = false; \
+      m_attributeGetters->set(#alias, a); \
+   }
+
+#define NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(clazz, name) { \
+      NXSL_ExtAttribute *a = new NXSL_ExtAttribute; \
+      a->handler = A_##clazz##_##name; \
+      a->overridable = true; \
+      m_attributeGetters->set(#name, a); \
+   }
+
+#define NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE_ALIAS(clazz, name, alias) { \
+      NXSL_ExtAttribute *a = new NXSL_ExtAttribute; \
+      a->handler = A_##clazz##_##name; \
+      a->overridable = true; \
+      m_attributeGetters->set(#alias, a); \
+   }
+
 /**
  * Handle class attribute request. It is supposed to be used within getAttr methhod with standard parameter naming.
  */
@@ -364,6 +404,7 @@ class LIBNXSL_EXPORTABLE NXSL_Class
 
 protected:
    HashMap<NXSL_Identifier, NXSL_ExtMethod> *m_methods;
+   HashMap<NXSL_Identifier, NXSL_ExtAttribute> *m_attributeGetters;
 
    void setName(const TCHAR *name);
    const StringList& getClassHierarchy() const { return m_classHierarchy; }
@@ -401,6 +442,8 @@ class LIBNXSL_EXPORTABLE NXSL_Class
 
 	virtual void toString(StringBuffer *sb, NXSL_Object *object);
 
+   const NXSL_ExtAttribute *findAttributeGetter(const NXSL_Identifier& name) const { return m_attributeGetters->get(name); }
+
    const TCHAR *getName() const { return m_name; }
    bool instanceOf(const TCHAR *name) const { return !_tcscmp(name, m_name) || m_classHierarchy.contains(name); }
 
@@ -1103,13 +1146,19 @@ struct NXSL_VariablePtr;
 struct NXSL_Instruction;
 
 /**
- * Variable pointer restore point
+ * Per-VM replacement for instruction from shared program image
  */
-struct VREF_RESTORE_POINT
-{
-   uint32_t addr;
-   NXSL_Identifier *identifier;
-};
+struct NXSL_InstructionPatch;
+
+/**
+ * Per-VM inline cache entry for attribute access instruction
+ */
+struct NXSL_AttributeCacheEntry;
+
+/**
+ * Compiled program code shared between program object and VMs
+ */
+class NXSL_ProgramImage;
 
 /**
  * Maximum number of variable reference restore points
@@ -1138,7 +1187,7 @@ class LIBNXSL_EXPORTABLE NXSL_VariableSystem : public NXSL_RuntimeObject
    NXSL_VariablePtr *m_variables;
    NXSL_VariableSystemType m_type;
    int m_restorePointCount;
-   VREF_RESTORE_POINT m_restorePoints[MAX_VREF_RESTORE_POINTS];
+   uint32_t m_restorePoints[MAX_VREF_RESTORE_POINTS];
 
 public:
    NXSL_VariableSystem(NXSL_VM *vm, NXSL_VariableSystemType type);
@@ -1153,8 +1202,8 @@ class LIBNXSL_EXPORTABLE NXSL_VariableSystem : public NXSL_RuntimeObject
    void clear();
    bool isConstant() const { return m_type == NXSL_VariableSystemType::CONSTANT; }
 
-   bool createVariableReferenceRestorePoint(uint32_t addr, NXSL_Identifier *identifier);
-   void restoreVariableReferences(StructArray<NXSL_Instruction> *instructions);
+   bool createVariableReferenceRestorePoint(uint32_t addr);
+   void restoreVariableReferences(NXSL_InstructionPatch *patches);
 
    void forEach(void (*callback)(const NXSL_Identifier&, NXSL_Value*, void*), void *context) const;
    template<typename T> void forEach(void (*callback)(const NXSL_Identifier&, NXSL_Value*, T*), T *context) const
@@ -1176,6 +1225,7 @@ struct NXSL_Module
    int m_codeSize;
    int m_functionStart;
    int m_numFunctions;
+   shared_ptr<NXSL_ProgramImage> m_image;   // Code of NXSL module (not set for external modules)
 };
 
 /**
@@ -1211,7 +1261,7 @@ class LIBNXSL_EXPORTABLE NXSL_Program : public NXSL_ValueManager
    friend class NXSL_VM;
 
 private:
-   StructArray<NXSL_Instruction> m_instructionSet;
+   shared_ptr<NXSL_ProgramImage> m_image;
    StructArray<NXSL_ModuleImport> m_requiredModules;
    StructArray<NXSL_FunctionImport> m_importedFunctions;
    NXSL_ValueHashMap<NXSL_Identifier> m_constants;
@@ -1223,7 +1273,7 @@ class LIBNXSL_EXPORTABLE NXSL_Program : public NXSL_ValueManager
    NXSL_Program(NXSL_ProgramBuilder *builder);
    ~NXSL_Program();
 
-   uint32_t getCodeSize() const { return m_instructionSet.size(); }
+   uint32_t getCodeSize() const;
    bool isEmpty() const;
    StringList *getRequiredModules(bool withFlags = false) const;
    const TCHAR *getMetadataEntry(const TCHAR *key) const { return m_metadata.get(key); }
@@ -1379,7 +1429,13 @@ class LIBNXSL_EXPORTABLE NXSL_VM : public NXSL_ValueManager
    StringMap m_metadata;
 	void *m_userData;
 
-   StructArray<NXSL_Instruction> m_instructionSet;
+   shared_ptr<NXSL_ProgramImage> m_image;
+   uint32_t m_codeSize;
+   NXSL_InstructionPatch *m_patches;  // Per-VM instruction replacements (resolved variables, functions, constants)
+   NXSL_AttributeCacheEntry *m_attributeCache;  // Inline cache for attribute access instructions (allocated on first use)
+   const NXSL_Instruction *m_segmentCode;   // Code segment (main program or module) containing current instruction
+   uint32_t m_segmentStart;
+   uint32_t m_segmentSize;
    uint32_t m_cp;
    bool m_stopFlag;
    FILE *m_instructionTraceFile;
@@ -1423,7 +1479,8 @@ class LIBNXSL_EXPORTABLE NXSL_VM : public NXSL_ValueManager
    uint32_t callSelector(const NXSL_Identifier& name, int numElements);
    void pushProperty(const NXSL_Identifier& name);
    void doUnaryOperation(int nOpCode);
-   void doBinaryOperation(int nOpCode);
+   void doBinaryOperation(int nOpCode, NXSL_Instruction *instruction);
+   NXSL_Value *getObjectAttribute(NXSL_Object *object, const NXSL_Identifier& name);
    void buildString(int numElements);
    void getOrUpdateArrayElement(int opcode, NXSL_Value *array, NXSL_Value *index);
    bool setArrayElement(NXSL_Value *array, NXSL_Value *index, NXSL_Value *value);
@@ -1442,7 +1499,10 @@ class LIBNXSL_EXPORTABLE NXSL_VM : public NXSL_ValueManager
 	NXSL_Variable *createVariable(const NXSL_Identifier& name);
 	bool isDefinedConstant(const NXSL_Identifier& name);
 
-   void relocateCode(uint32_t startOffset, uint32_t len, uint32_t shift);
+   const NXSL_Instruction *findCodeSegment(uint32_t addr, uint32_t *start, uint32_t *size) const;
+   NXSL_Value *getConstantOperand(NXSL_Instruction *instruction);
+   void resizePatchTable(uint32_t codeSize);
+   void resetCode();
    uint32_t getFunctionAddress(const NXSL_Identifier& name);
    const NXSL_ExtFunction *findExternalFunction(const NXSL_Identifier& name);
 
@@ -1507,7 +1567,7 @@ class LIBNXSL_EXPORTABLE NXSL_VM : public NXSL_ValueManager
    void stop() { m_stopFlag = true; }
    void setInstructionTraceFile(FILE *fp) { m_instructionTraceFile = fp; }
 
-   uint32_t getCodeSize() const { return m_instructionSet.size(); }
+   uint32_t getCodeSize() const { return m_codeSize; }
 
    void print(const TCHAR *text) { m_env->print(text); }
 	void trace(int level, const TCHAR *text);
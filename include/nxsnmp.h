@@ -947,6 +947,12 @@ class LIBNXSNMP_EXPORTABLE SNMP_PDU
    SNMP_Variable *getVariable(int index) { return m_variables.get(index); }
    SNMP_Version getVersion() const { return m_version; }
    SNMP_ErrorCode getErrorCode() const { return static_cast<SNMP_ErrorCode>(m_errorCode); }
+   uint32_t getErrorIndex() const { return m_errorIndex; }
+
+   // GETBULK request parameters are encoded in place of error status and error index
+   void setBulkParameters(uint32_t nonRepeaters, uint32_t maxRepetitions) { m_errorCode = nonRepeaters; m_errorIndex = maxRepetitions; }
+   uint32_t getNonRepeaters() const { return m_errorCode; }
+   uint32_t getMaxRepetitions() const { return m_errorIndex; }
 
    void setTrapId(const SNMP_ObjectId& id) { setTrapId(id.value(), id.length()); }
    void setTrapId(const uint32_t *value, size_t length);
@@ -1000,6 +1006,7 @@ class LIBNXSNMP_EXPORTABLE SNMP_Transport
 	bool m_reliable;
 	SNMP_Version m_snmpVersion;
 	SNMP_Codepage m_codepage;
+   uint32_t m_bulkMaxRepetitions;   // Max repetitions for GETBULK requests in MIB walk, 0 to use GETNEXT requests
 
 	uint32_t doEngineIdDiscovery(SNMP_PDU *originalRequest, uint32_t timeout, int numRetries);
 
@@ -1033,9 +1040,81 @@ class LIBNXSNMP_EXPORTABLE SNMP_Transport
 	void setSnmpVersion(SNMP_Version version) { m_snmpVersion = version; }
 	SNMP_Version getSnmpVersion() const { return m_snmpVersion; }
 
+   void setBulkMaxRepetitions(uint32_t maxRepetitions) { m_bulkMaxRepetitions = maxRepetitions; }
+   uint32_t getBulkMaxRepetitions() const { return m_bulkMaxRepetitions; }
+
    void setCodepage(const char* codepage) { strlcpy(m_codepage.codepage, codepage, 16); }
 };
 
+/**
+ * Callback for asynchronous SNMP request completion. Callback receives ownership of response PDU (which is null on error).
+ */
+typedef std::function<void (uint32_t, SNMP_PDU*)> SNMP_ResponseCallback;
+
+struct SNMP_PendingRequest;
+struct SNMP_CompletedRequest;
+
+/**
+ * Retransmission/timeout timer for asynchronous SNMP request
+ */
+struct SNMP_RequestTimer
+{
+   int64_t due;
+   uint64_t serial;
+   uint32_t key;
+};
+
+/**
+ * Asynchronous SNMP request engine. Sends requests to any number of peers over shared UDP sockets (one per address family),
+ * matches responses by request ID (message ID for SNMPv3) and peer address, and handles retransmissions and timeouts from timer heap.
+ * All I/O is done by single worker thread.
+ */
+class LIBNXSNMP_EXPORTABLE SNMP_RequestEngine
+{
+private:
+   SOCKET m_sockets[2];    // IPv4 and IPv6
+   SOCKET m_controlSockets[2];
+   THREAD m_workerThread;
+   Mutex m_mutex;
+   HashMap<uint32_t, SNMP_PendingRequest> m_requests;
+   std::vector<SNMP_RequestTimer> m_timers;   // Heap ordered by due time
+   uint64_t m_serial;
+   uint64_t m_retransmissions;
+   uint64_t m_timeouts;
+   bool m_running;
+   bool m_shutdown;
+
+   void workerThread();
+   void notifyWorkerThread();
+   uint32_t processTimers(int64_t now, StructArray<SNMP_CompletedRequest> *completed);
+   void receiveResponses(SOCKET s, BYTE *buffer, StructArray<SNMP_CompletedRequest> *completed);
+
+public:
+   SNMP_RequestEngine();
+   SNMP_RequestEngine(const SNMP_RequestEngine& src) = delete;
+   ~SNMP_RequestEngine();
+
+   bool start();
+   void shutdown();
+   bool isRunning() const { return m_running; }
+   bool isAddressFamilySupported(int family) const { return m_sockets[(family == AF_INET) ? 0 : 1] != INVALID_SOCKET; }
+
+   int sendRequest(SNMP_PDU *request, const InetAddress& addr, uint16_t port, SNMP_SecurityContext *securityContext,
+            SNMP_ResponseCallback callback, uint32_t timeout = 0, int numRetries = 0, bool engineIdAutoupdate = false, uint64_t *serial = nullptr);
+   int sendRequest(SNMP_PDU *request, const struct sockaddr *addr, SNMP_SecurityContext *securityContext,
+            SNMP_ResponseCallback callback, uint32_t timeout = 0, int numRetries = 0, bool engineIdAutoupdate = false, uint64_t *serial = nullptr);
+   void cancelRequest(uint32_t key, uint64_t serial);
+
+   int getPendingRequestCount();
+   uint64_t getRetransmissionCount() const { return m_retransmissions; }
+   uint64_t getTimeoutCount() const { return m_timeouts; }
+};
+
+void LIBNXSNMP_EXPORTABLE SnmpSetDefaultRequestEngine(SNMP_RequestEngine *engine);
+SNMP_RequestEngine LIBNXSNMP_EXPORTABLE *SnmpGetDefaultRequestEngine();
+
+struct SNMP_EngineResponse;
+
 /**
  * UDP SNMP transport
  */
@@ -1050,10 +1129,14 @@ class LIBNXSNMP_EXPORTABLE SNMP_UDPTransport : public SNMP_Transport
    size_t m_dwBufferPos;
    BYTE *m_pBuffer;
    UINT16 m_port;
+   SNMP_RequestEngine *m_engine;   // Request engine used instead of own socket
+   shared_ptr<SNMP_EngineResponse> m_engineResponse;
 
    size_t preParsePDU();
    int recvData(UINT32 dwTimeout, struct sockaddr *pSender, socklen_t *piAddrSize);
    void clearBuffer();
+   int sendMessageViaEngine(SNMP_PDU *pdu, uint32_t timeout);
+   int readMessageFromEngine(SNMP_PDU **pdu, uint32_t timeout);
 
 public:
    SNMP_UDPTransport();
@@ -1271,6 +1354,8 @@ void LIBNXSNMP_EXPORTABLE SnmpSetDefaultTimeout(uint32_t timeout);
 uint32_t LIBNXSNMP_EXPORTABLE SnmpGetDefaultTimeout();
 void LIBNXSNMP_EXPORTABLE SnmpSetDefaultRetryCount(int numRetries);
 int LIBNXSNMP_EXPORTABLE SnmpGetDefaultRetryCount();
+void LIBNXSNMP_EXPORTABLE SnmpSetDefaultBulkMaxRepetitions(uint32_t maxRepetitions);
+uint32_t LIBNXSNMP_EXPORTABLE SnmpGetDefaultBulkMaxRepetitions();
 uint32_t LIBNXSNMP_EXPORTABLE SnmpGet(SNMP_Version version, SNMP_Transport *transport, const SNMP_ObjectId& oid, void *value, size_t bufferSize, uint32_t flags);
 uint32_t LIBNXSNMP_EXPORTABLE SnmpGet(SNMP_Version version, SNMP_Transport *transport, const TCHAR *oidStr, const uint32_t *oidBinary, size_t oidLen, void *value, size_t bufferSize, uint32_t flags);
 uint32_t LIBNXSNMP_EXPORTABLE SnmpGetEx(SNMP_Transport *transport, const TCHAR *oidStr, const uint32_t *oidBinary, size_t oidLen,
@@ -71,6 +71,20 @@ class WelfordVariance
       update(static_cast<double>(v));
    }
 
+   /**
+    * Merge with data set given as number of samples, mean value, and sum of squared differences from mean
+    */
+   void merge(int64_t samples, double mean, double ss)
+   {
+      if (samples <= 0)
+         return;
+      int64_t total = m_samples + samples;
+      double delta = mean - m_mean;
+      m_ss += ss + delta * delta * static_cast<double>(m_samples) * static_cast<double>(samples) / static_cast<double>(total);
+      m_mean += delta * static_cast<double>(samples) / static_cast<double>(total);
+      m_samples = total;
+   }
+
    /**
     * Reset
     */
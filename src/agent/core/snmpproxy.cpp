@@ -226,7 +226,7 @@ static inline void StartBackgroundPoll(SOCKET hSocket, ProxyContext *context)
    for(int i = 0; i < s_snmpProxySocketPollers.size(); i++)
    {
       BackgroundSocketPollerHandle *p = s_snmpProxySocketPollers.get(i);
-      if (InterlockedIncrement(&p->usageCount) < SOCKET_POLLER_MAX_SOCKETS)
+      if (InterlockedIncrement(&p->usageCount) < BACKGROUND_SOCKET_POLLER_MAX_SOCKETS)
       {
          sp = p;
          break;
@@ -154,6 +154,8 @@ private void fillMetricList()
          list.add(new AgentParameter("Server.AgentTunnels.Bound.SyslogProxy", "Number of bound agent tunnels with enabled syslog proxy", DataType.UINT32));
          list.add(new AgentParameter("Server.AgentTunnels.Bound.UserAgent", "Number of bound agent tunnels with installed user agent", DataType.UINT32));
          list.add(new AgentParameter("Server.AgentTunnels.Unbound.Total", "Number of unbound agent tunnels", DataType.UINT32));
+         list.add(new AgentParameter("Server.AnomalyDetection.ModelCache.Size", "Number of cached anomaly detection models", DataType.UINT32));
+         list.add(new AgentParameter("Server.AnomalyDetection.TrainingTime", "Average anomaly detection model training time (milliseconds)", DataType.UINT32));
          list.add(new AgentParameter("Server.AverageDCIQueuingTime", "Average time to queue DCI for polling for last minute", DataType.UINT32));
          list.add(new AgentParameter("Server.Certificate.ExpirationDate", "Server certificate expiration date (YYYY-MM-DD)", DataType.STRING)); 
          list.add(new AgentParameter("Server.Certificate.ExpirationTime", "Server certificate expiration time", DataType.UINT64)); 
@@ -167,6 +169,8 @@ private void fillMetricList()
          list.add(new AgentParameter("Server.ClientSessions.Total", "Client sessions: total", DataType.UINT32));
          list.add(new AgentParameter("Server.ClientSessions.Web", "Client sessions: web clients", DataType.UINT32));
          list.add(new AgentParameter("Server.ClientSessions.Web(*)", "Client sessions for user {instance}: web clients", DataType.UINT32));
+         list.add(new AgentParameter("Server.DataCollection.ItemsScheduledLate", "Number of data collection items queued for polling later than scheduled", DataType.COUNTER64));
+         list.add(new AgentParameter("Server.DataCollection.SchedulingLag", "Average data collection scheduling lag for last 5 minutes (milliseconds)", DataType.UINT32));
          list.add(new AgentParameter("Server.DataCollectionItems", "Number of data collection items in the system", DataType.UINT32));
          list.add(new AgentParameter("Server.DB.Queries.Failed", "Failed DB queries", DataType.COUNTER64));
          list.add(new AgentParameter("Server.DB.Queries.LongRunning", "Long running DB queries", DataType.COUNTER64));
@@ -176,6 +180,7 @@ private void fillMetricList()
          list.add(new AgentParameter("Server.DBWriter.Requests.IData", "DB writer requests (DCI data)", DataType.COUNTER64));
          list.add(new AgentParameter("Server.DBWriter.Requests.Other", "DB writer requests (other queries)", DataType.COUNTER64));
          list.add(new AgentParameter("Server.DBWriter.Requests.RawData", "DB writer requests (raw DCI data)", DataType.COUNTER64));
+         list.add(new AgentParameter("Server.EventLogWriter.QueueLatency(*)", "Event log writer: queue latency percentile {instance} (milliseconds)", DataType.UINT32));
          list.add(new AgentParameter("Server.EventProcessor.AverageWaitTime(*)", "Event processor {instance}: average event wait time", DataType.UINT32));
          list.add(new AgentParameter("Server.EventProcessor.Bindings(*)", "Event processor {instance}: active bindings", DataType.UINT32));
          list.add(new AgentParameter("Server.EventProcessor.ProcessedEvents(*)", "Event processor {instance}: total number of processed events", DataType.COUNTER64));
@@ -207,6 +212,10 @@ private void fillMetricList()
          list.add(new AgentParameter("Server.SyncerRunTime.Last", "Syncer run time: last", DataType.UINT32));
          list.add(new AgentParameter("Server.SyncerRunTime.Max", "Syncer run time: max", DataType.UINT32));
          list.add(new AgentParameter("Server.SyncerRunTime.Min", "Syncer run time: min", DataType.UINT32));
+         list.add(new AgentParameter("Server.Syslog.Drops.Malformed", "Syslog messages dropped because they cannot be parsed", DataType.COUNTER64));
+         list.add(new AgentParameter("Server.Syslog.Drops.ReceiveBuffer", "Syslog messages dropped because of socket receive buffer overflow", DataType.COUNTER64));
+         list.add(new AgentParameter("Server.Syslog.Drops.UnknownSource", "Syslog messages dropped because they are from unknown source", DataType.COUNTER64));
+         list.add(new AgentParameter("Server.Syslog.ProcessorQueueSize(*)", "Syslog processor {instance}: queue size", DataType.INT64));
          list.add(new AgentParameter("Server.ThreadPool.ActiveRequests(*)", "Thread pool {instance}: active requests", DataType.INT32));
          list.add(new AgentParameter("Server.ThreadPool.AverageWaitTime(*)", "Thread pool {instance}: average wait time", DataType.UINT32));
          list.add(new AgentParameter("Server.ThreadPool.CurrSize(*)", "Thread pool {instance}: current size", DataType.INT32));
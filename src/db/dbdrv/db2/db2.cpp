@@ -1143,7 +1143,10 @@ static DBDriverCallTable s_callTable =
    GetColumnCountUnbuffered,
    GetColumnNameUnbuffered,
    PrepareString,
-   IsTableExist
+   IsTableExist,
+   nullptr, // CopyBegin
+   nullptr, // CopyData
+   nullptr  // CopyEnd
 };
 
 DB_DRIVER_ENTRY_POINT("DB2", s_callTable)
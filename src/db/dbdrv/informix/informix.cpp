@@ -970,7 +970,10 @@ static DBDriverCallTable s_callTable =
    GetColumnCountUnbuffered,
    GetColumnNameUnbuffered,
    PrepareString,
-   IsTableExist
+   IsTableExist,
+   nullptr, // CopyBegin
+   nullptr, // CopyData
+   nullptr  // CopyEnd
 };
 
 DB_DRIVER_ENTRY_POINT("INFORMIX", s_callTable)
@@ -1256,7 +1256,10 @@ static DBDriverCallTable s_callTable =
    GetColumnCountUnbuffered,
    GetColumnNameUnbuffered,
    PrepareString,
-   IsTableExist
+   IsTableExist,
+   nullptr, // CopyBegin
+   nullptr, // CopyData
+   nullptr  // CopyEnd
 };
 
 DB_DRIVER_ENTRY_POINT("MARIADB", s_callTable)
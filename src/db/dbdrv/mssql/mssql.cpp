@@ -981,7 +981,10 @@ static DBDriverCallTable s_callTable =
    GetColumnCountUnbuffered,
    GetColumnNameUnbuffered,
    PrepareString,
-   IsTableExist
+   IsTableExist,
+   nullptr, // CopyBegin
+   nullptr, // CopyData
+   nullptr  // CopyEnd
 };
 
 DB_DRIVER_ENTRY_POINT("MSSQL", s_callTable)
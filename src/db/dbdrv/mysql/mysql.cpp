@@ -1175,7 +1175,10 @@ static DBDriverCallTable s_callTable =
    GetColumnCountUnbuffered,
    GetColumnNameUnbuffered,
    PrepareString,
-   IsTableExist
+   IsTableExist,
+   nullptr, // CopyBegin
+   nullptr, // CopyData
+   nullptr  // CopyEnd
 };
 
 DB_DRIVER_ENTRY_POINT("MYSQL", s_callTable)
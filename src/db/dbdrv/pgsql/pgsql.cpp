@@ -1165,6 +1165,113 @@ static int IsTableExist(DBDRV_CONNECTION connection, const WCHAR *name)
    return rc;
 }
 
+/**
+ * Start bulk copy into given table. Connection remains locked until CopyEnd is called.
+ */
+static uint32_t CopyBegin(DBDRV_CONNECTION connection, const WCHAR *table, WCHAR *errorText)
+{
+   auto conn = static_cast<PG_CONN*>(connection);
+
+   QueryString tableUTF8 = QueryToUTF8(table);
+   size_t len = strlen(tableUTF8) + 32;
+   QueryString query(len);
+   snprintf(query.buffer(), len, "COPY %s FROM STDIN", tableUTF8.buffer());
+
+   conn->mutexQueryLock.lock();
+   PGresult *result = PQexec(conn->handle, query);
+   if (PQresultStatus(result) == PGRES_COPY_IN)
+   {
+      PQclear(result);
+      if (errorText != nullptr)
+         *errorText = 0;
+      return DBERR_SUCCESS;
+   }
+
+   if (errorText != nullptr)
+   {
+      utf8_to_wchar(PQerrorMessage(conn->handle), -1, errorText, DBDRV_MAX_ERROR_TEXT);
+      errorText[DBDRV_MAX_ERROR_TEXT - 1] = 0;
+      RemoveTrailingCRLFW(errorText);
+   }
+   PQclear(result);
+   uint32_t rc = (PQstatus(conn->handle) == CONNECTION_BAD) ? DBERR_CONNECTION_LOST : DBERR_OTHER_ERROR;
+   conn->mutexQueryLock.unlock();
+   return rc;
+}
+
+/**
+ * Send data for bulk copy. Data should be in PostgreSQL COPY text format.
+ */
+static uint32_t CopyData(DBDRV_CONNECTION connection, const char *data, size_t size, WCHAR *errorText)
+{
+   auto conn = static_cast<PG_CONN*>(connection);
+   if (PQputCopyData(conn->handle, data, static_cast<int>(size)) == 1)
+      return DBERR_SUCCESS;
+
+   if (errorText != nullptr)
+   {
+      utf8_to_wchar(PQerrorMessage(conn->handle), -1, errorText, DBDRV_MAX_ERROR_TEXT);
+      errorText[DBDRV_MAX_ERROR_TEXT - 1] = 0;
+      RemoveTrailingCRLFW(errorText);
+   }
+   return (PQstatus(conn->handle) == CONNECTION_BAD) ? DBERR_CONNECTION_LOST : DBERR_OTHER_ERROR;
+}
+
+/**
+ * Complete (or cancel) bulk copy and unlock connection
+ */
+static uint32_t CopyEnd(DBDRV_CONNECTION connection, bool cancel, WCHAR *errorText)
+{
+   auto conn = static_cast<PG_CONN*>(connection);
+
+   uint32_t rc;
+   if (PQputCopyEnd(conn->handle, cancel ? "cancelled by client" : nullptr) == 1)
+   {
+      rc = cancel ? DBERR_OTHER_ERROR : DBERR_SUCCESS;
+      PGresult *result;
+      while((result = PQgetResult(conn->handle)) != nullptr)
+      {
+         if ((PQresultStatus(result) != PGRES_COMMAND_OK) && (rc == DBERR_SUCCESS))
+         {
+            if (errorText != nullptr)
+            {
+               const char *sqlState = PQresultErrorField(result, PG_DIAG_SQLSTATE);
+               utf8_to_wchar(CHECK_NULL_EX_A(sqlState), -1, errorText, DBDRV_MAX_ERROR_TEXT);
+               int len = (int)wcslen(errorText);
+               if (len > 0)
+               {
+                  errorText[len] = L' ';
+                  len++;
+               }
+               utf8_to_wchar(PQerrorMessage(conn->handle), -1, &errorText[len], DBDRV_MAX_ERROR_TEXT - len);
+               errorText[DBDRV_MAX_ERROR_TEXT - 1] = 0;
+               RemoveTrailingCRLFW(errorText);
+            }
+            rc = DBERR_OTHER_ERROR;
+         }
+         PQclear(result);
+      }
+   }
+   else
+   {
+      if (errorText != nullptr)
+      {
+         utf8_to_wchar(PQerrorMessage(conn->handle), -1, errorText, DBDRV_MAX_ERROR_TEXT);
+         errorText[DBDRV_MAX_ERROR_TEXT - 1] = 0;
+         RemoveTrailingCRLFW(errorText);
+      }
+      rc = DBERR_OTHER_ERROR;
+   }
+
+   if ((rc != DBERR_SUCCESS) && (PQstatus(conn->handle) == CONNECTION_BAD))
+      rc = DBERR_CONNECTION_LOST;
+   else if ((rc == DBERR_SUCCESS) && (errorText != nullptr))
+      *errorText = 0;
+
+   conn->mutexQueryLock.unlock();
+   return rc;
+}
+
 /**
  * Driver call table
  */
@@ -1204,7 +1311,10 @@ static DBDriverCallTable s_callTable =
    GetColumnCountUnbuffered,
    GetColumnNameUnbuffered,
    PrepareString,
-   IsTableExist
+   IsTableExist,
+   CopyBegin,
+   CopyData,
+   CopyEnd
 };
 
 DB_DRIVER_ENTRY_POINT("PGSQL", s_callTable)
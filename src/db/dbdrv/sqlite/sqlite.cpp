@@ -96,7 +96,7 @@ static DBDRV_CONNECTION Connect(const char *host, const char *login, const char
 {
    SQLITE_CONN *pConn;
 	sqlite3 *hdb;
-   if (sqlite3_open_v2(database, &hdb, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, nullptr) == SQLITE_OK)
+   if (sqlite3_open_v2(database, &hdb, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_URI, nullptr) == SQLITE_OK)
    {
       sqlite3_busy_timeout(hdb, 30000);  // 30 sec. busy timeout
 
@@ -781,7 +781,10 @@ static DBDriverCallTable s_callTable =
    GetColumnCountUnbuffered,
    GetColumnNameUnbuffered,
    PrepareString,
-   IsTableExist
+   IsTableExist,
+   nullptr, // CopyBegin
+   nullptr, // CopyData
+   nullptr  // CopyEnd
 };
 
 DB_DRIVER_ENTRY_POINT("SQLITE", s_callTable)
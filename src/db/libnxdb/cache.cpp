@@ -26,26 +26,44 @@
 #define DEBUG_TAG _T("db.cache")
 
 /**
- * Open in memory database
+ * Open in memory database. If name is given, database is opened in shared cache mode and can be attached
+ * to other in-memory databases within same process by calling DBAttachInMemoryDatabase. Named database
+ * exists until last connection to it is closed.
  */
-DB_HANDLE LIBNXDB_EXPORTABLE DBOpenInMemoryDatabase()
+DB_HANDLE LIBNXDB_EXPORTABLE DBOpenInMemoryDatabase(const TCHAR *name)
 {
    DB_DRIVER drv = DBLoadDriver(_T("sqlite.ddr"), nullptr, nullptr, nullptr);
    if (drv == nullptr)
       return nullptr;
 
+   TCHAR uri[256];
+   if (name != nullptr)
+      _sntprintf(uri, 256, _T("file:%s?mode=memory&cache=shared"), name);
+
    TCHAR errorText[DBDRV_MAX_ERROR_TEXT];
-   DB_HANDLE hdb = DBConnect(drv, nullptr, _T(":memory:"), nullptr, nullptr, nullptr, errorText);
+   DB_HANDLE hdb = DBConnect(drv, nullptr, (name != nullptr) ? uri : _T(":memory:"), nullptr, nullptr, nullptr, errorText);
    if (hdb == nullptr)
    {
       nxlog_debug_tag(DEBUG_TAG, 2, _T("Cannot open in-memory database: %s"), errorText);
       DBUnloadDriver(drv);
+      return nullptr;
    }
 
    DBQuery(hdb, _T("PRAGMA page_size=65536"));
    return hdb;
 }
 
+/**
+ * Attach named in-memory database (previously opened by DBOpenInMemoryDatabase) to given in-memory database.
+ * Tables from attached database can be accessed without schema prefix if their names are unique.
+ */
+bool LIBNXDB_EXPORTABLE DBAttachInMemoryDatabase(DB_HANDLE hdb, const TCHAR *name)
+{
+   TCHAR query[512];
+   _sntprintf(query, 512, _T("ATTACH DATABASE 'file:%s?mode=memory&cache=shared' AS %s"), name, name);
+   return DBQuery(hdb, query);
+}
+
 /**
  * Close in-memory database
  */
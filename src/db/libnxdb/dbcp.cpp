@@ -307,12 +307,11 @@ void LIBNXDB_EXPORTABLE DBConnectionPoolReset()
 }
 
 /**
- * Acquire connection from pool. This function never fails - if it's impossible to acquire
- * pooled connection, calling thread will be suspended until there will be connection available.
+ * Try to acquire connection from pool (single attempt). Returns nullptr if all connections are in use
+ * and pool cannot grow.
  */
-DB_HANDLE LIBNXDB_EXPORTABLE __DBConnectionPoolAcquireConnection(const char *srcFile, int srcLine)
+static DB_HANDLE TryAcquireConnection(const char *srcFile, int srcLine)
 {
-retry:
 	m_poolAccessMutex.lock();
 
 	DB_HANDLE handle = nullptr;
@@ -366,19 +365,40 @@ DB_HANDLE LIBNXDB_EXPORTABLE __DBConnectionPoolAcquireConnection(const char *src
 	}
 
 	m_poolAccessMutex.unlock();
+	return handle;
+}
 
-	if (handle == NULL)
+/**
+ * Acquire connection from pool. This function never fails - if it's impossible to acquire
+ * pooled connection, calling thread will be suspended until there will be connection available.
+ */
+DB_HANDLE LIBNXDB_EXPORTABLE __DBConnectionPoolAcquireConnection(const char *srcFile, int srcLine)
+{
+   DB_HANDLE handle;
+	while((handle = TryAcquireConnection(srcFile, srcLine)) == nullptr)
 	{
    	nxlog_debug_tag(DEBUG_TAG, 1, _T("Database connection pool exhausted (call from %hs:%d)"), srcFile, srcLine);
       m_condRelease.wait(10000);
       nxlog_debug_tag(DEBUG_TAG, 5, _T("Retry acquire connection (call from %hs:%d)"), srcFile, srcLine);
-      goto retry;
 	}
 
    nxlog_debug_tag(DEBUG_TAG, 7, _T("Handle %p acquired (call from %hs:%d)"), handle, srcFile, srcLine);
 	return handle;
 }
 
+/**
+ * Try to acquire connection from pool without waiting. Returns nullptr if no connection is available.
+ */
+DB_HANDLE LIBNXDB_EXPORTABLE __DBConnectionPoolTryAcquireConnection(const char *srcFile, int srcLine)
+{
+   DB_HANDLE handle = TryAcquireConnection(srcFile, srcLine);
+   if (handle != nullptr)
+      nxlog_debug_tag(DEBUG_TAG, 7, _T("Handle %p acquired (call from %hs:%d)"), handle, srcFile, srcLine);
+   else
+      nxlog_debug_tag(DEBUG_TAG, 5, _T("No free connections in pool (call from %hs:%d)"), srcFile, srcLine);
+   return handle;
+}
+
 /**
  * Release acquired connection
  */
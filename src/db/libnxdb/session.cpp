@@ -1878,6 +1878,121 @@ bool LIBNXDB_EXPORTABLE DBRollback(DB_HANDLE hConn)
    return bRet;
 }
 
+/**
+ * Report failed bulk copy operation
+ */
+static void ReportBulkCopyFailure(DB_HANDLE hConn, const TCHAR *operation, uint32_t rc, const WCHAR *wcErrorText, TCHAR *errorText)
+{
+#ifndef UNICODE
+   wchar_to_mb(wcErrorText, -1, errorText, DBDRV_MAX_ERROR_TEXT);
+   errorText[DBDRV_MAX_ERROR_TEXT - 1] = 0;
+#endif
+   InterlockedIncrement64(&s_perfFailedQueries);
+   nxlog_write_tag(NXLOG_ERROR, DEBUG_TAG_DRIVER, _T("Bulk copy %s failed: %s"), operation, errorText);
+   if (hConn->m_driver->m_fpEventHandler != nullptr)
+      hConn->m_driver->m_fpEventHandler(DBEVENT_QUERY_FAILED, L"COPY", wcErrorText, rc == DBERR_CONNECTION_LOST, hConn->m_driver->m_context);
+}
+
+/**
+ * Check if bulk copy is supported by database driver
+ */
+bool LIBNXDB_EXPORTABLE DBIsBulkCopySupported(DB_DRIVER driver)
+{
+   return (driver->m_callTable.CopyBegin != nullptr) && (driver->m_callTable.CopyData != nullptr) && (driver->m_callTable.CopyEnd != nullptr);
+}
+
+/**
+ * Check if bulk copy is supported by driver used for given connection
+ */
+bool LIBNXDB_EXPORTABLE DBIsBulkCopySupported(DB_HANDLE hConn)
+{
+   return DBIsBulkCopySupported(hConn->m_driver);
+}
+
+/**
+ * Start bulk copy into given table. Table can be followed by column list in parenthesis. Connection will remain
+ * locked by calling thread until DBBulkCopyEnd is called. On failure connection is left unlocked.
+ */
+bool LIBNXDB_EXPORTABLE DBBulkCopyBegin(DB_HANDLE hConn, const TCHAR *table, TCHAR *errorText)
+{
+   if (!DBIsBulkCopySupported(hConn))
+   {
+      _tcslcpy(errorText, _T("Bulk copy is not supported by database driver"), DBDRV_MAX_ERROR_TEXT);
+      return false;
+   }
+
+#ifdef UNICODE
+   auto wcTable = table;
+   auto wcErrorText = errorText;
+#else
+   WCHAR *wcTable = WideStringFromMBString(table);
+   WCHAR wcErrorText[DBDRV_MAX_ERROR_TEXT] = L"";
+#endif
+
+   hConn->m_mutexTransLock.lock();
+   uint32_t rc = hConn->m_driver->m_callTable.CopyBegin(hConn->m_connection, wcTable, wcErrorText);
+   if ((rc == DBERR_CONNECTION_LOST) && hConn->m_reconnectEnabled && (hConn->m_transactionLevel == 0))
+   {
+      DBReconnect(hConn);
+      rc = hConn->m_driver->m_callTable.CopyBegin(hConn->m_connection, wcTable, wcErrorText);
+   }
+
+   InterlockedIncrement64(&s_perfNonSelectQueries);
+   InterlockedIncrement64(&s_perfTotalQueries);
+   if (s_queryTrace)
+      nxlog_debug_tag(DEBUG_TAG_QUERY, 9, _T("%s bulk copy start: \"%s\""), (rc == DBERR_SUCCESS) ? _T("Successful") : _T("Failed"), table);
+
+   if (rc != DBERR_SUCCESS)
+   {
+      hConn->m_mutexTransLock.unlock();
+      ReportBulkCopyFailure(hConn, _T("start"), rc, wcErrorText, errorText);
+   }
+
+#ifndef UNICODE
+   MemFree(wcTable);
+#endif
+   return rc == DBERR_SUCCESS;
+}
+
+/**
+ * Send data block for bulk copy. Data should be in tab separated text format (as produced by DBBulkCopyBuffer).
+ * Rows can span multiple blocks.
+ */
+bool LIBNXDB_EXPORTABLE DBBulkCopyData(DB_HANDLE hConn, const char *data, size_t size, TCHAR *errorText)
+{
+#ifdef UNICODE
+   auto wcErrorText = errorText;
+#else
+   WCHAR wcErrorText[DBDRV_MAX_ERROR_TEXT] = L"";
+#endif
+   uint32_t rc = hConn->m_driver->m_callTable.CopyData(hConn->m_connection, data, size, wcErrorText);
+   if (rc != DBERR_SUCCESS)
+      ReportBulkCopyFailure(hConn, _T("data transfer"), rc, wcErrorText, errorText);
+   return rc == DBERR_SUCCESS;
+}
+
+/**
+ * Complete or cancel bulk copy and unlock connection. Must be called after successful call to DBBulkCopyBegin
+ * even if data transfer has failed.
+ */
+bool LIBNXDB_EXPORTABLE DBBulkCopyEnd(DB_HANDLE hConn, bool cancel, TCHAR *errorText)
+{
+#ifdef UNICODE
+   auto wcErrorText = errorText;
+#else
+   WCHAR wcErrorText[DBDRV_MAX_ERROR_TEXT] = L"";
+#endif
+   uint32_t rc = hConn->m_driver->m_callTable.CopyEnd(hConn->m_connection, cancel, wcErrorText);
+   if (s_queryTrace)
+      nxlog_debug_tag(DEBUG_TAG_QUERY, 9, _T("Bulk copy %s"), (rc == DBERR_SUCCESS) ? _T("completed") : (cancel ? _T("cancelled") : _T("failed")));
+   if ((rc == DBERR_CONNECTION_LOST) && hConn->m_reconnectEnabled && (hConn->m_transactionLevel == 0))
+      DBReconnect(hConn);
+   hConn->m_mutexTransLock.unlock();
+   if ((rc != DBERR_SUCCESS) && !cancel)
+      ReportBulkCopyFailure(hConn, _T("completion"), rc, wcErrorText, errorText);
+   return rc == DBERR_SUCCESS;
+}
+
 /**
  * Prepare string for using in SQL statement
  */
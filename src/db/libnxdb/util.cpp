@@ -1153,3 +1153,123 @@ void LIBNXDB_EXPORTABLE DBResultToTable(DB_RESULT hResult, Table *table)
       }
    }
 }
+
+/**
+ * Add integer field to bulk copy buffer
+ */
+void DBBulkCopyBuffer::add(int32_t value)
+{
+   startField();
+   char buffer[32];
+   IntegerToString(value, buffer);
+   m_data.write(buffer, strlen(buffer));
+}
+
+/**
+ * Add unsigned integer field to bulk copy buffer
+ */
+void DBBulkCopyBuffer::add(uint32_t value)
+{
+   startField();
+   char buffer[32];
+   IntegerToString(value, buffer);
+   m_data.write(buffer, strlen(buffer));
+}
+
+/**
+ * Add 64 bit integer field to bulk copy buffer
+ */
+void DBBulkCopyBuffer::add(int64_t value)
+{
+   startField();
+   char buffer[32];
+   IntegerToString(value, buffer);
+   m_data.write(buffer, strlen(buffer));
+}
+
+/**
+ * Add unsigned 64 bit integer field to bulk copy buffer
+ */
+void DBBulkCopyBuffer::add(uint64_t value)
+{
+   startField();
+   char buffer[32];
+   IntegerToString(value, buffer);
+   m_data.write(buffer, strlen(buffer));
+}
+
+/**
+ * Add floating point field to bulk copy buffer
+ */
+void DBBulkCopyBuffer::add(double value)
+{
+   startField();
+   char buffer[64];
+   int len = snprintf(buffer, 64, "%.17g", value);
+   m_data.write(buffer, len);
+}
+
+/**
+ * Add string field to bulk copy buffer. NULL pointer is encoded as SQL NULL.
+ */
+void DBBulkCopyBuffer::add(const TCHAR *value)
+{
+   if (value == nullptr)
+   {
+      addNull();
+      return;
+   }
+
+#ifdef UNICODE
+   size_t len = wchar_utf8len(value, -1);
+#else
+   size_t len = strlen(value) * 3 + 1;
+#endif
+   Buffer<char, 1024> utf8(len);
+   tchar_to_utf8(value, -1, utf8, len);
+   addUTF8(utf8);
+}
+
+/**
+ * Add UTF-8 string field to bulk copy buffer. NULL pointer is encoded as SQL NULL.
+ */
+void DBBulkCopyBuffer::addUTF8(const char *value)
+{
+   if (value == nullptr)
+   {
+      addNull();
+      return;
+   }
+
+   startField();
+   const char *chunk = value;
+   for(const char *p = value; *p != 0; p++)
+   {
+      char escape;
+      switch(*p)
+      {
+         case '\\':
+            escape = '\\';
+            break;
+         case '\t':
+            escape = 't';
+            break;
+         case '\n':
+            escape = 'n';
+            break;
+         case '\r':
+            escape = 'r';
+            break;
+         default:
+            continue;
+      }
+      if (p > chunk)
+         m_data.write(chunk, p - chunk);
+      m_data.write('\\');
+      m_data.write(escape);
+      chunk = p + 1;
+   }
+   size_t tail = strlen(chunk);
+   if (tail > 0)
+      m_data.write(chunk, tail);
+}
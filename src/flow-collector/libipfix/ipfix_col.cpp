@@ -105,6 +105,7 @@ sctp_assoc_node_t *sctp_assocs = nullptr;               /* sctp associations */
 static ipfixt_node_t *_get_ipfixt(ipfixt_node_t *tlist, int tid);
 static ipfixs_node_t *_get_ipfix_source(ipfixs_node_t **slist, ipfix_input_t *input, uint32_t odid);
 static void _delete_ipfixt(ipfixt_node_t **tlist, ipfixt_node_t *node);
+static void _free_ipfixt_userdata(ipfixt_node_t *node);
 void _delete_ipfix_source(ipfixs_node_t **slist, ipfixs_node_t *node);
 
 /*----- static funcs -----------------------------------------------------*/
@@ -126,6 +127,19 @@ static ipfixt_node_t *_get_ipfixt(ipfixt_node_t *tlist, int tid)
    return NULL;
 }
 
+/*
+ * name:        _free_ipfixt_userdata
+ * remarks:     release exporter data bound to template (called when template
+ *              is deleted or its field definitions are re-read)
+ */
+static void _free_ipfixt_userdata(ipfixt_node_t *node)
+{
+   if ((node->userdata != NULL) && (node->userdata_free != NULL))
+      node->userdata_free(node->userdata);
+   node->userdata = NULL;
+   node->userdata_free = NULL;
+}
+
 static void _delete_ipfixt(ipfixt_node_t **tlist, ipfixt_node_t *node)
 {
    ipfixt_node_t *last, *n = *tlist;
@@ -159,7 +173,8 @@ static void _delete_ipfixt(ipfixt_node_t **tlist, ipfixt_node_t *node)
 
    nxlog_debug_tag(LIBIPFIX_DEBUG_TAG, 5, _T("[delete_ipfixt] node %hs not found!\n"), node->ident);
 
-   freenode: for (i = 0; i < node->ipfixt->nfields; i++)
+   freenode: _free_ipfixt_userdata(node);
+   for (i = 0; i < node->ipfixt->nfields; i++)
    {
       if (node->ipfixt->fields[i].unknown_f)
       {
@@ -721,6 +736,7 @@ int ipfix_decode_trecord(ipfixs_node_t *s, int setid, const uint8_t *buf, size_t
    {
       newnode = 0;
       t = n->ipfixt;
+      _free_ipfixt_userdata(n);
       /* todo: remove the code below */
       for (i = 0; i < nfields; i++)
       {
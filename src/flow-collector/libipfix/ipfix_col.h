@@ -37,6 +37,8 @@ typedef struct ipfixt_node
     time_t               expire_time;
     ipfix_template_t     *ipfixt;
     char                 ident[MAXTEMPLIDENT];
+    void                 *userdata;        /* exporter data bound to template */
+    void                 (*userdata_free)(void*);
 #ifdef DBSUPPORT
     char                 tablename[MAXTABLENAMELEN+1]; /* make this dynamic */
     unsigned             template_id;      /* id from template table (hack) */
@@ -0,0 +1,502 @@
+/*
+** nxflowd - NetXMS Flow Collector Daemon
+** Copyright (c) 2009-2024 Raden Solutions
+*/
+
+#include "nxflowd.h"
+
+/**
+ * Aggregation key fields
+ */
+#define AGG_KEY_EXPORTER      0x01
+#define AGG_KEY_SOURCE        0x02
+#define AGG_KEY_DESTINATION   0x04
+#define AGG_KEY_PROTOCOL      0x08
+#define AGG_KEY_SOURCE_PORT   0x10
+#define AGG_KEY_DEST_PORT     0x20
+
+/**
+ * Maximum number of closed buckets waiting to be written
+ */
+#define MAX_PENDING_BUCKETS   4
+
+/**
+ * Aggregation key (fields not selected for aggregation are set to 0)
+ */
+struct FlowAggregationKey
+{
+   uint32_t exporterAddr;
+   uint32_t sourcePrefix;
+   uint32_t destPrefix;
+   uint16_t sourcePort;
+   uint16_t destPort;
+   uint8_t ipProto;
+   uint8_t padding[3];
+};
+
+/**
+ * Aggregated counters for single key
+ */
+struct FlowAggregate
+{
+   FlowAggregationKey key;
+   uint64_t flowCount;
+   uint64_t octetCount;
+   uint64_t packetCount;
+   uint64_t octetCountError;  // Possible overestimation of octet count caused by eviction
+   int heapPosition;
+};
+
+/**
+ * Accumulator for single time bucket. When number of distinct keys reaches the limit,
+ * space-saving algorithm is used: entry with lowest octet count is replaced by new key,
+ * which inherits evicted counter value as possible error. Entries are kept in min-heap
+ * ordered by octet count to find eviction candidate in constant time.
+ */
+class FlowAggregationBucket
+{
+private:
+   time_t m_startTime;
+   int m_capacity;
+   int m_size;
+   uint64_t m_evictions;
+   FlowAggregate *m_entries;
+   int *m_heap;
+   HashMap<FlowAggregationKey, FlowAggregate> m_index;
+
+   void swap(int a, int b)
+   {
+      int t = m_heap[a];
+      m_heap[a] = m_heap[b];
+      m_heap[b] = t;
+      m_entries[m_heap[a]].heapPosition = a;
+      m_entries[m_heap[b]].heapPosition = b;
+   }
+   void siftUp(int pos);
+   void siftDown(int pos);
+
+public:
+   FlowAggregationBucket(time_t startTime, int capacity) : m_index(Ownership::False)
+   {
+      m_startTime = startTime;
+      m_capacity = capacity;
+      m_size = 0;
+      m_evictions = 0;
+      m_entries = MemAllocArray<FlowAggregate>(capacity);
+      m_heap = MemAllocArray<int>(capacity);
+   }
+   ~FlowAggregationBucket()
+   {
+      MemFree(m_entries);
+      MemFree(m_heap);
+   }
+
+   void update(const FlowAggregationKey& key, const FlowRecord *record);
+
+   time_t getStartTime() const { return m_startTime; }
+   int size() const { return m_size; }
+   uint64_t getEvictions() const { return m_evictions; }
+   FlowAggregate *getEntry(int index) { return &m_entries[index]; }
+};
+
+/**
+ * Move heap element up
+ */
+void FlowAggregationBucket::siftUp(int pos)
+{
+   while(pos > 0)
+   {
+      int parent = (pos - 1) / 2;
+      if (m_entries[m_heap[parent]].octetCount <= m_entries[m_heap[pos]].octetCount)
+         break;
+      swap(pos, parent);
+      pos = parent;
+   }
+}
+
+/**
+ * Move heap element down
+ */
+void FlowAggregationBucket::siftDown(int pos)
+{
+   while(true)
+   {
+      int smallest = pos;
+      int left = pos * 2 + 1;
+      int right = left + 1;
+      if ((left < m_size) && (m_entries[m_heap[left]].octetCount < m_entries[m_heap[smallest]].octetCount))
+         smallest = left;
+      if ((right < m_size) && (m_entries[m_heap[right]].octetCount < m_entries[m_heap[smallest]].octetCount))
+         smallest = right;
+      if (smallest == pos)
+         break;
+      swap(pos, smallest);
+      pos = smallest;
+   }
+}
+
+/**
+ * Update bucket with flow record
+ */
+void FlowAggregationBucket::update(const FlowAggregationKey& key, const FlowRecord *record)
+{
+   bool appended = false;
+   FlowAggregate *entry = m_index.get(key);
+   if (entry == nullptr)
+   {
+      if (m_size < m_capacity)
+      {
+         appended = true;
+         entry = &m_entries[m_size];
+         entry->heapPosition = m_size;
+         m_heap[m_size++] = static_cast<int>(entry - m_entries);
+         entry->octetCountError = 0;
+         entry->octetCount = 0;
+      }
+      else
+      {
+         // Replace entry with smallest octet count
+         entry = &m_entries[m_heap[0]];
+         m_index.remove(entry->key);
+         entry->octetCountError = entry->octetCount;
+         m_evictions++;
+      }
+      entry->key = key;
+      entry->flowCount = 0;
+      entry->packetCount = 0;
+      m_index.set(key, entry);
+   }
+
+   entry->flowCount++;
+   entry->octetCount += record->octetCount;
+   entry->packetCount += record->packetCount;
+   // Counter can only grow, so existing entry can only move down; new entry starts at the bottom of the heap
+   if (appended)
+      siftUp(entry->heapPosition);
+   else
+      siftDown(entry->heapPosition);
+}
+
+/**
+ * Aggregator state
+ */
+static uint32_t s_keyFields = 0;
+static uint32_t s_prefixMask = 0;
+static FlowAggregationBucket *s_currentBucket = nullptr;
+static ObjectQueue<FlowAggregationBucket> s_pendingBuckets(16, Ownership::True);
+static THREAD s_aggregateWriterThread = INVALID_THREAD_HANDLE;
+static bool s_aggregatorShutdown = false;
+static VolatileCounter64 s_droppedBuckets = 0;
+
+/**
+ * Get start time of bucket containing given time
+ */
+static inline time_t BucketStartTime(time_t now)
+{
+   return now - now % g_aggregationInterval;
+}
+
+/**
+ * Close current bucket and pass it to writer
+ */
+static void CloseCurrentBucket()
+{
+   if (s_currentBucket == nullptr)
+      return;
+
+   if ((s_currentBucket->size() > 0) && (s_pendingBuckets.size() < MAX_PENDING_BUCKETS))
+   {
+      s_pendingBuckets.put(s_currentBucket);
+   }
+   else
+   {
+      if (s_currentBucket->size() > 0)
+      {
+         InterlockedIncrement64(&s_droppedBuckets);
+         nxlog_write(NXLOG_WARNING, _T("Flow aggregation bucket with %d entries dropped because aggregate writer is not keeping up"), s_currentBucket->size());
+      }
+      delete s_currentBucket;
+   }
+   s_currentBucket = nullptr;
+}
+
+/**
+ * Add flow record to current aggregation bucket (called from collector thread only)
+ */
+void AggregateFlow(const FlowRecord *record)
+{
+   time_t startTime = BucketStartTime(time(nullptr));
+   if ((s_currentBucket != nullptr) && (s_currentBucket->getStartTime() != startTime))
+      CloseCurrentBucket();
+   if (s_currentBucket == nullptr)
+      s_currentBucket = new FlowAggregationBucket(startTime, static_cast<int>(g_aggregationMaxEntries));
+
+   FlowAggregationKey key;
+   memset(&key, 0, sizeof(key));
+   if (s_keyFields & AGG_KEY_EXPORTER)
+      key.exporterAddr = record->exporterAddr;
+   if (s_keyFields & AGG_KEY_SOURCE)
+      key.sourcePrefix = record->sourceAddr & s_prefixMask;
+   if (s_keyFields & AGG_KEY_DESTINATION)
+      key.destPrefix = record->destAddr & s_prefixMask;
+   if (s_keyFields & AGG_KEY_PROTOCOL)
+      key.ipProto = record->ipProto;
+   if (s_keyFields & AGG_KEY_SOURCE_PORT)
+      key.sourcePort = record->sourcePort;
+   if (s_keyFields & AGG_KEY_DEST_PORT)
+      key.destPort = record->destPort;
+   s_currentBucket->update(key, record);
+}
+
+/**
+ * Close current bucket if its interval is over (called from collector thread only)
+ */
+void CheckAggregationBucket()
+{
+   if ((s_currentBucket != nullptr) && (s_currentBucket->getStartTime() != BucketStartTime(time(nullptr))))
+      CloseCurrentBucket();
+}
+
+/**
+ * Build INSERT statement for aggregates with selected key columns
+ */
+static StringBuffer BuildAggregateInsertQuery()
+{
+   StringBuffer query(_T("INSERT INTO flow_aggregates (bucket_time,bucket_length"));
+   int count = 2;
+   if (s_keyFields & AGG_KEY_EXPORTER)
+   {
+      query.append(_T(",exporter_ip_addr"));
+      count++;
+   }
+   if (s_keyFields & AGG_KEY_SOURCE)
+   {
+      query.append(_T(",source_prefix"));
+      count++;
+   }
+   if (s_keyFields & AGG_KEY_DESTINATION)
+   {
+      query.append(_T(",dest_prefix"));
+      count++;
+   }
+   if (s_keyFields & AGG_KEY_PROTOCOL)
+   {
+      query.append(_T(",ip_proto"));
+      count++;
+   }
+   if (s_keyFields & AGG_KEY_SOURCE_PORT)
+   {
+      query.append(_T(",source_ip_port"));
+      count++;
+   }
+   if (s_keyFields & AGG_KEY_DEST_PORT)
+   {
+      query.append(_T(",dest_ip_port"));
+      count++;
+   }
+   query.append(_T(",flow_count,octet_count,packet_count,octet_count_error) VALUES (?"));
+   for(int i = 1; i < count + 4; i++)
+      query.append(_T(",?"));
+   query.append(_T(')'));
+   return query;
+}
+
+/**
+ * Bind network prefix as text in form address/bits
+ */
+static void BindPrefix(DB_STATEMENT hStmt, int pos, uint32_t prefix)
+{
+   TCHAR text[64];
+   InetAddress(prefix).toString(text);
+   _sntprintf(&text[_tcslen(text)], 8, _T("/%u"), g_aggregationPrefixLength);
+   DBBind(hStmt, pos, DB_SQLTYPE_VARCHAR, text, DB_BIND_TRANSIENT);
+}
+
+/**
+ * Bind aggregate to prepared statement
+ */
+static void BindAggregate(DB_STATEMENT hStmt, time_t bucketTime, const FlowAggregate *a)
+{
+   int pos = 1;
+   DBBind(hStmt, pos++, DB_SQLTYPE_BIGINT, static_cast<int64_t>(bucketTime));
+   DBBind(hStmt, pos++, DB_SQLTYPE_INTEGER, static_cast<uint32_t>(g_aggregationInterval));
+   if (s_keyFields & AGG_KEY_EXPORTER)
+      DBBind(hStmt, pos++, DB_SQLTYPE_VARCHAR, InetAddress(a->key.exporterAddr));
+   if (s_keyFields & AGG_KEY_SOURCE)
+      BindPrefix(hStmt, pos++, a->key.sourcePrefix);
+   if (s_keyFields & AGG_KEY_DESTINATION)
+      BindPrefix(hStmt, pos++, a->key.destPrefix);
+   if (s_keyFields & AGG_KEY_PROTOCOL)
+      DBBind(hStmt, pos++, DB_SQLTYPE_INTEGER, static_cast<int32_t>(a->key.ipProto));
+   if (s_keyFields & AGG_KEY_SOURCE_PORT)
+      DBBind(hStmt, pos++, DB_SQLTYPE_INTEGER, static_cast<int32_t>(a->key.sourcePort));
+   if (s_keyFields & AGG_KEY_DEST_PORT)
+      DBBind(hStmt, pos++, DB_SQLTYPE_INTEGER, static_cast<int32_t>(a->key.destPort));
+   DBBind(hStmt, pos++, DB_SQLTYPE_BIGINT, a->flowCount);
+   DBBind(hStmt, pos++, DB_SQLTYPE_BIGINT, a->octetCount);
+   DBBind(hStmt, pos++, DB_SQLTYPE_BIGINT, a->packetCount);
+   DBBind(hStmt, pos++, DB_SQLTYPE_BIGINT, a->octetCountError);
+}
+
+/**
+ * Write closed bucket to database. If top N retention is configured, only N entries
+ * with highest octet count are written.
+ */
+static void WriteBucket(DB_HANDLE hdb, const TCHAR *query, FlowAggregationBucket *bucket)
+{
+   FlowAggregate **entries = MemAllocArray<FlowAggregate*>(bucket->size());
+   for(int i = 0; i < bucket->size(); i++)
+      entries[i] = bucket->getEntry(i);
+
+   int count = bucket->size();
+   if ((g_aggregationTopCount > 0) && (static_cast<int>(g_aggregationTopCount) < count))
+   {
+      count = static_cast<int>(g_aggregationTopCount);
+      std::partial_sort(entries, entries + count, entries + bucket->size(),
+         [] (const FlowAggregate *a, const FlowAggregate *b) -> bool { return a->octetCount > b->octetCount; });
+   }
+
+   bool success = false;
+   DB_STATEMENT hStmt = DBPrepare(hdb, query);
+   if ((hStmt != nullptr) && DBBegin(hdb))
+   {
+      success = true;
+      for(int i = 0; (i < count) && success;)
+      {
+         if (DBOpenBatch(hStmt))
+         {
+            for(int n = 0; (n < 1000) && (i < count); n++, i++)
+            {
+               DBNextBatchRow(hStmt);
+               BindAggregate(hStmt, bucket->getStartTime(), entries[i]);
+            }
+         }
+         else
+         {
+            BindAggregate(hStmt, bucket->getStartTime(), entries[i++]);
+         }
+         success = DBExecute(hStmt);
+      }
+      if (success)
+         success = DBCommit(hdb);
+      else
+         DBRollback(hdb);
+   }
+   if (hStmt != nullptr)
+      DBFreeStatement(hStmt);
+   MemFree(entries);
+
+   if (success)
+   {
+      nxlog_debug(5, _T("Flow aggregator: %d of %d aggregates for bucket ") INT64_FMT _T(" written (") UINT64_FMT _T(" evictions)"),
+            count, bucket->size(), static_cast<int64_t>(bucket->getStartTime()), bucket->getEvictions());
+   }
+   else
+   {
+      nxlog_write(NXLOG_WARNING, _T("Flow aggregator: cannot write aggregates for bucket ") INT64_FMT, static_cast<int64_t>(bucket->getStartTime()));
+   }
+}
+
+/**
+ * Aggregate writer thread
+ */
+static void AggregateWriterThread()
+{
+   TCHAR errorText[DBDRV_MAX_ERROR_TEXT];
+   DB_HANDLE hdb = ConnectToDatabase(errorText);
+   if (hdb == nullptr)
+   {
+      nxlog_write(NXLOG_ERROR, _T("Flow aggregate writer cannot establish connection with database (%s)"), errorText);
+      return;
+   }
+
+   nxlog_debug(1, _T("Flow aggregate writer started"));
+   StringBuffer query = BuildAggregateInsertQuery();
+   while(true)
+   {
+      FlowAggregationBucket *bucket = s_pendingBuckets.getOrBlock(1000);
+      if ((bucket == nullptr) || (bucket == INVALID_POINTER_VALUE))
+      {
+         if (s_aggregatorShutdown)
+            break;
+         continue;
+      }
+      WriteBucket(hdb, query, bucket);
+      delete bucket;
+   }
+   DBDisconnect(hdb);
+   nxlog_debug(1, _T("Flow aggregate writer stopped"));
+}
+
+/**
+ * Parse list of aggregation key fields
+ */
+static uint32_t ParseKeyFields(const TCHAR *list)
+{
+   static const struct
+   {
+      const TCHAR *name;
+      uint32_t flag;
+   } names[] =
+   {
+      { _T("exporter"), AGG_KEY_EXPORTER },
+      { _T("source"), AGG_KEY_SOURCE },
+      { _T("destination"), AGG_KEY_DESTINATION },
+      { _T("protocol"), AGG_KEY_PROTOCOL },
+      { _T("source_port"), AGG_KEY_SOURCE_PORT },
+      { _T("destination_port"), AGG_KEY_DEST_PORT },
+      { nullptr, 0 }
+   };
+
+   uint32_t fields = 0;
+   String::split(list, _T(","), true,
+      [&fields] (const String& name) -> void
+      {
+         if (name.isEmpty())
+            return;
+         for(int i = 0; names[i].name != nullptr; i++)
+         {
+            if (!_tcsicmp(name.cstr(), names[i].name))
+            {
+               fields |= names[i].flag;
+               return;
+            }
+         }
+         nxlog_write(NXLOG_WARNING, _T("Unknown flow aggregation key field \"%s\""), name.cstr());
+      });
+   return fields;
+}
+
+/**
+ * Start flow aggregator
+ */
+bool StartFlowAggregator()
+{
+   s_keyFields = ParseKeyFields(g_aggregationKeys);
+   if (s_keyFields == 0)
+   {
+      nxlog_write(NXLOG_ERROR, _T("Flow aggregation enabled but no valid key fields configured"));
+      return false;
+   }
+   if (g_aggregationPrefixLength > 32)
+      g_aggregationPrefixLength = 32;
+   s_prefixMask = (g_aggregationPrefixLength > 0) ? (0xFFFFFFFF << (32 - g_aggregationPrefixLength)) : 0;
+   if (g_aggregationMaxEntries == 0)
+      g_aggregationMaxEntries = 1;
+
+   s_aggregateWriterThread = ThreadCreateEx(AggregateWriterThread);
+   nxlog_debug(1, _T("Flow aggregator started (interval %u seconds, keys \"%s\", prefix length %u, entry limit %u, top count %u)"),
+         g_aggregationInterval, g_aggregationKeys, g_aggregationPrefixLength, g_aggregationMaxEntries, g_aggregationTopCount);
+   return true;
+}
+
+/**
+ * Stop flow aggregator. Should be called after collector thread is stopped.
+ */
+void StopFlowAggregator()
+{
+   CloseCurrentBucket();
+   s_aggregatorShutdown = true;
+   ThreadJoin(s_aggregateWriterThread);
+   s_aggregateWriterThread = INVALID_THREAD_HANDLE;
+}
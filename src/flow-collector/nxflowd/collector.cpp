@@ -16,7 +16,7 @@ static int s_numTcpSockets = 0;
 static SOCKET *s_tcpSockets = NULL;
 static int s_numUdpSockets = 0;
 static SOCKET *s_udpSockets = NULL;
-static INT64 s_flowId = 1;
+static VolatileCounter64 s_flowId = 0;
 
 
 //
@@ -39,45 +39,41 @@ static int H_NewMessage(ipfixs_node_t *node, ipfix_hdr_t *header, void *arg)
 }
 
 
-//
-// Get 64bit integer value from data field
-//
-
-static INT64 Int64FromData(void *data, int len)
+/**
+ * Get unsigned integer value from decoded (host byte order) data field
+ */
+static inline uint64_t UInt64FromData(const void *data, int len)
 {
-	INT64 value;
-
-	switch(len)
-	{
-		case 1:
-			value = *((char *)data);
-			break;
-		case 2:
-			value = *((short *)data);
-			break;
-		case 4:
-			value = *((LONG *)data);
-			break;
-		case 8:
-			value = *((INT64 *)data);
-			break;
-		default:
-			value = 0;
-			break;
-	}
-	return value;
+   switch(len)
+   {
+      case 1:
+         return *static_cast<const uint8_t*>(data);
+      case 2:
+         uint16_t v16;
+         memcpy(&v16, data, 2);
+         return v16;
+      case 4:
+         uint32_t v32;
+         memcpy(&v32, data, 4);
+         return v32;
+      case 8:
+         uint64_t v64;
+         memcpy(&v64, data, 8);
+         return v64;
+   }
+   return 0;
 }
 
 
 //
-// Handler for data record
+// Mapping between IPFIX fields and database columns
 //
 
 static struct
 {
 	int ipfixField;
 	const TCHAR *dbField;
-} s_fieldMapping[] =
+} s_fieldMapping[FLOW_FIELD_COUNT + 1] =
 {
 	{ IPFIX_FT_EXPORTERIPV4ADDRESS, _T("exporter_ip_addr") },
 	{ IPFIX_FT_SOURCEMACADDRESS, _T("source_mac_addr") },
@@ -94,84 +90,633 @@ static struct
 	{ 0, NULL }
 };
 
-static int H_DataRecord(ipfixs_node_t *node, ipfixt_node_t *trec, ipfix_datarecord_t *data, void *arg) 
+/**
+ * Field converters used in decoding plan
+ */
+enum FlowFieldConverter
 {
-	StringBuffer fields, values;
-	char buffer[256];
-	INT64 flowStartTime = 0, flowEndTime = 0;
+   FLOW_CONV_UINT,
+   FLOW_CONV_IPV4,
+   FLOW_CONV_MAC,
+   FLOW_CONV_SYSUPTIME,
+   FLOW_CONV_SECONDS,
+   FLOW_CONV_MILLISECONDS,
+   FLOW_CONV_MICROSECONDS,
+   FLOW_CONV_NANOSECONDS,
+   FLOW_CONV_DELTA_MICROSECONDS
+};
+
+/**
+ * Single step of decoding plan: take template field and store converted value at given offset within flow record
+ */
+struct FlowDecoderStep
+{
+   uint16_t field;      // Index of field within template
+   uint16_t offset;     // Offset of target member within FlowRecord
+   uint8_t size;        // Size of target member
+   uint8_t converter;
+   uint32_t columnBit;  // Bit to set in field mask (0 for flow time fields)
+};
 
-	for(int i = 0; i < trec->ipfixt->nfields; i++)
+/**
+ * Decoding plan compiled from IPFIX template
+ */
+struct FlowDecodingPlan
+{
+   int stepCount;
+   bool usable;         // false if records cannot produce valid flow (no time or no mapped fields)
+   FlowDecoderStep *steps;
+};
+
+/**
+ * Flow writer data
+ */
+static ObjectQueue<FlowRecord> s_writerQueue(1024, Ownership::True);
+static THREAD *s_writerThreads = NULL;
+static int s_writerThreadCount = 0;
+static bool s_writerShutdown = false;
+static VolatileCounter64 s_droppedRecords = 0;
+static VolatileCounter64 s_failedRecords = 0;
+static VolatileCounter64 s_writtenRecords = 0;
+
+/**
+ * Target members for mapped columns
+ */
+static const struct
+{
+   uint16_t offset;
+   uint8_t size;
+   uint8_t converter;
+} s_columnTargets[FLOW_FIELD_COUNT] =
+{
+   { offsetof(FlowRecord, exporterAddr), 4, FLOW_CONV_IPV4 },
+   { offsetof(FlowRecord, sourceMac), FLOW_MAC_ADDR_SIZE, FLOW_CONV_MAC },
+   { offsetof(FlowRecord, destMac), FLOW_MAC_ADDR_SIZE, FLOW_CONV_MAC },
+   { offsetof(FlowRecord, sourceAddr), 4, FLOW_CONV_IPV4 },
+   { offsetof(FlowRecord, destAddr), 4, FLOW_CONV_IPV4 },
+   { offsetof(FlowRecord, ipProto), 1, FLOW_CONV_UINT },
+   { offsetof(FlowRecord, sourcePort), 2, FLOW_CONV_UINT },
+   { offsetof(FlowRecord, destPort), 2, FLOW_CONV_UINT },
+   { offsetof(FlowRecord, octetCount), 8, FLOW_CONV_UINT },
+   { offsetof(FlowRecord, packetCount), 8, FLOW_CONV_UINT },
+   { offsetof(FlowRecord, ingressInterface), 4, FLOW_CONV_UINT },
+   { offsetof(FlowRecord, egressInterface), 4, FLOW_CONV_UINT }
+};
+
+/**
+ * Free decoding plan (called by IPFIX library when template is withdrawn, expired, or refreshed)
+ */
+static void FreeDecodingPlan(void *plan)
+{
+   MemFree(plan);
+}
+
+/**
+ * Compile IPFIX template into decoding plan
+ */
+static FlowDecodingPlan *CompileDecodingPlan(const ipfix_template_t *t)
+{
+   FlowDecodingPlan *plan = static_cast<FlowDecodingPlan*>(MemAlloc(sizeof(FlowDecodingPlan) + sizeof(FlowDecoderStep) * std::max(t->nfields, 1)));
+   plan->steps = reinterpret_cast<FlowDecoderStep*>(plan + 1);
+   plan->stepCount = 0;
+
+   bool hasStartTime = false, hasEndTime = false;
+   uint32_t columns = 0;
+   for(int i = 0; i < t->nfields; i++)
+   {
+      FlowDecoderStep *step = &plan->steps[plan->stepCount];
+      step->field = static_cast<uint16_t>(i);
+      step->size = 8;
+      step->columnBit = 0;
+
+      bool isStart = true;
+      int ftype = t->fields[i].elem->ft->ftype;
+      switch(ftype)
+      {
+         case IPFIX_FT_FLOWENDSYSUPTIME:
+            isStart = false;
+            /* no break */
+         case IPFIX_FT_FLOWSTARTSYSUPTIME:
+            step->converter = FLOW_CONV_SYSUPTIME;
+            break;
+         case IPFIX_FT_FLOWENDSECONDS:
+            isStart = false;
+            /* no break */
+         case IPFIX_FT_FLOWSTARTSECONDS:
+            step->converter = FLOW_CONV_SECONDS;
+            break;
+         case IPFIX_FT_FLOWENDMILLISECONDS:
+            isStart = false;
+            /* no break */
+         case IPFIX_FT_FLOWSTARTMILLISECONDS:
+            step->converter = FLOW_CONV_MILLISECONDS;
+            break;
+         case IPFIX_FT_FLOWENDMICROSECONDS:
+            isStart = false;
+            /* no break */
+         case IPFIX_FT_FLOWSTARTMICROSECONDS:
+            step->converter = FLOW_CONV_MICROSECONDS;
+            break;
+         case IPFIX_FT_FLOWENDNANOSECONDS:
+            isStart = false;
+            /* no break */
+         case IPFIX_FT_FLOWSTARTNANOSECONDS:
+            step->converter = FLOW_CONV_NANOSECONDS;
+            break;
+         case IPFIX_FT_FLOWENDDELTAMICROSECONDS:
+            isStart = false;
+            /* no break */
+         case IPFIX_FT_FLOWSTARTDELTAMICROSECONDS:
+            step->converter = FLOW_CONV_DELTA_MICROSECONDS;
+            break;
+         default:
+            for(int j = 0; s_fieldMapping[j].dbField != NULL; j++)
+            {
+               if (ftype == s_fieldMapping[j].ipfixField)
+               {
+                  step->offset = s_columnTargets[j].offset;
+                  step->size = s_columnTargets[j].size;
+                  step->converter = s_columnTargets[j].converter;
+                  step->columnBit = 1 << j;
+                  columns |= step->columnBit;
+                  plan->stepCount++;
+                  break;
+               }
+            }
+            continue;
+      }
+
+      step->offset = isStart ? offsetof(FlowRecord, startTime) : offsetof(FlowRecord, endTime);
+      if (isStart)
+         hasStartTime = true;
+      else
+         hasEndTime = true;
+      plan->stepCount++;
+   }
+
+   plan->usable = hasStartTime && hasEndTime && (columns != 0);
+   nxlog_debug(5, _T("Compiled decoding plan for template %d (%d fields, %d steps, %s)"),
+         t->tid, t->nfields, plan->stepCount, plan->usable ? _T("usable") : _T("not usable"));
+   return plan;
+}
+
+/**
+ * Store unsigned integer value into flow record member of given size
+ */
+static inline void StoreUInt(FlowRecord *record, const FlowDecoderStep *step, uint64_t value)
+{
+   BYTE *target = reinterpret_cast<BYTE*>(record) + step->offset;
+   switch(step->size)
+   {
+      case 1:
+         *target = static_cast<BYTE>(value);
+         break;
+      case 2:
+         *reinterpret_cast<uint16_t*>(target) = static_cast<uint16_t>(value);
+         break;
+      case 4:
+         *reinterpret_cast<uint32_t*>(target) = static_cast<uint32_t>(value);
+         break;
+      case 8:
+         *reinterpret_cast<uint64_t*>(target) = value;
+         break;
+   }
+}
+
+/**
+ * Handler for data record
+ */
+static int H_DataRecord(ipfixs_node_t *node, ipfixt_node_t *trec, ipfix_datarecord_t *data, void *arg) 
+{
+   FlowDecodingPlan *plan = static_cast<FlowDecodingPlan*>(trec->userdata);
+   if (plan == NULL)
+   {
+      plan = CompileDecodingPlan(trec->ipfixt);
+      trec->userdata = plan;
+      trec->userdata_free = FreeDecodingPlan;
+   }
+   if (!plan->usable)
+      return 0;
+
+   FlowRecord record;
+   memset(&record, 0, sizeof(FlowRecord));
+   for(int i = 0; i < plan->stepCount; i++)
+   {
+      const FlowDecoderStep *step = &plan->steps[i];
+      const void *value = data->addrs[step->field];
+      int len = data->lens[step->field];
+      int64_t *timestamp = reinterpret_cast<int64_t*>(reinterpret_cast<BYTE*>(&record) + step->offset);
+      switch(step->converter)
+      {
+         case FLOW_CONV_UINT:
+            StoreUInt(&record, step, UInt64FromData(value, len));
+            break;
+         case FLOW_CONV_IPV4:
+            if (len != 4)
+               continue;
+            uint32_t addr;
+            memcpy(&addr, value, 4);
+            StoreUInt(&record, step, ntohl(addr));
+            break;
+         case FLOW_CONV_MAC:
+            if (len != FLOW_MAC_ADDR_SIZE)
+               continue;
+            memcpy(reinterpret_cast<BYTE*>(&record) + step->offset, value, FLOW_MAC_ADDR_SIZE);
+            break;
+         case FLOW_CONV_SYSUPTIME:
+            if (node->boot_time != 0)
+               *timestamp = static_cast<int64_t>(node->boot_time) * 1000 + UInt64FromData(value, len);
+            break;
+         case FLOW_CONV_SECONDS:
+            *timestamp = UInt64FromData(value, len) * 1000;
+            break;
+         case FLOW_CONV_MILLISECONDS:
+            *timestamp = UInt64FromData(value, len);
+            break;
+         case FLOW_CONV_MICROSECONDS:
+            *timestamp = UInt64FromData(value, len) / 1000;
+            break;
+         case FLOW_CONV_NANOSECONDS:
+            *timestamp = UInt64FromData(value, len) / 1000000;
+            break;
+         case FLOW_CONV_DELTA_MICROSECONDS:
+            if (node->export_time != 0)
+               *timestamp = static_cast<int64_t>(node->export_time) * 1000 + UInt64FromData(value, len);
+            break;
+      }
+      record.fieldMask |= step->columnBit;
+   }
+
+	if ((record.fieldMask != 0) && (record.startTime != 0) && (record.endTime != 0))
 	{
-		int ftype = trec->ipfixt->fields[i].elem->ft->ftype;
-		switch(ftype)
+		if (g_aggregationInterval > 0)
+			AggregateFlow(&record);
+
+		if (g_flags & AF_STORE_RAW_FLOWS)
 		{
-			case IPFIX_FT_FLOWSTARTSYSUPTIME:
-				if (node->boot_time != 0)
-					flowStartTime = node->boot_time * 1000 + Int64FromData(data->addrs[i], data->lens[i]);
-				break;
-			case IPFIX_FT_FLOWENDSYSUPTIME:
-				if (node->boot_time != 0)
-					flowEndTime = node->boot_time * 1000 + Int64FromData(data->addrs[i], data->lens[i]);
-				break;
-			case IPFIX_FT_FLOWSTARTSECONDS:
-				flowStartTime = Int64FromData(data->addrs[i], data->lens[i]) * 1000;
-				break;
-			case IPFIX_FT_FLOWENDSECONDS:
-				flowEndTime = Int64FromData(data->addrs[i], data->lens[i]) * 1000;
-				break;
-			case IPFIX_FT_FLOWSTARTMILLISECONDS:
-				flowStartTime = Int64FromData(data->addrs[i], data->lens[i]);
-				break;
-			case IPFIX_FT_FLOWENDMILLISECONDS:
-				flowEndTime = Int64FromData(data->addrs[i], data->lens[i]);
-				break;
-			case IPFIX_FT_FLOWSTARTMICROSECONDS:
-				flowStartTime = Int64FromData(data->addrs[i], data->lens[i]) / 1000;
-				break;
-			case IPFIX_FT_FLOWENDMICROSECONDS:
-				flowEndTime = Int64FromData(data->addrs[i], data->lens[i]) / 1000;
-				break;
-			case IPFIX_FT_FLOWSTARTNANOSECONDS:
-				flowStartTime = Int64FromData(data->addrs[i], data->lens[i]) / 1000000;
-				break;
-			case IPFIX_FT_FLOWENDNANOSECONDS:
-				flowEndTime = Int64FromData(data->addrs[i], data->lens[i]) / 1000000;
-				break;
-			case IPFIX_FT_FLOWSTARTDELTAMICROSECONDS:
-				if (node->export_time != 0)
-					flowStartTime = node->export_time * 1000 + Int64FromData(data->addrs[i], data->lens[i]);
-				break;
-			case IPFIX_FT_FLOWENDDELTAMICROSECONDS:
-				if (node->export_time != 0)
-					flowEndTime = node->export_time * 1000 + Int64FromData(data->addrs[i], data->lens[i]);
-				break;
-			default:
-				for(int j = 0; s_fieldMapping[j].dbField != NULL; j++)
-				{
-					if (ftype == s_fieldMapping[j].ipfixField)
-					{
-						fields += _T(",");
-						fields += s_fieldMapping[j].dbField;
-						trec->ipfixt->fields[i].elem->snprint(buffer, sizeof(buffer), data->addrs[i], data->lens[i]);
-						values.appendFormattedString(_T(",'%hs'"), buffer);
-						break;
-					}
-				}
-				break;
+			// Queue is bounded so that slow database will not cause unlimited memory growth
+			if (s_writerQueue.size() < static_cast<size_t>(g_writerQueueSize))
+				s_writerQueue.put(new FlowRecord(record));
+			else
+				InterlockedIncrement64(&s_droppedRecords);
 		}
 	}
+	return 0;
+}
 
-	if (!fields.isEmpty() && (flowStartTime != 0) && (flowEndTime != 0))
-	{
-		StringBuffer query = _T("INSERT INTO flows (flow_id,start_time,end_time");
-		query += (const TCHAR *)fields;
-		query.appendFormattedString(_T(") VALUES (") INT64_FMT _T(",") INT64_FMT _T(",") INT64_FMT, s_flowId++, flowStartTime, flowEndTime);
-		query += (const TCHAR *)values;
-		query += _T(")");
+/**
+ * Maximum number of cached prepared statements per writer
+ */
+#define MAX_CACHED_STATEMENTS    16
 
-		DBQuery(g_dbConnection, query);
-	}
-	return 0;
+/**
+ * Prepared statement cache for flow writer (separate statement is needed for each field set)
+ */
+class FlowStatementCache
+{
+private:
+   DB_HANDLE m_hdb;
+   int m_count;
+   int m_next;
+   uint32_t m_masks[MAX_CACHED_STATEMENTS];
+   DB_STATEMENT m_statements[MAX_CACHED_STATEMENTS];
+
+public:
+   FlowStatementCache(DB_HANDLE hdb)
+   {
+      m_hdb = hdb;
+      m_count = 0;
+      m_next = 0;
+   }
+
+   ~FlowStatementCache()
+   {
+      clear();
+   }
+
+   DB_STATEMENT get(uint32_t mask);
+   void clear();
+};
+
+/**
+ * Get prepared INSERT statement for given field set
+ */
+DB_STATEMENT FlowStatementCache::get(uint32_t mask)
+{
+   for(int i = 0; i < m_count; i++)
+      if (m_masks[i] == mask)
+         return m_statements[i];
+
+   StringBuffer query(_T("INSERT INTO flows (flow_id,start_time,end_time"));
+   int count = 0;
+   for(int i = 0; i < FLOW_FIELD_COUNT; i++)
+   {
+      if (mask & (1 << i))
+      {
+         query.append(_T(','));
+         query.append(s_fieldMapping[i].dbField);
+         count++;
+      }
+   }
+   query.append(_T(") VALUES (?,?,?"));
+   for(int i = 0; i < count; i++)
+      query.append(_T(",?"));
+   query.append(_T(')'));
+
+   DB_STATEMENT hStmt = DBPrepare(m_hdb, query, true);
+   if (hStmt == NULL)
+      return NULL;
+
+   int index;
+   if (m_count < MAX_CACHED_STATEMENTS)
+   {
+      index = m_count++;
+   }
+   else
+   {
+      index = m_next;
+      m_next = (m_next + 1) % MAX_CACHED_STATEMENTS;
+      DBFreeStatement(m_statements[index]);
+   }
+   m_masks[index] = mask;
+   m_statements[index] = hStmt;
+   return hStmt;
+}
+
+/**
+ * Free all cached statements
+ */
+void FlowStatementCache::clear()
+{
+   for(int i = 0; i < m_count; i++)
+      DBFreeStatement(m_statements[i]);
+   m_count = 0;
+   m_next = 0;
+}
+
+/**
+ * Bind MAC address in same format as used by IPFIX library for byte fields
+ */
+static void BindMacAddress(DB_STATEMENT hStmt, int pos, const BYTE *addr)
+{
+   static const char hexDigits[] = "0123456789abcdef";
+   char text[FLOW_MAC_ADDR_SIZE * 2 + 3];
+   text[0] = '0';
+   text[1] = 'x';
+   for(int i = 0; i < FLOW_MAC_ADDR_SIZE; i++)
+   {
+      text[i * 2 + 2] = hexDigits[addr[i] >> 4];
+      text[i * 2 + 3] = hexDigits[addr[i] & 15];
+   }
+   text[FLOW_MAC_ADDR_SIZE * 2 + 2] = 0;
+   DBBind(hStmt, pos, DB_SQLTYPE_VARCHAR, DB_CTYPE_UTF8_STRING, text, DB_BIND_TRANSIENT);
+}
+
+/**
+ * Bind flow record to prepared statement
+ */
+static void BindFlowRecord(DB_STATEMENT hStmt, const FlowRecord *record)
+{
+   DBBind(hStmt, 1, DB_SQLTYPE_BIGINT, static_cast<int64_t>(InterlockedIncrement64(&s_flowId)));
+   DBBind(hStmt, 2, DB_SQLTYPE_BIGINT, record->startTime);
+   DBBind(hStmt, 3, DB_SQLTYPE_BIGINT, record->endTime);
+   int pos = 4;
+   for(int i = 0; i < FLOW_FIELD_COUNT; i++)
+   {
+      if (!(record->fieldMask & (1 << i)))
+         continue;
+
+      switch(i)
+      {
+         case FLOW_COL_EXPORTER_ADDR:
+            DBBind(hStmt, pos++, DB_SQLTYPE_VARCHAR, InetAddress(record->exporterAddr));
+            break;
+         case FLOW_COL_SOURCE_MAC:
+            BindMacAddress(hStmt, pos++, record->sourceMac);
+            break;
+         case FLOW_COL_DEST_MAC:
+            BindMacAddress(hStmt, pos++, record->destMac);
+            break;
+         case FLOW_COL_SOURCE_ADDR:
+            DBBind(hStmt, pos++, DB_SQLTYPE_VARCHAR, InetAddress(record->sourceAddr));
+            break;
+         case FLOW_COL_DEST_ADDR:
+            DBBind(hStmt, pos++, DB_SQLTYPE_VARCHAR, InetAddress(record->destAddr));
+            break;
+         case FLOW_COL_IP_PROTO:
+            DBBind(hStmt, pos++, DB_SQLTYPE_INTEGER, static_cast<int32_t>(record->ipProto));
+            break;
+         case FLOW_COL_SOURCE_PORT:
+            DBBind(hStmt, pos++, DB_SQLTYPE_INTEGER, static_cast<int32_t>(record->sourcePort));
+            break;
+         case FLOW_COL_DEST_PORT:
+            DBBind(hStmt, pos++, DB_SQLTYPE_INTEGER, static_cast<int32_t>(record->destPort));
+            break;
+         case FLOW_COL_OCTET_COUNT:
+            DBBind(hStmt, pos++, DB_SQLTYPE_BIGINT, record->octetCount);
+            break;
+         case FLOW_COL_PACKET_COUNT:
+            DBBind(hStmt, pos++, DB_SQLTYPE_BIGINT, record->packetCount);
+            break;
+         case FLOW_COL_INGRESS_INTERFACE:
+            DBBind(hStmt, pos++, DB_SQLTYPE_INTEGER, record->ingressInterface);
+            break;
+         case FLOW_COL_EGRESS_INTERFACE:
+            DBBind(hStmt, pos++, DB_SQLTYPE_INTEGER, record->egressInterface);
+            break;
+      }
+   }
+}
+
+/**
+ * Write flow records. Consecutive records with same field set are written with single
+ * statement execution if driver supports batch binding.
+ */
+static bool WriteFlowRecords(FlowStatementCache *cache, FlowRecord **records, int count)
+{
+   for(int i = 0; i < count;)
+   {
+      uint32_t mask = records[i]->fieldMask;
+      DB_STATEMENT hStmt = cache->get(mask);
+      if (hStmt == NULL)
+         return false;
+
+      if (DBOpenBatch(hStmt))
+      {
+         for(; (i < count) && (records[i]->fieldMask == mask); i++)
+         {
+            DBNextBatchRow(hStmt);
+            BindFlowRecord(hStmt, records[i]);
+         }
+      }
+      else
+      {
+         BindFlowRecord(hStmt, records[i++]);
+      }
+      if (!DBExecute(hStmt))
+         return false;
+   }
+   return true;
+}
+
+/**
+ * Write batch of flow records within single transaction. If transaction fails,
+ * records are written one by one so that single bad record will not cause loss of entire batch.
+ */
+static void WriteFlowBatch(DB_HANDLE hdb, FlowStatementCache *cache, FlowRecord **records, int count)
+{
+   bool success = false;
+   if (DBBegin(hdb))
+   {
+      success = WriteFlowRecords(cache, records, count);
+      if (success)
+         success = DBCommit(hdb);
+      else
+         DBRollback(hdb);
+   }
+
+   if (success)
+   {
+      InterlockedAdd64(&s_writtenRecords, count);
+      nxlog_debug(7, _T("Flow writer: %d records written"), count);
+   }
+   else
+   {
+      nxlog_debug(5, _T("Flow writer: failed to write batch of %d records, retrying one by one"), count);
+      for(int i = 0; i < count; i++)
+      {
+         if (WriteFlowRecords(cache, &records[i], 1))
+            InterlockedIncrement64(&s_writtenRecords);
+         else
+            InterlockedIncrement64(&s_failedRecords);
+      }
+   }
+}
+
+/**
+ * Interval for reporting flow writer statistics (seconds)
+ */
+#define WRITER_REPORT_INTERVAL   60
+
+/**
+ * Report queue depth and dropped records
+ */
+static void ReportWriterStatistics()
+{
+   static int64_t lastDropped = 0;
+   static int64_t lastFailed = 0;
+
+   int64_t dropped = s_droppedRecords;
+   int64_t failed = s_failedRecords;
+   if (dropped != lastDropped)
+   {
+      nxlog_write(NXLOG_WARNING, _T("%d flow records dropped because writer queue is full (queue size %d)"),
+            static_cast<int>(dropped - lastDropped), static_cast<int>(s_writerQueue.size()));
+      lastDropped = dropped;
+   }
+   if (failed != lastFailed)
+   {
+      nxlog_write(NXLOG_WARNING, _T("%d flow records could not be written to database"), static_cast<int>(failed - lastFailed));
+      lastFailed = failed;
+   }
+   nxlog_debug(3, _T("Flow writer: queue size %d, written ") INT64_FMT _T(", dropped ") INT64_FMT _T(", failed ") INT64_FMT,
+         static_cast<int>(s_writerQueue.size()), static_cast<int64_t>(s_writtenRecords), dropped, failed);
+}
+
+/**
+ * Flow writer thread. First writer uses main database connection, others open their own.
+ */
+static void FlowWriterThread(int writerId)
+{
+   DB_HANDLE hdb;
+   if (writerId == 0)
+   {
+      hdb = g_dbConnection;
+   }
+   else
+   {
+      TCHAR errorText[DBDRV_MAX_ERROR_TEXT];
+      hdb = ConnectToDatabase(errorText);
+      if (hdb == NULL)
+      {
+         nxlog_write(NXLOG_ERROR, _T("Flow writer %d cannot establish connection with database (%s)"), writerId, errorText);
+         return;
+      }
+   }
+
+   nxlog_debug(1, _T("Flow writer %d started"), writerId);
+
+   FlowStatementCache *cache = new FlowStatementCache(hdb);
+   int batchSize = std::max(static_cast<int>(g_writerBatchSize), 1);
+   FlowRecord **batch = MemAllocArray<FlowRecord*>(batchSize);
+   time_t lastReport = time(NULL);
+   while(true)
+   {
+      FlowRecord *record = s_writerQueue.getOrBlock(1000);
+      if ((record == NULL) || (record == INVALID_POINTER_VALUE))
+      {
+         if (s_writerShutdown)
+            break;
+      }
+      else
+      {
+         int count = 0;
+         batch[count++] = record;
+         while(count < batchSize)
+         {
+            record = s_writerQueue.get();
+            if ((record == NULL) || (record == INVALID_POINTER_VALUE))
+               break;
+            batch[count++] = record;
+         }
+
+         WriteFlowBatch(hdb, cache, batch, count);
+         for(int i = 0; i < count; i++)
+            delete batch[i];
+      }
+
+      if (writerId == 0)
+      {
+         time_t now = time(NULL);
+         if (now - lastReport >= WRITER_REPORT_INTERVAL)
+         {
+            ReportWriterStatistics();
+            lastReport = now;
+         }
+      }
+   }
+
+   MemFree(batch);
+   delete cache;
+   if (writerId != 0)
+      DBDisconnect(hdb);
+
+   nxlog_debug(1, _T("Flow writer %d stopped"), writerId);
+}
+
+/**
+ * Start flow writer threads
+ */
+static void StartFlowWriters()
+{
+   s_writerThreadCount = std::max(static_cast<int>(g_writerThreads), 1);
+   s_writerThreads = MemAllocArray<THREAD>(s_writerThreadCount);
+   for(int i = 0; i < s_writerThreadCount; i++)
+      s_writerThreads[i] = ThreadCreateEx(FlowWriterThread, i);
+   nxlog_debug(1, _T("%d flow writer threads started (queue size limit %u, batch size %u)"), s_writerThreadCount, g_writerQueueSize, g_writerBatchSize);
+}
+
+/**
+ * Stop flow writer threads. Records already in queue will be written before writers exit.
+ */
+void StopFlowWriters()
+{
+   s_writerShutdown = true;
+   for(int i = 0; i < s_writerThreadCount; i++)
+      ThreadJoin(s_writerThreads[i]);
+   MemFreeAndNull(s_writerThreads);
+   s_writerThreadCount = 0;
+   ReportWriterStatistics();
 }
 
 
@@ -204,6 +749,8 @@ static THREAD_RESULT THREAD_CALL CollectorThread(void *arg)
 		   nxlog_write(NXLOG_ERROR, _T("IPFIX polling error"));
 			break;
 		}
+		if (g_aggregationInterval > 0)
+			CheckAggregationBucket();
 	}
 
    nxlog_write(NXLOG_INFO, _T("Collector thread stopped"));
@@ -219,7 +766,7 @@ bool StartCollector()
 	DB_RESULT hResult = DBSelect(g_dbConnection, _T("SELECT max(flow_id) FROM flows"));
 	if (hResult != NULL)
 	{
-		s_flowId = DBGetFieldInt64(hResult, 0, 0) + 1;
+		s_flowId = DBGetFieldInt64(hResult, 0, 0);
 		DBFreeResult(hResult);
 	}
 
@@ -250,6 +797,10 @@ bool StartCollector()
       goto failure;
 	}
 
+	if ((g_aggregationInterval > 0) && !StartFlowAggregator())
+		goto failure;
+
+	StartFlowWriters();
 	s_collectorThread = ThreadCreateEx(CollectorThread, 0, NULL);
 	return true;
 
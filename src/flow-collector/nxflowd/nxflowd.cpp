@@ -30,10 +30,18 @@ extern const TCHAR *g_szMessages[];
 //
 
 int g_debugLevel = 0;
-DWORD g_flags = AF_LOG_SQL_ERRORS;
+DWORD g_flags = AF_LOG_SQL_ERRORS | AF_STORE_RAW_FLOWS;
+DWORD g_aggregationInterval = 0;
+TCHAR g_aggregationKeys[MAX_PATH] = _T("exporter,source,destination,protocol,destination_port");
+DWORD g_aggregationMaxEntries = 100000;
+DWORD g_aggregationPrefixLength = 24;
+DWORD g_aggregationTopCount = 0;
 TCHAR g_listenAddress[MAX_PATH] = _T("0.0.0.0");
 DWORD g_tcpPort = IPFIX_DEFAULT_PORT;
 DWORD g_udpPort = IPFIX_DEFAULT_PORT;
+DWORD g_writerBatchSize = 1000;
+DWORD g_writerQueueSize = 100000;
+DWORD g_writerThreads = 1;
 DB_DRIVER g_dbDriverHandle = NULL;
 DB_HANDLE g_dbConnection = NULL;
 #ifdef _WIN32
@@ -63,6 +71,11 @@ static TCHAR s_dbLogin[MAX_DB_LOGIN] = _T("netxms");
 static TCHAR s_dbPassword[MAX_PASSWORD] = _T("");
 static NX_CFG_TEMPLATE m_cfgTemplate[] =
 {
+   { _T("AggregationInterval"), CT_LONG, 0, 0, 0, 0, &g_aggregationInterval },
+   { _T("AggregationKeys"), CT_STRING, 0, 0, MAX_PATH, 0, g_aggregationKeys },
+   { _T("AggregationMaxEntries"), CT_LONG, 0, 0, 0, 0, &g_aggregationMaxEntries },
+   { _T("AggregationPrefixLength"), CT_LONG, 0, 0, 0, 0, &g_aggregationPrefixLength },
+   { _T("AggregationTopCount"), CT_LONG, 0, 0, 0, 0, &g_aggregationTopCount },
    { _T("DBDriver"), CT_STRING, 0, 0, MAX_PATH, 0, s_dbDriver },
    { _T("DBDrvParams"), CT_STRING, 0, 0, MAX_PATH, 0, s_dbDrvParams },
    { _T("DBLogin"), CT_STRING, 0, 0, MAX_DB_LOGIN, 0, s_dbLogin },
@@ -77,6 +90,10 @@ static NX_CFG_TEMPLATE m_cfgTemplate[] =
    { _T("LogFile"), CT_STRING, 0, 0, MAX_PATH, 0, g_logFile },
    { _T("LogFailedSQLQueries"), CT_BOOLEAN_FLAG_32, 0, 0, AF_LOG_SQL_ERRORS, 0, &g_flags },
    { _T("LogFile"), CT_STRING, 0, 0, MAX_PATH, 0, g_logFile },
+   { _T("StoreRawFlows"), CT_BOOLEAN_FLAG_32, 0, 0, AF_STORE_RAW_FLOWS, 0, &g_flags },
+   { _T("WriterBatchSize"), CT_LONG, 0, 0, 0, 0, &g_writerBatchSize },
+   { _T("WriterQueueSize"), CT_LONG, 0, 0, 0, 0, &g_writerQueueSize },
+   { _T("WriterThreads"), CT_LONG, 0, 0, 0, 0, &g_writerThreads },
    { _T(""), CT_END_OF_LIST, 0, 0, 0, 0, NULL }
 };
 
@@ -111,6 +128,14 @@ static bool LoadConfig()
    return success;
 }
 
+/**
+ * Connect to database using configured credentials
+ */
+DB_HANDLE ConnectToDatabase(TCHAR *errorText)
+{
+   return DBConnect(g_dbDriverHandle, s_dbServer, s_dbName, s_dbLogin, s_dbPassword, s_dbSchema, errorText);
+}
+
 /**
  * Initialization
  */
@@ -149,7 +174,7 @@ bool Initialize()
 	TCHAR errorText[DBDRV_MAX_ERROR_TEXT];
 	for(int i = 0; ; i++)
 	{
-		g_dbConnection = DBConnect(g_dbDriverHandle, s_dbServer, s_dbName, s_dbLogin, s_dbPassword, s_dbSchema, errorText);
+		g_dbConnection = ConnectToDatabase(errorText);
 		if ((g_dbConnection != NULL) || (i == 5))
 			break;
 		ThreadSleep(5);
@@ -176,6 +201,9 @@ void Shutdown()
    g_flags |= AF_SHUTDOWN;
 
 	WaitForCollectorThread();
+	if (g_aggregationInterval > 0)
+	   StopFlowAggregator();
+	StopFlowWriters();
 
 	ipfix_cleanup();
    nxlog_close();
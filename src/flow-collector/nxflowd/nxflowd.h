@@ -37,9 +37,60 @@
 #define AF_DEBUG           0x00000002
 #define AF_USE_SYSLOG      0x00000004
 #define AF_LOG_SQL_ERRORS  0x00000008
+#define AF_STORE_RAW_FLOWS 0x00000010
 #define AF_SHUTDOWN        0x01000000
 
 
+//
+// Flow record
+//
+
+#define FLOW_FIELD_COUNT      12
+#define FLOW_MAC_ADDR_SIZE    6
+
+/**
+ * Flow table column indexes (must match order in collector field mapping table)
+ */
+enum FlowColumn
+{
+   FLOW_COL_EXPORTER_ADDR = 0,
+   FLOW_COL_SOURCE_MAC = 1,
+   FLOW_COL_DEST_MAC = 2,
+   FLOW_COL_SOURCE_ADDR = 3,
+   FLOW_COL_DEST_ADDR = 4,
+   FLOW_COL_IP_PROTO = 5,
+   FLOW_COL_SOURCE_PORT = 6,
+   FLOW_COL_DEST_PORT = 7,
+   FLOW_COL_OCTET_COUNT = 8,
+   FLOW_COL_PACKET_COUNT = 9,
+   FLOW_COL_INGRESS_INTERFACE = 10,
+   FLOW_COL_EGRESS_INTERFACE = 11
+};
+
+/**
+ * Decoded flow record waiting to be written to database. Bit N in field mask is set if value
+ * for column N from field mapping table is present.
+ */
+struct FlowRecord
+{
+   int64_t startTime;
+   int64_t endTime;
+   uint64_t octetCount;
+   uint64_t packetCount;
+   uint32_t fieldMask;
+   uint32_t exporterAddr;
+   uint32_t sourceAddr;
+   uint32_t destAddr;
+   uint32_t ingressInterface;
+   uint32_t egressInterface;
+   uint16_t sourcePort;
+   uint16_t destPort;
+   BYTE ipProto;
+   BYTE sourceMac[FLOW_MAC_ADDR_SIZE];
+   BYTE destMac[FLOW_MAC_ADDR_SIZE];
+};
+
+
 //
 // Functions
 //
@@ -48,8 +99,16 @@ bool Initialize();
 void Shutdown();
 void Main();
 
+DB_HANDLE ConnectToDatabase(TCHAR *errorText);
+
 bool StartCollector();
 void WaitForCollectorThread();
+void StopFlowWriters();
+
+bool StartFlowAggregator();
+void StopFlowAggregator();
+void AggregateFlow(const FlowRecord *record);
+void CheckAggregationBucket();
 
 #ifdef _WIN32
 void InitService();
@@ -68,9 +127,17 @@ void RemoveEventSource();
 //
 
 extern DWORD g_flags;
+extern DWORD g_aggregationInterval;
+extern TCHAR g_aggregationKeys[];
+extern DWORD g_aggregationMaxEntries;
+extern DWORD g_aggregationPrefixLength;
+extern DWORD g_aggregationTopCount;
 extern TCHAR g_listenAddress[];
 extern DWORD g_tcpPort;
 extern DWORD g_udpPort;
+extern DWORD g_writerBatchSize;
+extern DWORD g_writerQueueSize;
+extern DWORD g_writerThreads;
 extern TCHAR g_configFile[];
 extern TCHAR g_logFile[];
 extern int g_debugLevel;
@@ -168,6 +168,8 @@ private void fillMetricList()
          list.add(new AgentParameter("Server.ClientSessions.Total", "Client sessions: total", DataType.UINT32)); //$NON-NLS-1$
          list.add(new AgentParameter("Server.ClientSessions.Web", "Client sessions: web clients", DataType.UINT32)); //$NON-NLS-1$
          list.add(new AgentParameter("Server.ClientSessions.Web(*)", "Client sessions for user {instance}: web clients", DataType.UINT32)); //$NON-NLS-1$
+         list.add(new AgentParameter("Server.DataCollection.ItemsScheduledLate", "Number of data collection items queued for polling later than scheduled", DataType.COUNTER64)); //$NON-NLS-1$
+         list.add(new AgentParameter("Server.DataCollection.SchedulingLag", "Average data collection scheduling lag for last 5 minutes (milliseconds)", DataType.UINT32)); //$NON-NLS-1$
          list.add(new AgentParameter("Server.DataCollectionItems", "Number of data collection items in the system", DataType.UINT32)); //$NON-NLS-1$
          list.add(new AgentParameter("Server.DB.Queries.Failed", "Failed DB queries", DataType.COUNTER64)); //$NON-NLS-1$
          list.add(new AgentParameter("Server.DB.Queries.LongRunning", "Long running DB queries", DataType.COUNTER64)); //$NON-NLS-1$
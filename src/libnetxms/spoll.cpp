@@ -23,6 +23,31 @@
 
 #include "libnetxms.h"
 
+#if HAVE_SYS_EPOLL_H
+#include <sys/epoll.h>
+
+/**
+ * Timer wheel resolution for background socket poller (in milliseconds)
+ */
+#define TIMER_WHEEL_RESOLUTION   16
+
+/**
+ * Maximum number of events retrieved by background socket poller with single epoll_wait() call
+ */
+#define EPOLL_BATCH_SIZE         256
+
+#define DEBUG_TAG _T("socket.poller")
+
+/**
+ * Build epoll event data from socket (lower 32 bits) and request generation (upper 32 bits)
+ */
+static inline uint64_t EpollEventData(SOCKET s, uint32_t generation)
+{
+   return (static_cast<uint64_t>(generation) << 32) | static_cast<uint32_t>(s);
+}
+
+#endif
+
 /**
  * Add socket
  */
@@ -173,10 +198,23 @@ bool SocketPoller::isError(SOCKET s)
 /**
  * Create background socket poller
  */
+#if HAVE_SYS_EPOLL_H
+BackgroundSocketPoller::BackgroundSocketPoller() : m_mutex(MutexType::FAST), m_activeRequests(Ownership::False)
+#else
 BackgroundSocketPoller::BackgroundSocketPoller() : m_mutex(MutexType::FAST)
+#endif
 {
+#if HAVE_SYS_EPOLL_H
+   memset(m_timerWheel, 0, sizeof(m_timerWheel));
+   m_currentTick = GetCurrentTimeMs() / TIMER_WHEEL_RESOLUTION;
+   m_wakeupTick = m_currentTick;
+   m_cancelledRequests = nullptr;
+   m_failedRequests = nullptr;
+   m_requestGeneration = 0;
+#else
    m_head = m_memoryPool.allocate();   // dummy element at list head
    m_head->next = nullptr;
+#endif
    m_shutdown = false;
 
 #ifdef _WIN32
@@ -207,6 +245,21 @@ BackgroundSocketPoller::BackgroundSocketPoller() : m_mutex(MutexType::FAST)
    }
 #endif
 
+#if HAVE_SYS_EPOLL_H
+   m_epollFd = epoll_create1(EPOLL_CLOEXEC);
+   if ((m_epollFd != -1) && (m_controlSockets[0] != INVALID_SOCKET))
+   {
+      struct epoll_event event;
+      event.events = EPOLLIN;
+      event.data.u64 = EpollEventData(m_controlSockets[0], 0);  // Control socket is identified by generation 0
+      if (epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_controlSockets[0], &event) != 0)
+      {
+         close(m_epollFd);
+         m_epollFd = -1;
+      }
+   }
+#endif
+
    m_workerThreadId = 0;
    m_workerThread = ThreadCreateEx(this, &BackgroundSocketPoller::workerThread);
 }
@@ -220,6 +273,10 @@ BackgroundSocketPoller::~BackgroundSocketPoller()
    ThreadJoin(m_workerThread);
    closesocket(m_controlSockets[1]);
    closesocket(m_controlSockets[0]);
+#if HAVE_SYS_EPOLL_H
+   if (m_epollFd != -1)
+      close(m_epollFd);
+#endif
 }
 
 /**
@@ -247,6 +304,65 @@ void BackgroundSocketPoller::poll(SOCKET socket, uint32_t timeout, void (*callba
    request->queueTime = GetCurrentTimeMs();
    request->cancelled = false;
 
+#if HAVE_SYS_EPOLL_H
+   if (m_epollFd == -1)
+   {
+      // Worker thread is not running
+      m_memoryPool.free(request);
+      callback(BackgroundSocketPollResult::FAILURE, socket, context);
+      return;
+   }
+
+   m_mutex.lock();
+
+   // Existing request for same socket could be left from closed socket with same descriptor
+   // (closed descriptors are removed from epoll set silently), so it is replaced and reported as failed
+   bool notify = false;
+   BackgroundSocketPollRequest *prevRequest = m_activeRequests.get(socket);
+   if (prevRequest != nullptr)
+   {
+      deactivateRequest(prevRequest);
+      prevRequest->next = m_failedRequests;
+      m_failedRequests = prevRequest;
+      notify = true;
+   }
+
+   // Events are matched to requests by socket and generation rather than by request pointer, because event
+   // for already completed request (and possibly reused request object) can still be retrieved from epoll set
+   if (++m_requestGeneration == 0)
+      m_requestGeneration = 1;
+   request->generation = m_requestGeneration;
+
+   struct epoll_event event;
+   event.events = EPOLLIN | EPOLLONESHOT;
+   event.data.u64 = EpollEventData(socket, request->generation);
+   int rc = epoll_ctl(m_epollFd, EPOLL_CTL_ADD, socket, &event);
+   if ((rc != 0) && (errno == EEXIST))
+      rc = epoll_ctl(m_epollFd, EPOLL_CTL_MOD, socket, &event);   // Registration left after failed removal
+   if (rc == 0)
+   {
+      activateRequest(request);
+
+      // Worker thread should be woken up only if new request expires before planned wakeup time
+      if ((request->queueTime + request->timeout) / TIMER_WHEEL_RESOLUTION < m_wakeupTick)
+         notify = true;
+   }
+   else
+   {
+      // Socket cannot be polled (most likely invalid or already closed descriptor), failure
+      // will be reported from worker thread, as it would be done by poll() based implementation
+      request->wheelSlot = -1;
+      request->next = m_failedRequests;
+      m_failedRequests = request;
+      notify = true;
+   }
+   m_mutex.unlock();
+
+   // No need for notification if poll() called from worker thread itself
+   // (likely that means re-insert from poll completion callback)
+   if (notify && (GetCurrentThreadId() != m_workerThreadId))
+      notifyWorkerThread();
+#else
    m_mutex.lock();
    request->next = m_head->next;
    m_head->next = request;
@@ -256,6 +372,7 @@ void BackgroundSocketPoller::poll(SOCKET socket, uint32_t timeout, void (*callba
    // (likely that means re-insert from poll completion callback)
    if (GetCurrentThreadId() != m_workerThreadId)
       notifyWorkerThread();
+#endif
 }
 
 /**
@@ -263,6 +380,18 @@ void BackgroundSocketPoller::poll(SOCKET socket, uint32_t timeout, void (*callba
  */
 void BackgroundSocketPoller::cancel(SOCKET socket)
 {
+#if HAVE_SYS_EPOLL_H
+   m_mutex.lock();
+   BackgroundSocketPollRequest *r = m_activeRequests.get(socket);
+   if (r != nullptr)
+   {
+      deactivateRequest(r);
+      r->cancelled = true;
+      r->next = m_cancelledRequests;
+      m_cancelledRequests = r;
+   }
+   m_mutex.unlock();
+#else
    m_mutex.lock();
    auto r = m_head->next;
    for(; r != nullptr; r = r->next)
@@ -274,6 +403,7 @@ void BackgroundSocketPoller::cancel(SOCKET socket)
       }
    }
    m_mutex.unlock();
+#endif
 
    // No need for notification if poll() called from worker thread itself
    // (likely that means cancellation from poll completion callback)
@@ -311,8 +441,226 @@ void BackgroundSocketPoller::notifyWorkerThread(char command)
    }
 }
 
+#if HAVE_SYS_EPOLL_H
+
 /**
- * Background poller's worker thread
+ * Add request to active request set and to timer wheel. Poller lock must be held by caller.
+ */
+void BackgroundSocketPoller::activateRequest(BackgroundSocketPollRequest *request)
+{
+   m_activeRequests.set(request->socket, request);
+
+   // Request is placed into slot for first tick not earlier than expiration time
+   int64_t tick = (request->queueTime + request->timeout + TIMER_WHEEL_RESOLUTION - 1) / TIMER_WHEEL_RESOLUTION;
+   if (tick <= m_currentTick)
+      tick = m_currentTick + 1;
+   int32_t slot = static_cast<int32_t>(tick % BACKGROUND_SOCKET_POLLER_WHEEL_SIZE);
+   request->wheelSlot = slot;
+   request->prev = nullptr;
+   request->next = m_timerWheel[slot];
+   if (request->next != nullptr)
+      request->next->prev = request;
+   m_timerWheel[slot] = request;
+}
+
+/**
+ * Remove request from active request set, timer wheel, and epoll set. Poller lock must be held by caller.
+ */
+void BackgroundSocketPoller::deactivateRequest(BackgroundSocketPollRequest *request)
+{
+   // Removal fails if socket is already closed. If closed descriptor was duplicated, registration can stay in epoll
+   // set, but it is one-shot and events with outdated generation are dropped by worker thread.
+   if ((epoll_ctl(m_epollFd, EPOLL_CTL_DEL, request->socket, nullptr) != 0) && (errno != EBADF) && (errno != ENOENT))
+      nxlog_debug_tag(DEBUG_TAG, 5, _T("BackgroundSocketPoller: cannot remove socket %d from epoll set (%s)"), static_cast<int>(request->socket), _tcserror(errno));
+   m_activeRequests.unlink(request->socket);
+
+   if (request->prev != nullptr)
+      request->prev->next = request->next;
+   else
+      m_timerWheel[request->wheelSlot] = request->next;
+   if (request->next != nullptr)
+      request->next->prev = request->prev;
+   request->next = nullptr;
+   request->prev = nullptr;
+   request->wheelSlot = -1;
+}
+
+/**
+ * Find next timer wheel tick with non-empty slot. Returns -1 if timer wheel is empty. Poller lock must be held by caller.
+ */
+int64_t BackgroundSocketPoller::getNextTimerTick()
+{
+   for(int64_t tick = m_currentTick + 1; tick <= m_currentTick + BACKGROUND_SOCKET_POLLER_WHEEL_SIZE; tick++)
+   {
+      if (m_timerWheel[tick % BACKGROUND_SOCKET_POLLER_WHEEL_SIZE] != nullptr)
+         return tick;
+   }
+   return -1;
+}
+
+/**
+ * Advance timer wheel to given time and deactivate all expired requests. Returns list of expired requests.
+ * Poller lock must be held by caller.
+ */
+BackgroundSocketPollRequest *BackgroundSocketPoller::processExpiredTimers(int64_t now)
+{
+   int64_t tick = now / TIMER_WHEEL_RESOLUTION;
+   if (tick <= m_currentTick)
+      return nullptr;   // Same tick or clock moved backwards
+
+   BackgroundSocketPollRequest *expiredRequests = nullptr;
+   int64_t lastTick = std::min(tick, m_currentTick + BACKGROUND_SOCKET_POLLER_WHEEL_SIZE);
+   for(int64_t t = m_currentTick + 1; t <= lastTick; t++)
+   {
+      // Slot may also contain requests for next wheel rotations
+      BackgroundSocketPollRequest *r = m_timerWheel[t % BACKGROUND_SOCKET_POLLER_WHEEL_SIZE];
+      while(r != nullptr)
+      {
+         BackgroundSocketPollRequest *next = r->next;
+         if (r->queueTime + r->timeout <= now)
+         {
+            deactivateRequest(r);
+            r->next = expiredRequests;
+            expiredRequests = r;
+         }
+         r = next;
+      }
+   }
+   m_currentTick = tick;
+   return expiredRequests;
+}
+
+/**
+ * Call callback for all requests in the list and release them
+ */
+template<BackgroundSocketPollResult result> static inline void CompleteRequests(BackgroundSocketPollRequest *requests, SynchronizedObjectMemoryPool<BackgroundSocketPollRequest> *memoryPool)
+{
+   for(auto r = requests; r != nullptr;)
+   {
+      auto n = r->next;
+      r->callback(result, r->socket, r->context);
+      memoryPool->free(r);
+      r = n;
+   }
+}
+
+/**
+ * Background poller's worker thread (epoll based implementation). Only sockets with pending events are processed on each
+ * wakeup, and timeouts are tracked in timer wheel, so processing cost does not depend on number of registered sockets.
+ */
+void BackgroundSocketPoller::workerThread()
+{
+   m_workerThreadId = GetCurrentThreadId();
+   if (m_epollFd == -1)
+      return;
+
+   struct epoll_event events[EPOLL_BATCH_SIZE];
+   while(!m_shutdown)
+   {
+      int64_t now = GetCurrentTimeMs();
+
+      m_mutex.lock();
+      int timeout;
+      if ((m_cancelledRequests != nullptr) || (m_failedRequests != nullptr))
+      {
+         timeout = 0;
+         m_wakeupTick = m_currentTick;
+      }
+      else
+      {
+         int64_t nextTick = getNextTimerTick();
+         if (nextTick != -1)
+         {
+            timeout = static_cast<int>(std::max(std::min(nextTick * TIMER_WHEEL_RESOLUTION - now, static_cast<int64_t>(30000)), static_cast<int64_t>(0)));
+            m_wakeupTick = nextTick;
+         }
+         else
+         {
+            timeout = 30000;
+            m_wakeupTick = (now + timeout) / TIMER_WHEEL_RESOLUTION;
+         }
+      }
+      m_mutex.unlock();
+
+      int rc = epoll_wait(m_epollFd, events, EPOLL_BATCH_SIZE, timeout);
+
+      bool stop = false;
+      BackgroundSocketPollRequest *readyRequests = nullptr;
+      m_mutex.lock();
+      for(int i = 0; i < rc; i++)
+      {
+         SOCKET s = static_cast<SOCKET>(events[i].data.u64 & 0xFFFFFFFF);
+         uint32_t generation = static_cast<uint32_t>(events[i].data.u64 >> 32);
+         if (generation == 0)
+         {
+            char commands[64];
+            ssize_t bytes = read(m_controlSockets[0], commands, sizeof(commands));
+            if ((bytes > 0) && (memchr(commands, 'S', bytes) != nullptr))
+               stop = true;
+            continue;
+         }
+
+         // Request could be cancelled or replaced after event was retrieved, or event could be left
+         // from descriptor that was closed without removal from epoll set
+         BackgroundSocketPollRequest *r = m_activeRequests.get(s);
+         if ((r != nullptr) && (r->generation == generation))
+         {
+            deactivateRequest(r);
+            r->next = readyRequests;
+            readyRequests = r;
+         }
+      }
+      BackgroundSocketPollRequest *expiredRequests = processExpiredTimers(GetCurrentTimeMs());
+      BackgroundSocketPollRequest *cancelledRequests = m_cancelledRequests;
+      m_cancelledRequests = nullptr;
+      BackgroundSocketPollRequest *failedRequests = m_failedRequests;
+      m_failedRequests = nullptr;
+      m_mutex.unlock();
+
+      CompleteRequests<BackgroundSocketPollResult::CANCELLED>(cancelledRequests, &m_memoryPool);
+      CompleteRequests<BackgroundSocketPollResult::FAILURE>(failedRequests, &m_memoryPool);
+      CompleteRequests<BackgroundSocketPollResult::SUCCESS>(readyRequests, &m_memoryPool);
+
+      // Closed descriptors are silently removed from epoll set, so socket closed while being polled
+      // is detected only on request expiration and reported as failure instead of timeout
+      for(auto r = expiredRequests; r != nullptr;)
+      {
+         auto n = r->next;
+         r->callback(IsValidSocket(r->socket) ? BackgroundSocketPollResult::TIMEOUT : BackgroundSocketPollResult::FAILURE, r->socket, r->context);
+         m_memoryPool.free(r);
+         r = n;
+      }
+
+      if (stop)
+         break;
+   }
+
+   m_mutex.lock();
+   BackgroundSocketPollRequest *failedRequests = m_failedRequests;
+   m_failedRequests = nullptr;
+   BackgroundSocketPollRequest *remainingRequests = m_cancelledRequests;
+   m_cancelledRequests = nullptr;
+   for(int i = 0; i < BACKGROUND_SOCKET_POLLER_WHEEL_SIZE; i++)
+   {
+      while(m_timerWheel[i] != nullptr)
+      {
+         BackgroundSocketPollRequest *r = m_timerWheel[i];
+         deactivateRequest(r);
+         r->next = remainingRequests;
+         remainingRequests = r;
+      }
+   }
+   m_mutex.unlock();
+
+   CompleteRequests<BackgroundSocketPollResult::FAILURE>(failedRequests, &m_memoryPool);
+   for(auto r = remainingRequests; r != nullptr; r = r->next)
+      r->callback(BackgroundSocketPollResult::SHUTDOWN, r->socket, r->context);
+}
+
+#else /* HAVE_SYS_EPOLL_H */
+
+/**
+ * Background poller's worker thread (poll/select based implementation)
  */
 void BackgroundSocketPoller::workerThread()
 {
@@ -351,7 +699,8 @@ void BackgroundSocketPoller::workerThread()
       for(auto r = processedRequests; r != nullptr;)
       {
          auto n = r->next;
-         r->callback(r->cancelled ? BackgroundSocketPollResult::CANCELLED : BackgroundSocketPollResult::TIMEOUT, r->socket, r->context);
+         // Socket closed while being polled is reported as failure and not as timeout
+         r->callback(r->cancelled ? BackgroundSocketPollResult::CANCELLED : (IsValidSocket(r->socket) ? BackgroundSocketPollResult::TIMEOUT : BackgroundSocketPollResult::FAILURE), r->socket, r->context);
          m_memoryPool.free(r);
          r = n;
       }
@@ -422,3 +771,5 @@ void BackgroundSocketPoller::workerThread()
    for(auto r = m_head->next; r != nullptr; r = r->next)
       r->callback(BackgroundSocketPollResult::SHUTDOWN, r->socket, r->context);
 }
+
+#endif /* HAVE_SYS_EPOLL_H */
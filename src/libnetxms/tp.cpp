@@ -40,18 +40,19 @@ static uint32_t s_waitTimeLowWatermark = 50;
 static int s_maintThreadResponsiveness = 12;
 
 /**
- * Indicator for stop with deregistration
+ * Capacity of per-worker request deque in work stealing pool (must be power of 2)
  */
-static char s_stopAndUnregister[] = "UNREGISTER";
+#define WORKER_DEQUE_CAPACITY    256
 
 /**
- * Worker thread data
+ * Maximum number of samples applied to wait time moving average during single merge of worker statistics
  */
-struct WorkerThreadInfo
-{
-   ThreadPool *pool;
-   THREAD handle;
-};
+#define MAX_MERGED_EMA_SAMPLES   4096
+
+/**
+ * Indicator for stop with deregistration
+ */
+static char s_stopAndUnregister[] = "UNREGISTER";
 
 /**
  * Thread work request
@@ -64,6 +65,131 @@ struct WorkRequest
    int64_t runTime;
 };
 
+/**
+ * Wakeup request for idle workers in work stealing pool
+ */
+static WorkRequest s_wakeupRequest = { nullptr, nullptr, 0, 0 };
+
+/**
+ * Fixed size work stealing deque (Chase-Lev). Only owning worker thread can call push() and pop(),
+ * steal() can be called from any thread.
+ */
+class WorkStealingDeque
+{
+private:
+   std::atomic<int64_t> m_top;
+   std::atomic<WorkRequest*> m_buffer[WORKER_DEQUE_CAPACITY];
+   std::atomic<int64_t> m_bottom;
+
+public:
+   WorkStealingDeque() : m_top(0), m_bottom(0)
+   {
+      for(int i = 0; i < WORKER_DEQUE_CAPACITY; i++)
+         m_buffer[i].store(nullptr, std::memory_order_relaxed);
+   }
+
+   /**
+    * Push request to the bottom of the deque. Returns false if deque is full.
+    */
+   bool push(WorkRequest *rq)
+   {
+      int64_t b = m_bottom.load(std::memory_order_relaxed);
+      int64_t t = m_top.load(std::memory_order_acquire);
+      if (b - t >= WORKER_DEQUE_CAPACITY)
+         return false;
+      m_buffer[b & (WORKER_DEQUE_CAPACITY - 1)].store(rq, std::memory_order_relaxed);
+      m_bottom.store(b + 1, std::memory_order_release);
+      return true;
+   }
+
+   /**
+    * Pop request from the bottom of the deque
+    */
+   WorkRequest *pop()
+   {
+      int64_t b = m_bottom.load(std::memory_order_relaxed) - 1;
+      m_bottom.store(b, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      int64_t t = m_top.load(std::memory_order_relaxed);
+      if (t > b)
+      {
+         m_bottom.store(b + 1, std::memory_order_relaxed);
+         return nullptr;
+      }
+      WorkRequest *rq = m_buffer[b & (WORKER_DEQUE_CAPACITY - 1)].load(std::memory_order_relaxed);
+      if (t == b)
+      {
+         // Last element in the deque, compete with thieves for it
+         if (!m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            rq = nullptr;
+         m_bottom.store(b + 1, std::memory_order_relaxed);
+      }
+      return rq;
+   }
+
+   /**
+    * Steal request from the top of the deque
+    */
+   WorkRequest *steal()
+   {
+      while(true)
+      {
+         int64_t t = m_top.load(std::memory_order_acquire);
+         std::atomic_thread_fence(std::memory_order_seq_cst);
+         int64_t b = m_bottom.load(std::memory_order_acquire);
+         if (t >= b)
+            return nullptr;
+         WorkRequest *rq = m_buffer[t & (WORKER_DEQUE_CAPACITY - 1)].load(std::memory_order_relaxed);
+         if (m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return rq;
+         // Lost race with owner or another thief, retry while deque is not empty
+      }
+   }
+
+   /**
+    * Get approximate number of requests in the deque
+    */
+   int size() const
+   {
+      int64_t size = m_bottom.load(std::memory_order_relaxed) - m_top.load(std::memory_order_relaxed);
+      return (size > 0) ? static_cast<int>(size) : 0;
+   }
+};
+
+/**
+ * Worker slot in work stealing pool. Slots are allocated once for maximum number of threads and reused by
+ * worker threads, so other workers can safely access deques without any additional synchronization.
+ */
+struct WorkerSlot
+{
+   WorkStealingDeque deque;
+   std::atomic<uint64_t> waitTimeSamples;  // Wait time counters are updated only by owning worker
+   std::atomic<uint64_t> waitTimeSum;
+   std::atomic<uint64_t> waitTimeSumSq;
+   uint64_t mergedSamples;    // Values already merged into pool statistics (protected by pool mutex)
+   uint64_t mergedSum;
+   uint64_t mergedSumSq;
+   bool inUse;                // Protected by pool mutex
+
+   WorkerSlot() : waitTimeSamples(0), waitTimeSum(0), waitTimeSumSq(0)
+   {
+      mergedSamples = 0;
+      mergedSum = 0;
+      mergedSumSq = 0;
+      inUse = false;
+   }
+};
+
+/**
+ * Worker thread data
+ */
+struct WorkerThreadInfo
+{
+   ThreadPool *pool;
+   THREAD handle;
+   WorkerSlot *slot;
+};
+
 /**
  * Request queue for serialized execution
  */
@@ -80,6 +206,45 @@ class SerializationQueue: public Queue
    void updateMaxWaitTime(uint32_t waitTime) { m_maxWaitTime = std::max(waitTime, m_maxWaitTime); }
 };
 
+struct SerializationShard;
+
+/**
+ * Request queue for serialized execution with integer key. Queue itself is passed to the worker
+ * function, so no additional allocations are needed when new serialized execution chain starts.
+ */
+class KeyedSerializationQueue : public SerializationQueue
+{
+public:
+   ThreadPool *pool;
+   SerializationShard *shard;
+   uint64_t key;
+
+   KeyedSerializationQueue(ThreadPool *_pool, SerializationShard *_shard, uint64_t _key) : SerializationQueue(16)
+   {
+      pool = _pool;
+      shard = _shard;
+      key = _key;
+   }
+};
+
+/**
+ * Number of shards for serialized execution queues with integer keys (must be power of 2)
+ */
+#define SERIALIZATION_SHARD_COUNT   64
+
+/**
+ * Shard of serialized execution queues with integer keys
+ */
+struct SerializationShard
+{
+   Mutex lock;
+   HashMap<uint64_t, KeyedSerializationQueue> queues;
+
+   SerializationShard() : lock(MutexType::FAST), queues(Ownership::True)
+   {
+   }
+};
+
 /**
  * Scheduled requests comparator (used for task sorting)
  */
@@ -111,6 +276,7 @@ struct ThreadPool
    ObjectQueue<WorkRequest> queue;
    StringObjectMap<SerializationQueue> serializationQueues;
    Mutex serializationLock;
+   SerializationShard serializationShards[SERIALIZATION_SHARD_COUNT];
    std::priority_queue<WorkRequest*, std::vector<WorkRequest*>, ScheduledRequestsComparator> schedulerQueue;
    Mutex schedulerLock;
    TCHAR *name;
@@ -124,8 +290,13 @@ struct ThreadPool
    uint64_t threadStopCount;
    VolatileCounter64 taskExecutionCount;
    SynchronizedObjectMemoryPool<WorkRequest> workRequestMemoryPool;
+   bool workStealing;
+   WorkerSlot *slots;
+   VolatileCounter slotCount;
+   VolatileCounter idleWorkers;
+   VolatileCounter pendingWakeups;   // Number of wakeup requests queued but not yet received by workers
 
-   ThreadPool(const TCHAR *name, int minThreads, int maxThreads, int stackSize) :
+   ThreadPool(const TCHAR *name, int minThreads, int maxThreads, int stackSize, uint32_t flags) :
          mutex(MutexType::FAST), maintThreadWakeup(false), queue(64, Ownership::False), serializationQueues(Ownership::True),
          serializationLock(MutexType::FAST), schedulerLock(MutexType::FAST)
    {
@@ -143,13 +314,63 @@ struct ThreadPool
       threadStartCount = 0;
       threadStopCount = 0;
       taskExecutionCount = 0;
+      workStealing = ((flags & THREAD_POOL_WORK_STEALING) != 0);
+      slots = workStealing ? new WorkerSlot[this->maxThreads] : nullptr;
+      slotCount = 0;
+      idleWorkers = 0;
+      pendingWakeups = 0;
    }
 
    ~ThreadPool()
    {
       threads.setOwner(Ownership::True);
+      if (workStealing)
+         destroyPendingRequests();
+      delete[] slots;
       MemFree(name);
    }
+
+   /**
+    * Destroy requests left in queues. Work stealing pool allocates requests directly from heap, so they will not be
+    * released together with memory pool.
+    */
+   void destroyPendingRequests()
+   {
+      WorkRequest *rq;
+      while((rq = queue.get()) != nullptr)
+      {
+         if ((rq != &s_wakeupRequest) && ((rq->func != nullptr) || (rq->arg != nullptr)))
+            delete rq;
+      }
+      for(int i = 0; i < slotCount; i++)
+      {
+         while((rq = slots[i].deque.steal()) != nullptr)
+            delete rq;
+      }
+      while(!schedulerQueue.empty())
+      {
+         delete schedulerQueue.top();
+         schedulerQueue.pop();
+      }
+      auto it = serializationQueues.begin();
+      while(it.hasNext())
+      {
+         SerializationQueue *q = it.next()->value;
+         while((rq = static_cast<WorkRequest*>(q->get())) != nullptr)
+            delete rq;
+      }
+      for(int i = 0; i < SERIALIZATION_SHARD_COUNT; i++)
+      {
+         serializationShards[i].queues.forEach(
+            [] (const uint64_t& key, KeyedSerializationQueue *q) -> EnumerationCallbackResult
+            {
+               WorkRequest *rq;
+               while((rq = static_cast<WorkRequest*>(q->get())) != nullptr)
+                  delete rq;
+               return _CONTINUE;
+            });
+      }
+   }
 };
 
 /**
@@ -158,6 +379,105 @@ struct ThreadPool
 static StringObjectMap<ThreadPool> s_registry(Ownership::False);
 static Mutex s_registryLock;
 
+#if HAVE_THREAD_LOCAL_STORAGE
+
+/**
+ * Worker thread information for current thread (used for submitting requests to worker's local deque)
+ */
+static thread_local WorkerThreadInfo *s_currentWorker = nullptr;
+
+#endif
+
+/**
+ * Create work request. Work stealing pool allocates requests directly from heap to avoid contention on shared memory pool.
+ */
+static inline WorkRequest *CreateWorkRequest(ThreadPool *p)
+{
+   return p->workStealing ? new WorkRequest : p->workRequestMemoryPool.create();
+}
+
+/**
+ * Destroy work request
+ */
+static inline void DestroyWorkRequest(ThreadPool *p, WorkRequest *rq)
+{
+   if (p->workStealing)
+      delete rq;
+   else
+      p->workRequestMemoryPool.destroy(rq);
+}
+
+/**
+ * Get current number of queued requests
+ */
+static int64_t GetQueueSize(ThreadPool *p)
+{
+   int64_t size = static_cast<int64_t>(p->queue.size());
+   if (p->workStealing)
+   {
+      for(int i = 0; i < p->slotCount; i++)
+         size += p->slots[i].deque.size();
+   }
+   return size;
+}
+
+/**
+ * Merge per-worker wait time statistics into pool statistics (should be called with pool mutex locked).
+ * Counters are read without synchronization with worker, so snapshot can be slightly inconsistent - such
+ * error is compensated on next merge.
+ */
+static void MergeWorkerStatistics(ThreadPool *p)
+{
+   int emaExp = EMA_EXP(1, 1000);
+   for(int i = 0; i < p->slotCount; i++)
+   {
+      WorkerSlot *slot = &p->slots[i];
+      uint64_t samples = slot->waitTimeSamples.load(std::memory_order_acquire);
+      uint64_t sum = slot->waitTimeSum.load(std::memory_order_relaxed);
+      uint64_t sumSq = slot->waitTimeSumSq.load(std::memory_order_relaxed);
+      uint64_t count = samples - slot->mergedSamples;
+      if (count == 0)
+         continue;
+
+      double deltaSum = static_cast<double>(sum - slot->mergedSum);
+      double deltaSumSq = static_cast<double>(sumSq - slot->mergedSumSq);
+      double mean = deltaSum / static_cast<double>(count);
+      p->waitTimeVariance.merge(static_cast<int64_t>(count), mean, std::max(deltaSumSq - deltaSum * mean, 0.0));
+
+      int64_t value = static_cast<int64_t>(mean);
+      for(uint64_t n = std::min(count, static_cast<uint64_t>(MAX_MERGED_EMA_SAMPLES)); n > 0; n--)
+         UpdateExpMovingAverage(p->waitTimeEMA, emaExp, value);
+
+      slot->mergedSamples = samples;
+      slot->mergedSum = sum;
+      slot->mergedSumSq = sumSq;
+   }
+}
+
+/**
+ * Wake up idle workers after request was placed into or stolen from given worker's local deque. Number of
+ * outstanding wakeups is kept in proportion to deque depth (limited by number of idle workers), so burst of
+ * requests pushed by one worker wakes one more idle worker on each push.
+ */
+static inline void WakeIdleWorkers(ThreadPool *p, WorkerSlot *slot)
+{
+   // Full barrier to order push into deque with read of idle worker counter (worker
+   // increments counter before final check of other workers' deques)
+   std::atomic_thread_fence(std::memory_order_seq_cst);
+   int demand = std::min(static_cast<int>(p->idleWorkers), slot->deque.size());
+   while(true)
+   {
+      VolatileCounter pending = p->pendingWakeups;
+      if (pending >= demand)
+         break;
+      if (InterlockedCompareExchange(&p->pendingWakeups, pending + 1, pending) == pending)
+      {
+         p->queue.put(&s_wakeupRequest);
+         break;
+      }
+   }
+}
+
 /**
  * Worker function to join stopped thread
  */
@@ -167,6 +487,124 @@ static void JoinWorkerThread(void *arg)
    delete static_cast<WorkerThreadInfo*>(arg);
 }
 
+/**
+ * Execute work request on worker thread
+ */
+static inline void ExecuteWorkRequest(ThreadPool *p, WorkerSlot *slot, WorkRequest *rq)
+{
+   int64_t waitTime = GetCurrentTimeMs() - rq->queueTime;
+   if (slot != nullptr)
+   {
+      // Only owning worker updates slot counters, so atomic read-modify-write is not needed
+      uint64_t w = static_cast<uint64_t>(std::max(waitTime, static_cast<int64_t>(0)));
+      slot->waitTimeSum.store(slot->waitTimeSum.load(std::memory_order_relaxed) + w, std::memory_order_relaxed);
+      slot->waitTimeSumSq.store(slot->waitTimeSumSq.load(std::memory_order_relaxed) + w * w, std::memory_order_relaxed);
+      slot->waitTimeSamples.store(slot->waitTimeSamples.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+   }
+   else
+   {
+      p->mutex.lock();
+      UpdateExpMovingAverage(p->waitTimeEMA, EMA_EXP(1, 1000), waitTime); // Use last 1000 executions
+      p->waitTimeVariance.update(waitTime);
+      p->mutex.unlock();
+   }
+
+   rq->func(rq->arg);
+   DestroyWorkRequest(p, rq);
+   InterlockedDecrement(&p->activeRequests);
+}
+
+/**
+ * Try to steal request from other workers in work stealing pool
+ */
+static WorkRequest *StealWorkRequest(ThreadPool *p, WorkerSlot *self, uint32_t seed)
+{
+   int count = p->slotCount;
+   if (count == 0)
+      return nullptr;
+
+   // Start from different position for different workers to spread contention
+   if (self != nullptr)
+      seed += static_cast<uint32_t>(self - p->slots);
+   int start = static_cast<int>(seed % static_cast<uint32_t>(count));
+   for(int i = 0; i < count; i++)
+   {
+      WorkerSlot *slot = &p->slots[(start + i) % count];
+      if (slot == self)
+         continue;
+      WorkRequest *rq = slot->deque.steal();
+      if (rq != nullptr)
+      {
+         // Pass wakeup on if victim still has queued requests (wakeups sent by victim can be consumed by active workers)
+         if (slot->deque.size() > 0)
+            WakeIdleWorkers(p, slot);
+         return rq;
+      }
+   }
+   return nullptr;
+}
+
+/**
+ * Get request from shared queue without waiting. Wakeup requests retrieved by active worker are discarded.
+ */
+static inline WorkRequest *GetSharedQueueRequest(ThreadPool *p)
+{
+   WorkRequest *rq = p->queue.get();
+   if (rq == &s_wakeupRequest)
+   {
+      InterlockedDecrement(&p->pendingWakeups);
+      rq = nullptr;
+   }
+   return rq;
+}
+
+/**
+ * Get next request for worker in work stealing pool. Local deque is checked first, then shared queue, then
+ * deques of other workers. Shared queue is checked first on every 32nd call to guarantee progress for
+ * requests submitted from outside of the pool.
+ */
+static WorkRequest *GetNextWorkRequest(ThreadPool *p, WorkerSlot *slot, uint32_t& tick)
+{
+   WorkRequest *rq;
+   tick++;
+   if ((tick % 32) == 0)
+   {
+      rq = GetSharedQueueRequest(p);
+      if (rq != nullptr)
+         return rq;
+   }
+
+   if (slot != nullptr)
+   {
+      rq = slot->deque.pop();
+      if (rq != nullptr)
+         return rq;
+   }
+
+   rq = GetSharedQueueRequest(p);
+   if (rq != nullptr)
+      return rq;
+
+   rq = StealWorkRequest(p, slot, tick);
+   if (rq != nullptr)
+      return rq;
+
+   // Announce idle state and re-check other workers' deques before going to sleep. Any request pushed
+   // to local deque after this point will be seen by this check or cause wakeup request to be queued.
+   InterlockedIncrement(&p->idleWorkers);
+   rq = StealWorkRequest(p, slot, tick);
+   if (rq == nullptr)
+   {
+      rq = p->queue.getOrBlock(INFINITE);
+      // Pending wakeup counter should be updated while worker is still counted as idle, otherwise
+      // pushing worker can see stale pending wakeup and skip waking up another idle worker
+      if (rq == &s_wakeupRequest)
+         InterlockedDecrement(&p->pendingWakeups);
+   }
+   InterlockedDecrement(&p->idleWorkers);
+   return rq;
+}
+
 /**
  * Worker thread function
  */
@@ -185,15 +623,39 @@ static void WorkerThread(WorkerThreadInfo *threadInfo)
    strlcat(threadName, "/WRK", 16);
    ThreadSetName(threadName);
 
+#if HAVE_THREAD_LOCAL_STORAGE
+   s_currentWorker = threadInfo;
+#endif
+
+   uint32_t tick = 0;
    while(true)
    {
-      WorkRequest *rq = p->queue.getOrBlock(INFINITE);
+      WorkRequest *rq = p->workStealing ? GetNextWorkRequest(p, threadInfo->slot, tick) : p->queue.getOrBlock(INFINITE);
+      if (rq == &s_wakeupRequest)
+         continue;
+
       if (rq->func == nullptr) // stop indicator
       {
+         if (threadInfo->slot != nullptr)
+         {
+            // Hand over requests from local deque to other workers if thread is stopped because of pool
+            // resize, or execute them if entire pool is being destroyed
+            WorkRequest *lrq;
+            while((lrq = threadInfo->slot->deque.pop()) != nullptr)
+            {
+               if (rq->arg == s_stopAndUnregister)
+                  p->queue.put(lrq);
+               else
+                  ExecuteWorkRequest(p, threadInfo->slot, lrq);
+            }
+         }
+
          if (rq->arg == s_stopAndUnregister)
          {
             p->mutex.lock();
             p->threads.remove(CAST_FROM_POINTER(threadInfo, uint64_t));
+            if (threadInfo->slot != nullptr)
+               threadInfo->slot->inUse = false;
             p->threadStopCount++;
             p->mutex.unlock();
 
@@ -206,20 +668,48 @@ static void WorkerThread(WorkerThreadInfo *threadInfo)
          break;
       }
 
-      int64_t waitTime = GetCurrentTimeMs() - rq->queueTime;
-      p->mutex.lock();
-      UpdateExpMovingAverage(p->waitTimeEMA, EMA_EXP(1, 1000), waitTime); // Use last 1000 executions
-      p->waitTimeVariance.update(waitTime);
-      p->mutex.unlock();
-
-      rq->func(rq->arg);
-      p->workRequestMemoryPool.destroy(rq);
-      InterlockedDecrement(&p->activeRequests);
+      ExecuteWorkRequest(p, threadInfo->slot, rq);
    }
 
    nxlog_debug_tag(DEBUG_TAG, 8, _T("Worker thread in thread pool %s stopped"), p->name);
 }
 
+/**
+ * Start new worker thread (should be called with pool mutex locked)
+ */
+static bool StartWorkerThread(ThreadPool *p)
+{
+   WorkerThreadInfo *wt = new WorkerThreadInfo;
+   wt->pool = p;
+   wt->slot = nullptr;
+   if (p->workStealing)
+   {
+      for(int i = 0; i < p->maxThreads; i++)
+      {
+         if (!p->slots[i].inUse)
+         {
+            wt->slot = &p->slots[i];
+            wt->slot->inUse = true;
+            if (i >= p->slotCount)
+               p->slotCount = i + 1;
+            break;
+         }
+      }
+   }
+
+   wt->handle = ThreadCreateEx(WorkerThread, wt, p->stackSize);
+   if (wt->handle == INVALID_THREAD_HANDLE)
+   {
+      if (wt->slot != nullptr)
+         wt->slot->inUse = false;
+      delete wt;
+      return false;
+   }
+
+   p->threads.set(CAST_FROM_POINTER(wt, uint64_t), wt);
+   return true;
+}
+
 /**
  * Thread pool maintenance thread
  */
@@ -255,7 +745,14 @@ static void MaintenanceThread(ThreadPool *p)
          UpdateExpMovingAverage(p->loadAverage[1], EMA_EXP_60, requestCount);
          UpdateExpMovingAverage(p->loadAverage[2], EMA_EXP_180, requestCount);
 
-         int64_t queueSize = static_cast<int64_t>(p->queue.size());
+         if (p->workStealing)
+         {
+            p->mutex.lock();
+            MergeWorkerStatistics(p);
+            p->mutex.unlock();
+         }
+
+         int64_t queueSize = GetQueueSize(p);
          UpdateExpMovingAverage(p->queueSizeEMA, EMA_EXP_180, queueSize);
          p->queueSizeVariance.update(queueSize);
 
@@ -278,21 +775,13 @@ static void MaintenanceThread(ThreadPool *p)
                int delta = std::min(p->maxThreads - threadCount, std::max(std::min(queueSizeSMA, queueSizeEMA) / 2, 1));
                for(int i = 0; i < delta; i++)
                {
-                  WorkerThreadInfo *wt = new WorkerThreadInfo;
-                  wt->pool = p;
-                  wt->handle = ThreadCreateEx(WorkerThread, wt, p->stackSize);
-                  if (wt->handle != INVALID_THREAD_HANDLE)
+                  if (!StartWorkerThread(p))
                   {
-                     p->threads.set(CAST_FROM_POINTER(wt, uint64_t), wt);
-                     p->threadStartCount++;
-                     started++;
-                  }
-                  else
-                  {
-                     delete wt;
                      failure = true;
                      break;
                   }
+                  p->threadStartCount++;
+                  started++;
                }
             }
             else if ((waitTimeEMA < s_waitTimeLowWatermark) && (waitTimeSMA < s_waitTimeLowWatermark) && (threadCount > p->minThreads))
@@ -306,7 +795,7 @@ static void MaintenanceThread(ThreadPool *p)
                }
                for(int i = 0; i < stopped; i++)
                {
-                  WorkRequest *rq = p->workRequestMemoryPool.create();
+                  WorkRequest *rq = CreateWorkRequest(p);
                   rq->func = nullptr;
                   rq->arg = s_stopAndUnregister;
                   rq->queueTime = GetCurrentTimeMs();
@@ -369,26 +858,16 @@ static void MaintenanceThread(ThreadPool *p)
 /**
  * Create thread pool
  */
-ThreadPool LIBNETXMS_EXPORTABLE *ThreadPoolCreate(const TCHAR *name, int minThreads, int maxThreads, int stackSize)
+ThreadPool LIBNETXMS_EXPORTABLE *ThreadPoolCreate(const TCHAR *name, int minThreads, int maxThreads, int stackSize, uint32_t flags)
 {
-   auto p = new ThreadPool(name, minThreads, maxThreads, stackSize);
+   auto p = new ThreadPool(name, minThreads, maxThreads, stackSize, flags);
    p->maintThread = ThreadCreateEx(MaintenanceThread, p, 256 * 1024);
 
    p->mutex.lock();
    for(int i = 0; i < p->minThreads; i++)
    {
-      WorkerThreadInfo *wt = new WorkerThreadInfo;
-      wt->pool = p;
-      wt->handle = ThreadCreateEx(WorkerThread, wt, stackSize);
-      if (wt->handle != INVALID_THREAD_HANDLE)
-      {
-         p->threads.set(CAST_FROM_POINTER(wt, uint64_t), wt);
-      }
-      else
-      {
+      if (!StartWorkerThread(p))
          nxlog_debug_tag(DEBUG_TAG, 1, _T("Cannot create worker thread in pool %s"), p->name);
-         delete wt;
-      }
    }
    p->mutex.unlock();
 
@@ -396,7 +875,7 @@ ThreadPool LIBNETXMS_EXPORTABLE *ThreadPoolCreate(const TCHAR *name, int minThre
    s_registry.set(p->name, p);
    s_registryLock.unlock();
 
-   nxlog_debug_tag(DEBUG_TAG, 1, _T("Thread pool %s initialized (min=%d, max=%d)"), p->name, p->minThreads, p->maxThreads);
+   nxlog_debug_tag(DEBUG_TAG, 1, _T("Thread pool %s initialized (min=%d, max=%d%s)"), p->name, p->minThreads, p->maxThreads, p->workStealing ? _T(", work stealing") : _T(""));
    return p;
 }
 
@@ -453,10 +932,21 @@ void LIBNETXMS_EXPORTABLE ThreadPoolExecute(ThreadPool *p, ThreadPoolWorkerFunct
 
    InterlockedIncrement(&p->activeRequests);
    InterlockedIncrement64(&p->taskExecutionCount);
-   WorkRequest *rq = p->workRequestMemoryPool.create();
+   WorkRequest *rq = CreateWorkRequest(p);
    rq->func = f;
    rq->arg = arg;
    rq->queueTime = GetCurrentTimeMs();
+
+#if HAVE_THREAD_LOCAL_STORAGE
+   // Requests submitted by pool's own worker threads are placed into worker's local deque
+   WorkerThreadInfo *worker = s_currentWorker;
+   if ((worker != nullptr) && (worker->pool == p) && (worker->slot != nullptr) && worker->slot->deque.push(rq))
+   {
+      WakeIdleWorkers(p, worker->slot);
+      return;
+   }
+#endif
+
    p->queue.put(rq);
 }
 
@@ -497,7 +987,7 @@ static void ProcessSerializedRequests(RequestSerializationData *data)
       data->queue->updateMaxWaitTime(static_cast<uint32_t>(GetCurrentTimeMs() - rq->queueTime));
 
       rq->func(rq->arg);
-      data->pool->workRequestMemoryPool.destroy(rq);
+      DestroyWorkRequest(data->pool, rq);
    }
    MemFree(data);
 }
@@ -510,7 +1000,7 @@ void LIBNETXMS_EXPORTABLE ThreadPoolExecuteSerialized(ThreadPool *p, const TCHAR
    if (p->shutdownMode)
       return;
 
-   WorkRequest *rq = p->workRequestMemoryPool.create();
+   WorkRequest *rq = CreateWorkRequest(p);
    rq->func = f;
    rq->arg = arg;
    rq->queueTime = GetCurrentTimeMs();
@@ -538,6 +1028,80 @@ void LIBNETXMS_EXPORTABLE ThreadPoolExecuteSerialized(ThreadPool *p, const TCHAR
    p->serializationLock.unlock();
 }
 
+/**
+ * Get shard for given serialization key
+ */
+static inline SerializationShard *GetSerializationShard(ThreadPool *p, uint64_t key)
+{
+   // Fibonacci hashing - sequential keys (like object IDs) are spread evenly between shards
+   return &p->serializationShards[(key * _ULL(0x9E3779B97F4A7C15)) >> 58];
+}
+
+/**
+ * Worker function to process serialized requests with integer key
+ */
+static void ProcessKeyedSerializedRequests(KeyedSerializationQueue *queue)
+{
+   ThreadPool *p = queue->pool;
+   while(true)
+   {
+      WorkRequest *rq = static_cast<WorkRequest*>(queue->get());
+      if (rq == nullptr)
+      {
+         // Re-check queue with shard lock being held (see comment in ProcessSerializedRequests)
+         SerializationShard *shard = queue->shard;
+         shard->lock.lock();
+         rq = static_cast<WorkRequest*>(queue->get());
+         if (rq == nullptr)
+         {
+            shard->queues.remove(queue->key);   // Will destroy queue object
+            shard->lock.unlock();
+            break;
+         }
+         shard->lock.unlock();
+      }
+      queue->updateMaxWaitTime(static_cast<uint32_t>(GetCurrentTimeMs() - rq->queueTime));
+
+      rq->func(rq->arg);
+      DestroyWorkRequest(p, rq);
+   }
+}
+
+/**
+ * Execute task serialized with integer key (not before previous task with same key ends). Unlike string keys,
+ * integer keys are spread between multiple independently locked shards, and do not require key formatting and
+ * copying, so this variant should be preferred for high volume serialized execution (like per-object tasks).
+ */
+void LIBNETXMS_EXPORTABLE ThreadPoolExecuteSerialized(ThreadPool *p, uint64_t key, ThreadPoolWorkerFunction f, void *arg)
+{
+   if (p->shutdownMode)
+      return;
+
+   WorkRequest *rq = CreateWorkRequest(p);
+   rq->func = f;
+   rq->arg = arg;
+   rq->queueTime = GetCurrentTimeMs();
+
+   SerializationShard *shard = GetSerializationShard(p, key);
+   shard->lock.lock();
+   KeyedSerializationQueue *q = shard->queues.get(key);
+   if (q != nullptr)
+   {
+      q->put(rq);
+      shard->lock.unlock();
+      InterlockedIncrement64(&p->taskExecutionCount);
+      return;
+   }
+
+   q = new KeyedSerializationQueue(p, shard, key);
+   q->put(rq);
+   shard->queues.set(key, q);
+   shard->lock.unlock();
+
+   // Queue cannot be removed before processing task is started, so it is safe to start it outside of lock
+   ThreadPoolExecute(p, ProcessKeyedSerializedRequests, q);
+}
+
 /**
  * Schedule task for execution using absolute time (in milliseconds)
  */
@@ -546,7 +1110,7 @@ void LIBNETXMS_EXPORTABLE ThreadPoolScheduleAbsoluteMs(ThreadPool *p, int64_t ru
    if (p->shutdownMode)
       return;
 
-   WorkRequest *rq = p->workRequestMemoryPool.create();
+   WorkRequest *rq = CreateWorkRequest(p);
    rq->func = f;
    rq->arg = arg;
    rq->runTime = runTime;
@@ -589,6 +1153,8 @@ void LIBNETXMS_EXPORTABLE ThreadPoolGetInfo(ThreadPool *p, ThreadPoolInfo *info)
    info->curThreads = p->threads.size();
    info->threadStarts = p->threadStartCount;
    info->threadStops = p->threadStopCount;
+   if (p->workStealing)
+      MergeWorkerStatistics(p);
    info->activeRequests = p->activeRequests;
    info->totalRequests = p->taskExecutionCount;
    info->load = (info->curThreads > 0) ? info->activeRequests * 100 / info->curThreads : 0;
@@ -614,6 +1180,19 @@ void LIBNETXMS_EXPORTABLE ThreadPoolGetInfo(ThreadPool *p, ThreadPoolInfo *info)
    while(it.hasNext())
       info->serializedRequests += static_cast<int>(it.next()->value->size());
    p->serializationLock.unlock();
+
+   for(int i = 0; i < SERIALIZATION_SHARD_COUNT; i++)
+   {
+      SerializationShard *shard = &p->serializationShards[i];
+      shard->lock.lock();
+      shard->queues.forEach(
+         [info] (const uint64_t& key, KeyedSerializationQueue *q) -> EnumerationCallbackResult
+         {
+            info->serializedRequests += static_cast<int>(q->size());
+            return _CONTINUE;
+         });
+      shard->lock.unlock();
+   }
 }
 
 /**
@@ -663,6 +1242,19 @@ int LIBNETXMS_EXPORTABLE ThreadPoolGetSerializedRequestCount(ThreadPool *p, cons
    return count;
 }
 
+/**
+ * Get number of queued jobs on the pool by integer key
+ */
+int LIBNETXMS_EXPORTABLE ThreadPoolGetSerializedRequestCount(ThreadPool *p, uint64_t key)
+{
+   SerializationShard *shard = GetSerializationShard(p, key);
+   shard->lock.lock();
+   KeyedSerializationQueue *q = shard->queues.get(key);
+   int count = (q != nullptr) ? static_cast<int>(q->size()) : 0;
+   shard->lock.unlock();
+   return count;
+}
+
 /**
  * Get number of queued jobs on the pool by key
  */
@@ -675,6 +1267,19 @@ uint32_t LIBNETXMS_EXPORTABLE ThreadPoolGetSerializedRequestMaxWaitTime(ThreadPo
    return waitTime;
 }
 
+/**
+ * Get maximum wait time for serialized requests by integer key
+ */
+uint32_t LIBNETXMS_EXPORTABLE ThreadPoolGetSerializedRequestMaxWaitTime(ThreadPool *p, uint64_t key)
+{
+   SerializationShard *shard = GetSerializationShard(p, key);
+   shard->lock.lock();
+   KeyedSerializationQueue *q = shard->queues.get(key);
+   uint32_t waitTime = (q != nullptr) ? q->getMaxWaitTime() : 0;
+   shard->lock.unlock();
+   return waitTime;
+}
+
 /**
  * Set thread pool resize parameters - responsiveness and wait time high/low watermarks
  */
@@ -576,6 +576,7 @@ bool LogParser::monitorFile(off_t startOffset)
    bool readFromStart = (m_rescan || (startOffset == 0));
 
 	nxlog_debug_tag(DEBUG_TAG, 0, _T("Parser thread for file \"%s\" started"), m_fileName);
+	FileChangeWatch *watch = nullptr;
 	bool exclusionPeriod = false;
 	while(true)
 	{
@@ -600,13 +601,15 @@ bool LogParser::monitorFile(off_t startOffset)
 
       TCHAR fname[MAX_PATH];
       ExpandFileName(getFileName(), fname, MAX_PATH, true);
+      if (!m_followSymlinks)
+         watch = UpdateFileChangeWatch(watch, fname, &m_changeCondition);
       NX_STAT_STRUCT st;
       if (__stat(this, fname, &st) != 0)
       {
          if (errno == ENOENT)
             readFromStart = true;
          setStatus(LPS_NO_FILE);
-         if (m_stopCondition.wait(10000))
+         if (waitForFileChange(watch, 10000))
             break;
          continue;
       }
@@ -662,7 +665,7 @@ bool LogParser::monitorFile(off_t startOffset)
 
 		while(true)
 		{
-			if (m_stopCondition.wait(m_fileCheckInterval))
+			if (waitForFileChange(watch, m_fileCheckInterval))
 			{
 			   _close(fh);
 				goto stop_parser;
@@ -767,6 +770,7 @@ bool LogParser::monitorFile(off_t startOffset)
 	}
 
 stop_parser:
+   UnwatchFileChanges(watch);
    nxlog_debug_tag(DEBUG_TAG, 0, _T("Parser thread for file \"%s\" stopped"), m_fileName);
 	return true;
 }
@@ -786,6 +790,7 @@ bool LogParser::monitorFile2(off_t startOffset)
    bool firstRead = true;
 
    nxlog_debug_tag(DEBUG_TAG, 0, _T("Parser thread for file \"%s\" started (\"keep open\" option disabled)"), m_fileName);
+   FileChangeWatch *watch = nullptr;
    bool exclusionPeriod = false;
    while(true)
    {
@@ -810,6 +815,8 @@ bool LogParser::monitorFile2(off_t startOffset)
 
       TCHAR fname[MAX_PATH];
       ExpandFileName(getFileName(), fname, MAX_PATH, true);
+      if (!m_followSymlinks)
+         watch = UpdateFileChangeWatch(watch, fname, &m_changeCondition);
 
       NX_STAT_STRUCT st;
       if (__stat(this, fname, &st) != 0)
@@ -821,7 +828,7 @@ bool LogParser::monitorFile2(off_t startOffset)
             startOffset = -1;
          }
          setStatus(LPS_NO_FILE);
-         if (m_stopCondition.wait(10000))
+         if (waitForFileChange(watch, 10000))
             break;
          continue;
       }
@@ -841,7 +848,7 @@ bool LogParser::monitorFile2(off_t startOffset)
              (!m_ignoreMTime && (size == st.st_size) && (mtime == st.st_mtime)))
 #endif
          {
-            if (m_stopCondition.wait(m_fileCheckInterval))
+            if (waitForFileChange(watch, m_fileCheckInterval))
                break;
             continue;
          }
@@ -943,10 +950,11 @@ bool LogParser::monitorFile2(off_t startOffset)
       size = static_cast<size_t>(st.st_size);
       mtime = st.st_mtime;
 
-      if (m_stopCondition.wait(m_fileCheckInterval))
+      if (waitForFileChange(watch, m_fileCheckInterval))
          break;
    }
 
+   UnwatchFileChanges(watch);
    nxlog_debug_tag(DEBUG_TAG, 0, _T("Parser thread for file \"%s\" stopped"), m_fileName);
    return true;
 }
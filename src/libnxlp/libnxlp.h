@@ -30,6 +30,43 @@
 
 #define DEBUG_TAG _T("logwatch")
 
+/**
+ * Literal prefilter for log parser rules. Uses Aho-Corasick automaton built from literals
+ * required by rule regular expressions to select rules which can possibly match given line.
+ */
+class LogParserPrefilter
+{
+private:
+   int m_ruleCount;
+   int m_filteredRuleCount;
+   BYTE *m_alwaysCheck;
+   BYTE *m_candidates;
+   int m_classCount;
+   BYTE m_charClass[128];
+   int m_stateCount;
+   int32_t *m_transitions;
+   int32_t *m_firstOutput;
+   int32_t *m_nextOutput;
+   int32_t *m_outputLink;
+
+public:
+   LogParserPrefilter(const ObjectArray<LogParserRule>& rules);
+   ~LogParserPrefilter();
+
+   void selectCandidates(const TCHAR *line);
+   bool isCandidate(int ruleIndex) const { return m_candidates[ruleIndex] != 0; }
+
+   int getFilteredRuleCount() const { return m_filteredRuleCount; }
+};
+
+/**
+ * File change notifications
+ */
+FileChangeWatch *UpdateFileChangeWatch(FileChangeWatch *watch, const TCHAR *fileName, Condition *condition);
+void UnwatchFileChanges(FileChangeWatch *watch);
+bool IsFileChangeWatchActive(FileChangeWatch *watch);
+void ShutdownFileChangeWatcher();
+
 #ifdef _WIN32
 
 THREAD_RESULT THREAD_CALL ParserThreadEventLog(void *);
@@ -48,6 +48,8 @@ void LIBNXLP_EXPORTABLE CleanupLogParserLibrary()
 {
    if (InterlockedDecrement(&s_referenceCount) > 0)
       return;  // still referenced
+
+   ShutdownFileChangeWatcher();
 }
 
 #ifdef _WIN32
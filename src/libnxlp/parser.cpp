@@ -131,7 +131,7 @@ struct LogParser_XmlParserState
 /**
  * Parser default constructor
  */
-LogParser::LogParser() : m_rules(0, 16, Ownership::True), m_stopCondition(true)
+LogParser::LogParser() : m_rules(0, 16, Ownership::True), m_stopCondition(true), m_changeCondition(false)
 {
 	m_cb = nullptr;
 	m_cbAction = nullptr;
@@ -151,6 +151,8 @@ LogParser::LogParser() : m_rules(0, 16, Ownership::True), m_stopCondition(true)
 	m_recordsMatched = 0;
 	m_processAllRules = false;
    m_suspended = false;
+   m_usePrefilter = true;
+   m_prefilter = nullptr;
    m_keepFileOpen = true;
    m_ignoreMTime = false;
    m_followSymlinks = false;
@@ -168,7 +170,7 @@ LogParser::LogParser() : m_rules(0, 16, Ownership::True), m_stopCondition(true)
 /**
  * Parser copy constructor
  */
-LogParser::LogParser(const LogParser *src) : m_rules(src->m_rules.size(), 16, Ownership::True), m_stopCondition(true)
+LogParser::LogParser(const LogParser *src) : m_rules(src->m_rules.size(), 16, Ownership::True), m_stopCondition(true), m_changeCondition(false)
 {
    int count = src->m_rules.size();
 	for(int i = 0; i < count; i++)
@@ -207,6 +209,8 @@ LogParser::LogParser(const LogParser *src) : m_rules(src->m_rules.size(), 16, Ow
 	m_recordsMatched = 0;
 	m_processAllRules = src->m_processAllRules;
    m_suspended = src->m_suspended;
+   m_usePrefilter = src->m_usePrefilter;
+   m_prefilter = nullptr;
    m_keepFileOpen = src->m_keepFileOpen;
    m_ignoreMTime = src->m_ignoreMTime;
    m_followSymlinks = src->m_followSymlinks;
@@ -233,6 +237,7 @@ LogParser::~LogParser()
 #endif
    MemFree(m_readBuffer);
    MemFree(m_textBuffer);
+   delete m_prefilter;
 }
 
 /**
@@ -255,6 +260,7 @@ bool LogParser::addRule(LogParserRule *rule)
 	if (valid)
 	{
 	   m_rules.add(rule);
+	   delete_and_null(m_prefilter);  // Will be rebuilt on next match
 	}
 	else
 	{
@@ -263,6 +269,16 @@ bool LogParser::addRule(LogParserRule *rule)
 	return valid;
 }
 
+/**
+ * Enable or disable rule prefiltering
+ */
+void LogParser::setPrefilterEnabled(bool enabled)
+{
+   m_usePrefilter = enabled;
+   if (!enabled)
+      delete_and_null(m_prefilter);
+}
+
 /**
  * Check context
  */
@@ -311,6 +327,17 @@ bool LogParser::matchLogRecord(bool hasAttributes, const TCHAR *source, uint32_t
 		trace(6, _T("Match line: \"%s\""), line);
 
 	m_recordsProcessed++;
+
+	if (m_usePrefilter)
+	{
+	   if (m_prefilter == nullptr)
+	   {
+	      m_prefilter = new LogParserPrefilter(m_rules);
+	      trace(5, _T("Rule prefilter created (%d of %d rules can be prefiltered)"), m_prefilter->getFilteredRuleCount(), m_rules.size());
+	   }
+	   m_prefilter->selectCandidates(line);
+	}
+
 	int i;
 	for(i = 0; i < m_rules.size(); i++)
 	{
@@ -318,6 +345,14 @@ bool LogParser::matchLogRecord(bool hasAttributes, const TCHAR *source, uint32_t
 		trace(7, _T("checking rule %d \"%s\""), i + 1, rule->getDescription());
 		if ((state = checkContext(rule)) != nullptr)
 		{
+		   if ((m_prefilter != nullptr) && !m_prefilter->isCandidate(i))
+		   {
+		      // Required literal not found in line, so regular expression cannot match
+		      trace(7, _T("  skipped by prefilter"));
+		      rule->incCheckCount(objectId);
+		      continue;
+		   }
+
 			bool ruleMatched = hasAttributes ?
 			   rule->matchEx(source, eventId, level, line, variables, recordId, objectId, timestamp, logName, m_cb, m_cbDataPush, m_cbAction, m_userData) :
 				rule->match(line, objectId, m_cb, m_cbDataPush, m_cbAction, logName, m_userData);
@@ -1131,6 +1166,7 @@ bool LogParser::isExclusionPeriod()
 void LogParser::stop()
 {
    m_stopCondition.set();
+   m_changeCondition.set();
    ThreadJoin(m_thread);
    m_thread = INVALID_THREAD_HANDLE;
 }
@@ -1141,6 +1177,7 @@ void LogParser::stop()
 void LogParser::suspend()
 {
    m_suspended = true;
+   m_changeCondition.set();
 }
 
 /**
@@ -1149,6 +1186,7 @@ void LogParser::suspend()
 void LogParser::resume()
 {
    m_suspended = false;
+   m_changeCondition.set();
 }
 
 /**
@@ -0,0 +1,401 @@
+/*
+** NetXMS - Network Management System
+** Log Parsing Library
+** Copyright (C) 2003-2024 Raden Solutions
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as published by
+** the Free Software Foundation; either version 3 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** File: prefilter.cpp
+**
+**/
+
+#include "libnxlp.h"
+
+/**
+ * Minimal length of literal to be used for prefiltering (shorter literals are too common to be useful)
+ */
+#define MIN_LITERAL_LENGTH    3
+
+/**
+ * Maximum length of literal used for prefiltering (any substring of required literal is also required)
+ */
+#define MAX_LITERAL_LENGTH    16
+
+/**
+ * Convert ASCII character to lower case
+ */
+static inline char ToLowerASCII(uint32_t ch)
+{
+   return ((ch >= 'A') && (ch <= 'Z')) ? static_cast<char>(ch + ('a' - 'A')) : static_cast<char>(ch);
+}
+
+/**
+ * Skip character class starting at given position (p should point to opening bracket).
+ * Returns pointer to first character after class or nullptr if class is not terminated.
+ */
+static const TCHAR *SkipCharacterClass(const TCHAR *p)
+{
+   p++;
+   if (*p == _T('^'))
+      p++;
+   if (*p == _T(']'))
+      p++;
+   while(*p != 0)
+   {
+      if (*p == _T(']'))
+         return p + 1;
+      if ((*p == _T('\\')) && (p[1] != 0))
+      {
+         p += 2;
+      }
+      else if ((*p == _T('[')) && (p[1] == _T(':')))
+      {
+         const TCHAR *e = _tcsstr(p + 2, _T(":]"));
+         if (e == nullptr)
+            return nullptr;
+         p = e + 2;
+      }
+      else
+      {
+         p++;
+      }
+   }
+   return nullptr;
+}
+
+/**
+ * Skip group starting at given position (p should point to opening parenthesis).
+ * Returns pointer to first character after group or nullptr if group is not terminated.
+ */
+static const TCHAR *SkipGroup(const TCHAR *p)
+{
+   int depth = 0;
+   while(*p != 0)
+   {
+      if ((*p == _T('\\')) && (p[1] != 0))
+      {
+         p += 2;
+      }
+      else if (*p == _T('['))
+      {
+         p = SkipCharacterClass(p);
+         if (p == nullptr)
+            return nullptr;
+      }
+      else
+      {
+         if (*p == _T('('))
+         {
+            depth++;
+         }
+         else if (*p == _T(')'))
+         {
+            depth--;
+            if (depth == 0)
+               return p + 1;
+         }
+         p++;
+      }
+   }
+   return nullptr;
+}
+
+/**
+ * Extract longest literal which must be present in any string matched by given regular expression.
+ * Literal is converted to lower case, and only ASCII characters are considered. Returns length of
+ * extracted literal or 0 if suitable literal cannot be found. Analysis is conservative - any construct
+ * which is not fully understood causes rule to be excluded from prefiltering.
+ */
+static int ExtractRequiredLiteral(const TCHAR *regexp, char *literal)
+{
+   char current[MAX_LITERAL_LENGTH];
+   int currLen = 0, bestLen = 0;
+   bool lastIsLiteral = false;   // true if last atom was literal character added to current run
+
+   auto flush = [&] () -> void
+   {
+      if (currLen > bestLen)
+      {
+         memcpy(literal, current, currLen);
+         bestLen = currLen;
+      }
+      currLen = 0;
+      lastIsLiteral = false;
+   };
+
+   auto addChar = [&] (uint32_t ch) -> void
+   {
+      if ((ch < 32) || (ch > 126))
+      {
+         flush();
+         return;
+      }
+      if (currLen < MAX_LITERAL_LENGTH)
+      {
+         current[currLen++] = ToLowerASCII(ch);
+         lastIsLiteral = true;
+      }
+      else
+      {
+         // Run is long enough, just finish it
+         flush();
+      }
+   };
+
+   const TCHAR *p = regexp;
+   while(*p != 0)
+   {
+      switch(*p)
+      {
+         case _T('\\'):
+            if (p[1] == 0)
+               return 0;
+            if (_istalnum(p[1]))
+            {
+               // Escapes with additional characters (like \x41 or \p{L}) or quoting - give up
+               if (_tcschr(_T("QEceopPxNgk0123456789"), p[1]) != nullptr)
+                  return 0;
+               flush();
+            }
+            else
+            {
+               addChar(static_cast<uint32_t>(p[1]));
+            }
+            p += 2;
+            break;
+         case _T('['):
+            flush();
+            p = SkipCharacterClass(p);
+            if (p == nullptr)
+               return 0;
+            break;
+         case _T('('):
+            // Inline option settings and verbs may change meaning of the rest of the pattern
+            if ((p[1] == _T('*')) || ((p[1] == _T('?')) && (_tcschr(_T("imsxXUJ-"), p[2]) != nullptr)))
+               return 0;
+            flush();
+            p = SkipGroup(p);
+            if (p == nullptr)
+               return 0;
+            break;
+         case _T(')'):
+         case _T('|'):
+            return 0;   // Unbalanced parenthesis or top level alternation
+         case _T('?'):
+         case _T('*'):
+            // Preceding character is optional
+            if (lastIsLiteral)
+               currLen--;
+            flush();
+            p++;
+            break;
+         case _T('+'):
+            // Preceding character is required but can be repeated
+            flush();
+            p++;
+            break;
+         case _T('{'):
+            if (lastIsLiteral)
+               currLen--;
+            flush();
+            while((*p != 0) && (*p != _T('}')))
+               p++;
+            if (*p != 0)
+               p++;
+            break;
+         case _T('.'):
+         case _T('^'):
+         case _T('$'):
+            flush();
+            p++;
+            break;
+         default:
+            addChar(static_cast<uint32_t>(*p));
+            p++;
+            break;
+      }
+   }
+   flush();
+   return (bestLen >= MIN_LITERAL_LENGTH) ? bestLen : 0;
+}
+
+/**
+ * Build prefilter for given rule set
+ */
+LogParserPrefilter::LogParserPrefilter(const ObjectArray<LogParserRule>& rules)
+{
+   m_ruleCount = rules.size();
+   m_alwaysCheck = MemAllocArray<BYTE>(m_ruleCount);
+   m_candidates = MemAllocArray<BYTE>(m_ruleCount);
+   m_nextOutput = MemAllocArray<int32_t>(m_ruleCount);
+   m_filteredRuleCount = 0;
+
+   // Extract literals and build character classes (class 0 is for all characters not present in any literal)
+   char *literals = MemAllocArray<char>(m_ruleCount * MAX_LITERAL_LENGTH);
+   int *literalLengths = MemAllocArray<int>(m_ruleCount);
+   memset(m_charClass, 0, sizeof(m_charClass));
+   m_classCount = 1;
+   for(int i = 0; i < m_ruleCount; i++)
+   {
+      LogParserRule *rule = rules.get(i);
+      m_nextOutput[i] = -1;
+      literalLengths[i] = rule->isInverted() ? 0 : ExtractRequiredLiteral(rule->getRegexpSource(), &literals[i * MAX_LITERAL_LENGTH]);
+      if (literalLengths[i] == 0)
+      {
+         m_alwaysCheck[i] = 1;
+         continue;
+      }
+
+      m_filteredRuleCount++;
+      for(int j = 0; j < literalLengths[i]; j++)
+      {
+         BYTE ch = static_cast<BYTE>(literals[i * MAX_LITERAL_LENGTH + j]);
+         if (m_charClass[ch] == 0)
+            m_charClass[ch] = static_cast<BYTE>(m_classCount++);
+      }
+   }
+
+   // Build trie
+   IntegerArray<int32_t> transitions(1024, 1024);
+   IntegerArray<int32_t> firstOutput(256, 256);
+   for(int c = 0; c < m_classCount; c++)
+      transitions.add(-1);
+   firstOutput.add(-1);
+   int stateCount = 1;
+   for(int i = 0; i < m_ruleCount; i++)
+   {
+      int state = 0;
+      for(int j = 0; j < literalLengths[i]; j++)
+      {
+         int c = m_charClass[static_cast<BYTE>(literals[i * MAX_LITERAL_LENGTH + j])];
+         int next = transitions.get(state * m_classCount + c);
+         if (next == -1)
+         {
+            next = stateCount++;
+            transitions.set(state * m_classCount + c, next);
+            for(int k = 0; k < m_classCount; k++)
+               transitions.add(-1);
+            firstOutput.add(-1);
+         }
+         state = next;
+      }
+      if (literalLengths[i] > 0)
+      {
+         // Keep rules in each output list in ascending order
+         if (firstOutput.get(state) == -1)
+         {
+            firstOutput.set(state, i);
+         }
+         else
+         {
+            int r = firstOutput.get(state);
+            while(m_nextOutput[r] != -1)
+               r = m_nextOutput[r];
+            m_nextOutput[r] = i;
+         }
+      }
+   }
+   MemFree(literals);
+   MemFree(literalLengths);
+
+   // Convert trie into DFA (Aho-Corasick) using breadth-first traversal
+   m_stateCount = stateCount;
+   m_transitions = MemCopyArray(transitions.getBuffer(), stateCount * m_classCount);
+   m_firstOutput = MemCopyArray(firstOutput.getBuffer(), stateCount);
+   m_outputLink = MemAllocArray<int32_t>(stateCount);
+   int32_t *fail = MemAllocArray<int32_t>(stateCount);
+   int32_t *queue = MemAllocArray<int32_t>(stateCount);
+   int head = 0, tail = 0;
+   for(int c = 0; c < m_classCount; c++)
+   {
+      int32_t t = m_transitions[c];
+      if (t == -1)
+      {
+         m_transitions[c] = 0;
+      }
+      else
+      {
+         fail[t] = 0;
+         m_outputLink[t] = -1;
+         queue[tail++] = t;
+      }
+   }
+   m_outputLink[0] = -1;
+   while(head < tail)
+   {
+      int32_t s = queue[head++];
+      for(int c = 0; c < m_classCount; c++)
+      {
+         int32_t t = m_transitions[s * m_classCount + c];
+         int32_t ft = m_transitions[fail[s] * m_classCount + c];
+         if (t == -1)
+         {
+            m_transitions[s * m_classCount + c] = ft;
+         }
+         else
+         {
+            fail[t] = ft;
+            m_outputLink[t] = (m_firstOutput[ft] != -1) ? ft : m_outputLink[ft];
+            queue[tail++] = t;
+         }
+      }
+   }
+   MemFree(fail);
+   MemFree(queue);
+}
+
+/**
+ * Destructor
+ */
+LogParserPrefilter::~LogParserPrefilter()
+{
+   MemFree(m_alwaysCheck);
+   MemFree(m_candidates);
+   MemFree(m_nextOutput);
+   MemFree(m_transitions);
+   MemFree(m_firstOutput);
+   MemFree(m_outputLink);
+}
+
+/**
+ * Select candidate rules for given line. After this call isCandidate() can be used to check if rule
+ * can possibly match given line.
+ */
+void LogParserPrefilter::selectCandidates(const TCHAR *line)
+{
+   memcpy(m_candidates, m_alwaysCheck, m_ruleCount);
+   if (m_filteredRuleCount == 0)
+      return;
+
+   int32_t state = 0;
+   for(const TCHAR *p = line; *p != 0; p++)
+   {
+      uint32_t ch = static_cast<uint32_t>(*p);
+#ifdef UNICODE
+      // Non-ASCII characters which are matched by ASCII letters in caseless Unicode mode
+      if (ch == 0x212A)
+         ch = 'k';   // Kelvin sign
+      else if (ch == 0x017F)
+         ch = 's';   // Latin small letter long s
+#endif
+      int c = (ch < 128) ? m_charClass[static_cast<BYTE>(ToLowerASCII(ch))] : 0;
+      state = m_transitions[state * m_classCount + c];
+      for(int32_t s = (m_firstOutput[state] != -1) ? state : m_outputLink[state]; s > 0; s = m_outputLink[s])
+      {
+         for(int32_t r = m_firstOutput[s]; r != -1; r = m_nextOutput[r])
+            m_candidates[r] = 1;
+      }
+   }
+}
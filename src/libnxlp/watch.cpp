@@ -0,0 +1,442 @@
+/*
+** NetXMS - Network Management System
+** Log Parsing Library
+** Copyright (C) 2003-2024 Raden Solutions
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as published by
+** the Free Software Foundation; either version 3 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** File: watch.cpp
+**
+**/
+
+#include "libnxlp.h"
+
+/**
+ * Interval for re-checking file when change notifications are available (milliseconds). Used as
+ * safety net in case some notification was lost and to catch exclusion period changes.
+ */
+#define FILE_CHANGE_FALLBACK_INTERVAL  30000
+
+#if HAVE_SYS_INOTIFY_H
+
+#include <sys/inotify.h>
+#include <sys/vfs.h>
+#include <poll.h>
+
+struct DirectoryWatch;
+
+/**
+ * File change watch
+ */
+struct FileChangeWatch
+{
+   DirectoryWatch *directory;
+   TCHAR *fileName;
+   char *path;
+   const char *name;    // File name part of path
+   Condition *condition;
+};
+
+/**
+ * Directory watch (one inotify watch is used for all monitored files within directory)
+ */
+struct DirectoryWatch
+{
+   int wd;
+   char *path;
+   ObjectArray<FileChangeWatch> files;
+
+   DirectoryWatch(int _wd, const char *_path) : files(0, 16, Ownership::False)
+   {
+      wd = _wd;
+      path = MemCopyStringA(_path);
+   }
+
+   ~DirectoryWatch()
+   {
+      MemFree(path);
+   }
+
+   void detachFiles()
+   {
+      for(int i = 0; i < files.size(); i++)
+      {
+         FileChangeWatch *f = files.get(i);
+         f->directory = nullptr;
+         f->condition->set();
+      }
+      files.clear();
+   }
+};
+
+/**
+ * Watcher state
+ */
+static Mutex s_watchLock(MutexType::FAST);
+static int s_inotifyFd = -1;
+static THREAD s_watchThread = INVALID_THREAD_HANDLE;
+static bool s_watchThreadStop = false;
+static ObjectArray<DirectoryWatch> s_directories(0, 16, Ownership::True);
+
+/**
+ * Events monitored on directories
+ */
+#define DIRECTORY_WATCH_MASK (IN_MODIFY | IN_ATTRIB | IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR)
+
+/**
+ * Check if file system is remote (inotify does not report changes made by other hosts on such file systems)
+ */
+static bool IsRemoteFileSystem(const struct statfs& fs)
+{
+   switch(static_cast<uint32_t>(fs.f_type))
+   {
+      case 0x00006969:  // NFS
+      case 0x0000517B:  // SMB
+      case 0xFF534D42:  // CIFS
+      case 0xFE534D42:  // SMB2
+      case 0x65735546:  // FUSE
+      case 0x00C36400:  // Ceph
+      case 0x5346414F:  // AFS
+      case 0x01021997:  // 9P
+      case 0x47504653:  // GPFS
+      case 0x0BD00BD0:  // Lustre
+         return true;
+      default:
+         return false;
+   }
+}
+
+/**
+ * Find directory watch by descriptor (watch lock must be held)
+ */
+static DirectoryWatch *FindDirectoryWatch(int wd)
+{
+   for(int i = 0; i < s_directories.size(); i++)
+   {
+      DirectoryWatch *d = s_directories.get(i);
+      if (d->wd == wd)
+         return d;
+   }
+   return nullptr;
+}
+
+/**
+ * Find directory watch by path (watch lock must be held)
+ */
+static DirectoryWatch *FindDirectoryWatch(const char *path)
+{
+   for(int i = 0; i < s_directories.size(); i++)
+   {
+      DirectoryWatch *d = s_directories.get(i);
+      if (!strcmp(d->path, path))
+         return d;
+   }
+   return nullptr;
+}
+
+/**
+ * Process single inotify event (watch lock must be held)
+ */
+static void ProcessWatchEvent(const struct inotify_event *event)
+{
+   if (event->mask & IN_Q_OVERFLOW)
+   {
+      // Some events were lost, wake up all parsers
+      nxlog_debug_tag(DEBUG_TAG, 4, _T("File change notification queue overflow"));
+      for(int i = 0; i < s_directories.size(); i++)
+      {
+         DirectoryWatch *d = s_directories.get(i);
+         for(int j = 0; j < d->files.size(); j++)
+            d->files.get(j)->condition->set();
+      }
+      return;
+   }
+
+   DirectoryWatch *d = FindDirectoryWatch(event->wd);
+   if (d == nullptr)
+      return;
+
+   if (event->mask & (IN_IGNORED | IN_DELETE_SELF | IN_MOVE_SELF))
+   {
+      // Directory was deleted, moved, or unmounted - parsers will register new watch when file re-appears
+      nxlog_debug_tag(DEBUG_TAG, 5, _T("Watched directory %hs removed or moved"), d->path);
+      d->detachFiles();
+      if (!(event->mask & IN_IGNORED))
+         inotify_rm_watch(s_inotifyFd, d->wd);
+      s_directories.remove(d);
+      return;
+   }
+
+   for(int i = 0; i < d->files.size(); i++)
+   {
+      FileChangeWatch *f = d->files.get(i);
+      if ((event->len == 0) || !strcmp(f->name, event->name))
+         f->condition->set();
+   }
+}
+
+/**
+ * File change watcher thread
+ */
+static void FileChangeWatcherThread()
+{
+   ThreadSetName("LogFileWatcher");
+   nxlog_debug_tag(DEBUG_TAG, 3, _T("Log file change watcher started"));
+
+   alignas(struct inotify_event) char buffer[16384];
+   while(!s_watchThreadStop)
+   {
+      struct pollfd pfd;
+      pfd.fd = s_inotifyFd;
+      pfd.events = POLLIN;
+      pfd.revents = 0;
+      int rc = poll(&pfd, 1, 1000);
+      if (rc <= 0)
+      {
+         if ((rc < 0) && (errno != EINTR))
+            ThreadSleepMs(100);
+         continue;
+      }
+
+      ssize_t bytes = read(s_inotifyFd, buffer, sizeof(buffer));
+      if (bytes <= 0)
+         continue;
+
+      s_watchLock.lock();
+      for(char *p = buffer; p < buffer + bytes;)
+      {
+         const struct inotify_event *event = reinterpret_cast<const struct inotify_event*>(p);
+         ProcessWatchEvent(event);
+         p += sizeof(struct inotify_event) + event->len;
+      }
+      s_watchLock.unlock();
+   }
+
+   nxlog_debug_tag(DEBUG_TAG, 3, _T("Log file change watcher stopped"));
+}
+
+/**
+ * Start watching for changes in given file. Returns nullptr if change notifications are not available for that file.
+ * Watch lock must be held.
+ */
+static FileChangeWatch *WatchFileChanges(const TCHAR *fileName, Condition *condition)
+{
+#ifdef UNICODE
+   char *path = MBStringFromWideStringSysLocale(fileName);
+#else
+   char *path = MemCopyStringA(fileName);
+#endif
+   char *s = strrchr(path, '/');
+   if ((s == nullptr) || (s[1] == 0))
+   {
+      MemFree(path);
+      return nullptr;
+   }
+
+   char directory[MAX_PATH];
+   strlcpy(directory, path, std::min(static_cast<size_t>((s == path) ? 2 : s - path + 1), static_cast<size_t>(MAX_PATH)));
+
+   struct statfs fs;
+   if (statfs(directory, &fs) != 0)
+   {
+      MemFree(path);
+      return nullptr;
+   }
+   if (IsRemoteFileSystem(fs))
+   {
+      nxlog_debug_tag(DEBUG_TAG, 5, _T("Directory %hs is on remote file system, change notifications will not be used"), directory);
+      MemFree(path);
+      return nullptr;
+   }
+
+   if (s_inotifyFd == -1)
+   {
+      s_inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+      if (s_inotifyFd == -1)
+      {
+         nxlog_debug_tag(DEBUG_TAG, 3, _T("Cannot initialize inotify (%s), file change notifications will not be used"), _tcserror(errno));
+         MemFree(path);
+         return nullptr;
+      }
+      s_watchThreadStop = false;
+      s_watchThread = ThreadCreateEx(FileChangeWatcherThread);
+   }
+
+   DirectoryWatch *d = FindDirectoryWatch(directory);
+   if (d == nullptr)
+   {
+      int wd = inotify_add_watch(s_inotifyFd, directory, DIRECTORY_WATCH_MASK);
+      if (wd == -1)
+      {
+         nxlog_debug_tag(DEBUG_TAG, 5, _T("Cannot add inotify watch for directory %hs (%s)"), directory, _tcserror(errno));
+         MemFree(path);
+         return nullptr;
+      }
+
+      // Same directory could be already watched under different path (kernel returns same descriptor in that case)
+      d = FindDirectoryWatch(wd);
+      if (d == nullptr)
+      {
+         d = new DirectoryWatch(wd, directory);
+         s_directories.add(d);
+         nxlog_debug_tag(DEBUG_TAG, 5, _T("Watching directory %hs for changes"), directory);
+      }
+   }
+
+   FileChangeWatch *watch = new FileChangeWatch();
+   watch->directory = d;
+   watch->fileName = MemCopyString(fileName);
+   watch->path = path;
+   watch->name = path + (s - path) + 1;
+   watch->condition = condition;
+   d->files.add(watch);
+   return watch;
+}
+
+/**
+ * Stop watching for changes (watch lock must be held)
+ */
+static void RemoveFileChangeWatch(FileChangeWatch *watch)
+{
+   DirectoryWatch *d = watch->directory;
+   if (d != nullptr)
+   {
+      d->files.remove(watch);
+      if (d->files.isEmpty())
+      {
+         inotify_rm_watch(s_inotifyFd, d->wd);
+         s_directories.remove(d);
+      }
+   }
+   MemFree(watch->fileName);
+   MemFree(watch->path);
+   delete watch;
+}
+
+/**
+ * Make sure that change watch is registered for given file. Existing watch is replaced if it was
+ * created for different file or is no longer active. Returns nullptr if change notifications are not
+ * available for given file.
+ */
+FileChangeWatch *UpdateFileChangeWatch(FileChangeWatch *watch, const TCHAR *fileName, Condition *condition)
+{
+   s_watchLock.lock();
+   if (watch != nullptr)
+   {
+      if ((watch->directory != nullptr) && !_tcscmp(watch->fileName, fileName))
+      {
+         s_watchLock.unlock();
+         return watch;
+      }
+      RemoveFileChangeWatch(watch);
+   }
+   watch = WatchFileChanges(fileName, condition);
+   s_watchLock.unlock();
+   return watch;
+}
+
+/**
+ * Stop watching for file changes
+ */
+void UnwatchFileChanges(FileChangeWatch *watch)
+{
+   if (watch == nullptr)
+      return;
+
+   s_watchLock.lock();
+   RemoveFileChangeWatch(watch);
+   s_watchLock.unlock();
+}
+
+/**
+ * Check if file change watch is still active
+ */
+bool IsFileChangeWatchActive(FileChangeWatch *watch)
+{
+   s_watchLock.lock();
+   bool active = (watch->directory != nullptr);
+   s_watchLock.unlock();
+   return active;
+}
+
+/**
+ * Shutdown file change watcher
+ */
+void ShutdownFileChangeWatcher()
+{
+   if (s_inotifyFd == -1)
+      return;
+
+   s_watchThreadStop = true;
+   ThreadJoin(s_watchThread);
+   s_watchThread = INVALID_THREAD_HANDLE;
+
+   s_watchLock.lock();
+   for(int i = 0; i < s_directories.size(); i++)
+      s_directories.get(i)->detachFiles();
+   s_directories.clear();
+   close(s_inotifyFd);
+   s_inotifyFd = -1;
+   s_watchLock.unlock();
+}
+
+#else /* HAVE_SYS_INOTIFY_H */
+
+/**
+ * Change notifications are not supported on this platform
+ */
+FileChangeWatch *UpdateFileChangeWatch(FileChangeWatch *watch, const TCHAR *fileName, Condition *condition)
+{
+   return nullptr;
+}
+
+/**
+ * Stop watching for file changes (stub)
+ */
+void UnwatchFileChanges(FileChangeWatch *watch)
+{
+}
+
+/**
+ * Check if file change watch is still active (stub)
+ */
+bool IsFileChangeWatchActive(FileChangeWatch *watch)
+{
+   return false;
+}
+
+/**
+ * Shutdown file change watcher (stub)
+ */
+void ShutdownFileChangeWatcher()
+{
+}
+
+#endif /* HAVE_SYS_INOTIFY_H */
+
+/**
+ * Wait for file change notification (if available) or given timeout. Returns true if parser stop was requested.
+ */
+bool LogParser::waitForFileChange(FileChangeWatch *watch, uint32_t timeout)
+{
+   if ((watch == nullptr) || !IsFileChangeWatchActive(watch))
+      return m_stopCondition.wait(timeout);
+
+   // File name with macros can change over time, so it should be re-evaluated at normal interval
+   if ((_tcschr(m_fileName, _T('%')) == nullptr) && (_tcschr(m_fileName, _T('`')) == nullptr))
+      timeout = std::max(timeout, static_cast<uint32_t>(FILE_CHANGE_FALLBACK_INTERVAL));
+   m_changeCondition.wait(timeout);
+   return m_stopCondition.wait(0);
+}
@@ -73,6 +73,7 @@ NXSL_Class::NXSL_Class() : m_metadataLock(MutexType::FAST)
 {
    setName(_T("Object"));
    m_methods = new HashMap<NXSL_Identifier, NXSL_ExtMethod>(Ownership::True);
+   m_attributeGetters = new HashMap<NXSL_Identifier, NXSL_ExtAttribute>(Ownership::True);
 
    NXSL_REGISTER_METHOD(Object, __get, 1);
    NXSL_REGISTER_METHOD(Object, __invoke, -1);
@@ -91,6 +92,7 @@ NXSL_Class::NXSL_Class() : m_metadataLock(MutexType::FAST)
 NXSL_Class::~NXSL_Class()
 {
    delete m_methods;
+   delete m_attributeGetters;
 }
 
 /**
@@ -104,10 +106,15 @@ void NXSL_Class::setName(const TCHAR *name)
 
 /**
  * Get attribute
- * Default implementation always returns error
+ * Default implementation handles attributes registered with NXSL_REGISTER_ATTRIBUTE macro.
+ * Because derived classes call this method first, registered attributes are resolved
+ * with single hash lookup without walking attribute comparison chains.
  */
 NXSL_Value *NXSL_Class::getAttr(NXSL_Object *object, const NXSL_Identifier& attr)
 {
+   NXSL_ExtAttribute *getter = m_attributeGetters->get(attr);
+   if (getter != nullptr)
+      return getter->handler(object, object->vm());
    if (NXSL_COMPARE_ATTRIBUTE_NAME("__class"))
       return object->vm()->createValue(object->vm()->createObject(&g_nxslMetaClass, object->getClass()));
    return nullptr;
@@ -136,6 +143,16 @@ void NXSL_Class::scanAttributes()
       if (v != nullptr)
          vm.destroyValue(v);
       vm.destroyObject(object);
+      m_attributeGetters->forEach(
+         [this] (const NXSL_Identifier& name, NXSL_ExtAttribute *getter) -> EnumerationCallbackResult
+         {
+#ifdef UNICODE
+            m_attributes.addPreallocated(WideStringFromUTF8String(name.value));
+#else
+            m_attributes.add(name.value);
+#endif
+            return _CONTINUE;
+         });
    }
    m_metadataLock.unlock();
 }
@@ -77,11 +77,11 @@ void NXSL_Instruction::dispose(NXSL_ValueManager *vm)
 }
 
 /**
- * Get operand type for instruction
+ * Get operand type for given opcode
  */
-OperandType NXSL_Instruction::getOperandType() const
+OperandType NXSL_Instruction::getOperandType(int16_t opCode)
 {
-   switch(m_opCode)
+   switch(opCode)
    {
       case OPCODE_ARRAY:
       case OPCODE_BIND:
@@ -144,34 +144,3 @@ OperandType NXSL_Instruction::getOperandType() const
          return OP_TYPE_NONE;
    }
 }
-
-/**
- * Restore variable reference
- */
-void NXSL_Instruction::restoreVariableReference(NXSL_Identifier *identifier)
-{
-   switch(m_opCode)
-   {
-      case OPCODE_PUSH_VARPTR:
-         m_opCode = (m_addr2 == INVALID_ADDRESS) ? OPCODE_PUSH_VARIABLE : OPCODE_PUSH_EXPRVAR;
-         break;
-      case OPCODE_SET_VARPTR:
-         m_opCode = OPCODE_SET;
-         break;
-      case OPCODE_INC_VARPTR:
-         m_opCode = OPCODE_INC;
-         break;
-      case OPCODE_DEC_VARPTR:
-         m_opCode = OPCODE_DEC;
-         break;
-      case OPCODE_INCP_VARPTR:
-         m_opCode = OPCODE_INCP;
-         break;
-      case OPCODE_DECP_VARPTR:
-         m_opCode = OPCODE_DECP;
-         break;
-      default:
-         break;
-   }
-   m_operand.m_identifier = identifier;
-}
@@ -29,6 +29,7 @@
 #include <nxcpapi.h>
 #include <nxsl.h>
 #include <nxqueue.h>
+#include <netxms-regex.h>
 
 union YYSTYPE;
 typedef void *yyscan_t;
@@ -195,6 +196,22 @@ enum OperandType
    OP_TYPE_UINT64 = 9
 };
 
+/**
+ * Instruction's operand
+ */
+union NXSL_InstructionOperand
+{
+   NXSL_Value *m_constant;
+   NXSL_Identifier *m_identifier;
+   NXSL_Variable *m_variable;
+   const NXSL_ExtFunction *m_function;
+   uint32_t m_addr;
+   int32_t m_valueInt32;
+   uint32_t m_valueUInt32;
+   int64_t m_valueInt64;
+   uint64_t m_valueUInt64;
+};
+
 /**
  * Single execution instruction
  */
@@ -203,24 +220,57 @@ struct NXSL_Instruction
    int16_t m_opCode;
    int16_t m_stackItems;
    uint32_t m_addr2;   // Second address
-   union
-   {
-      NXSL_Value *m_constant;
-      NXSL_Identifier *m_identifier;
-      NXSL_Variable *m_variable;
-      const NXSL_ExtFunction *m_function;
-      uint32_t m_addr;
-      int32_t m_valueInt32;
-      uint32_t m_valueUInt32;
-      int64_t m_valueInt64;
-      uint64_t m_valueUInt64;
-   } m_operand;
+   NXSL_InstructionOperand m_operand;
    int32_t m_sourceLine;
 
-   OperandType getOperandType() const;
+   OperandType getOperandType() const { return getOperandType(m_opCode); }
    void copyFrom(const NXSL_Instruction *src, NXSL_ValueManager *vm);
    void dispose(NXSL_ValueManager *vm);
-   void restoreVariableReference(NXSL_Identifier *identifier);
+
+   static OperandType getOperandType(int16_t opCode);
+};
+
+/**
+ * Per-VM replacement for instruction from shared program image. Used for
+ * converting name based access to direct pointers and for holding VM-local
+ * copies of constants. Patch with opcode OPCODE_NOP is not active.
+ */
+struct NXSL_InstructionPatch
+{
+   int16_t m_opCode;
+   NXSL_InstructionOperand m_operand;
+};
+
+/**
+ * Inline cache entry for attribute access instruction. Holds attribute getter resolved
+ * for the class of last object accessed by that instruction (or nullptr if attribute
+ * is not registered for that class and should be resolved by calling getAttr).
+ */
+struct NXSL_AttributeCacheEntry
+{
+   const NXSL_Class *nxslClass;
+   const NXSL_ExtAttribute *getter;
+};
+
+/**
+ * Compiled program code. Image is immutable after creation and is shared
+ * between program object and all VMs that were loaded with that program.
+ */
+class NXSL_ProgramImage : public NXSL_ValueManager
+{
+public:
+   StructArray<NXSL_Instruction> m_instructionSet;
+
+   NXSL_ProgramImage(size_t valueRegionSize = 0, size_t identifierRegionSize = 0, int initialSize = 0) :
+            NXSL_ValueManager(valueRegionSize, identifierRegionSize), m_instructionSet(initialSize, 256) { }
+   virtual ~NXSL_ProgramImage();
+
+   const NXSL_Instruction *getCode() const { return m_instructionSet.getBuffer(); }
+   uint32_t getCodeSize() const { return static_cast<uint32_t>(m_instructionSet.size()); }
+   size_t getValueCount() const { return m_values.getElementCount(); }
+   size_t getIdentifierCount() const { return m_identifiers.getElementCount(); }
+
+   virtual uint64_t getMemoryUsage() const override;
 };
 
 /**
@@ -412,6 +462,24 @@ class NXSL_Compiler
 	int getIdentifierOperation() { return m_idOpCode; }
 };
 
+/**
+ * Compiled regular expression. Instances are immutable and shared between VMs through process-wide cache.
+ */
+class NXSL_CompiledRegexp
+{
+private:
+   PCRE *m_preg;
+   PCRE_EXTRA_T *m_extra;   // Study data (JIT compiled code if available)
+
+public:
+   NXSL_CompiledRegexp(PCRE *preg);
+   ~NXSL_CompiledRegexp();
+
+   int match(const TCHAR *subject, size_t length, int *ovector, int ovecsize) const;
+};
+
+shared_ptr<NXSL_CompiledRegexp> GetCompiledRegexp(const TCHAR *pattern, bool ignoreCase);
+
 /**
  * Class registry
  */
@@ -628,6 +628,17 @@ void NXSL_ProgramBuilder::optimize()
          removeInstructions(i + 1, 1);
       }
    }
+   // Pre-compile constant regular expressions used by match operators (compiled patterns are kept in process-wide cache)
+   for(i = 0; (m_instructionSet.size() > 1) && (i < m_instructionSet.size() - 1); i++)
+   {
+      NXSL_Instruction *instr = m_instructionSet.get(i);
+      int16_t nextOpCode = m_instructionSet.get(i + 1)->m_opCode;
+      if ((instr->m_opCode == OPCODE_PUSH_CONSTANT) && (instr->m_operand.m_constant->getDataType() == NXSL_DT_STRING) &&
+          ((nextOpCode == OPCODE_MATCH) || (nextOpCode == OPCODE_IMATCH)))
+      {
+         GetCompiledRegexp(instr->m_operand.m_constant->getValueAsCString(), nextOpCode == OPCODE_IMATCH);
+      }
+   }
 }
 
 /**
@@ -705,11 +716,28 @@ uint64_t NXSL_ProgramBuilder::getMemoryUsage() const
    return mem;
 }
 
+/**
+ * Program image destructor
+ */
+NXSL_ProgramImage::~NXSL_ProgramImage()
+{
+   for(int i = 0; i < m_instructionSet.size(); i++)
+      m_instructionSet.get(i)->dispose(this);
+}
+
+/**
+ * Get estimated memory usage of program image
+ */
+uint64_t NXSL_ProgramImage::getMemoryUsage() const
+{
+   return NXSL_ValueManager::getMemoryUsage() + m_instructionSet.size() * sizeof(NXSL_Instruction) + sizeof(m_instructionSet);
+}
+
 /**
  * Create empty compiled script
  */
-NXSL_Program::NXSL_Program(size_t valueRegionSize, size_t identifierRegionSize) : NXSL_ValueManager(valueRegionSize, identifierRegionSize),
-         m_instructionSet(0, 256), m_requiredModules(0, 16), m_constants(this, Ownership::True), m_functions(0, 64)
+NXSL_Program::NXSL_Program(size_t valueRegionSize, size_t identifierRegionSize) : NXSL_ValueManager(16, 4),
+         m_image(make_shared<NXSL_ProgramImage>(valueRegionSize, identifierRegionSize)), m_requiredModules(0, 16), m_constants(this, Ownership::True), m_functions(0, 64)
 {
 }
 
@@ -727,26 +755,33 @@ EnumerationCallbackResult CopyConstantsCallback(const void *key, void *value, vo
  * Create compiled script object from code builder
  */
 NXSL_Program::NXSL_Program(NXSL_ProgramBuilder *builder) :
-         NXSL_ValueManager(builder->m_values.getElementCount(), builder->m_identifiers.getElementCount()),
-         m_instructionSet(builder->m_instructionSet.size(), 256),
+         NXSL_ValueManager(std::max(static_cast<size_t>(builder->m_constants.size()), static_cast<size_t>(4)), 4),
+         m_image(make_shared<NXSL_ProgramImage>(builder->m_values.getElementCount(), builder->m_identifiers.getElementCount(), builder->m_instructionSet.size())),
          m_requiredModules(builder->m_requiredModules),
          m_importedFunctions(builder->m_importedFunctions),
          m_constants(this, Ownership::True),
          m_functions(builder->m_functions),
          m_metadata(builder->m_metadata)
 {
+   NXSL_ProgramImage *image = m_image.get();
    for(int i = 0; i < builder->m_instructionSet.size(); i++)
-      m_instructionSet.addPlaceholder()->copyFrom(builder->m_instructionSet.get(i), this);
+      image->m_instructionSet.addPlaceholder()->copyFrom(builder->m_instructionSet.get(i), image);
    builder->m_constants.forEach(CopyConstantsCallback, &m_constants);
 }
 
 /**
- * Destructor
+ * Destructor (program image will be destroyed when last VM using it is destroyed)
  */
 NXSL_Program::~NXSL_Program()
 {
-   for(int i = 0; i < m_instructionSet.size(); i++)
-      m_instructionSet.get(i)->dispose(this);
+}
+
+/**
+ * Get code size
+ */
+uint32_t NXSL_Program::getCodeSize() const
+{
+   return m_image->getCodeSize();
 }
 
 /**
@@ -754,7 +789,8 @@ NXSL_Program::~NXSL_Program()
  */
 bool NXSL_Program::isEmpty() const
 {
-   return m_instructionSet.isEmpty() || ((m_instructionSet.size() == 1) && (m_instructionSet.get(0)->m_opCode == OPCODE_RET_NULL));
+   const StructArray<NXSL_Instruction>& code = m_image->m_instructionSet;
+   return code.isEmpty() || ((code.size() == 1) && (code.get(0)->m_opCode == OPCODE_RET_NULL));
 }
 
 /**
@@ -808,8 +844,7 @@ StringList *NXSL_Program::getRequiredModules(bool withFlags) const
  */
 uint64_t NXSL_Program::getMemoryUsage() const
 {
-   uint64_t mem = NXSL_ValueManager::getMemoryUsage();
-   mem += m_instructionSet.size() * sizeof(NXSL_Instruction) + sizeof(m_instructionSet);
+   uint64_t mem = NXSL_ValueManager::getMemoryUsage() + m_image->getMemoryUsage();
    mem += m_requiredModules.size() * sizeof(NXSL_ModuleImport) + sizeof(m_requiredModules);
    mem += m_functions.size() * sizeof(NXSL_Function) + sizeof(m_functions);
    return mem;
@@ -820,7 +855,7 @@ uint64_t NXSL_Program::getMemoryUsage() const
  */
 void NXSL_Program::dump(FILE *fp) const
 {
-   NXSL_ProgramBuilder::dump(fp, m_instructionSet);
+   NXSL_ProgramBuilder::dump(fp, m_image->m_instructionSet);
 }
 
 /**
@@ -834,16 +869,17 @@ void NXSL_Program::serialize(ByteStream& s) const
    memset(&header, 0, sizeof(header));
    memcpy(header.magic, "NXSL", 4);
    header.version = NXSL_BIN_FORMAT_VERSION;
-   header.valueRegionSizeHint = htonl(static_cast<uint32_t>(m_values.getElementCount()));
-   header.identifierRegionSizeHint = htonl(static_cast<uint32_t>(m_identifiers.getElementCount()));
+   header.valueRegionSizeHint = htonl(static_cast<uint32_t>(m_image->getValueCount()));
+   header.identifierRegionSizeHint = htonl(static_cast<uint32_t>(m_image->getIdentifierCount()));
    s.write(&header, sizeof(header));
 
    // Serialize instructions
    header.codeSectionOffset = htonl((UINT32)s.pos());
+   const StructArray<NXSL_Instruction>& code = m_image->m_instructionSet;
    int i;
-   for(i = 0; i < m_instructionSet.size(); i++)
+   for(i = 0; i < code.size(); i++)
    {
-      NXSL_Instruction *instr = m_instructionSet.get(i);
+      NXSL_Instruction *instr = code.get(i);
       s.writeB(instr->m_opCode);
       s.writeB(instr->m_stackItems);
       s.writeB(instr->m_sourceLine);
@@ -950,6 +986,7 @@ NXSL_Program *NXSL_Program::load(ByteStream& s, TCHAR *errMsg, size_t errMsgSize
    header.identifierRegionSizeHint = ntohl(header.identifierRegionSizeHint);
 
    NXSL_Program *p = new NXSL_Program(MAX(header.valueRegionSizeHint, 4), MAX(header.identifierRegionSizeHint, 4));
+   NXSL_ProgramImage *image = p->m_image.get();
 
    // Load constants
    ObjectRefArray<NXSL_Value> constants(64, 64);
@@ -972,7 +1009,7 @@ NXSL_Program *NXSL_Program::load(ByteStream& s, TCHAR *errMsg, size_t errMsgSize
       int16_t opcode = s.readInt16B();
       int16_t stackItems = s.readInt16B();
       int32_t line = s.readInt32B();
-      NXSL_Instruction *instr = p->m_instructionSet.addPlaceholder();
+      NXSL_Instruction *instr = image->m_instructionSet.addPlaceholder();
       instr->m_sourceLine = line;
       instr->m_opCode = opcode;
       instr->m_stackItems = stackItems;
@@ -987,19 +1024,19 @@ NXSL_Program *NXSL_Program::load(ByteStream& s, TCHAR *errMsg, size_t errMsgSize
                NXSL_Value *v = constants.get(idx);
                if (v == nullptr)
                {
-                  _sntprintf(errMsg, errMsgSize, _T("Binary file read error (instruction %04X)"), p->m_instructionSet.size());
+                  _sntprintf(errMsg, errMsgSize, _T("Binary file read error (instruction %04X)"), image->m_instructionSet.size());
                   delete instr;
                   goto failure;
                }
-               instr->m_operand.m_constant = p->createValue(v);
+               instr->m_operand.m_constant = image->createValue(v);
             }
             break;
          case OP_TYPE_IDENTIFIER:
-            instr->m_operand.m_identifier = p->createIdentifier();
+            instr->m_operand.m_identifier = image->createIdentifier();
             instr->m_operand.m_identifier->length = s.readByte();
             if ((instr->m_operand.m_identifier->length == 0) || (instr->m_operand.m_identifier->length > MAX_IDENTIFIER_LENGTH))
             {
-               _sntprintf(errMsg, errMsgSize, _T("Binary file read error (instruction %04X)"), p->m_instructionSet.size());
+               _sntprintf(errMsg, errMsgSize, _T("Binary file read error (instruction %04X)"), image->m_instructionSet.size());
                delete instr;
                goto failure;
             }
@@ -0,0 +1,218 @@
+/*
+** NetXMS - Network Management System
+** NetXMS Scripting Language Interpreter
+** Copyright (C) 2003-2024 Victor Kirhenshtein
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as published by
+** the Free Software Foundation; either version 3 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** File: regexp.cpp
+**
+**/
+
+#include "libnxsl.h"
+
+/**
+ * Default maximum number of cached regular expressions
+ */
+#define DEFAULT_REGEXP_CACHE_SIZE   1024
+
+/**
+ * Create compiled regular expression object. Takes ownership of compiled pattern.
+ */
+NXSL_CompiledRegexp::NXSL_CompiledRegexp(PCRE *preg)
+{
+   m_preg = preg;
+#ifdef PCRE_STUDY_JIT_COMPILE
+   const char *eptr;
+   m_extra = _pcre_study_t(preg, PCRE_STUDY_JIT_COMPILE, &eptr);
+#else
+   m_extra = nullptr;
+#endif
+}
+
+/**
+ * Destructor
+ */
+NXSL_CompiledRegexp::~NXSL_CompiledRegexp()
+{
+#ifdef PCRE_STUDY_JIT_COMPILE
+   if (m_extra != nullptr)
+      _pcre_free_study_t(m_extra);
+#endif
+   _pcre_free_t(m_preg);
+}
+
+/**
+ * Match given subject against this regular expression. Return value is the same as for pcre_exec.
+ */
+int NXSL_CompiledRegexp::match(const TCHAR *subject, size_t length, int *ovector, int ovecsize) const
+{
+   return _pcre_exec_t(m_preg, m_extra, reinterpret_cast<const PCRE_TCHAR*>(subject), static_cast<int>(length), 0, 0, ovector, ovecsize);
+}
+
+/**
+ * Regular expression cache entry. Entries are linked into LRU list with most recently used entry at the head.
+ */
+struct RegexpCacheEntry
+{
+   RegexpCacheEntry *prev;
+   RegexpCacheEntry *next;
+   TCHAR *key;
+   shared_ptr<NXSL_CompiledRegexp> regexp;
+
+   ~RegexpCacheEntry()
+   {
+      MemFree(key);
+   }
+};
+
+/**
+ * Regular expression cache
+ */
+static Mutex s_cacheLock(MutexType::FAST);
+static StringObjectMap<RegexpCacheEntry> *s_cache = nullptr;
+static RegexpCacheEntry *s_lruHead = nullptr;
+static RegexpCacheEntry *s_lruTail = nullptr;
+static int s_cacheSizeLimit = DEFAULT_REGEXP_CACHE_SIZE;
+static uint64_t s_cacheHits = 0;
+static uint64_t s_cacheMisses = 0;
+
+/**
+ * Unlink entry from LRU list (cache lock must be held)
+ */
+static void UnlinkEntry(RegexpCacheEntry *e)
+{
+   if (e->prev != nullptr)
+      e->prev->next = e->next;
+   else
+      s_lruHead = e->next;
+   if (e->next != nullptr)
+      e->next->prev = e->prev;
+   else
+      s_lruTail = e->prev;
+}
+
+/**
+ * Link entry at the head of LRU list (cache lock must be held)
+ */
+static void LinkEntry(RegexpCacheEntry *e)
+{
+   e->prev = nullptr;
+   e->next = s_lruHead;
+   if (s_lruHead != nullptr)
+      s_lruHead->prev = e;
+   else
+      s_lruTail = e;
+   s_lruHead = e;
+}
+
+/**
+ * Remove least recently used entries until cache size is within limit (cache lock must be held)
+ */
+static void EnforceCacheSizeLimit()
+{
+   while((s_cache != nullptr) && (s_cache->size() > s_cacheSizeLimit) && (s_lruTail != nullptr))
+   {
+      RegexpCacheEntry *e = s_lruTail;
+      UnlinkEntry(e);
+      TCHAR *key = e->key;
+      e->key = nullptr;
+      s_cache->remove(key);   // Will destroy entry; compiled regexp will stay alive while used by VMs
+      MemFree(key);
+   }
+}
+
+/**
+ * Get compiled regular expression from cache or compile and add to cache.
+ * Returns nullptr if pattern is invalid.
+ */
+shared_ptr<NXSL_CompiledRegexp> GetCompiledRegexp(const TCHAR *pattern, bool ignoreCase)
+{
+   StringBuffer key(ignoreCase ? _T("i:") : _T("c:"));
+   key.append(pattern);
+
+   s_cacheLock.lock();
+   RegexpCacheEntry *e = (s_cache != nullptr) ? s_cache->get(key) : nullptr;
+   if (e != nullptr)
+   {
+      s_cacheHits++;
+      if (e != s_lruHead)
+      {
+         UnlinkEntry(e);
+         LinkEntry(e);
+      }
+      shared_ptr<NXSL_CompiledRegexp> regexp = e->regexp;
+      s_cacheLock.unlock();
+      return regexp;
+   }
+   s_cacheMisses++;
+   s_cacheLock.unlock();
+
+   // Compile outside lock
+   const char *eptr;
+   int eoffset;
+   PCRE *preg = _pcre_compile_t(reinterpret_cast<const PCRE_TCHAR*>(pattern), ignoreCase ? PCRE_COMMON_FLAGS | PCRE_CASELESS : PCRE_COMMON_FLAGS, &eptr, &eoffset, nullptr);
+   if (preg == nullptr)
+      return shared_ptr<NXSL_CompiledRegexp>();
+   auto regexp = make_shared<NXSL_CompiledRegexp>(preg);
+
+   s_cacheLock.lock();
+   if (s_cache == nullptr)
+   {
+      s_cache = new StringObjectMap<RegexpCacheEntry>(Ownership::True);
+      s_cache->setIgnoreCase(false);
+   }
+   e = s_cache->get(key);
+   if (e != nullptr)
+   {
+      // Same pattern was compiled and cached by another thread
+      regexp = e->regexp;
+   }
+   else if (s_cacheSizeLimit > 0)
+   {
+      e = new RegexpCacheEntry();
+      e->key = MemCopyString(key);
+      e->regexp = regexp;
+      LinkEntry(e);
+      s_cache->set(key, e);
+      EnforceCacheSizeLimit();
+   }
+   s_cacheLock.unlock();
+   return regexp;
+}
+
+/**
+ * Get regular expression cache statistics
+ */
+void LIBNXSL_EXPORTABLE NXSLGetRegexpCacheStats(NXSL_RegexpCacheStats *stats)
+{
+   s_cacheLock.lock();
+   stats->hits = s_cacheHits;
+   stats->misses = s_cacheMisses;
+   stats->size = (s_cache != nullptr) ? s_cache->size() : 0;
+   stats->limit = s_cacheSizeLimit;
+   s_cacheLock.unlock();
+}
+
+/**
+ * Set maximum number of cached regular expressions (0 to disable caching)
+ */
+void LIBNXSL_EXPORTABLE NXSLSetRegexpCacheSize(int size)
+{
+   s_cacheLock.lock();
+   s_cacheSizeLimit = std::max(size, 0);
+   EnforceCacheSizeLimit();
+   s_cacheLock.unlock();
+}
@@ -112,8 +112,6 @@ NXSL_VariableSystem::NXSL_VariableSystem(NXSL_VM *vm, const NXSL_VariableSystem
 NXSL_VariableSystem::~NXSL_VariableSystem()
 {
    clear();
-   for(int i = 0; i < m_restorePointCount; i++)
-      m_vm->destroyIdentifier(m_restorePoints[i].identifier);
 }
 
 /**
@@ -208,24 +206,22 @@ void NXSL_VariableSystem::remove(const NXSL_Identifier& name)
 /**
  * Create restore point for variable reference
  */
-bool NXSL_VariableSystem::createVariableReferenceRestorePoint(uint32_t addr, NXSL_Identifier *identifier)
+bool NXSL_VariableSystem::createVariableReferenceRestorePoint(uint32_t addr)
 {
    if ((m_restorePointCount >= MAX_VREF_RESTORE_POINTS) || (m_type == NXSL_VariableSystemType::CONTEXT))
       return false;
 
-   m_restorePoints[m_restorePointCount].addr = addr;
-   m_restorePoints[m_restorePointCount].identifier = identifier;
-   m_restorePointCount++;
+   m_restorePoints[m_restorePointCount++] = addr;
    return true;
 }
 
 /**
- * Restore saved variable references
+ * Restore saved variable references (remove instruction patches pointing to variables from this system)
  */
-void NXSL_VariableSystem::restoreVariableReferences(StructArray<NXSL_Instruction> *instructions)
+void NXSL_VariableSystem::restoreVariableReferences(NXSL_InstructionPatch *patches)
 {
    for(int i = 0; i < m_restorePointCount; i++)
-      instructions->get(m_restorePoints[i].addr)->restoreVariableReference(m_restorePoints[i].identifier);
+      patches[m_restorePoints[i]].m_opCode = OPCODE_NOP;
    m_restorePointCount = 0;
 }
 
@@ -186,8 +186,14 @@ bool NXSL_SecurityContext::validateAccess(int accessType, const void *object)
  * Constructor
  */
 NXSL_VM::NXSL_VM(NXSL_Environment *env, NXSL_Storage *storage) : NXSL_ValueManager(), m_objectClassData(64), m_objects(64),
-         m_instructionSet(256, 256), m_functions(0, 16), m_modules(0, 16, Ownership::True)
+         m_functions(0, 16), m_modules(0, 16, Ownership::True)
 {
+   m_codeSize = 0;
+   m_patches = nullptr;
+   m_attributeCache = nullptr;
+   m_segmentCode = nullptr;
+   m_segmentStart = 0;
+   m_segmentSize = 0;
    m_cp = INVALID_ADDRESS;
    m_stopFlag = false;
    m_instructionTraceFile = nullptr;
@@ -227,8 +233,7 @@ NXSL_VM::NXSL_VM(NXSL_Environment *env, NXSL_Storage *storage) : NXSL_ValueManag
  */
 NXSL_VM::~NXSL_VM()
 {
-   for(int i = 0; i < m_instructionSet.size(); i++)
-      m_instructionSet.get(i)->dispose(this);
+   resetCode();
 
    delete m_constants;
    delete m_globalVariables;
@@ -258,7 +263,111 @@ EnumerationCallbackResult NXSL_VM::createConstantsCallback(const void *key, void
 }
 
 /**
- * Load program
+ * Detach from currently loaded code
+ */
+void NXSL_VM::resetCode()
+{
+   for(uint32_t i = 0; i < m_codeSize; i++)
+   {
+      NXSL_InstructionPatch *patch = &m_patches[i];
+      if ((patch->m_opCode != OPCODE_NOP) && (NXSL_Instruction::getOperandType(patch->m_opCode) == OP_TYPE_CONST))
+         destroyValue(patch->m_operand.m_constant);
+   }
+   MemFreeAndNull(m_patches);
+   MemFreeAndNull(m_attributeCache);
+   m_codeSize = 0;
+   m_image.reset();
+   m_segmentCode = nullptr;
+   m_segmentStart = 0;
+   m_segmentSize = 0;
+}
+
+/**
+ * Resize instruction patch table to match new code size. New entries are created inactive.
+ */
+void NXSL_VM::resizePatchTable(uint32_t codeSize)
+{
+   m_patches = MemReallocArray(m_patches, codeSize);
+   if (codeSize > m_codeSize)
+      memset(&m_patches[m_codeSize], 0, (codeSize - m_codeSize) * sizeof(NXSL_InstructionPatch));
+   if (m_attributeCache != nullptr)
+   {
+      m_attributeCache = MemReallocArray(m_attributeCache, codeSize);
+      if (codeSize > m_codeSize)
+         memset(&m_attributeCache[m_codeSize], 0, (codeSize - m_codeSize) * sizeof(NXSL_AttributeCacheEntry));
+   }
+   m_codeSize = codeSize;
+}
+
+/**
+ * Find code segment (main program or module) containing given address.
+ * Returns pointer to first instruction of the segment or nullptr if address is invalid.
+ */
+const NXSL_Instruction *NXSL_VM::findCodeSegment(uint32_t addr, uint32_t *start, uint32_t *size) const
+{
+   if (m_image == nullptr)
+      return nullptr;
+
+   if (addr < m_image->getCodeSize())
+   {
+      *start = 0;
+      *size = m_image->getCodeSize();
+      return m_image->getCode();
+   }
+
+   for(int i = 0; i < m_modules.size(); i++)
+   {
+      NXSL_Module *m = m_modules.get(i);
+      if ((m->m_image != nullptr) && (addr >= m->m_codeStart) && (addr < m->m_codeStart + m->m_codeSize))
+      {
+         *start = m->m_codeStart;
+         *size = m->m_codeSize;
+         return m->m_image->getCode();
+      }
+   }
+   return nullptr;
+}
+
+/**
+ * Get VM-local copy of constant operand of current instruction. Constants from shared
+ * program image are never referenced directly because value reference counters are not thread safe.
+ */
+NXSL_Value *NXSL_VM::getConstantOperand(NXSL_Instruction *instruction)
+{
+   NXSL_InstructionPatch *patch = &m_patches[m_cp];
+   if (patch->m_opCode == OPCODE_NOP)
+   {
+      patch->m_opCode = instruction->m_opCode;
+      patch->m_operand.m_constant = createValue(instruction->m_operand.m_constant);
+      instruction->m_operand.m_constant = patch->m_operand.m_constant;
+   }
+   return instruction->m_operand.m_constant;
+}
+
+/**
+ * Get attribute of given object from current instruction. Attribute getter resolved for
+ * object's class is cached per instruction, so repeated access from same instruction to
+ * objects of same class skips attribute lookup. Overridable getters are not cached because
+ * class may resolve object's dynamic attributes with same name first.
+ */
+NXSL_Value *NXSL_VM::getObjectAttribute(NXSL_Object *object, const NXSL_Identifier& name)
+{
+   if (m_attributeCache == nullptr)
+      m_attributeCache = MemAllocArray<NXSL_AttributeCacheEntry>(m_codeSize);
+
+   NXSL_Class *nxslClass = object->getClass();
+   NXSL_AttributeCacheEntry *entry = &m_attributeCache[m_cp];
+   if (entry->nxslClass != nxslClass)
+   {
+      entry->nxslClass = nxslClass;
+      const NXSL_ExtAttribute *getter = nxslClass->findAttributeGetter(name);
+      entry->getter = ((getter != nullptr) && !getter->overridable) ? getter : nullptr;
+   }
+   return (entry->getter != nullptr) ? entry->getter->handler(object, object->vm()) : nxslClass->getAttr(object, name);
+}
+
+/**
+ * Load program. Program code is not copied - VM executes shared program image directly.
  */
 bool NXSL_VM::load(const NXSL_Program *program)
 {
@@ -268,12 +377,11 @@ bool NXSL_VM::load(const NXSL_Program *program)
    m_metadata.clear();
    m_metadata.addAll(program->m_metadata);
 
-   // Copy instructions
-   for(int i = 0; i < m_instructionSet.size(); i++)
-      m_instructionSet.get(i)->dispose(this);
-   m_instructionSet.clear();
-   for(int i = 0; i < program->m_instructionSet.size(); i++)
-      m_instructionSet.addPlaceholder()->copyFrom(program->m_instructionSet.get(i), this);
+   // Attach program code
+   m_modules.clear();
+   resetCode();
+   m_image = program->m_image;
+   resizePatchTable(m_image->getCodeSize());
 
    // Copy function information
    m_functions.clear();
@@ -295,8 +403,6 @@ bool NXSL_VM::load(const NXSL_Program *program)
    }
 
    // Load modules
-   m_modules.clear();
-
    static NXSL_ModuleImport systemModule = { _T("stdlib"), 0, true };
    m_env->loadModule(this, &systemModule);
 
@@ -425,7 +531,7 @@ bool NXSL_VM::run(const ObjectRefArray<NXSL_Value>& args, NXSL_VariableSystem **
          m_cp = entryAddr;
          m_stopFlag = false;
 resume:
-         while((m_cp < static_cast<uint32_t>(m_instructionSet.size())) && !m_stopFlag)
+         while((m_cp < m_codeSize) && !m_stopFlag)
             execute();
          if (!m_stopFlag)
          {
@@ -467,12 +573,12 @@ bool NXSL_VM::run(const ObjectRefArray<NXSL_Value>& args, NXSL_VariableSystem **
    s_recursionCounter--;
 
    // Restore instructions replaced to direct variable pointers
-   m_localVariables->restoreVariableReferences(&m_instructionSet);
-   m_globalVariables->restoreVariableReferences(&m_instructionSet);
+   m_localVariables->restoreVariableReferences(m_patches);
+   m_globalVariables->restoreVariableReferences(m_patches);
    if (m_constants != nullptr)
-      m_constants->restoreVariableReferences(&m_instructionSet);
+      m_constants->restoreVariableReferences(m_patches);
    if (m_expressionVariables != nullptr)
-      m_expressionVariables->restoreVariableReferences(&m_instructionSet);
+      m_expressionVariables->restoreVariableReferences(m_patches);
 
    // Restore global variables
    if (globals == nullptr)
@@ -498,7 +604,7 @@ bool NXSL_VM::run(const ObjectRefArray<NXSL_Value>& args, NXSL_VariableSystem **
       auto variableSystem = static_cast<NXSL_VariableSystem*>(m_codeStack.pop());
       if (variableSystem != nullptr)
       {
-         variableSystem->restoreVariableReferences(&m_instructionSet);
+         variableSystem->restoreVariableReferences(m_patches);
          delete variableSystem;
       }
 
@@ -506,7 +612,7 @@ bool NXSL_VM::run(const ObjectRefArray<NXSL_Value>& args, NXSL_VariableSystem **
       variableSystem = static_cast<NXSL_VariableSystem*>(m_codeStack.pop());
       if (variableSystem != nullptr)
       {
-         variableSystem->restoreVariableReferences(&m_instructionSet);
+         variableSystem->restoreVariableReferences(m_patches);
          delete variableSystem;
       }
 
@@ -538,12 +644,12 @@ bool NXSL_VM::unwind()
 
       if (m_expressionVariables != nullptr)
       {
-         m_expressionVariables->restoreVariableReferences(&m_instructionSet);
+         m_expressionVariables->restoreVariableReferences(m_patches);
          delete m_expressionVariables;
       }
       m_expressionVariables = static_cast<NXSL_VariableSystem*>(m_codeStack.pop());
 
-      m_localVariables->restoreVariableReferences(&m_instructionSet);
+      m_localVariables->restoreVariableReferences(m_patches);
       delete m_localVariables;
       m_localVariables = static_cast<NXSL_VariableSystem*>(m_codeStack.pop());
 
@@ -703,13 +809,33 @@ void NXSL_VM::execute()
    NXSL_VariableSystem *vs;
 
    uint32_t dwNext = m_cp + 1;
-   NXSL_Instruction *cp = m_instructionSet.get(m_cp);
+
+   if (m_cp - m_segmentStart >= m_segmentSize)
+      m_segmentCode = findCodeSegment(m_cp, &m_segmentStart, &m_segmentSize);
+
+   // Work on local copy of shared instruction with VM-specific patch or relocation applied
+   NXSL_Instruction instruction = m_segmentCode[m_cp - m_segmentStart];
+   NXSL_InstructionPatch *patch = &m_patches[m_cp];
+   if (patch->m_opCode != OPCODE_NOP)
+   {
+      instruction.m_opCode = patch->m_opCode;
+      instruction.m_operand = patch->m_operand;
+   }
+   else if (m_segmentStart != 0)
+   {
+      // Module code is addressed relative to module start
+      if (instruction.getOperandType() == OP_TYPE_ADDR)
+         instruction.m_operand.m_addr += m_segmentStart;
+      if ((instruction.m_opCode == OPCODE_PUSH_EXPRVAR) || (instruction.m_opCode == OPCODE_UPDATE_EXPRVAR))
+         instruction.m_addr2 += m_segmentStart;
+   }
+   NXSL_Instruction *cp = &instruction;
    if (m_instructionTraceFile != nullptr)
       NXSL_ProgramBuilder::dump(m_instructionTraceFile, m_cp, *cp);
    switch(cp->m_opCode)
    {
       case OPCODE_PUSH_CONSTANT:
-         m_dataStack.push(createValueRef(cp->m_operand.m_constant));
+         m_dataStack.push(createValueRef(getConstantOperand(cp)));
          break;
       case OPCODE_PUSH_NULL:
          m_dataStack.push(createValue());
@@ -743,10 +869,10 @@ void NXSL_VM::execute()
             pVar = findOrCreateVariable(*cp->m_operand.m_identifier, &vs);
             m_dataStack.push(createValueRef(pVar->getValue()));
             // convert to direct variable access without name lookup
-            if (vs->createVariableReferenceRestorePoint(m_cp, cp->m_operand.m_identifier))
+            if (vs->createVariableReferenceRestorePoint(m_cp))
             {
-               cp->m_opCode = OPCODE_PUSH_VARPTR;
-               cp->m_operand.m_variable = pVar;
+               patch->m_opCode = OPCODE_PUSH_VARPTR;
+               patch->m_operand.m_variable = pVar;
             }
          }
          break;
@@ -762,10 +888,10 @@ void NXSL_VM::execute()
          {
             m_dataStack.push(createValueRef(pVar->getValue()));
             // convert to direct variable access without name lookup
-            if (m_expressionVariables->createVariableReferenceRestorePoint(m_cp, cp->m_operand.m_identifier))
+            if (m_expressionVariables->createVariableReferenceRestorePoint(m_cp))
             {
-               cp->m_opCode = OPCODE_PUSH_VARPTR;
-               cp->m_operand.m_variable = pVar;
+               patch->m_opCode = OPCODE_PUSH_VARPTR;
+               patch->m_operand.m_variable = pVar;
             }
             dwNext++;   // Skip next instruction
          }
@@ -777,7 +903,7 @@ void NXSL_VM::execute()
             m_codeStack.push(m_expressionVariables);
             if (m_expressionVariables != nullptr)
             {
-               m_expressionVariables->restoreVariableReferences(&m_instructionSet);
+               m_expressionVariables->restoreVariableReferences(m_patches);
                m_expressionVariables = nullptr;
             }
             dwNext = cp->m_addr2;
@@ -810,7 +936,7 @@ void NXSL_VM::execute()
             m_codeStack.push(m_expressionVariables);
             if (m_expressionVariables != nullptr)
             {
-               m_expressionVariables->restoreVariableReferences(&m_instructionSet);
+               m_expressionVariables->restoreVariableReferences(m_patches);
                m_expressionVariables = nullptr;
             }
             dwNext = cp->m_addr2;
@@ -833,10 +959,10 @@ void NXSL_VM::execute()
             {
                m_dataStack.push(createValue(pVar->getValue()));
                // convert to direct value access without name lookup
-               if (m_constants->createVariableReferenceRestorePoint(m_cp, cp->m_operand.m_identifier))
+               if (m_constants->createVariableReferenceRestorePoint(m_cp))
                {
-                  cp->m_opCode = OPCODE_PUSH_VARPTR;
-                  cp->m_operand.m_variable = pVar;
+                  patch->m_opCode = OPCODE_PUSH_VARPTR;
+                  patch->m_operand.m_variable = pVar;
                }
             }
             else if (strstr(cp->m_operand.m_identifier->value, "::"))
@@ -855,7 +981,7 @@ void NXSL_VM::execute()
          break;
       case OPCODE_CLEAR_EXPRVARS:
          if (m_expressionVariables != nullptr)
-            m_expressionVariables->restoreVariableReferences(&m_instructionSet);
+            m_expressionVariables->restoreVariableReferences(m_patches);
          if (m_exportedExpressionVariables != nullptr)
          {
             delete *m_exportedExpressionVariables;
@@ -885,10 +1011,10 @@ void NXSL_VM::execute()
 				{
 					pVar->setValue((cp->m_stackItems == 0) ? createValueRef(pValue) : pValue);
                // convert to direct variable access without name lookup
-		         if (vs->createVariableReferenceRestorePoint(m_cp, cp->m_operand.m_identifier))
+		         if (vs->createVariableReferenceRestorePoint(m_cp))
 		         {
-                  cp->m_opCode = OPCODE_SET_VARPTR;
-                  cp->m_operand.m_variable = pVar;
+                  patch->m_opCode = OPCODE_SET_VARPTR;
+                  patch->m_operand.m_variable = pVar;
 		         }
 				}
 				else
@@ -1419,12 +1545,11 @@ void NXSL_VM::execute()
          if (pFunc != nullptr)
          {
             // convert to direct call using pointer
-            cp->m_opCode = OPCODE_CALL_EXTPTR;
-            destroyIdentifier(cp->m_operand.m_identifier);
-            cp->m_operand.m_function = pFunc;
+            patch->m_opCode = OPCODE_CALL_EXTPTR;
+            patch->m_operand.m_function = pFunc;
 
             if (callExternalFunction(pFunc, (cp->m_stackItems > 0) ? cp->m_stackItems + m_spreadCounts[m_argvIndex] : 0))
-               dwNext = m_instructionSet.size();
+               dwNext = m_codeSize;
          }
          else
          {
@@ -1432,9 +1557,8 @@ void NXSL_VM::execute()
             if (addr != INVALID_ADDRESS)
             {
                // convert to CALL
-               cp->m_opCode = OPCODE_CALL;
-               destroyIdentifier(cp->m_operand.m_identifier);
-               cp->m_operand.m_addr = addr;
+               patch->m_opCode = OPCODE_CALL;
+               patch->m_operand.m_addr = addr;
 
                dwNext = addr;
                callFunction((cp->m_stackItems > 0) ? cp->m_stackItems + m_spreadCounts[m_argvIndex] : 0);
@@ -1452,12 +1576,11 @@ void NXSL_VM::execute()
                   if (pFunc != nullptr)
                   {
                      // convert to direct call using pointer
-                     cp->m_opCode = OPCODE_CALL_EXTPTR;
-                     destroyIdentifier(cp->m_operand.m_identifier);
-                     cp->m_operand.m_function = pFunc;
+                     patch->m_opCode = OPCODE_CALL_EXTPTR;
+                     patch->m_operand.m_function = pFunc;
 
                      if (callExternalFunction(pFunc, (cp->m_stackItems > 0) ? cp->m_stackItems + m_spreadCounts[m_argvIndex] : 0))
-                        dwNext = m_instructionSet.size();
+                        dwNext = m_codeSize;
                   }
                   else
                   {
@@ -1475,7 +1598,7 @@ void NXSL_VM::execute()
          break;
       case OPCODE_CALL_EXTPTR:
          if (callExternalFunction(cp->m_operand.m_function, (cp->m_stackItems > 0) ? cp->m_stackItems + m_spreadCounts[m_argvIndex] : 0))
-            dwNext = m_instructionSet.size();
+            dwNext = m_codeSize;
          if (cp->m_stackItems > 0)
             m_argvIndex--;
          break;
@@ -1489,7 +1612,7 @@ void NXSL_VM::execute()
                if (pFunc != nullptr)
                {
                   if (callExternalFunction(pFunc, (cp->m_stackItems > 0) ? cp->m_stackItems + m_spreadCounts[m_argvIndex] : 0))
-                     dwNext = m_instructionSet.size();
+                     dwNext = m_codeSize;
                }
                else
                {
@@ -1520,7 +1643,7 @@ void NXSL_VM::execute()
       case OPCODE_CALL_METHOD:
       case OPCODE_SAFE_CALL:
          if (callMethod(*cp->m_operand.m_identifier, (cp->m_stackItems > 0) ? cp->m_stackItems + m_spreadCounts[m_argvIndex] : 0, cp->m_opCode == OPCODE_SAFE_CALL))
-            dwNext = m_instructionSet.size();
+            dwNext = m_codeSize;
          if (cp->m_stackItems > 0)
             m_argvIndex--;
          break;
@@ -1535,7 +1658,7 @@ void NXSL_VM::execute()
             NXSL_VariableSystem *savedExpressionVariables = static_cast<NXSL_VariableSystem*>(m_codeStack.pop());
             if (m_expressionVariables != nullptr)
             {
-               m_expressionVariables->restoreVariableReferences(&m_instructionSet);
+               m_expressionVariables->restoreVariableReferences(m_patches);
                delete m_expressionVariables;
             }
             m_expressionVariables = savedExpressionVariables;
@@ -1543,7 +1666,7 @@ void NXSL_VM::execute()
             NXSL_VariableSystem *savedLocals = static_cast<NXSL_VariableSystem*>(m_codeStack.pop());
             if (savedLocals != nullptr)
             {
-               m_localVariables->restoreVariableReferences(&m_instructionSet);
+               m_localVariables->restoreVariableReferences(m_patches);
                delete m_localVariables;
                m_localVariables = savedLocals;
             }
@@ -1553,7 +1676,7 @@ void NXSL_VM::execute()
          else
          {
             // Return from main(), terminate program
-            dwNext = m_instructionSet.size();
+            dwNext = m_codeSize;
          }
          break;
       case OPCODE_BIND:
@@ -1569,7 +1692,7 @@ void NXSL_VM::execute()
       case OPCODE_EXIT:
 			if (m_dataStack.getPosition() > 0)
          {
-            dwNext = m_instructionSet.size();
+            dwNext = m_codeSize;
          }
          else
          {
@@ -1634,7 +1757,7 @@ void NXSL_VM::execute()
       case OPCODE_CASE_CONST_LT:
       case OPCODE_CASE_GT:
       case OPCODE_CASE_CONST_GT:
-         doBinaryOperation(cp->m_opCode);
+         doBinaryOperation(cp->m_opCode, cp);
          break;
       case OPCODE_NEG:
       case OPCODE_NOT:
@@ -1657,10 +1780,10 @@ void NXSL_VM::execute()
                   pValue->decrement();
 
                // Convert to direct variable access
-               if (vs->createVariableReferenceRestorePoint(m_cp, cp->m_operand.m_identifier))
+               if (vs->createVariableReferenceRestorePoint(m_cp))
                {
-                  cp->m_opCode = (cp->m_opCode == OPCODE_INC) ? OPCODE_INC_VARPTR : OPCODE_DEC_VARPTR;
-                  cp->m_operand.m_variable = pVar;
+                  patch->m_opCode = (cp->m_opCode == OPCODE_INC) ? OPCODE_INC_VARPTR : OPCODE_DEC_VARPTR;
+                  patch->m_operand.m_variable = pVar;
                }
             }
             else
@@ -1707,10 +1830,10 @@ void NXSL_VM::execute()
                m_dataStack.push(createValueRef(pValue));
 
                // Convert to direct variable access
-               if (vs->createVariableReferenceRestorePoint(m_cp, cp->m_operand.m_identifier))
+               if (vs->createVariableReferenceRestorePoint(m_cp))
                {
-                  cp->m_opCode = (cp->m_opCode == OPCODE_INCP) ? OPCODE_INCP_VARPTR : OPCODE_DECP_VARPTR;
-                  cp->m_operand.m_variable = pVar;
+                  patch->m_opCode = (cp->m_opCode == OPCODE_INCP) ? OPCODE_INCP_VARPTR : OPCODE_DECP_VARPTR;
+                  patch->m_operand.m_variable = pVar;
                }
             }
             else
@@ -1751,7 +1874,7 @@ void NXSL_VM::execute()
                NXSL_Object *object = pValue->getValueAsObject();
                if (object != nullptr)
                {
-                  NXSL_Value *attr = object->getClass()->getAttr(object, *cp->m_operand.m_identifier);
+                  NXSL_Value *attr = getObjectAttribute(object, *cp->m_operand.m_identifier);
                   if (attr != nullptr)
                   {
                      m_dataStack.push(attr);
@@ -2254,7 +2377,7 @@ void NXSL_VM::getOrUpdateHashMapElement(int opcode, NXSL_Value *hashMap, NXSL_Va
 /**
  * Perform binary operation on two operands from stack and push result to stack
  */
-void NXSL_VM::doBinaryOperation(int nOpCode)
+void NXSL_VM::doBinaryOperation(int nOpCode, NXSL_Instruction *instruction)
 {
    NXSL_Value *pVal1, *pVal2, *pRes = nullptr;
    NXSL_Variable *var;
@@ -2269,16 +2392,16 @@ void NXSL_VM::doBinaryOperation(int nOpCode)
       case OPCODE_CASE:
       case OPCODE_CASE_LT:
       case OPCODE_CASE_GT:
-		   pVal1 = m_instructionSet.get(m_cp)->m_operand.m_constant;
+		   pVal1 = getConstantOperand(instruction);
 		   pVal2 = m_dataStack.peek();
          break;
       case OPCODE_CASE_CONST:
       case OPCODE_CASE_CONST_LT:
       case OPCODE_CASE_CONST_GT:
-         pVal1 = m_env->getConstantValue(*(m_instructionSet.get(m_cp)->m_operand.m_identifier), this);
+         pVal1 = m_env->getConstantValue(*instruction->m_operand.m_identifier, this);
          if (pVal1 == nullptr)
          {
-            var = (m_constants != nullptr) ? m_constants->find(*(m_instructionSet.get(m_cp)->m_operand.m_identifier)) : nullptr;
+            var = (m_constants != nullptr) ? m_constants->find(*instruction->m_operand.m_identifier) : nullptr;
             if (var != nullptr)
             {
                pVal1 = var->getValue();
@@ -2674,27 +2797,6 @@ void NXSL_VM::buildString(int numElements)
    m_dataStack.push(createValue(result));
 }
 
-/**
- * Relocate code block
- */
-void NXSL_VM::relocateCode(uint32_t start, uint32_t len, uint32_t shift)
-{
-   uint32_t last = std::min(start + len, static_cast<uint32_t>(m_instructionSet.size()));
-   for(uint32_t i = start; i < last; i++)
-	{
-      NXSL_Instruction *instr = m_instructionSet.get(i);
-      if ((instr->m_opCode == OPCODE_JMP) ||
-          (instr->m_opCode == OPCODE_JZ) ||
-          (instr->m_opCode == OPCODE_JNZ) ||
-          (instr->m_opCode == OPCODE_JZ_PEEK) ||
-          (instr->m_opCode == OPCODE_JNZ_PEEK) ||
-          (instr->m_opCode == OPCODE_CALL))
-      {
-         instr->m_operand.m_addr += shift;
-      }
-	}
-}
-
 /**
  * Well-known identifiers
  */
@@ -2711,11 +2813,9 @@ bool NXSL_VM::loadModule(NXSL_Program *module, const NXSL_ModuleImport *importIn
       if (!_tcsicmp(importInfo->name, m_modules.get(i)->m_name))
          return true;  // Already loaded
 
-   // Add code from module
-   int start = m_instructionSet.size();
-   for(int i = 0; i < module->m_instructionSet.size(); i++)
-      m_instructionSet.addPlaceholder()->copyFrom(module->m_instructionSet.get(i), this);
-   relocateCode(start, module->m_instructionSet.size(), start);
+   // Map module code after already loaded code (module instructions are shared, not copied)
+   uint32_t start = m_codeSize;
+   resizePatchTable(m_codeSize + module->m_image->getCodeSize());
 
    // Add function names from module
    int fnstart = m_functions.size();
@@ -2772,8 +2872,9 @@ bool NXSL_VM::loadModule(NXSL_Program *module, const NXSL_ModuleImport *importIn
    // Register module as loaded
    auto m = new NXSL_Module;
    _tcslcpy(m->m_name, importInfo->name, MAX_PATH);
-   m->m_codeStart = static_cast<uint32_t>(start);
-   m->m_codeSize = module->m_instructionSet.size();
+   m->m_codeStart = start;
+   m->m_codeSize = module->m_image->getCodeSize();
+   m->m_image = module->m_image;
    m->m_functionStart = fnstart;
    m->m_numFunctions = m_functions.size() - fnstart;
    m_modules.add(m);
@@ -2893,12 +2994,12 @@ void NXSL_VM::callFunction(int nArgCount)
       m_subLevel++;
       m_codeStack.push(CAST_TO_POINTER(m_cp + 1, void *));
       m_codeStack.push(m_localVariables);
-      m_localVariables->restoreVariableReferences(&m_instructionSet);
+      m_localVariables->restoreVariableReferences(m_patches);
       m_localVariables = new NXSL_VariableSystem(this, NXSL_VariableSystemType::LOCAL);
       m_codeStack.push(m_expressionVariables);
       if (m_expressionVariables != nullptr)
       {
-         m_expressionVariables->restoreVariableReferences(&m_instructionSet);
+         m_expressionVariables->restoreVariableReferences(m_patches);
          m_expressionVariables = nullptr;
       }
       m_nBindPos = 1;
@@ -3159,16 +3260,13 @@ NXSL_Value *NXSL_VM::matchRegexp(NXSL_Value *value, NXSL_Value *regexp, bool ign
 {
    NXSL_Value *result;
 
-   const TCHAR *re = regexp->getValueAsCString();
-   const char *eptr;
-   int eoffset;
-	PCRE *preg = _pcre_compile_t(reinterpret_cast<const PCRE_TCHAR*>(re), ignoreCase ? PCRE_COMMON_FLAGS | PCRE_CASELESS : PCRE_COMMON_FLAGS, &eptr, &eoffset, nullptr);
+   shared_ptr<NXSL_CompiledRegexp> preg = GetCompiledRegexp(regexp->getValueAsCString(), ignoreCase);
    if (preg != nullptr)
    {
       int pmatch[MAX_REGEXP_CGROUPS * 3];
       uint32_t valueLen;
 		const TCHAR *v = value->getValueAsString(&valueLen);
-		int cgcount = _pcre_exec_t(preg, nullptr, reinterpret_cast<const PCRE_TCHAR*>(v), valueLen, 0, 0, pmatch, MAX_REGEXP_CGROUPS * 3);
+		int cgcount = preg->match(v, valueLen, pmatch, MAX_REGEXP_CGROUPS * 3);
       if (cgcount >= 0)
       {
          if (cgcount == 0)
@@ -3206,7 +3304,6 @@ NXSL_Value *NXSL_VM::matchRegexp(NXSL_Value *value, NXSL_Value *regexp, bool ign
       {
          result = createValue(false);  // No match
       }
-      _pcre_free_t(preg);
    }
    else
    {
@@ -3231,12 +3328,19 @@ void NXSL_VM::trace(int level, const TCHAR *text)
 void NXSL_VM::error(int errorCode, int sourceLine, const TCHAR *customMessage)
 {
    m_errorCode = errorCode;
-   m_errorLine = (sourceLine == -1) ?
-            (((m_cp == INVALID_ADDRESS) || (m_cp >= static_cast<uint32_t>(m_instructionSet.size()))) ?
-                     0 : m_instructionSet.get(m_cp)->m_sourceLine) : sourceLine;
+   if (sourceLine == -1)
+   {
+      uint32_t start, size;
+      const NXSL_Instruction *code = (m_cp < m_codeSize) ? findCodeSegment(m_cp, &start, &size) : nullptr;
+      m_errorLine = (code != nullptr) ? code[m_cp - start].m_sourceLine : 0;
+   }
+   else
+   {
+      m_errorLine = sourceLine;
+   }
 
    m_errorModule = nullptr;
-   if (m_cp < static_cast<uint32_t>(m_instructionSet.size()))
+   if (m_cp < m_codeSize)
    {
       for(int i = 0; i < m_modules.size(); i++)
       {
@@ -3420,7 +3524,17 @@ void NXSL_VM::setSecurityContext(NXSL_SecurityContext *context)
  */
 void NXSL_VM::dump(FILE *fp) const
 {
-   NXSL_ProgramBuilder::dump(fp, m_instructionSet);
+   if (m_image != nullptr)
+      NXSL_ProgramBuilder::dump(fp, m_image->m_instructionSet);
+   for(int i = 0; i < m_modules.size(); i++)
+   {
+      NXSL_Module *m = m_modules.get(i);
+      if (m->m_image == nullptr)
+         continue;
+      _ftprintf(fp, _T("\nModule %s:\n"), m->m_name);
+      for(int j = 0; j < m->m_image->m_instructionSet.size(); j++)
+         NXSL_ProgramBuilder::dump(fp, m->m_codeStart + j, *m->m_image->m_instructionSet.get(j));
+   }
 
    if (!m_functions.isEmpty())
    {
@@ -140,10 +140,9 @@ unique_ptr<StructArray<ScoredDciValue>> DetectAnomalies(const DataCollectionTarg
 }
 
 /**
- * Check if given value is an anomaly
- * Period is number of days, depth is number of periods to look into, width is time interval around current time in minutes
+ * Check if given value is an anomaly by training new model on historical data around current time (used when model cache is disabled)
  */
-bool IsAnomalousValue(const DataCollectionTarget& dcTarget, const DCObject& dci, double value, double threshold, int period, int depth, int width)
+static bool IsAnomalousValueUncached(const DataCollectionTarget& dcTarget, const DCObject& dci, double value, double threshold, int period, int depth, int width)
 {
    if (depth > 90)
       depth = 90;
@@ -206,6 +205,346 @@ bool IsAnomalousValue(const DataCollectionTarget& dcTarget, const DCObject& dci,
    return scores[count - 1] >= threshold;
 }
 
+/**
+ * Get length of time slot for given window width (in minutes). Model is trained on historical windows centered
+ * at the middle of current slot, so with slot of half window width window used for training is never shifted
+ * by more than quarter of its width relative to window around current time. Retraining once per period instead
+ * would require separate model for each slot within period (48 models per DCI for 1 hour window and daily period).
+ */
+static inline time_t SlotLength(int width)
+{
+   return std::max(width * 30, 60);
+}
+
+/**
+ * Anomaly detection model cache key. There is one model per DCI and detection parameters; model is
+ * trained for time slot of half window width and retrained when current time moves to next slot.
+ */
+struct AnomalyModelKey
+{
+   uint32_t dciId;
+   int16_t period;
+   int16_t depth;
+   int16_t width;
+};
+
+/**
+ * Cached anomaly detection model
+ */
+struct AnomalyModel
+{
+   AnomalyModelKey key;
+   AnomalyModel *prev;        // LRU list links
+   AnomalyModel *next;
+   shared_ptr<isotree::IsolationForest> model;
+   time_t slotStart;          // Start of time slot model was trained for (0 if model was never trained)
+   uint64_t trainingId;       // ID of currently running training task (0 if none)
+};
+
+/**
+ * Model training request
+ */
+struct AnomalyModelTrainingRequest
+{
+   AnomalyModelKey key;
+   uint32_t nodeId;
+   DCObjectStorageClass storageClass;
+   time_t slotStart;
+   uint64_t trainingId;
+};
+
+/**
+ * Model cache
+ */
+static Mutex s_modelCacheLock(MutexType::FAST);
+static HashMap<AnomalyModelKey, AnomalyModel> s_modelCache(Ownership::True);
+static HashSet<AnomalyModelKey> s_pendingTrainings;   // Keys with queued or running training task
+static AnomalyModel *s_lruHead = nullptr;
+static AnomalyModel *s_lruTail = nullptr;
+static uint32_t s_modelCacheSizeLimit = 0;   // Maximum number of cached models
+static uint64_t s_trainingId = 0;
+static uint32_t s_averageTrainingTime = 0;
+static ThreadPool *s_trainingThreadPool = nullptr;
+
+/**
+ * Unlink model from LRU list (cache lock must be held)
+ */
+static void UnlinkModel(AnomalyModel *m)
+{
+   if (m->prev != nullptr)
+      m->prev->next = m->next;
+   else
+      s_lruHead = m->next;
+   if (m->next != nullptr)
+      m->next->prev = m->prev;
+   else
+      s_lruTail = m->prev;
+}
+
+/**
+ * Link model at the head of LRU list (cache lock must be held)
+ */
+static void LinkModel(AnomalyModel *m)
+{
+   m->prev = nullptr;
+   m->next = s_lruHead;
+   if (s_lruHead != nullptr)
+      s_lruHead->prev = m;
+   else
+      s_lruTail = m;
+   s_lruHead = m;
+}
+
+/**
+ * Remove model from cache (cache lock must be held)
+ */
+static void RemoveModel(AnomalyModel *m)
+{
+   UnlinkModel(m);
+   AnomalyModelKey key = m->key;
+   s_modelCache.remove(key);
+}
+
+/**
+ * Remove least recently used models to make room for new one (cache lock must be held)
+ */
+static void EnforceModelCacheLimit()
+{
+   AnomalyModel *m = s_lruTail;
+   while((static_cast<uint32_t>(s_modelCache.size()) >= s_modelCacheSizeLimit) && (m != nullptr))
+   {
+      AnomalyModel *prev = m->prev;
+      nxlog_debug_tag(DEBUG_TAG, 7, _T("EnforceModelCacheLimit: evicting model for DCI [%u] [p=%d d=%d w=%d]"), m->key.dciId, m->key.period, m->key.depth, m->key.width);
+      RemoveModel(m);
+      m = prev;
+   }
+}
+
+/**
+ * Train anomaly detection model on historical data around center of given time slot
+ */
+static shared_ptr<isotree::IsolationForest> BuildModel(const AnomalyModelKey& key, uint32_t nodeId, DCObjectStorageClass storageClass, time_t slotStart, uint64_t trainingId)
+{
+   int64_t startTime = GetCurrentTimeMs();
+
+   // Construct time ranges for previous periods around the center of time slot
+   time_t t = slotStart + SlotLength(key.width) / 2 - key.width * 30;
+   std::pair<time_t, time_t> timeRanges[90];
+   for(int i = 0; i < key.depth; i++)
+   {
+      t -= 86400 * key.period;
+      timeRanges[i].first = t;
+      timeRanges[i].second = t + key.width * 60;
+   }
+
+   shared_ptr<isotree::IsolationForest> model;
+   auto series = LoadDciValues(nodeId, key.dciId, storageClass, timeRanges, key.depth);
+   if ((series != nullptr) && !series->isEmpty())
+   {
+      int count = series->size();
+      double *points = MemAllocArrayNoInit<double>(count);
+      for(int i = 0; i < count; i++)
+         points[i] = series->get(i)->value;
+      model = make_shared<isotree::IsolationForest>();
+      model->fit(points, count, 1);
+      MemFree(points);
+   }
+
+   uint32_t elapsed = static_cast<uint32_t>(GetCurrentTimeMs() - startTime);
+   nxlog_debug_tag(DEBUG_TAG, 6, _T("BuildModel: model for DCI [%u] [p=%d d=%d w=%d] trained on %d data points in %u ms"),
+         key.dciId, key.period, key.depth, key.width, (series != nullptr) ? series->size() : 0, elapsed);
+
+   s_modelCacheLock.lock();
+   s_averageTrainingTime = (s_averageTrainingTime == 0) ? elapsed : (s_averageTrainingTime * 7 + elapsed) / 8;
+   s_pendingTrainings.remove(key);
+   AnomalyModel *m = s_modelCache.get(key);
+   if ((m != nullptr) && (m->trainingId == trainingId))   // Entry could be invalidated while training was in progress
+   {
+      m->model = model;
+      m->slotStart = slotStart;
+      m->trainingId = 0;
+   }
+   s_modelCacheLock.unlock();
+
+   return model;
+}
+
+/**
+ * Train anomaly detection model (executed on training thread pool)
+ */
+static void TrainModel(AnomalyModelTrainingRequest *request)
+{
+   BuildModel(request->key, request->nodeId, request->storageClass, request->slotStart, request->trainingId);
+   delete request;
+}
+
+/**
+ * Schedule model training (cache lock must be held). Request is dropped if training for same key is already
+ * pending (cache entry could be evicted or invalidated and re-created while previous training is still queued).
+ */
+static void ScheduleModelTraining(AnomalyModel *m, const DataCollectionTarget& dcTarget, const DCObject& dci, time_t slotStart)
+{
+   if (s_pendingTrainings.contains(m->key))
+      return;
+
+   s_pendingTrainings.put(m->key);
+   auto request = new AnomalyModelTrainingRequest();
+   request->key = m->key;
+   request->nodeId = dcTarget.getId();
+   request->storageClass = dci.getStorageClass();
+   request->slotStart = slotStart;
+   request->trainingId = ++s_trainingId;
+   m->trainingId = request->trainingId;
+   ThreadPoolExecute(s_trainingThreadPool, TrainModel, request);
+}
+
+/**
+ * Check if given value is an anomaly
+ * Period is number of days, depth is number of periods to look into, width is time interval around current time in minutes
+ */
+bool IsAnomalousValue(const DataCollectionTarget& dcTarget, const DCObject& dci, double value, double threshold, int period, int depth, int width)
+{
+   if (depth > 90)
+      depth = 90;
+
+   if (s_modelCacheSizeLimit == 0)
+      return IsAnomalousValueUncached(dcTarget, dci, value, threshold, period, depth, width);
+
+   // Models are retrained when current time moves to next time slot
+   time_t now = time(nullptr);
+   time_t slotLength = SlotLength(width);
+   time_t slotStart = now - now % slotLength;
+
+   AnomalyModelKey key;
+   memset(&key, 0, sizeof(key));
+   key.dciId = dci.getId();
+   key.period = static_cast<int16_t>(period);
+   key.depth = static_cast<int16_t>(depth);
+   key.width = static_cast<int16_t>(width);
+
+   s_modelCacheLock.lock();
+   if (s_trainingThreadPool == nullptr)   // Anomaly detection is shutting down
+   {
+      s_modelCacheLock.unlock();
+      return IsAnomalousValueUncached(dcTarget, dci, value, threshold, period, depth, width);
+   }
+
+   AnomalyModel *m = s_modelCache.get(key);
+   if (m == nullptr)
+   {
+      m = new AnomalyModel();
+      m->key = key;
+      m->slotStart = 0;
+      m->trainingId = 0;
+      EnforceModelCacheLimit();  // Called before new entry is added so it cannot be evicted
+      s_modelCache.set(key, m);
+      LinkModel(m);
+   }
+   else if (m != s_lruHead)
+   {
+      UnlinkModel(m);
+      LinkModel(m);
+   }
+
+   // If there is no model yet it is trained synchronously and stored in cache, otherwise previous
+   // model is used while new one is trained in background
+   uint64_t trainingId = 0;
+   if ((m->trainingId == 0) && (m->slotStart != slotStart))
+   {
+      if (m->model != nullptr)
+      {
+         ScheduleModelTraining(m, dcTarget, dci, slotStart);
+      }
+      else if (!s_pendingTrainings.contains(key))
+      {
+         s_pendingTrainings.put(key);
+         trainingId = ++s_trainingId;
+         m->trainingId = trainingId;
+      }
+   }
+   shared_ptr<isotree::IsolationForest> model = m->model;
+   s_modelCacheLock.unlock();
+
+   if (trainingId != 0)
+      model = BuildModel(key, dcTarget.getId(), dci.getStorageClass(), slotStart, trainingId);
+
+   if (model == nullptr)
+   {
+      nxlog_debug_tag(DEBUG_TAG, 6, _T("IsAnomalousValue(%s [%u], \"%s\"): model for period [p=%d d=%d w=%d] is not available (no historical data or training in progress)"),
+            dcTarget.getName(), dcTarget.getId(), dci.getName().cstr(), period, depth, width);
+      return false;
+   }
+
+   std::vector<double> scores = model->predict(&value, 1, true);
+   nxlog_debug_tag(DEBUG_TAG, 6, _T("IsAnomalousValue(%s [%u], \"%s\"): score for value %f and period [p=%d d=%d w=%d] is %f"),
+         dcTarget.getName(), dcTarget.getId(), dci.getName().cstr(), value, period, depth, width, scores[0]);
+   return scores[0] >= threshold;
+}
+
+/**
+ * Invalidate all cached models for given DCI
+ */
+void InvalidateAnomalyModels(uint32_t dciId)
+{
+   s_modelCacheLock.lock();
+   for(AnomalyModel *m = s_lruHead; m != nullptr;)
+   {
+      AnomalyModel *next = m->next;
+      if (m->key.dciId == dciId)
+         RemoveModel(m);
+      m = next;
+   }
+   s_modelCacheLock.unlock();
+}
+
+/**
+ * Get number of cached anomaly detection models
+ */
+uint32_t GetAnomalyModelCacheSize()
+{
+   s_modelCacheLock.lock();
+   uint32_t size = static_cast<uint32_t>(s_modelCache.size());
+   s_modelCacheLock.unlock();
+   return size;
+}
+
+/**
+ * Get average model training time in milliseconds
+ */
+uint32_t GetAnomalyModelTrainingTime()
+{
+   return s_averageTrainingTime;
+}
+
+/**
+ * Initialize anomaly detection
+ */
+void InitAnomalyDetection()
+{
+   s_modelCacheSizeLimit = ConfigReadULong(_T("DataCollection.AnomalyDetection.ModelCacheSize"), 256);
+   if (s_modelCacheSizeLimit > 0)
+   {
+      // Small pool so that model training will not compete with data collection for CPU
+      s_trainingThreadPool = ThreadPoolCreate(_T("AD"), 0, 2);
+      nxlog_debug_tag(DEBUG_TAG, 2, _T("Anomaly detection model cache initialized (size limit %u models)"), s_modelCacheSizeLimit);
+   }
+}
+
+/**
+ * Shutdown anomaly detection
+ */
+void ShutdownAnomalyDetection()
+{
+   s_modelCacheLock.lock();
+   ThreadPool *pool = s_trainingThreadPool;
+   s_trainingThreadPool = nullptr;
+   s_modelCacheLock.unlock();
+
+   // Pool is destroyed without holding cache lock because running training tasks need it to complete
+   if (pool != nullptr)
+      ThreadPoolDestroy(pool);
+}
+
 #else /* WITH_LIBISOTREE */
 
 /**
@@ -224,4 +563,41 @@ bool IsAnomalousValue(const DataCollectionTarget& dcTarget, const DCObject& dci,
    return false;
 }
 
+/**
+ * Invalidate cached models for given DCI (dummy implementation)
+ */
+void InvalidateAnomalyModels(uint32_t dciId)
+{
+}
+
+/**
+ * Get number of cached anomaly detection models (dummy implementation)
+ */
+uint32_t GetAnomalyModelCacheSize()
+{
+   return 0;
+}
+
+/**
+ * Get average model training time (dummy implementation)
+ */
+uint32_t GetAnomalyModelTrainingTime()
+{
+   return 0;
+}
+
+/**
+ * Initialize anomaly detection (dummy implementation)
+ */
+void InitAnomalyDetection()
+{
+}
+
+/**
+ * Shutdown anomaly detection (dummy implementation)
+ */
+void ShutdownAnomalyDetection()
+{
+}
+
 #endif   /* WITH_LIBISOTREE */
@@ -46,81 +46,6 @@ AlarmComment::AlarmComment(uint32_t id, time_t changeTime, uint32_t userId, TCHA
    m_text = text;
 }
 
-/**
- * Alarm list
- */
-class AlarmList
-{
-private:
-   Mutex m_lock;
-   ObjectArray<Alarm> m_list;
-   StringObjectMap<Alarm> m_keyIndex;
-
-public:
-   AlarmList() : m_list(256, 256, Ownership::True), m_keyIndex(Ownership::False) { }
-   ~AlarmList() { }
-
-   void lock() { m_lock.lock(); }
-   void unlock() { m_lock.unlock(); }
-
-   int size() { return m_list.size(); }
-
-   uint64_t memoryUsage()
-   {
-      uint64_t memUsage = sizeof(AlarmList);
-      lock();
-      for(int i = 0; i < m_list.size(); i++)
-         memUsage += m_list.get(i)->getMemoryUsage();
-      unlock();
-      return memUsage;
-   }
-
-   Alarm *get(int index) { return m_list.get(index); }
-
-   Alarm *find(const TCHAR *key) { return m_keyIndex.get(key); }
-   Alarm *find(uint32_t id)
-   {
-      for(int i = 0; i < m_list.size(); i++)
-         if (m_list.get(i)->getAlarmId() == id)
-            return m_list.get(i);
-      return nullptr;
-   }
-
-   void add(Alarm *alarm)
-   {
-      m_list.add(alarm);
-      if (*alarm->getKey() != 0)
-         m_keyIndex.set(alarm->getKey(), alarm);
-   }
-
-   void remove(int index)
-   {
-      Alarm *alarm = m_list.get(index);
-      if (alarm->getParentAlarmId() != 0)
-      {
-         Alarm *parent = find(alarm->getParentAlarmId());
-         if (parent != nullptr)
-            parent->removeSubordinateAlarm(alarm->getAlarmId());
-      }
-      if (*alarm->getKey() != 0)
-         m_keyIndex.remove(alarm->getKey());
-      m_list.remove(index);
-   }
-
-   void remove(Alarm *alarm)
-   {
-      if (alarm->getParentAlarmId() != 0)
-      {
-         Alarm *parent = find(alarm->getParentAlarmId());
-         if (parent != nullptr)
-            parent->removeSubordinateAlarm(alarm->getAlarmId());
-      }
-      if (*alarm->getKey() != 0)
-         m_keyIndex.remove(alarm->getKey());
-      m_list.remove(alarm);
-   }
-};
-
 /**
  * Global instance of alarm manager
  */
@@ -963,7 +888,7 @@ uint32_t NXCORE_EXPORTABLE CreateNewAlarm(const uuid& ruleGuid, const TCHAR *rul
    // Check if we have a duplicate alarm
    if (key[0] != 0)
    {
-      s_alarmList.lock();
+      s_alarmList.writeLock();
 
       Alarm *alarm = s_alarmList.find(key);
       if (alarm != nullptr)
@@ -978,7 +903,10 @@ uint32_t NXCORE_EXPORTABLE CreateNewAlarm(const uuid& ruleGuid, const TCHAR *rul
             if (parent != nullptr)
                parent->addSubordinateAlarm(alarm->getAlarmId());
          }
+         uint32_t oldSourceObject = alarm->getSourceObject();
+         int oldSeverity = alarm->getCurrentSeverity();
          alarm->updateFromEvent(event, parentAlarmId, rcaScriptName, ruleGuid, ruleDescription, ALARM_STATE_OUTSTANDING, severity, timeout, timeoutEvent, ackTimeout, message, impact, alarmCategoryList);
+         s_alarmList.update(alarm, oldSourceObject, oldSeverity);
          if (!alarm->isEventRelated(event->getId()))
          {
             alarmId = alarm->getAlarmId();      // needed for correct update of related events
@@ -1008,8 +936,8 @@ uint32_t NXCORE_EXPORTABLE CreateNewAlarm(const uuid& ruleGuid, const TCHAR *rul
       // Add new alarm to active alarm list if needed
 		if ((alarm->getState() & ALARM_STATE_MASK) != ALARM_STATE_TERMINATED)
       {
-         s_alarmList.lock();
-         nxlog_debug_tag(DEBUG_TAG, 7, _T("AlarmManager: adding new active alarm, current alarm count %d"), s_alarmList.size());
+         s_alarmList.writeLock();
+         nxlog_debug_tag(DEBUG_TAG, 7, _T("AlarmManager: adding new active alarm, current alarm count %d"), s_alarmList.count());
          s_alarmList.add(alarm);
          s_alarmList.unlock();
       }
@@ -1019,12 +947,14 @@ uint32_t NXCORE_EXPORTABLE CreateNewAlarm(const uuid& ruleGuid, const TCHAR *rul
 
       if (parentAlarmId != 0)
       {
+         s_alarmList.writeLock();
          Alarm *parent = s_alarmList.find(parentAlarmId);
          if (parent != nullptr)
          {
             parent->addSubordinateAlarm(alarm->getAlarmId());
             NotifyClients(NX_NOTIFY_ALARM_CHANGED, parent);
          }
+         s_alarmList.unlock();
       }
       if (event->getDciId() != 0)
       {
@@ -1125,16 +1055,12 @@ uint32_t NXCORE_EXPORTABLE AckAlarmById(uint32_t alarmId, GenericClientSession *
 {
    uint32_t objectId, rcc = RCC_INVALID_ALARM_ID;
 
-   s_alarmList.lock();
-   for(int i = 0; i < s_alarmList.size(); i++)
+   s_alarmList.writeLock();
+   Alarm *alarm = s_alarmList.find(alarmId);
+   if (alarm != nullptr)
    {
-      Alarm *alarm = s_alarmList.get(i);
-      if (alarm->getAlarmId() == alarmId)
-      {
-         rcc = alarm->acknowledge(session, sticky, acknowledgmentActionTime, includeSubordinates);
-         objectId = alarm->getSourceObject();
-         break;
-      }
+      rcc = alarm->acknowledge(session, sticky, acknowledgmentActionTime, includeSubordinates);
+      objectId = alarm->getSourceObject();
    }
    s_alarmList.unlock();
 
@@ -1150,10 +1076,12 @@ uint32_t NXCORE_EXPORTABLE AckAlarmByHDRef(const TCHAR *hdref, GenericClientSess
 {
    uint32_t objectId, rcc = RCC_INVALID_ALARM_ID;
 
-   s_alarmList.lock();
+   s_alarmList.writeLock();
    for(int i = 0; i < s_alarmList.size(); i++)
    {
       Alarm *alarm = s_alarmList.get(i);
+      if (alarm == nullptr)
+         continue;
       if (!_tcscmp(alarm->getHelpDeskRef(), hdref))
       {
          rcc = alarm->acknowledge(session, sticky, acknowledgmentActionTime, false);
@@ -1234,80 +1162,71 @@ void NXCORE_EXPORTABLE ResolveAlarmsById(const IntegerArray<uint32_t>& alarmIds,
 {
    IntegerArray<uint32_t> processedAlarms, updatedObjects;
 
-   s_alarmList.lock();
+   s_alarmList.writeLock();
    time_t changeTime = time(nullptr);
    for(int i = 0; i < alarmIds.size(); i++)
    {
       uint32_t currentId = alarmIds.get(i);
 
-      int n;
-      for(n = 0; n < s_alarmList.size(); n++)
+      Alarm *alarm = s_alarmList.find(currentId);
+      if (alarm == nullptr)
       {
-         Alarm *alarm = s_alarmList.get(n);
-         if (alarm->getAlarmId() == currentId)
+         failIds->add(currentId);
+         failCodes->add(RCC_INVALID_ALARM_ID);
+         continue;
+      }
+
+      // If alarm is open in helpdesk, it cannot be terminated. Check with helpdesk system if it is closed now.
+      if (alarm->getHelpDeskState() == ALARM_HELPDESK_OPEN)
+      {
+         bool isOpen;
+         if (GetHelpdeskIssueState(alarm->getHelpDeskRef(), &isOpen) == RCC_SUCCESS)
          {
-            // If alarm is open in helpdesk, it cannot be terminated. Check with helpdesk system if it is closed now.
-            if (alarm->getHelpDeskState() == ALARM_HELPDESK_OPEN)
+            if (!isOpen)
+               alarm->onHelpdeskIssueClose();
+         }
+      }
+      if ((alarm->getHelpDeskState() != ALARM_HELPDESK_OPEN) || ConfigReadBoolean(_T("Alarms.IgnoreHelpdeskState"), false))
+      {
+         if (terminate || (alarm->getState() != ALARM_STATE_RESOLVED))
+         {
+            // Allow to resolve/terminate alarms for objects that are already deleted
+            shared_ptr<NetObj> object = FindObjectById(alarm->getSourceObject());
+            if ((session != nullptr) && (object != nullptr))
             {
-               bool isOpen;
-               if (GetHelpdeskIssueState(alarm->getHelpDeskRef(), &isOpen) == RCC_SUCCESS)
+               // If user does not have the required object access rights, the alarm cannot be terminated
+               if (!object->checkAccessRights(session->getUserId(), terminate ? OBJECT_ACCESS_TERM_ALARMS : OBJECT_ACCESS_UPDATE_ALARMS))
                {
-                  if (!isOpen)
-                     alarm->onHelpdeskIssueClose();
+                  failIds->add(currentId);
+                  failCodes->add(RCC_ACCESS_DENIED);
+                  continue;
                }
-            }
-            if ((alarm->getHelpDeskState() != ALARM_HELPDESK_OPEN) || ConfigReadBoolean(_T("Alarms.IgnoreHelpdeskState"), false))
-            {
-               if (terminate || (alarm->getState() != ALARM_STATE_RESOLVED))
-               {
-                  // Allow to resolve/terminate alarms for objects that are already deleted
-                  shared_ptr<NetObj> object = FindObjectById(alarm->getSourceObject());
-                  if ((session != nullptr) && (object != nullptr))
-                  {
-                     // If user does not have the required object access rights, the alarm cannot be terminated
-                     if (!object->checkAccessRights(session->getUserId(), terminate ? OBJECT_ACCESS_TERM_ALARMS : OBJECT_ACCESS_UPDATE_ALARMS))
-                     {
-                        failIds->add(currentId);
-                        failCodes->add(RCC_ACCESS_DENIED);
-                        break;
-                     }
-
-                     session->writeAuditLog(AUDIT_OBJECTS, true, object->getId(),
-                        _T("%s alarm %d (%s) on object %s"), terminate ? _T("Terminated") : _T("Resolved"),
-                        alarm->getAlarmId(), alarm->getMessage(), object->getName());
-                  }
 
-                  alarm->resolve((session != nullptr) ? session->getUserId() : 0, nullptr, terminate, false, includeSubordinates);
-                  processedAlarms.add(alarm->getAlarmId());
-                  if (object != nullptr)
-                  {
-                     if (!updatedObjects.contains(object->getId()))
-                        updatedObjects.add(object->getId());
-                  }
-                  if (terminate)
-                  {
-                     s_alarmList.remove(n);
-                     n--;
-                  }
-               }
-               else
-               {
-                  // Alarm is already resolved, just mark it as processed
-                  processedAlarms.add(alarm->getAlarmId());
-               }
+               session->writeAuditLog(AUDIT_OBJECTS, true, object->getId(),
+                  _T("%s alarm %d (%s) on object %s"), terminate ? _T("Terminated") : _T("Resolved"),
+                  alarm->getAlarmId(), alarm->getMessage(), object->getName());
             }
-            else
+
+            alarm->resolve((session != nullptr) ? session->getUserId() : 0, nullptr, terminate, false, includeSubordinates);
+            processedAlarms.add(alarm->getAlarmId());
+            if (object != nullptr)
             {
-               failIds->add(currentId);
-               failCodes->add(RCC_ALARM_OPEN_IN_HELPDESK);
+               if (!updatedObjects.contains(object->getId()))
+                  updatedObjects.add(object->getId());
             }
-            break;
+            if (terminate)
+               s_alarmList.remove(alarm);
+         }
+         else
+         {
+            // Alarm is already resolved, just mark it as processed
+            processedAlarms.add(alarm->getAlarmId());
          }
       }
-      if (n == s_alarmList.size())
+      else
       {
          failIds->add(currentId);
-         failCodes->add(RCC_INVALID_ALARM_ID);
+         failCodes->add(RCC_ALARM_OPEN_IN_HELPDESK);
       }
    }
    s_alarmList.unlock();
@@ -1336,10 +1255,12 @@ static void ResolveAlarmByKeyRegexp(const TCHAR *keyPattern, bool terminate, Eve
       IntegerArray<uint32_t> objectList;
       int ovector[60];
 
-      s_alarmList.lock();
+      s_alarmList.writeLock();
       for(int i = 0; i < s_alarmList.size(); i++)
       {
          Alarm *alarm = s_alarmList.get(i);
+         if (alarm == nullptr)
+            continue;
          const TCHAR *key = alarm->getKey();
          if ((_pcre_exec_t(preg, nullptr, reinterpret_cast<const PCRE_TCHAR*>(key), static_cast<int>(_tcslen(key)), 0, 0, ovector, 60) >= 0) &&
              ((alarm->getHelpDeskState() != ALARM_HELPDESK_OPEN) || ConfigReadBoolean(_T("Alarms.IgnoreHelpdeskState"), false)) &&
@@ -1354,7 +1275,6 @@ static void ResolveAlarmByKeyRegexp(const TCHAR *keyPattern, bool terminate, Eve
             if (terminate)
             {
                s_alarmList.remove(i);
-               i--;
             }
          }
       }
@@ -1378,7 +1298,7 @@ static void ResolveAlarmByKeyRegexp(const TCHAR *keyPattern, bool terminate, Eve
 static void ResolveAlarmByKeyExact(const TCHAR *key, bool terminate, Event *event)
 {
    uint32_t objectId = 0;
-   s_alarmList.lock();
+   s_alarmList.writeLock();
    Alarm *alarm = s_alarmList.find(key);
    if ((alarm != nullptr) &&
        ((alarm->getHelpDeskState() != ALARM_HELPDESK_OPEN) || ConfigReadBoolean(_T("Alarms.IgnoreHelpdeskState"), false)) &&
@@ -1418,10 +1338,12 @@ void NXCORE_EXPORTABLE ResolveAlarmByDCObjectId(uint32_t dciId, bool terminate)
 {
    IntegerArray<uint32_t> objectList;
 
-   s_alarmList.lock();
+   s_alarmList.writeLock();
    for(int i = 0; i < s_alarmList.size(); i++)
    {
       Alarm *alarm = s_alarmList.get(i);
+      if (alarm == nullptr)
+         continue;
       if ((alarm->getDciId() == dciId) &&
           ((alarm->getHelpDeskState() != ALARM_HELPDESK_OPEN) || ConfigReadBoolean(_T("Alarms.IgnoreHelpdeskState"), false)) &&
           (terminate || (alarm->getState() != ALARM_STATE_RESOLVED)))
@@ -1435,7 +1357,6 @@ void NXCORE_EXPORTABLE ResolveAlarmByDCObjectId(uint32_t dciId, bool terminate)
          if (terminate)
          {
             s_alarmList.remove(i);
-            i--;
          }
       }
    }
@@ -1455,10 +1376,12 @@ uint32_t NXCORE_EXPORTABLE ResolveAlarmByHDRef(const TCHAR *hdref, GenericClient
    uint32_t objectId = 0;
    uint32_t rcc = RCC_INVALID_ALARM_ID;
 
-   s_alarmList.lock();
+   s_alarmList.writeLock();
    for(int i = 0; i < s_alarmList.size(); i++)
    {
       Alarm *alarm = s_alarmList.get(i);
+      if (alarm == nullptr)
+         continue;
       if (!_tcscmp(alarm->getHelpDeskRef(), hdref))
       {
          if (terminate || (alarm->getState() != ALARM_STATE_RESOLVED))
@@ -1548,18 +1471,14 @@ uint32_t OpenHelpdeskIssue(uint32_t alarmId, GenericClientSession *session, TCHA
    uint32_t rcc = RCC_INVALID_ALARM_ID;
    *hdref = 0;
 
-   s_alarmList.lock();
-   for(int i = 0; i < s_alarmList.size(); i++)
+   s_alarmList.writeLock();
+   Alarm *alarm = s_alarmList.find(alarmId);
+   if (alarm != nullptr)
    {
-      Alarm *alarm = s_alarmList.get(i);
-      if (alarm->getAlarmId() == alarmId)
-      {
-         if (alarm->checkCategoryAccess(session))
-            rcc = alarm->openHelpdeskIssue(hdref);
-         else
-            rcc = RCC_ACCESS_DENIED;
-         break;
-      }
+      if (alarm->checkCategoryAccess(session))
+         rcc = alarm->openHelpdeskIssue(hdref);
+      else
+         rcc = RCC_ACCESS_DENIED;
    }
    s_alarmList.unlock();
    return rcc;
@@ -1572,27 +1491,24 @@ uint32_t GetHelpdeskIssueUrlFromAlarm(uint32_t alarmId, uint32_t userId, TCHAR *
 {
    uint32_t rcc = RCC_INVALID_ALARM_ID;
 
-   s_alarmList.lock();
-   for(int i = 0; i < s_alarmList.size(); i++)
+   s_alarmList.readLock();
+   Alarm *alarm = s_alarmList.find(alarmId);
+   if (alarm != nullptr)
    {
-      if (s_alarmList.get(i)->getAlarmId() == alarmId)
+      if (alarm->checkCategoryAccess(session))
       {
-         if (s_alarmList.get(i)->checkCategoryAccess(session))
+         if ((alarm->getHelpDeskState() != ALARM_HELPDESK_IGNORED) && (alarm->getHelpDeskRef()[0] != 0))
          {
-            if ((s_alarmList.get(i)->getHelpDeskState() != ALARM_HELPDESK_IGNORED) && (s_alarmList.get(i)->getHelpDeskRef()[0] != 0))
-            {
-               rcc = GetHelpdeskIssueUrl(s_alarmList.get(i)->getHelpDeskRef(), url, size);
-            }
-            else
-            {
-               rcc = RCC_OUT_OF_STATE_REQUEST;
-            }
+            rcc = GetHelpdeskIssueUrl(alarm->getHelpDeskRef(), url, size);
          }
          else
          {
-            rcc = RCC_ACCESS_DENIED;
+            rcc = RCC_OUT_OF_STATE_REQUEST;
          }
-         break;
+      }
+      else
+      {
+         rcc = RCC_ACCESS_DENIED;
       }
    }
    s_alarmList.unlock();
@@ -1606,25 +1522,21 @@ uint32_t UnlinkHelpdeskIssueById(uint32_t alarmId, GenericClientSession *session
 {
    uint32_t rcc = RCC_INVALID_ALARM_ID;
 
-   s_alarmList.lock();
-   for(int i = 0; i < s_alarmList.size(); i++)
+   s_alarmList.writeLock();
+   Alarm *alarm = s_alarmList.find(alarmId);
+   if (alarm != nullptr)
    {
-      Alarm *alarm = s_alarmList.get(i);
-      if (alarm->getAlarmId() == alarmId)
+      if (session != nullptr)
       {
-         if (session != nullptr)
-         {
-            session->writeAuditLog(AUDIT_OBJECTS, true,
-               alarm->getSourceObject(), _T("Helpdesk issue %s unlinked from alarm %d (%s) on object %s"),
-               alarm->getHelpDeskRef(), alarm->getAlarmId(), alarm->getMessage(),
-               GetObjectName(alarm->getSourceObject(), _T("")));
-         }
-         alarm->unlinkFromHelpdesk();
+         session->writeAuditLog(AUDIT_OBJECTS, true,
+            alarm->getSourceObject(), _T("Helpdesk issue %s unlinked from alarm %d (%s) on object %s"),
+            alarm->getHelpDeskRef(), alarm->getAlarmId(), alarm->getMessage(),
+            GetObjectName(alarm->getSourceObject(), _T("")));
+      }
+      alarm->unlinkFromHelpdesk();
 			NotifyClients(NX_NOTIFY_ALARM_CHANGED, alarm);
 			alarm->updateInDatabase();
-         rcc = RCC_SUCCESS;
-         break;
-      }
+      rcc = RCC_SUCCESS;
    }
    s_alarmList.unlock();
 
@@ -1638,10 +1550,12 @@ uint32_t UnlinkHelpdeskIssueByHDRef(const TCHAR *hdref, GenericClientSession *se
 {
    uint32_t rcc = RCC_INVALID_ALARM_ID;
 
-   s_alarmList.lock();
+   s_alarmList.writeLock();
    for(int i = 0; i < s_alarmList.size(); i++)
    {
       Alarm *alarm = s_alarmList.get(i);
+      if (alarm == nullptr)
+         continue;
       if (!_tcscmp(alarm->getHelpDeskRef(), hdref))
       {
          if (session != nullptr)
@@ -1673,18 +1587,14 @@ void NXCORE_EXPORTABLE DeleteAlarm(uint32_t alarmId, bool objectCleanup)
 
    // Delete alarm from in-memory list
    if (!objectCleanup)  // otherwise already locked
-      s_alarmList.lock();
-   for(int i = 0; i < s_alarmList.size(); i++)
+      s_alarmList.writeLock();
+   Alarm *alarm = s_alarmList.find(alarmId);
+   if (alarm != nullptr)
    {
-      Alarm *alarm = s_alarmList.get(i);
-      if (alarm->getAlarmId() == alarmId)
-      {
-         objectId = alarm->getSourceObject();
-         NotifyClients(NX_NOTIFY_ALARM_DELETED, alarm);
-         s_alarmList.remove(i);
-         found = true;
-         break;
-      }
+      objectId = alarm->getSourceObject();
+      NotifyClients(NX_NOTIFY_ALARM_DELETED, alarm);
+      s_alarmList.remove(alarm);
+      found = true;
    }
    if (!objectCleanup)
       s_alarmList.unlock();
@@ -1711,17 +1621,18 @@ void NXCORE_EXPORTABLE DeleteAlarm(uint32_t alarmId, bool objectCleanup)
  */
 bool DeleteObjectAlarms(uint32_t objectId, DB_HANDLE hdb)
 {
-	s_alarmList.lock();
+	s_alarmList.writeLock();
 
-	// go through from end because s_alarmList.size() is decremented by DeleteAlarm()
-	for(int i = s_alarmList.size() - 1; i >= 0; i--)
+   // Copy alarm IDs because DeleteAlarm() will modify source object index
+   const ObjectArray<Alarm> *alarms = s_alarmList.getObjectAlarms(objectId);
+   if (alarms != nullptr)
    {
-      Alarm *alarm = s_alarmList.get(i);
-		if (alarm->getSourceObject() == objectId)
-      {
-			DeleteAlarm(alarm->getAlarmId(), true);
-      }
-	}
+      IntegerArray<uint32_t> alarmIds(alarms->size());
+      for(int i = 0; i < alarms->size(); i++)
+         alarmIds.add(alarms->get(i)->getAlarmId());
+      for(int i = 0; i < alarmIds.size(); i++)
+         DeleteAlarm(alarmIds.get(i), true);
+   }
 
 	s_alarmList.unlock();
 
@@ -1800,34 +1711,30 @@ uint32_t NXCORE_EXPORTABLE GetAlarm(uint32_t alarmId, NXCPMessage *msg, GenericC
 {
    uint32_t rcc = RCC_INVALID_ALARM_ID;
 
-   s_alarmList.lock();
-   for(int i = 0; i < s_alarmList.size(); i++)
+   s_alarmList.readLock();
+   Alarm *alarm = s_alarmList.find(alarmId);
+   if (alarm != nullptr)
    {
-      Alarm *alarm = s_alarmList.get(i);
-      if (alarm->getAlarmId() == alarmId)
+      if (alarm->checkCategoryAccess(session))
       {
-         if (alarm->checkCategoryAccess(session))
-         {
-            alarm->fillMessage(msg);
-            rcc = RCC_SUCCESS;
-         }
-         else
-         {
-            rcc = RCC_ACCESS_DENIED;
-         }
-         break;
+         alarm->fillMessage(msg);
+         rcc = RCC_SUCCESS;
+      }
+      else
+      {
+         rcc = RCC_ACCESS_DENIED;
       }
    }
    s_alarmList.unlock();
 
    if (rcc == RCC_INVALID_ALARM_ID)
    {
-      Alarm *alarm = LoadAlarmFromDatabase(alarmId);
-      if (alarm != nullptr)
+      Alarm *terminatedAlarm = LoadAlarmFromDatabase(alarmId);
+      if (terminatedAlarm != nullptr)
       {
-         if (alarm->checkCategoryAccess(session))
+         if (terminatedAlarm->checkCategoryAccess(session))
          {
-            alarm->fillMessage(msg);
+            terminatedAlarm->fillMessage(msg);
             rcc = RCC_SUCCESS;
          }
          else
@@ -1835,7 +1742,7 @@ uint32_t NXCORE_EXPORTABLE GetAlarm(uint32_t alarmId, NXCPMessage *msg, GenericC
             rcc = RCC_ACCESS_DENIED;
          }
       }
-      delete alarm;
+      delete terminatedAlarm;
    }
 
    return rcc;
@@ -1849,31 +1756,27 @@ uint32_t NXCORE_EXPORTABLE GetAlarmEvents(uint32_t alarmId, NXCPMessage *msg, Ge
 {
    uint32_t rcc = RCC_INVALID_ALARM_ID;
 
-   s_alarmList.lock();
-   for(int i = 0; i < s_alarmList.size(); i++)
+   s_alarmList.readLock();
+   Alarm *alarm = s_alarmList.find(alarmId);
+   if (alarm != nullptr)
    {
-      if (s_alarmList.get(i)->getAlarmId() == alarmId)
+      if (alarm->checkCategoryAccess(session))
       {
-         if (s_alarmList.get(i)->checkCategoryAccess(session))
-         {
-            rcc = RCC_SUCCESS;
-         }
-         else
-         {
-            rcc = RCC_ACCESS_DENIED;
-         }
-         break;
+         rcc = RCC_SUCCESS;
+      }
+      else
+      {
+         rcc = RCC_ACCESS_DENIED;
       }
    }
-
    s_alarmList.unlock();
 
    if (rcc == RCC_INVALID_ALARM_ID)
    {
-      Alarm *alarm = LoadAlarmFromDatabase(alarmId);
-      if (alarm != nullptr)
+      Alarm *terminatedAlarm = LoadAlarmFromDatabase(alarmId);
+      if (terminatedAlarm != nullptr)
       {
-         if (alarm->checkCategoryAccess(session))
+         if (terminatedAlarm->checkCategoryAccess(session))
          {
             //No need to fill alarm events as alarm is terminated and there is no event history for it
             rcc = RCC_SUCCESS;
@@ -1883,7 +1786,7 @@ uint32_t NXCORE_EXPORTABLE GetAlarmEvents(uint32_t alarmId, NXCPMessage *msg, Ge
             rcc = RCC_ACCESS_DENIED;
          }
       }
-      delete alarm;
+      delete terminatedAlarm;
    }
    else if (rcc == RCC_SUCCESS)
    {
@@ -1903,15 +1806,11 @@ shared_ptr<NetObj> NXCORE_EXPORTABLE GetAlarmSourceObject(uint32_t alarmId, bool
    uint32_t objectId = 0;
 
    if (!alreadyLocked)
-      s_alarmList.lock();
-   for(int i = 0; i < s_alarmList.size(); i++)
+      s_alarmList.readLock();
+   Alarm *alarm = s_alarmList.find(alarmId);
+   if (alarm != nullptr)
    {
-      Alarm *alarm = s_alarmList.get(i);
-      if (alarm->getAlarmId() == alarmId)
-      {
-         objectId = alarm->getSourceObject();
-         break;
-      }
+      objectId = alarm->getSourceObject();
    }
 
    if (!alreadyLocked)
@@ -1945,10 +1844,12 @@ shared_ptr<NetObj> NXCORE_EXPORTABLE GetAlarmSourceObject(const TCHAR *hdref)
 {
    UINT32 objectId = 0;
 
-   s_alarmList.lock();
+   s_alarmList.readLock();
    for(int i = 0; i < s_alarmList.size(); i++)
    {
       Alarm *alarm = s_alarmList.get(i);
+      if (alarm == nullptr)
+         continue;
       if (!_tcscmp(alarm->getHelpDeskRef(), hdref))
       {
          objectId = alarm->getSourceObject();
@@ -1967,15 +1868,18 @@ int GetMostCriticalStatusForObject(uint32_t objectId)
 {
    int status = STATUS_UNKNOWN;
 
-   s_alarmList.lock();
-   for(int i = 0; (i < s_alarmList.size()) && (status != STATUS_CRITICAL); i++)
+   s_alarmList.readLock();
+   const ObjectArray<Alarm> *alarms = s_alarmList.getObjectAlarms(objectId);
+   if (alarms != nullptr)
    {
-      Alarm *alarm = s_alarmList.get(i);
-      if ((alarm->getSourceObject() == objectId) &&
-			 ((alarm->getState() & ALARM_STATE_MASK) < ALARM_STATE_RESOLVED) &&
-          ((alarm->getCurrentSeverity() > status) || (status == STATUS_UNKNOWN)))
+      for(int i = 0; (i < alarms->size()) && (status != STATUS_CRITICAL); i++)
       {
-         status = (int)alarm->getCurrentSeverity();
+         Alarm *alarm = alarms->get(i);
+         if (((alarm->getState() & ALARM_STATE_MASK) < ALARM_STATE_RESOLVED) &&
+             ((alarm->getCurrentSeverity() > status) || (status == STATUS_UNKNOWN)))
+         {
+            status = (int)alarm->getCurrentSeverity();
+         }
       }
    }
    s_alarmList.unlock();
@@ -1989,11 +1893,10 @@ void GetAlarmStats(NXCPMessage *pMsg)
 {
    UINT32 dwCount[5];
 
-   s_alarmList.lock();
-   pMsg->setField(VID_NUM_ALARMS, s_alarmList.size());
-   memset(dwCount, 0, sizeof(UINT32) * 5);
-   for(int i = 0; i < s_alarmList.size(); i++)
-      dwCount[s_alarmList.get(i)->getCurrentSeverity()]++;
+   s_alarmList.readLock();
+   pMsg->setField(VID_NUM_ALARMS, s_alarmList.count());
+   for(int i = 0; i < 5; i++)
+      dwCount[i] = s_alarmList.getSeverityCount(i);
    s_alarmList.unlock();
    pMsg->setFieldFromInt32Array(VID_ALARMS_BY_SEVERITY, 5, dwCount);
 }
@@ -2003,8 +1906,8 @@ void GetAlarmStats(NXCPMessage *pMsg)
  */
 int GetAlarmCount()
 {
-   s_alarmList.lock();
-   int count = s_alarmList.size();
+   s_alarmList.readLock();
+   int count = s_alarmList.count();
    s_alarmList.unlock();
    return count;
 }
@@ -2017,6 +1920,25 @@ uint64_t GetAlarmMemoryUsage()
    return s_alarmList.memoryUsage();
 }
 
+/**
+ * Check if watchdog should take any action on given alarm
+ */
+static inline bool IsWatchdogActionRequired(Alarm *alarm, time_t now)
+{
+   if ((alarm->getTimeout() > 0) &&
+       ((alarm->getState() & ALARM_STATE_MASK) == ALARM_STATE_OUTSTANDING) &&
+       (((time_t)alarm->getLastChangeTime() + (time_t)alarm->getTimeout()) < now))
+      return true;
+   if ((alarm->getAckTimeout() != 0) &&
+       ((alarm->getState() & ALARM_STATE_STICKY) != 0) &&
+       (((time_t)alarm->getAckTimeout() <= now)))
+      return true;
+   return (s_resolveExpirationTime > 0) &&
+          ((alarm->getState() & ALARM_STATE_MASK) == ALARM_STATE_RESOLVED) &&
+          (alarm->getLastChangeTime() + s_resolveExpirationTime <= now) &&
+          (alarm->getHelpDeskState() != ALARM_HELPDESK_OPEN);
+}
+
 /**
  * Watchdog thread
  */
@@ -2029,11 +1951,26 @@ static void WatchdogThread()
 		if (!(g_flags & AF_SERVER_INITIALIZED))
 		   continue;   // Server not initialized yet
 
-		s_alarmList.lock();
-		time_t now = time(nullptr);
+      // Check under read lock first so that readers are not blocked when there is nothing to do
+      s_alarmList.readLock();
+      time_t now = time(nullptr);
+      bool actionRequired = false;
+      for(int i = 0; (i < s_alarmList.size()) && !actionRequired; i++)
+      {
+         Alarm *alarm = s_alarmList.get(i);
+         actionRequired = (alarm != nullptr) && IsWatchdogActionRequired(alarm, now);
+      }
+      s_alarmList.unlock();
+      if (!actionRequired)
+         continue;
+
+		s_alarmList.writeLock();
+		now = time(nullptr);
 	   for(int i = 0; i < s_alarmList.size(); i++)
 		{
          Alarm *alarm = s_alarmList.get(i);
+         if (alarm == nullptr)
+            continue;
 			if ((alarm->getTimeout() > 0) &&
 				 ((alarm->getState() & ALARM_STATE_MASK) == ALARM_STATE_OUTSTANDING) &&
 				 (((time_t)alarm->getLastChangeTime() + (time_t)alarm->getTimeout()) < now))
@@ -2085,7 +2022,6 @@ static void WatchdogThread()
                      alarm->getAlarmId(), alarm->getLastChangeTime(), s_resolveExpirationTime, (UINT32)now);
             alarm->resolve(0, nullptr, true, true, false);
             s_alarmList.remove(i);
-            i--;
 			}
 		}
 		s_alarmList.unlock();
@@ -2195,10 +2131,12 @@ uint32_t AddAlarmComment(const TCHAR *hdref, const TCHAR *text, uint32_t userId)
 {
    uint32_t rcc = RCC_INVALID_ALARM_ID;
 
-   s_alarmList.lock();
+   s_alarmList.writeLock();
    for(int i = 0; i < s_alarmList.size(); i++)
    {
       Alarm *alarm = s_alarmList.get(i);
+      if (alarm == nullptr)
+         continue;
       if (!_tcscmp(alarm->getHelpDeskRef(), hdref))
       {
          uint32_t id = 0;
@@ -2226,15 +2164,11 @@ uint32_t UpdateAlarmComment(uint32_t alarmId, uint32_t *noteId, const TCHAR *tex
 {
    uint32_t rcc = RCC_INVALID_ALARM_ID;
 
-   s_alarmList.lock();
-   for(int i = 0; i < s_alarmList.size(); i++)
+   s_alarmList.writeLock();
+   Alarm *alarm = s_alarmList.find(alarmId);
+   if (alarm != nullptr)
    {
-      Alarm *alarm = s_alarmList.get(i);
-      if (alarm->getAlarmId() == alarmId)
-      {
-         rcc = alarm->updateAlarmComment(noteId, text, userId, syncWithHelpdesk);
-         break;
-      }
+      rcc = alarm->updateAlarmComment(noteId, text, userId, syncWithHelpdesk);
    }
    s_alarmList.unlock();
 
@@ -2282,15 +2216,11 @@ uint32_t DeleteAlarmCommentByID(uint32_t alarmId, uint32_t noteId)
 {
    uint32_t rcc = RCC_INVALID_ALARM_ID;
 
-   s_alarmList.lock();
-   for(int i = 0; i < s_alarmList.size(); i++)
+   s_alarmList.writeLock();
+   Alarm *alarm = s_alarmList.find(alarmId);
+   if (alarm != nullptr)
    {
-      Alarm *alarm = s_alarmList.get(i);
-      if (alarm->getAlarmId() == alarmId)
-      {
-         rcc = alarm->deleteComment(noteId);
-         break;
-      }
+      rcc = alarm->deleteComment(noteId);
    }
    s_alarmList.unlock();
 
@@ -2393,15 +2323,31 @@ uint32_t GetAlarmComments(uint32_t alarmId, NXCPMessage *msg)
  */
 ObjectArray<Alarm> NXCORE_EXPORTABLE *GetAlarms(uint32_t objectId, bool recursive)
 {
-   s_alarmList.lock();
-   ObjectArray<Alarm> *result = new ObjectArray<Alarm>(s_alarmList.size(), 16, Ownership::True);
-   for(int i = 0; i < s_alarmList.size(); i++)
+   ObjectArray<Alarm> *result;
+   s_alarmList.readLock();
+   if ((objectId != 0) && !recursive)
    {
-      Alarm *alarm = s_alarmList.get(i);
-      if ((objectId == 0) || (alarm->getSourceObject() == objectId) ||
-          (recursive && IsParentObject(objectId, alarm->getSourceObject())))
+      const ObjectArray<Alarm> *alarms = s_alarmList.getObjectAlarms(objectId);
+      result = new ObjectArray<Alarm>((alarms != nullptr) ? alarms->size() : 0, 16, Ownership::True);
+      if (alarms != nullptr)
       {
-         result->add(new Alarm(alarm, true));
+         for(int i = 0; i < alarms->size(); i++)
+            result->add(new Alarm(alarms->get(i), true));
+      }
+   }
+   else
+   {
+      result = new ObjectArray<Alarm>(s_alarmList.count(), 16, Ownership::True);
+      for(int i = 0; i < s_alarmList.size(); i++)
+      {
+         Alarm *alarm = s_alarmList.get(i);
+         if (alarm == nullptr)
+            continue;
+         if ((objectId == 0) || (alarm->getSourceObject() == objectId) ||
+             (recursive && IsParentObject(objectId, alarm->getSourceObject())))
+         {
+            result->add(new Alarm(alarm, true));
+         }
       }
    }
    s_alarmList.unlock();
@@ -2432,7 +2378,7 @@ int F_FindAlarmByKey(int argc, NXSL_Value **argv, NXSL_Value **result, NXSL_VM *
 
    const TCHAR *key = argv[0]->getValueAsCString();
 
-   s_alarmList.lock();
+   s_alarmList.readLock();
    Alarm *alarm = s_alarmList.find(key);
    if (alarm != nullptr)
       alarm = new Alarm(alarm, false);
@@ -2453,10 +2399,12 @@ int F_FindAlarmByKeyRegex(int argc, NXSL_Value **argv, NXSL_Value **result, NXSL
    const TCHAR *key = argv[0]->getValueAsCString();
    Alarm *alarm = nullptr;
 
-   s_alarmList.lock();
+   s_alarmList.readLock();
    for(int i = 0; i < s_alarmList.size(); i++)
    {
       Alarm *a = s_alarmList.get(i);
+      if (a == nullptr)
+         continue;
       if (RegexpMatch(a->getKey(), key, TRUE))
       {
          alarm = new Alarm(a, false);
@@ -2477,7 +2425,7 @@ Alarm NXCORE_EXPORTABLE *FindAlarmById(UINT32 alarmId)
    if (alarmId == 0)
       return nullptr;
 
-   s_alarmList.lock();
+   s_alarmList.readLock();
    Alarm *alarm = s_alarmList.find(alarmId);
    if (alarm != nullptr)
       alarm = new Alarm(alarm, false);
@@ -2541,10 +2489,12 @@ static void RootCauseUpdateThread()
       s_rootCauseUpdateNeeded = false;
 
       ObjectArray<Alarm> updateList(0, 32, Ownership::True);
-      s_alarmList.lock();
+      s_alarmList.readLock();
       for(int i = 0; i < s_alarmList.size(); i++)
       {
          Alarm *a = s_alarmList.get(i);
+         if (a == nullptr)
+            continue;
          if ((*a->getRcaScriptName() != 0) && (a->getParentAlarmId() == 0))
          {
             updateList.add(new Alarm(a, false));
@@ -2573,7 +2523,7 @@ static void RootCauseUpdateThread()
                   nxlog_debug_tag(DEBUG_TAG, 5, _T("Background root cause analysis script in has found parent alarm %u (%s)"),
                            parentAlarmId, static_cast<Alarm*>(result->getValueAsObject()->getData())->getMessage());
 
-                  s_alarmList.lock();
+                  s_alarmList.writeLock();
                   Alarm *originalAlarm = s_alarmList.find(alarm->getAlarmId());
                   if (originalAlarm != nullptr)
                   {
@@ -2646,6 +2596,8 @@ bool InitAlarmManager()
    for(int i = 0; i < s_alarmList.size(); i++)
    {
       Alarm *curr = s_alarmList.get(i);
+      if (curr == nullptr)
+         continue;
       if (curr->getParentAlarmId() != 0)
       {
          Alarm *parent = s_alarmList.find(curr->getParentAlarmId());
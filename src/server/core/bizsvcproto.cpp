@@ -534,7 +534,7 @@ bool BusinessServicePrototype::lockForInstanceDiscoveryPoll()
 {
    bool success = false;
    lockProperties();
-   if (static_cast<uint32_t>(time(nullptr) - m_instancePollState.getLastCompleted()) > getCustomAttributeAsUInt32(_T("SysConfig:DataCollection.InstancePollingInterval"), g_instancePollingInterval))
+   if (m_instancePollState.isDue(getCustomAttributeAsUInt32(_T("SysConfig:DataCollection.InstancePollingInterval"), g_instancePollingInterval)))
    {
       success = m_instancePollState.schedule();
    }
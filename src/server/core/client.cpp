@@ -44,7 +44,7 @@ static RWLock s_sessionListLock;
 static session_id_t *s_freeList = nullptr;
 static size_t s_freePos = 0;
 static ObjectArray<BackgroundSocketPollerHandle> s_pollers(8, 8, Ownership::True);
-static uint32_t s_maxClientSessionsPerPoller = std::min(256, SOCKET_POLLER_MAX_SOCKETS - 1);
+static uint32_t s_maxClientSessionsPerPoller = std::min(256, BACKGROUND_SOCKET_POLLER_MAX_SOCKETS - 1);
 
 /**
  * Register new session in list
@@ -154,8 +154,8 @@ static void ClientSessionManager()
 void InitClientListeners()
 {
    s_maxClientSessionsPerPoller = ConfigReadULong(_T("ClientConnector.MaxSessionsPerPoller"), s_maxClientSessionsPerPoller);
-   if (s_maxClientSessionsPerPoller > SOCKET_POLLER_MAX_SOCKETS - 1)
-      s_maxClientSessionsPerPoller = SOCKET_POLLER_MAX_SOCKETS - 1;
+   if (s_maxClientSessionsPerPoller > BACKGROUND_SOCKET_POLLER_MAX_SOCKETS - 1)
+      s_maxClientSessionsPerPoller = BACKGROUND_SOCKET_POLLER_MAX_SOCKETS - 1;
 
    s_freeList = MemAllocArrayNoInit<session_id_t>(g_maxClientSessions);
    for(int i = 0; i < g_maxClientSessions; i++)
@@ -920,6 +920,7 @@ void Cluster::onTemplateRemove(const shared_ptr<DataCollectionOwner>& templateOb
  */
 void Cluster::onDataCollectionChange()
 {
+   scheduleItemsForPolling();
    queueUpdate();
 }
 
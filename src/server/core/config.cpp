@@ -647,6 +647,7 @@ static void OnConfigVariableChange(bool isCLOB, const TCHAR *name, const TCHAR *
    else if (!_tcscmp(name, _T("ICMP.PollingInterval")))
    {
       g_icmpPollingInterval = ConvertToUint32(value, 60);
+      RescheduleAllPolls(PollerType::ICMP);
    }
    else if (!_tcscmp(name, _T("ICMP.StatisticPeriod")))
    {
@@ -694,6 +695,7 @@ static void OnConfigVariableChange(bool isCLOB, const TCHAR *name, const TCHAR *
    else if (!_tcscmp(name, _T("NetworkDiscovery.PassiveDiscovery.Interval")))
    {
       g_discoveryPollingInterval = ConvertToUint32(value, 900);
+      RescheduleAllPolls(PollerType::DISCOVERY);
    }
    else if (!_tcscmp(name, _T("NXSL.EnableContainerFunctions")))
    {
@@ -706,10 +708,12 @@ static void OnConfigVariableChange(bool isCLOB, const TCHAR *name, const TCHAR *
    else if (!_tcscmp(name, _T("Objects.AutobindPollingInterval")))
    {
       g_autobindPollingInterval = ConvertToUint32(value, 3600);
+      RescheduleAllPolls(PollerType::AUTOBIND);
    }
    else if (!_tcscmp(name, _T("Objects.ConfigurationPollingInterval")))
    {
       g_configurationPollingInterval = ConvertToUint32(value, 3600);
+      RescheduleAllPolls(PollerType::CONFIGURATION);
    }
    else if (!_tcscmp(name, _T("Objects.Interfaces.Enable8021xStatusPoll")))
    {
@@ -718,6 +722,7 @@ static void OnConfigVariableChange(bool isCLOB, const TCHAR *name, const TCHAR *
    else if (!_tcscmp(name, _T("Objects.NetworkMaps.UpdateInterval")))
    {
       g_mapUpdatePollingInterval = ConvertToUint32(value, 60);
+      RescheduleAllPolls(PollerType::MAP_UPDATE);
    }
    else if (!_tcscmp(name, _T("Objects.Nodes.ResolveDNSToIPOnStatusPoll")))
    {
@@ -749,6 +754,7 @@ static void OnConfigVariableChange(bool isCLOB, const TCHAR *name, const TCHAR *
    else if (!_tcscmp(name, _T("Objects.StatusPollingInterval")))
    {
       g_statusPollingInterval = ConvertToUint32(value, 60);
+      RescheduleAllPolls(PollerType::STATUS);
    }
    else if (!_tcscmp(name, _T("Objects.Subnets.DeleteEmpty")))
    {
@@ -34,7 +34,6 @@ struct SnmpTrap;
  */
 extern ObjectQueue<SnmpTrap> g_snmpTrapProcessorQueue;
 extern ObjectQueue<SnmpTrap> g_snmpTrapWriterQueue;
-extern ObjectQueue<SyslogMessage> g_syslogProcessingQueue;
 extern ObjectQueue<SyslogMessage> g_syslogWriteQueue;
 extern ObjectQueue<WindowsEvent> g_windowsEventProcessingQueue;
 extern ObjectQueue<WindowsEvent> g_windowsEventWriterQueue;
@@ -48,6 +47,9 @@ uint32_t BindAgentTunnel(uint32_t tunnelId, uint32_t nodeId, uint32_t userId);
 uint32_t UnbindAgentTunnel(uint32_t nodeId, uint32_t userId);
 int64_t GetEventLogWriterQueueSize();
 int64_t GetEventProcessorQueueSize();
+int64_t GetSyslogProcessingQueueSize();
+int64_t GetSyslogProcessingQueueSize(int processorId);
+int GetSyslogProcessorCount();
 void RangeScanCallback(const InetAddress& addr, int32_t zoneUIN, const Node *proxy, uint32_t rtt, const TCHAR *proto, ServerConsole *console, void *context);
 void CheckRange(const InetAddressListElement& range, void(*callback)(const InetAddress&, int32_t, const Node*, uint32_t, const TCHAR*, ServerConsole*, void*), ServerConsole *console, void *context);
 void ShowSyncerStats(ServerConsole *console);
@@ -83,7 +85,10 @@ bool NXCORE_EXPORTABLE IsCommand(const TCHAR *cmdTemplate, const TCHAR *str, int
 static void ShowMemoryUsage(ServerConsole *console)
 {
    console->printf(_T("Alarms ...................: %.02f MB\n"), static_cast<double>(GetAlarmMemoryUsage()) / 1048576);
-   console->printf(_T("Data collection cache ....: %.02f MB\n"), static_cast<double>(GetDCICacheMemoryUsage()) / 1048576);
+   uint64_t dciCacheLegacySize;
+   uint64_t dciCacheSize = GetDCICacheMemoryUsage(&dciCacheLegacySize);
+   console->printf(_T("Data collection cache ....: %.02f MB (%.02f MB with non-compact value storage)\n"),
+            static_cast<double>(dciCacheSize) / 1048576, static_cast<double>(dciCacheLegacySize) / 1048576);
    console->printf(_T("Raw DCI data write cache .: %.02f MB\n"), static_cast<double>(GetRawDataWriterMemoryUsage()) / 1048576);
    console->print(_T("\n"));
 }
@@ -1280,6 +1285,17 @@ int ProcessConsoleCommand(const TCHAR *command, ServerConsole *console)
       {
          PrintNetworkDeviceDriverList(console);
       }
+      else if (IsCommand(_T("NXSL"), szBuffer, 2))
+      {
+         NXSL_RegexpCacheStats stats;
+         NXSLGetRegexpCacheStats(&stats);
+         uint64_t total = stats.hits + stats.misses;
+         ConsoleWrite(console, _T("NXSL regular expression cache:\n"));
+         ConsolePrintf(console, _T("   Entries ....: %d (limit %d)\n"), stats.size, stats.limit);
+         ConsolePrintf(console, _T("   Hits .......: ") UINT64_FMT _T("\n"), stats.hits);
+         ConsolePrintf(console, _T("   Misses .....: ") UINT64_FMT _T("\n"), stats.misses);
+         ConsolePrintf(console, _T("   Hit ratio ..: %0.2f%%\n\n"), (total > 0) ? static_cast<double>(stats.hits) * 100.0 / static_cast<double>(total) : 0.0);
+      }
       else if (IsCommand(_T("OBJECTS"), szBuffer, 1))
       {
          // Get filter
@@ -1338,7 +1354,17 @@ int ProcessConsoleCommand(const TCHAR *command, ServerConsole *console)
          ShowQueueStats(console, GetDiscoveryPollerQueueSize(), _T("Node discovery poller"));
          ShowQueueStats(console, &g_snmpTrapProcessorQueue, _T("SNMP trap processor"));
          ShowQueueStats(console, &g_snmpTrapWriterQueue, _T("SNMP trap writer"));
-         ShowQueueStats(console, &g_syslogProcessingQueue, _T("Syslog processor"));
+         ShowQueueStats(console, GetSyslogProcessingQueueSize(), _T("Syslog processor"));
+         int syslogProcessorCount = GetSyslogProcessorCount();
+         if (syslogProcessorCount > 1)
+         {
+            for(int i = 1; i <= syslogProcessorCount; i++)
+            {
+               TCHAR name[64];
+               _sntprintf(name, 64, _T("Syslog processor #%d"), i);
+               ShowQueueStats(console, GetSyslogProcessingQueueSize(i), name);
+            }
+         }
          ShowQueueStats(console, &g_syslogWriteQueue, _T("Syslog writer"));
          ShowThreadPoolPendingQueue(console, g_schedulerThreadPool, _T("Scheduler"));
          ShowQueueStats(console, &g_windowsEventProcessingQueue, _T("Windows event processor"));
@@ -1870,6 +1896,7 @@ int ProcessConsoleCommand(const TCHAR *command, ServerConsole *console)
             _T("   show index <index>                - Show internal index\n")
             _T("   show modules                      - Show loaded server modules\n")
             _T("   show ndd                          - Show loaded network device drivers\n")
+            _T("   show nxsl                         - Show NXSL regular expression cache statistics\n")
             _T("   show objects [<filter>]           - Dump network objects to screen\n")
             _T("   show pe                           - Show registered prediction engines\n")
             _T("   show pollers                      - Show poller threads state information\n")
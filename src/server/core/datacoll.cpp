@@ -23,12 +23,23 @@
 #include "nxcore.h"
 #include <nxcore_websvc.h>
 #include <gauge_helpers.h>
+#include <vector>
 
 /**
  * Interval between DCI polling
  */
 #define ITEM_POLLING_INTERVAL             1
 
+/**
+ * Size of data collection scheduler's timing wheel (in seconds)
+ */
+#define DC_SCHEDULER_WHEEL_SIZE           4096
+
+/**
+ * Re-check interval (in seconds) for DCIs on unmanaged targets or targets with disabled data collection
+ */
+#define DC_INACTIVE_TARGET_RECHECK_INTERVAL  60
+
 /**
  * Thread pool for data collectors
  */
@@ -44,6 +55,97 @@ SharedObjectQueue<DCObjectInfo> g_dciCacheLoaderQueue;
  */
 uint32_t g_averageDCIQueuingTime = 0;
 
+/**
+ * Maximum number of SNMP DCIs from same node collected with single request
+ */
+static uint32_t s_snmpBatchSize = 32;
+
+/**
+ * Data collection scheduler entry
+ */
+struct DCScheduleEntry
+{
+   time_t due;
+   weak_ptr<DCObject> dcObject;
+
+   DCScheduleEntry(time_t _due, const shared_ptr<DCObject>& _dcObject) : dcObject(_dcObject)
+   {
+      due = _due;
+   }
+};
+
+/**
+ * Data collection schedule. Timing wheel with one slot per second; entries with due time beyond
+ * one wheel revolution stay in their slot until due. Each DCI has one active entry; entries with
+ * due time not matching scheduled poll time of DCI are stale and ignored.
+ */
+static std::vector<DCScheduleEntry> s_scheduleWheel[DC_SCHEDULER_WHEEL_SIZE];
+static time_t s_scheduleWheelPosition = 0;   // Last processed second
+static Mutex s_scheduleLock(MutexType::FAST);
+
+/**
+ * Scheduler statistics
+ */
+static VolatileCounter64 s_lateDCObjectCount = 0;
+static uint32_t s_schedulingLag = 0;
+
+/**
+ * Add entry to data collection schedule. Should be called with schedule lock held.
+ */
+static void AddScheduleEntry(const shared_ptr<DCObject>& dcObject, time_t due)
+{
+   if (due <= s_scheduleWheelPosition)
+      due = s_scheduleWheelPosition + 1;
+   dcObject->setScheduledPollTime(due);
+   s_scheduleWheel[due % DC_SCHEDULER_WHEEL_SIZE].emplace_back(due, dcObject);
+}
+
+/**
+ * Request check of given DCI by data collection scheduler as soon as possible (intended for use
+ * when DCI configuration or state changes)
+ */
+void ScheduleDCObjectPollNow(const shared_ptr<DCObject>& dcObject)
+{
+   shared_ptr<DataCollectionOwner> owner = dcObject->getOwner();
+   if ((owner == nullptr) || !owner->isDataCollectionTarget())
+      return;
+
+   time_t now = time(nullptr);
+   s_scheduleLock.lock();
+   time_t t = dcObject->getScheduledPollTime();
+   if ((t == 0) || (t > now))
+      AddScheduleEntry(dcObject, now);
+   s_scheduleLock.unlock();
+}
+
+/**
+ * Reschedule DCI after data collection
+ */
+static void RescheduleDCObject(const shared_ptr<DCObject>& dcObject)
+{
+   time_t next = dcObject->getNextPollCheckTime(time(nullptr));
+   s_scheduleLock.lock();
+   if (dcObject->getScheduledPollTime() != 0)
+      AddScheduleEntry(dcObject, next);
+   s_scheduleLock.unlock();
+}
+
+/**
+ * Get number of DCIs queued for polling later than scheduled since server start
+ */
+uint64_t GetLateScheduledDCObjectCount()
+{
+   return static_cast<uint64_t>(s_lateDCObjectCount);
+}
+
+/**
+ * Get data collection scheduling lag (average for last 5 minutes, in milliseconds)
+ */
+uint32_t GetDataCollectionSchedulingLag()
+{
+   return s_schedulingLag;
+}
+
 /**
  * GUIDs for NXSL script exit codes
  */
@@ -249,6 +351,49 @@ static shared_ptr<Table> GetTableData(DataCollectionTarget *dcTarget, const DCTa
 	return result;
 }
 
+/**
+ * Process result of data collection - transform and store received value into database or handle error
+ */
+static void ProcessCollectionResult(const shared_ptr<DCObject>& dcObject, uint32_t error, const TCHAR *value, const shared_ptr<Table>& table, time_t currTime)
+{
+   switch(error)
+   {
+      case DCE_SUCCESS:
+         if (dcObject->getStatus() == ITEM_STATUS_NOT_SUPPORTED)
+            dcObject->setStatus(ITEM_STATUS_ACTIVE, true);
+         static_cast<DataCollectionTarget*>(dcObject->getOwner().get())->processNewDCValue(dcObject, currTime, value, table);
+         break;
+      case DCE_COLLECTION_ERROR:
+         if (dcObject->getStatus() == ITEM_STATUS_NOT_SUPPORTED)
+            dcObject->setStatus(ITEM_STATUS_ACTIVE, true);
+         dcObject->processNewError(false);
+         break;
+      case DCE_NO_SUCH_INSTANCE:
+         if (dcObject->getStatus() == ITEM_STATUS_NOT_SUPPORTED)
+            dcObject->setStatus(ITEM_STATUS_ACTIVE, true);
+         dcObject->processNewError(true);
+         break;
+      case DCE_COMM_ERROR:
+         dcObject->processNewError(false);
+         break;
+      case DCE_NOT_SUPPORTED:
+         // Change item's status
+         dcObject->setStatus(ITEM_STATUS_NOT_SUPPORTED, true);
+         break;
+   }
+
+   // Send session notification when force poll is performed
+   if (dcObject->isForcePollRequested())
+   {
+      ClientSession *session = dcObject->processForcePoll();
+      if (session != nullptr)
+      {
+         session->notify(NX_NOTIFY_FORCE_DCI_POLL, dcObject->getOwnerId());
+         session->decRefCount();
+      }
+   }
+}
+
 /**
  * Data collector
  */
@@ -328,43 +473,7 @@ void DataCollector(const shared_ptr<DCObject>& dcObject)
                break;
          }
 
-         // Transform and store received value into database or handle error
-         switch(error)
-         {
-            case DCE_SUCCESS:
-               if (dcObject->getStatus() == ITEM_STATUS_NOT_SUPPORTED)
-                  dcObject->setStatus(ITEM_STATUS_ACTIVE, true);
-               static_cast<DataCollectionTarget*>(dcObject->getOwner().get())->processNewDCValue(dcObject, currTime, value, table);
-               break;
-            case DCE_COLLECTION_ERROR:
-               if (dcObject->getStatus() == ITEM_STATUS_NOT_SUPPORTED)
-                  dcObject->setStatus(ITEM_STATUS_ACTIVE, true);
-               dcObject->processNewError(false);
-               break;
-            case DCE_NO_SUCH_INSTANCE:
-               if (dcObject->getStatus() == ITEM_STATUS_NOT_SUPPORTED)
-                  dcObject->setStatus(ITEM_STATUS_ACTIVE, true);
-               dcObject->processNewError(true);
-               break;
-            case DCE_COMM_ERROR:
-               dcObject->processNewError(false);
-               break;
-            case DCE_NOT_SUPPORTED:
-               // Change item's status
-               dcObject->setStatus(ITEM_STATUS_NOT_SUPPORTED, true);
-               break;
-         }
-
-         // Send session notification when force poll is performed
-         if (dcObject->isForcePollRequested())
-         {
-            ClientSession *session = dcObject->processForcePoll();
-            if (session != nullptr)
-            {
-               session->notify(NX_NOTIFY_FORCE_DCI_POLL, dcObject->getOwnerId());
-               session->decRefCount();
-            }
-         }
+         ProcessCollectionResult(dcObject, error, value, table, currTime);
       }
    }
    else     /* target == nullptr */
@@ -377,23 +486,220 @@ void DataCollector(const shared_ptr<DCObject>& dcObject)
    // Update item's last poll time and clear busy flag so item can be polled again
    dcObject->setLastPollTime(currTime);
    dcObject->clearBusyFlag();
+   RescheduleDCObject(dcObject);
 }
 
 /**
- * Callback for queueing DCIs
+ * Collect batch of SNMP DCIs from same node
  */
-static void QueueItems(NetObj *object, uint32_t *watchdogId)
+static void SNMPBatchCollector(SharedObjectArray<DCObject> *batch)
 {
-   if (IsShutdownInProgress())
-      return;
+   // DCIs that require special handling are passed to generic data collector
+   shared_ptr<Node> node;
+   SharedObjectArray<DCObject> items(batch->size());
+   for(int i = 0; i < batch->size(); i++)
+   {
+      const shared_ptr<DCObject>& dcObject = batch->getShared(i);
+      shared_ptr<DataCollectionOwner> owner = dcObject->getOwner();
+      if (dcObject->isScheduledForDeletion() || (owner == nullptr) || (owner->getObjectClass() != OBJECT_NODE) || IsShutdownInProgress() ||
+          (static_cast<DataCollectionTarget*>(owner.get())->getEffectiveSourceNode(dcObject.get()) != 0))
+      {
+         DataCollector(dcObject);
+         continue;
+      }
+      if (node == nullptr)
+         node = static_pointer_cast<Node>(owner);
+      items.add(dcObject);
+   }
+   delete batch;
+
+   // Request DCIs with same SNMP port and version together
+   while(!items.isEmpty())
+   {
+      uint16_t port = items.get(0)->getSnmpPort();
+      SNMP_Version version = items.get(0)->getSnmpVersion();
+
+      SharedObjectArray<DCObject> group(items.size());
+      StringList names;
+      for(int i = 0; i < items.size();)
+      {
+         DCObject *dcObject = items.get(i);
+         if ((dcObject->getSnmpPort() == port) && (dcObject->getSnmpVersion() == version))
+         {
+            group.add(items.getShared(i));
+            names.add(dcObject->getName());
+            items.remove(i);
+         }
+         else
+         {
+            i++;
+         }
+      }
+
+      SNMPMetricRequest *requests = MemAllocArray<SNMPMetricRequest>(group.size());
+      for(int i = 0; i < group.size(); i++)
+      {
+         auto dci = static_cast<DCItem*>(group.get(i));
+         requests[i].name = names.get(i);
+         requests[i].interpretRawValue = dci->isInterpretSnmpRawValue() ? static_cast<int>(dci->getSnmpRawValueType()) : SNMP_RAWTYPE_NONE;
+      }
+
+      nxlog_debug_tag(DEBUG_TAG_DC_COLLECTOR, 8, _T("SNMPBatchCollector: collecting %d DCIs from node %s [%u]"), group.size(), node->getName(), node->getId());
+      node->getMetricsFromSNMP(port, version, requests, group.size(), s_snmpBatchSize);
+
+      time_t currTime = time(nullptr);
+      for(int i = 0; i < group.size(); i++)
+      {
+         const shared_ptr<DCObject>& dcObject = group.getShared(i);
+         if (!IsShutdownInProgress())
+            ProcessCollectionResult(dcObject, requests[i].error, requests[i].value, shared_ptr<Table>(), currTime);
+
+         // Update item's last poll time and clear busy flag so item can be polled again
+         dcObject->setLastPollTime(currTime);
+         dcObject->clearBusyFlag();
+         RescheduleDCObject(dcObject);
+      }
+      MemFree(requests);
+   }
+}
+
+/**
+ * Add SNMP DCI to batch
+ */
+void SNMPCollectionBatchBuilder::add(uint64_t key, const shared_ptr<DCObject>& dcObject)
+{
+   SharedObjectArray<DCObject> *batch = m_batches.get(key);
+   if (batch == nullptr)
+   {
+      batch = new SharedObjectArray<DCObject>();
+      m_batches.set(key, batch);
+   }
+   batch->add(dcObject);
+}
+
+/**
+ * Submit collected batches to data collector thread pool
+ */
+void SNMPCollectionBatchBuilder::dispatch()
+{
+   m_batches.forEach(
+      [] (const uint64_t& key, SharedObjectArray<DCObject> *batch) -> EnumerationCallbackResult
+      {
+         if (batch->size() == 1)
+         {
+            ThreadPoolExecuteSerialized(g_dataCollectorThreadPool, key, DataCollector, batch->getShared(0));
+            delete batch;
+         }
+         else
+         {
+            ThreadPoolExecuteSerialized(g_dataCollectorThreadPool, key, SNMPBatchCollector, batch);
+         }
+         return _CONTINUE;
+      });
+   m_batches.clear();
+}
+
+/**
+ * Process data collection schedule entry. Returns true if DCI was queued for polling.
+ */
+static bool ProcessScheduleEntry(const DCScheduleEntry& e, time_t now, SNMPCollectionBatchBuilder *snmpBatches)
+{
+   shared_ptr<DCObject> dcObject = e.dcObject.lock();
+   if (dcObject == nullptr)
+      return false;
 
-   WatchdogNotify(*watchdogId);
-	nxlog_debug_tag(DEBUG_TAG_DC_POLLER, 8, _T("ItemPoller: calling DataCollectionTarget::queueItemsForPolling for object %s [%u]"), object->getName(), object->getId());
-	static_cast<DataCollectionTarget*>(object)->queueItemsForPolling();
+   s_scheduleLock.lock();
+   bool stale = (dcObject->getScheduledPollTime() != e.due);
+   s_scheduleLock.unlock();
+   if (stale)
+      return false;
+
+   shared_ptr<DataCollectionOwner> owner = dcObject->getOwner();
+   if ((owner == nullptr) || !owner->isDataCollectionTarget() || dcObject->isScheduledForDeletion())
+   {
+      // DCI was deleted or moved, drop entry
+      s_scheduleLock.lock();
+      if (dcObject->getScheduledPollTime() == e.due)
+         dcObject->setScheduledPollTime(0);
+      s_scheduleLock.unlock();
+      return false;
+   }
+
+   DataCollectionTarget *target = static_cast<DataCollectionTarget*>(owner.get());
+   bool queued = target->queueItemForPolling(dcObject, now, snmpBatches);
+
+   // Do not check DCIs on inactive targets too often, they will be rescheduled on target's data collection configuration change
+   time_t next = !target->isDataCollectionActive() ?
+            now + DC_INACTIVE_TARGET_RECHECK_INTERVAL : dcObject->getNextPollCheckTime(now);
+
+   s_scheduleLock.lock();
+   if (dcObject->getScheduledPollTime() == e.due)   // could be rescheduled while entry was processed
+      AddScheduleEntry(dcObject, next);
+   s_scheduleLock.unlock();
+   return queued;
 }
 
 /**
- * Item poller thread: check nodes' items and put into the
+ * Process all data collection schedule entries that are due. Returns maximum scheduling lag (in milliseconds).
+ */
+static uint32_t ProcessSchedule(uint32_t watchdogId)
+{
+   int64_t startTime = GetCurrentTimeMs();
+   time_t now = static_cast<time_t>(startTime / 1000);
+   std::vector<DCScheduleEntry> entries;
+   uint32_t maxLag = 0;
+   SNMPCollectionBatchBuilder *snmpBatches = (s_snmpBatchSize > 1) ? new SNMPCollectionBatchBuilder() : nullptr;
+
+   s_scheduleLock.lock();
+   bool initial = (s_scheduleWheelPosition == 0);
+   if (now < s_scheduleWheelPosition)
+      s_scheduleWheelPosition = now - 1;  // System time moved backwards
+   time_t first = std::max(s_scheduleWheelPosition + 1, now - DC_SCHEDULER_WHEEL_SIZE + 1);
+   s_scheduleLock.unlock();
+
+   for(time_t t = first; (t <= now) && !IsShutdownInProgress(); t++)
+   {
+      // Take out due entries from slot, leaving entries for future wheel revolutions in place
+      s_scheduleLock.lock();
+      std::vector<DCScheduleEntry>& slot = s_scheduleWheel[t % DC_SCHEDULER_WHEEL_SIZE];
+      size_t keep = 0;
+      for(size_t i = 0; i < slot.size(); i++)
+      {
+         if (slot[i].due <= now)
+         {
+            entries.push_back(std::move(slot[i]));
+         }
+         else
+         {
+            if (keep != i)
+               slot[keep] = std::move(slot[i]);
+            keep++;
+         }
+      }
+      slot.erase(slot.begin() + keep, slot.end());
+      s_scheduleWheelPosition = t;
+      s_scheduleLock.unlock();
+
+      for(const DCScheduleEntry& e : entries)
+      {
+         if (ProcessScheduleEntry(e, now, snmpBatches) && !initial)
+         {
+            uint32_t lag = static_cast<uint32_t>(startTime - static_cast<int64_t>(e.due) * 1000);
+            if (lag > maxLag)
+               maxLag = lag;
+            if (now - e.due > ITEM_POLLING_INTERVAL)
+               InterlockedIncrement64(&s_lateDCObjectCount);
+         }
+      }
+      entries.clear();
+      WatchdogNotify(watchdogId);
+   }
+   delete snmpBatches;  // will dispatch collected batches
+   return maxLag;
+}
+
+/**
+ * Item poller thread: check scheduled items and put into the
  * data collector queue when data polling required
  */
 static void ItemPoller()
@@ -404,6 +710,7 @@ static void ItemPoller()
 
    uint32_t watchdogId = WatchdogAddThread(_T("Item Poller"), 10);
    GaugeData<uint32_t> queuingTime(ITEM_POLLING_INTERVAL, 300);
+   GaugeData<uint32_t> schedulingLag(ITEM_POLLING_INTERVAL, 300);
 
    while(!IsShutdownInProgress())
    {
@@ -413,13 +720,8 @@ static void ItemPoller()
       nxlog_debug_tag(DEBUG_TAG_DC_POLLER, 8, _T("ItemPoller: wakeup"));
 
       int64_t startTime = GetCurrentTimeMs();
-      g_idxAccessPointById.forEach(QueueItems, &watchdogId);
-      g_idxChassisById.forEach(QueueItems, &watchdogId);
-      g_idxClusterById.forEach(QueueItems, &watchdogId);
-      g_idxCollectorById.forEach(QueueItems, &watchdogId);
-		g_idxMobileDeviceById.forEach(QueueItems, &watchdogId);
-      g_idxNodeById.forEach(QueueItems, &watchdogId);
-		g_idxSensorById.forEach(QueueItems, &watchdogId);
+      schedulingLag.update(ProcessSchedule(watchdogId));
+      s_schedulingLag = static_cast<uint32_t>(schedulingLag.getAverage());
 
 		queuingTime.update(static_cast<uint32_t>(GetCurrentTimeMs() - startTime));
 		g_averageDCIQueuingTime = static_cast<uint32_t>(queuingTime.getAverage());
@@ -449,6 +751,7 @@ static void CacheLoader()
             nxlog_debug_tag(DEBUG_TAG_DC_CACHE, 6, _T("Loading cache for DCI %s [%d] on %s [%d]"),
                      ref->getName(), ref->getId(), object->getName(), object->getId());
             static_cast<DCItem*>(dci.get())->reloadCache(false);
+            ScheduleDCObjectPollNow(dci);
          }
       }
    }
@@ -469,7 +772,13 @@ void InitDataCollector()
    g_dataCollectorThreadPool = ThreadPoolCreate(_T("DATACOLL"),
             ConfigReadInt(_T("ThreadPool.DataCollector.BaseSize"), 10),
             ConfigReadInt(_T("ThreadPool.DataCollector.MaxSize"), 250),
-            256 * 1024);
+            256 * 1024,
+            ConfigReadBoolean(_T("ThreadPool.DataCollector.WorkStealing"), false) ? THREAD_POOL_WORK_STEALING : 0);
+
+   s_snmpBatchSize = ConfigReadULong(_T("DataCollection.SNMP.BatchSize"), 32);
+   if (s_snmpBatchSize < 1)
+      s_snmpBatchSize = 1;
+   nxlog_debug_tag(DEBUG_TAG_DC_POLLER, 2, _T("SNMP data collection batch size set to %u"), s_snmpBatchSize);
 
    s_itemPollerThread = ThreadCreateEx(ItemPoller);
    s_cacheLoaderThread = ThreadCreateEx(CacheLoader);
@@ -73,6 +73,7 @@ struct IDataWriter
    const TCHAR *storageClass;
    int workerCount;   // Number of additional worker threads
    VolatileCounter pendingRequests;  // Requests taken from queue but not completed yet
+   bool bulkCopy;     // Use bulk copy instead of multi-row INSERT (PostgreSQL only)
 };
 
 /**
@@ -518,14 +519,65 @@ static void IDataWriteThreadSingleTable_Generic(IDataWriter *writer)
 }
 
 /**
- * Prepared PostgreSQL INSERT statement
+ * Prepared PostgreSQL INSERT statement or bulk copy data block
  */
 struct PreparedStatement_PostgreSQL
 {
    TCHAR *statement;
+   DBBulkCopyBuffer *copyData;
    int32_t numRecords;
 };
 
+/**
+ * Staging table for bulk copy. Data is copied into session-local staging table first
+ * and then merged into target table with ON CONFLICT DO NOTHING, so that duplicate
+ * records do not abort entire batch.
+ */
+#define IDATA_BULK_STAGE_TABLE _T("idata_bulk_stage")
+
+/**
+ * Start bulk copy into staging table. Should be called within transaction.
+ */
+static bool StartBulkCopy_PostgreSQL(DB_HANDLE hdb)
+{
+   if (!DBQuery(hdb, _T("CREATE TEMPORARY TABLE IF NOT EXISTS ") IDATA_BULK_STAGE_TABLE _T(" (item_id integer not null,idata_timestamp bigint not null,idata_value text null,raw_value text null) ON COMMIT DELETE ROWS")))
+      return false;
+
+   TCHAR errorText[DBDRV_MAX_ERROR_TEXT];
+   return DBBulkCopyBegin(hdb, IDATA_BULK_STAGE_TABLE _T(" (item_id,idata_timestamp,idata_value,raw_value)"), errorText);
+}
+
+/**
+ * Complete bulk copy and merge staging table into target table. If copy was not successful it will be cancelled.
+ */
+static bool CompleteBulkCopy_PostgreSQL(DB_HANDLE hdb, IDataWriter *writer, bool success)
+{
+   TCHAR errorText[DBDRV_MAX_ERROR_TEXT];
+   if (!DBBulkCopyEnd(hdb, !success, errorText) || !success)
+      return false;
+
+   TCHAR query[512];
+   if (writer->storageClass != nullptr)   // TimescaleDB
+   {
+      _sntprintf(query, 512, _T("INSERT INTO idata_sc_%s (item_id,idata_timestamp,idata_value,raw_value) SELECT item_id,to_timestamp(idata_timestamp),idata_value,raw_value FROM ") IDATA_BULK_STAGE_TABLE _T(" ON CONFLICT DO NOTHING"), writer->storageClass);
+   }
+   else
+   {
+      _tcscpy(query, _T("INSERT INTO idata (item_id,idata_timestamp,idata_value,raw_value) SELECT item_id,idata_timestamp,idata_value,raw_value FROM ") IDATA_BULK_STAGE_TABLE _T(" ON CONFLICT DO NOTHING"));
+   }
+   return DBQuery(hdb, query);
+}
+
+/**
+ * Free prepared PostgreSQL statement
+ */
+static inline void FreePreparedStatement_PostgreSQL(PreparedStatement_PostgreSQL *statement, SynchronizedObjectMemoryPool<PreparedStatement_PostgreSQL> *memoryPool)
+{
+   MemFree(statement->statement);
+   delete statement->copyData;
+   memoryPool->free(statement);
+}
+
 /**
  * Worker thread that prepares INSERT statements for PostgreSQL database
  */
@@ -558,6 +610,39 @@ static void QueryPrepareThread_PostgreSQL(IDataWriter *writer, ObjectQueue<Prepa
       if (rq == INVALID_POINTER_VALUE)   // End-of-job indicator
          break;
 
+      if (writer->bulkCopy)
+      {
+         auto copyData = new DBBulkCopyBuffer(maxRecordsPerStmt * 64);
+         while(true)
+         {
+            copyData->add(rq->dciId);
+            copyData->add(static_cast<int64_t>(rq->timestamp));
+            copyData->add(rq->transformedValue);
+            copyData->add(rq->rawValue);
+            copyData->endRow();
+            MemFree(rq);
+
+            if (copyData->rowCount() >= maxRecordsPerStmt)
+               break;
+
+            rq = writer->queue->getOrBlock(500);
+            if ((rq == nullptr) || (rq == INVALID_POINTER_VALUE))
+               break;
+         }
+
+         int count = copyData->rowCount();
+         InterlockedAdd(&writer->pendingRequests, count);
+         PreparedStatement_PostgreSQL *s = memoryPool->allocate();
+         s->statement = nullptr;
+         s->copyData = copyData;
+         s->numRecords = count;
+         statementQueue->put(s);
+
+         if (rq == INVALID_POINTER_VALUE)   // End-of-job indicator
+            break;
+         continue;
+      }
+
       query.append(queryBase);
       int count = 0;
       while(true)
@@ -595,6 +680,7 @@ static void QueryPrepareThread_PostgreSQL(IDataWriter *writer, ObjectQueue<Prepa
       InterlockedAdd(&writer->pendingRequests, count);
       PreparedStatement_PostgreSQL *s = memoryPool->allocate();
       s->statement = query.takeBuffer();
+      s->copyData = nullptr;
       s->numRecords = count;
       statementQueue->put(s);
 
@@ -672,10 +758,32 @@ static void IDataWriteThreadSingleTable_PostgreSQL(IDataWriter *writer)
             [writer, statement, &memoryPool] ()
             {
                DB_HANDLE hdb = DBConnectionPoolAcquireConnection();
-               DBQuery(hdb, statement->statement);
+               if (statement->copyData != nullptr)
+               {
+                  if (DBBegin(hdb))
+                  {
+                     TCHAR errorText[DBDRV_MAX_ERROR_TEXT];
+                     if (StartBulkCopy_PostgreSQL(hdb))
+                     {
+                        bool success = DBBulkCopyData(hdb, statement->copyData->data(), statement->copyData->size(), errorText);
+                        success = CompleteBulkCopy_PostgreSQL(hdb, writer, success);
+                        if (success)
+                           DBCommit(hdb);
+                        else
+                           DBRollback(hdb);
+                     }
+                     else
+                     {
+                        DBRollback(hdb);
+                     }
+                  }
+               }
+               else
+               {
+                  DBQuery(hdb, statement->statement);
+               }
                InterlockedAdd(&writer->pendingRequests, -statement->numRecords);
-               MemFree(statement->statement);
-               memoryPool.free(statement);
+               FreePreparedStatement_PostgreSQL(statement, &memoryPool);
                DBConnectionPoolReleaseConnection(hdb);
             });
       }
@@ -687,14 +795,27 @@ static void IDataWriteThreadSingleTable_PostgreSQL(IDataWriter *writer)
          DB_HANDLE hdb = DBConnectionPoolAcquireConnection();
          if (DBBegin(hdb))
          {
+            bool copyMode = (statement->copyData != nullptr);
+            bool copyStarted = copyMode && StartBulkCopy_PostgreSQL(hdb);
+            bool success = !copyMode || copyStarted;
             int count = 0;
             while(true)
             {
-               bool success = DBQuery(hdb, statement->statement);
+               if (copyMode)
+               {
+                  if (success)
+                  {
+                     TCHAR errorText[DBDRV_MAX_ERROR_TEXT];
+                     success = DBBulkCopyData(hdb, statement->copyData->data(), statement->copyData->size(), errorText);
+                  }
+               }
+               else
+               {
+                  success = DBQuery(hdb, statement->statement);
+               }
                count += statement->numRecords;
                InterlockedAdd(&writer->pendingRequests, -statement->numRecords);
-               MemFree(statement->statement);
-               memoryPool.free(statement);
+               FreePreparedStatement_PostgreSQL(statement, &memoryPool);
 
                if (!success || (count >= maxRecordsPerTxn))
                   break;
@@ -703,12 +824,21 @@ static void IDataWriteThreadSingleTable_PostgreSQL(IDataWriter *writer)
                if ((statement == nullptr) || (statement == INVALID_POINTER_VALUE))
                   break;
             }
-            DBCommit(hdb);
+            if (copyMode)
+            {
+               if (copyStarted && CompleteBulkCopy_PostgreSQL(hdb, writer, success))
+                  DBCommit(hdb);
+               else
+                  DBRollback(hdb);
+            }
+            else
+            {
+               DBCommit(hdb);
+            }
          }
          else
          {
-            MemFree(statement->statement);
-            memoryPool.free(statement);
+            FreePreparedStatement_PostgreSQL(statement, &memoryPool);
          }
          DBConnectionPoolReleaseConnection(hdb);
 
@@ -987,6 +1117,11 @@ void StartDBWriter()
 
 	if (g_flags & AF_SINGLE_TABLE_PERF_DATA)
 	{
+	   // Bulk copy is only used when supported by database driver, otherwise fall back to multi-row INSERT
+	   bool bulkCopy = ConfigReadBoolean(_T("DBWriter.UseBulkCopy"), true) && DBIsBulkCopySupported(g_dbDriver);
+	   if (bulkCopy)
+	      nxlog_debug_tag(DEBUG_TAG, 1, _T("Using bulk copy for idata writes"));
+
 	   // Always use single writer if performance data stored in single table
       switch(g_dbSyntax)
       {
@@ -1000,9 +1135,10 @@ void StartDBWriter()
          case DB_SYNTAX_PGSQL:
             s_idataWriters[0].storageClass = nullptr;
             s_idataWriters[0].queue = new ObjectQueue<DELAYED_IDATA_INSERT>(4096, Ownership::True, QueuedRequestDestructor);
-            s_idataWriters[0].thread = ThreadCreateEx(IDataWriteThreadSingleTable_PostgreSQL, &s_idataWriters[0]);
             s_idataWriters[0].workerCount = ConfigReadInt(_T("DBWriter.BackgroundWorkers"), 1);
             s_idataWriters[0].pendingRequests = 0;
+            s_idataWriters[0].bulkCopy = bulkCopy;
+            s_idataWriters[0].thread = ThreadCreateEx(IDataWriteThreadSingleTable_PostgreSQL, &s_idataWriters[0]);
             break;
          case DB_SYNTAX_TSDB:
             s_idataWriterCount = static_cast<int>(DCObjectStorageClass::OTHER) + 1;
@@ -1010,9 +1146,10 @@ void StartDBWriter()
             {
                s_idataWriters[i].storageClass = DCObject::getStorageClassName(static_cast<DCObjectStorageClass>(i));
                s_idataWriters[i].queue = new ObjectQueue<DELAYED_IDATA_INSERT>(4096, Ownership::True, QueuedRequestDestructor);
-               s_idataWriters[i].thread = ThreadCreateEx(IDataWriteThreadSingleTable_PostgreSQL, &s_idataWriters[i]);
                s_idataWriters[i].workerCount = ConfigReadInt(_T("DBWriter.BackgroundWorkers"), 1);
                s_idataWriters[i].pendingRequests = 0;
+               s_idataWriters[i].bulkCopy = bulkCopy;
+               s_idataWriters[i].thread = ThreadCreateEx(IDataWriteThreadSingleTable_PostgreSQL, &s_idataWriters[i]);
             }
             break;
          default:
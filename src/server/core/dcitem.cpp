@@ -31,18 +31,9 @@ DCItem::DCItem(const DCItem *src, bool shadowCopy) : DCObject(src, shadowCopy)
    m_dataType = src->m_dataType;
    m_deltaCalculation = src->m_deltaCalculation;
 	m_sampleCount = src->m_sampleCount;
-   m_cacheSize = shadowCopy ? src->m_cacheSize : 0;
    m_requiredCacheSize = shadowCopy ? src->m_requiredCacheSize : 0;
-   if (m_cacheSize > 0)
-   {
-      m_ppValueCache = MemAllocArray<ItemValue*>(m_cacheSize);
-      for(uint32_t i = 0; i < m_cacheSize; i++)
-         m_ppValueCache[i] = new ItemValue(*src->m_ppValueCache[i]);
-   }
-   else
-   {
-      m_ppValueCache = nullptr;
-   }
+   if (shadowCopy)
+      m_valueCache = src->m_valueCache;
    m_prevValueTimeStamp = shadowCopy ? src->m_prevValueTimeStamp : 0;
    m_cacheLoaded = shadowCopy ? src->m_cacheLoaded : false;
    m_anomalyDetected = shadowCopy ? src->m_anomalyDetected : false;
@@ -94,9 +85,7 @@ DCItem::DCItem(DB_HANDLE hdb, DB_RESULT hResult, int row, const shared_ptr<DataC
    m_instanceName = DBGetFieldAsSharedString(hResult, row, 11);
    m_templateItemId = DBGetFieldULong(hResult, row, 12);
    m_thresholds = nullptr;
-   m_cacheSize = 0;
    m_requiredCacheSize = 0;
-   m_ppValueCache = nullptr;
    m_prevValueTimeStamp = 0;
    m_cacheLoaded = false;
    m_anomalyDetected = false;
@@ -167,9 +156,7 @@ DCItem::DCItem(UINT32 id, const TCHAR *name, int source, int dataType, BYTE sche
    m_deltaCalculation = DCM_ORIGINAL_VALUE;
 	m_sampleCount = 0;
    m_thresholds = nullptr;
-   m_cacheSize = 0;
    m_requiredCacheSize = 0;
-   m_ppValueCache = nullptr;
    m_prevValueTimeStamp = 0;
    m_cacheLoaded = false;
    m_anomalyDetected = false;
@@ -188,9 +175,7 @@ DCItem::DCItem(ConfigEntry *config, const shared_ptr<DataCollectionOwner>& owner
    m_dataType = (BYTE)config->getSubEntryValueAsInt(_T("dataType"));
    m_deltaCalculation = (BYTE)config->getSubEntryValueAsInt(_T("delta"));
    m_sampleCount = (BYTE)config->getSubEntryValueAsInt(_T("samples"));
-   m_cacheSize = 0;
    m_requiredCacheSize = 0;
-   m_ppValueCache = nullptr;
    m_prevValueTimeStamp = 0;
    m_cacheLoaded = false;
    m_anomalyDetected = false;
@@ -246,11 +231,7 @@ void DCItem::deleteAllThresholds()
  */
 void DCItem::clearCache()
 {
-   for(uint32_t i = 0; i < m_cacheSize; i++)
-      delete m_ppValueCache[i];
-   MemFree(m_ppValueCache);
-   m_ppValueCache = nullptr;
-   m_cacheSize = 0;
+   m_valueCache.clear();
 }
 
 /**
@@ -397,7 +378,7 @@ bool DCItem::saveToDatabase(DB_HANDLE hdb)
          DBBind(hStmt, 1, DB_SQLTYPE_INTEGER, m_id);
          DBBind(hStmt, 2, DB_SQLTYPE_VARCHAR, m_prevRawValue.getString(), DB_BIND_STATIC, 255);
          DBBind(hStmt, 3, DB_SQLTYPE_INTEGER, static_cast<int64_t>(m_prevValueTimeStamp));
-         DBBind(hStmt, 4, DB_SQLTYPE_INTEGER, static_cast<int64_t>((m_cacheLoaded  && (m_cacheSize > 0)) ? m_ppValueCache[m_cacheSize - 1]->getTimeStamp() : 0));
+         DBBind(hStmt, 4, DB_SQLTYPE_INTEGER, static_cast<int64_t>((m_cacheLoaded  && (m_valueCache.size() > 0)) ? m_valueCache.last().getTimeStamp() : 0));
          DBBind(hStmt, 5, DB_SQLTYPE_VARCHAR, m_anomalyDetected ? _T("1") : _T("0"), DB_BIND_STATIC);
          success = DBExecute(hStmt);
          DBFreeStatement(hStmt);
@@ -428,7 +409,7 @@ void DCItem::checkThresholds(ItemValue &value)
 		Threshold *t = m_thresholds->get(i);
 		uint32_t thresholdId = t->getId();
       ItemValue checkValue, thresholdValue;
-      ThresholdCheckResult result = t->check(value, m_ppValueCache, checkValue, thresholdValue, owner, this);
+      ThresholdCheckResult result = t->check(value, m_valueCache, checkValue, thresholdValue, owner, this);
       t->setLastCheckedValue(checkValue);
       switch(result)
       {
@@ -552,6 +533,7 @@ void DCItem::createMessage(NXCPMessage *pMsg)
 void DCItem::deleteFromDatabase()
 {
 	DCObject::deleteFromDatabase();
+   InvalidateAnomalyModels(m_id);
 
    TCHAR query[256];
    _sntprintf(query, sizeof(query) / sizeof(TCHAR), _T("DELETE FROM items WHERE item_id=%u"), m_id);
@@ -571,6 +553,7 @@ void DCItem::deleteFromDatabase()
 void DCItem::updateFromMessage(const NXCPMessage& msg, uint32_t *numMaps, uint32_t **mapIndex, uint32_t **mapId)
 {
 	DCObject::updateFromMessage(msg);
+   InvalidateAnomalyModels(m_id);
 
    lock();
 
@@ -674,7 +657,7 @@ void DCItem::updateFromMessage(const NXCPMessage& msg, uint32_t *numMaps, uint32
  */
 bool DCItem::processNewValue(time_t tmTimeStamp, const TCHAR *originalValue, bool *updateStatus)
 {
-   ItemValue rawValue, *pValue;
+   ItemValue rawValue;
 
    *updateStatus = false;
 
@@ -690,26 +673,25 @@ bool DCItem::processNewValue(time_t tmTimeStamp, const TCHAR *originalValue, boo
    }
 
    // Create new ItemValue object and transform it as needed
-   pValue = new ItemValue(originalValue, tmTimeStamp);
+   ItemValue newValue(originalValue, tmTimeStamp);
    if (m_prevValueTimeStamp == 0)
-      m_prevRawValue = *pValue;  // Delta should be zero for first poll
-   rawValue = *pValue;
+      m_prevRawValue = newValue;  // Delta should be zero for first poll
+   rawValue = newValue;
 
    // Cluster can have only aggregated data, and transformation
    // should not be used on aggregation
    if ((owner->getObjectClass() != OBJECT_CLUSTER) || (m_flags & DCF_TRANSFORM_AGGREGATED))
    {
-      if (!transform(*pValue, (tmTimeStamp > m_prevValueTimeStamp) ? (tmTimeStamp - m_prevValueTimeStamp) : 0))
+      if (!transform(newValue, (tmTimeStamp > m_prevValueTimeStamp) ? (tmTimeStamp - m_prevValueTimeStamp) : 0))
       {
          unlock();
-         delete pValue;
          return false;
       }
    }
 
    m_errorCount = 0;
 
-   if (isStatusDCO() && (tmTimeStamp > m_prevValueTimeStamp) && ((m_cacheSize == 0) || !m_cacheLoaded || (pValue->getUInt32() != m_ppValueCache[0]->getUInt32())))
+   if (isStatusDCO() && (tmTimeStamp > m_prevValueTimeStamp) && ((m_valueCache.size() == 0) || !m_cacheLoaded || (newValue.getUInt32() != m_valueCache[0].getUInt32())))
    {
       *updateStatus = true;
    }
@@ -719,27 +701,27 @@ bool DCItem::processNewValue(time_t tmTimeStamp, const TCHAR *originalValue, boo
       if (m_flags & DCF_DETECT_ANOMALIES)
       {
          m_anomalyDetected =
-                  IsAnomalousValue(static_cast<DataCollectionTarget&>(*owner), *this, pValue->getDouble(), 0.75, 1, 30, 60) &&
-                  IsAnomalousValue(static_cast<DataCollectionTarget&>(*owner), *this, pValue->getDouble(), 0.75, 7, 10, 60);
-         nxlog_debug_tag(DEBUG_TAG_DC_POLLER, 6, _T("Value %f is %s"), pValue->getDouble(), m_anomalyDetected ? _T("an anomaly") : _T("not an anomaly"));
+                  IsAnomalousValue(static_cast<DataCollectionTarget&>(*owner), *this, newValue.getDouble(), 0.75, 1, 30, 60) &&
+                  IsAnomalousValue(static_cast<DataCollectionTarget&>(*owner), *this, newValue.getDouble(), 0.75, 7, 10, 60);
+         nxlog_debug_tag(DEBUG_TAG_DC_POLLER, 6, _T("Value %f is %s"), newValue.getDouble(), m_anomalyDetected ? _T("an anomaly") : _T("not an anomaly"));
       }
 
       m_prevRawValue = rawValue;
       m_prevValueTimeStamp = tmTimeStamp;
 
       // Save raw value into database
-      QueueRawDciDataUpdate(tmTimeStamp, m_id, originalValue, pValue->getString(), (m_cacheLoaded && (m_cacheSize > 0)) ? m_ppValueCache[m_cacheSize - 1]->getTimeStamp() : 0, m_anomalyDetected);
+      QueueRawDciDataUpdate(tmTimeStamp, m_id, originalValue, newValue.getString(), (m_cacheLoaded && (m_valueCache.size() > 0)) ? m_valueCache.last().getTimeStamp() : 0, m_anomalyDetected);
    }
 
 	// Check if user wants to collect all values or only changed values.
-   if (!isStoreChangesOnly() || (m_cacheLoaded && (m_cacheSize > 0) && _tcscmp(pValue->getString(), m_ppValueCache[0]->getString())))
+   if (!isStoreChangesOnly() || (m_cacheLoaded && (m_valueCache.size() > 0) && _tcscmp(newValue.getString(), m_valueCache[0].getString())))
    {
       //Save transformed value to database
       if (m_retentionType != DC_RETENTION_NONE)
-           QueueIDataInsert(tmTimeStamp, owner->getId(), m_id, originalValue, pValue->getString(), getStorageClass());
+           QueueIDataInsert(tmTimeStamp, owner->getId(), m_id, originalValue, newValue.getString(), getStorageClass());
 
       if (g_flags & AF_PERFDATA_STORAGE_DRIVER_LOADED)
-           PerfDataStorageRequest(this, tmTimeStamp, pValue->getString());
+           PerfDataStorageRequest(this, tmTimeStamp, newValue.getString());
    }
 
    // Update prediction engine
@@ -747,7 +729,7 @@ bool DCItem::processNewValue(time_t tmTimeStamp, const TCHAR *originalValue, boo
    {
       PredictionEngine *engine = FindPredictionEngine(m_predictionEngine);
       if (engine != nullptr)
-         engine->update(owner->getId(), m_id, getStorageClass(), tmTimeStamp, pValue->getDouble());
+         engine->update(owner->getId(), m_id, getStorageClass(), tmTimeStamp, newValue.getDouble());
    }
 
    // Check thresholds and add value to cache
@@ -762,7 +744,7 @@ bool DCItem::processNewValue(time_t tmTimeStamp, const TCHAR *originalValue, boo
          // shared pointer to DCI for additional background processing
          shared_ptr<DCItem> shadowCopy = make_shared<DCItem>(this, true);
          unlock();
-         shadowCopy->checkThresholds(*pValue);
+         shadowCopy->checkThresholds(newValue);
          lock();
 
          // Reconcile threshold updates
@@ -778,14 +760,14 @@ bool DCItem::processNewValue(time_t tmTimeStamp, const TCHAR *originalValue, boo
       }
       else
       {
-         checkThresholds(*pValue);
+         checkThresholds(newValue);
       }
    }
 
    // If DCI is related to interface and marked as inbound or outbound traffic indicator, update interface utilization
    if ((m_relatedObject != 0) && !m_systemTag.isEmpty() && (m_systemTag.str().startsWith(_T("iface-inbound-")) || m_systemTag.str().startsWith(_T("iface-outbound-"))))
    {
-      int64_t value = pValue->getInt64();
+      int64_t value = newValue.getInt64();
       if (value >= 0)
       {
          shared_ptr<Interface> iface = static_pointer_cast<Interface>(FindObjectById(m_relatedObject, OBJECT_INTERFACE));
@@ -823,34 +805,20 @@ bool DCItem::processNewValue(time_t tmTimeStamp, const TCHAR *originalValue, boo
       }
    }
 
-   if ((m_cacheSize > 0) && (tmTimeStamp >= m_prevValueTimeStamp))
+   if ((m_valueCache.size() > 0) && (tmTimeStamp >= m_prevValueTimeStamp))
    {
-      delete m_ppValueCache[m_cacheSize - 1];
-      memmove(&m_ppValueCache[1], m_ppValueCache, sizeof(ItemValue *) * (m_cacheSize - 1));
-      m_ppValueCache[0] = pValue;
+      m_valueCache.shiftIn(newValue);
       m_lastValueTimestamp = tmTimeStamp;
    }
    else if (!m_cacheLoaded && (m_requiredCacheSize == 1))
    {
       // If required cache size is 1 and we got value before cache loader
       // loads DCI cache then update it directly
-      for(uint32_t i = 0; i < m_cacheSize; i++)
-         delete m_ppValueCache[i];
-
-      if (m_cacheSize != m_requiredCacheSize)
-      {
-         m_ppValueCache = MemReallocArray(m_ppValueCache, m_requiredCacheSize);
-         m_cacheSize = m_requiredCacheSize;
-      }
-
-      m_ppValueCache[0] = pValue;
+      m_valueCache.resize(m_requiredCacheSize);
+      m_valueCache.shiftIn(newValue);
       m_cacheLoaded = true;
       m_lastValueTimestamp = tmTimeStamp;
    }
-   else
-   {
-      delete pValue;
-   }
 
    unlock();
 
@@ -994,7 +962,7 @@ void DCItem::generateEventsAfterMaintenance()
                .param(_T("dciId"), m_id, EventBuilder::OBJECT_ID_FORMAT)
                .param(_T("instance"), m_instanceName)
                .param(_T("isRepeatedEvent"), _T("0"))
-               .param(_T("dciValue"), (m_cacheLoaded && (m_cacheSize > 0)) ? m_ppValueCache[0]->getString() : _T(""))
+               .param(_T("dciValue"), (m_cacheLoaded && (m_valueCache.size() > 0)) ? m_valueCache[0].getString() : _T(""))
                .param(_T("operation"), t->getOperation())
                .param(_T("function"), t->getFunction())
                .param(_T("pollCount"), t->getSampleCount())
@@ -1011,7 +979,7 @@ void DCItem::generateEventsAfterMaintenance()
                .param(_T("instance"), m_instanceName)
                .param(_T("thresholdValue"), t->getStringValue())
                .param(_T("currentValue"), t->getLastCheckValue().getString())
-               .param(_T("dciValue"), (m_cacheLoaded && (m_cacheSize > 0)) ? m_ppValueCache[0]->getString() : _T(""))
+               .param(_T("dciValue"), (m_cacheLoaded && (m_valueCache.size() > 0)) ? m_valueCache[0].getString() : _T(""))
                .param(_T("operation"), t->getOperation())
                .param(_T("function"), t->getFunction())
                .param(_T("pollCount"), t->getSampleCount())
@@ -1269,37 +1237,22 @@ void DCItem::updateCacheSizeInternal(bool allowLoad)
    }
 
    nxlog_debug_tag(DEBUG_TAG_DC_CACHE, 8, _T("DCItem::updateCacheSizeInternal(dci=\"%s\", node=%s [%d]): requiredSize=%d cacheSize=%d"),
-            m_name.cstr(), owner->getName(), owner->getId(), m_requiredCacheSize, m_cacheSize);
+            m_name.cstr(), owner->getName(), owner->getId(), m_requiredCacheSize, m_valueCache.size());
 
    // Update cache if needed
-   if (m_requiredCacheSize < m_cacheSize)
+   if (m_requiredCacheSize < m_valueCache.size())
    {
       // Destroy unneeded values
-      if (m_cacheSize > 0)
-		{
-         for(uint32_t i = m_requiredCacheSize; i < m_cacheSize; i++)
-            delete m_ppValueCache[i];
-		}
-
-      m_cacheSize = m_requiredCacheSize;
-      if (m_cacheSize > 0)
-      {
-         m_ppValueCache = MemReallocArray(m_ppValueCache, m_cacheSize);
-      }
-      else
-      {
-         MemFree(m_ppValueCache);
-         m_ppValueCache = nullptr;
-      }
+      m_valueCache.resize(m_requiredCacheSize);
    }
-   else if (m_requiredCacheSize > m_cacheSize)
+   else if (m_requiredCacheSize > m_valueCache.size())
    {
       // Load missing values from database
       // Skip caching for DCIs where estimated time to fill the cache is less then 5 minutes
       // to reduce load on database at server startup
       if (allowLoad &&
           (m_ownerId != 0) &&
-          (((m_requiredCacheSize - m_cacheSize) * getEffectivePollingInterval() > 300) ||
+          (((m_requiredCacheSize - m_valueCache.size()) * getEffectivePollingInterval() > 300) ||
            (m_source == DS_PUSH_AGENT) ||
            (m_pollingScheduleType == DC_POLLING_SCHEDULE_ADVANCED)))
       {
@@ -1309,11 +1262,8 @@ void DCItem::updateCacheSizeInternal(bool allowLoad)
       else
       {
          // will not read data from database, fill cache with empty values
-         m_ppValueCache = MemReallocArray(m_ppValueCache, m_requiredCacheSize);
-         for(uint32_t i = m_cacheSize; i < m_requiredCacheSize; i++)
-            m_ppValueCache[i] = new ItemValue(_T(""), 1);
+         m_valueCache.resize(m_requiredCacheSize);
          nxlog_debug_tag(DEBUG_TAG_DC_CACHE, 7, _T("Cache load skipped for parameter %s [%u]"), m_name.cstr(), m_id);
-         m_cacheSize = m_requiredCacheSize;
          m_cacheLoaded = true;
       }
    }
@@ -1333,7 +1283,7 @@ void DCItem::loadCache()
 void DCItem::reloadCache(bool forceReload)
 {
    lock();
-   if (!forceReload && m_cacheLoaded && (m_cacheSize == m_requiredCacheSize))
+   if (!forceReload && m_cacheLoaded && (m_valueCache.size() == m_requiredCacheSize))
    {
       unlock();
       return;  // Cache already fully populated
@@ -1434,55 +1384,33 @@ void DCItem::reloadCache(bool forceReload)
 
    // While reload request was in queue DCI cache may have been already filled
    lock();
-   if (forceReload || !m_cacheLoaded || (m_cacheSize != m_requiredCacheSize))
+   if (forceReload || !m_cacheLoaded || (m_valueCache.size() != m_requiredCacheSize))
    {
-      for(uint32_t i = 0; i < m_cacheSize; i++)
-         delete m_ppValueCache[i];
-
-      if (m_cacheSize != m_requiredCacheSize)
-      {
-         m_ppValueCache = MemReallocArray(m_ppValueCache, m_requiredCacheSize);
-      }
-
       nxlog_debug_tag(DEBUG_TAG_DC_CACHE, 8, _T("DCItem::reloadCache(dci=\"%s\", node=%s [%d]): requiredSize=%d cacheSize=%d"),
-               m_name.cstr(), getOwnerName(), m_ownerId, m_requiredCacheSize, m_cacheSize);
+               m_name.cstr(), getOwnerName(), m_ownerId, m_requiredCacheSize, m_valueCache.size());
+
+      // Cache is filled with placeholder values (timestamp 1) on resize
+      m_valueCache.clear();
+      m_valueCache.resize(m_requiredCacheSize);
       if (hResult != nullptr)
       {
          // Create cache entries
-         bool moreData = true;
          uint32_t i;
-         for(i = 0; (i < m_requiredCacheSize) && moreData; i++)
+         for(i = 0; (i < m_requiredCacheSize) && DBFetch(hResult); i++)
          {
-            moreData = DBFetch(hResult);
-            if (moreData)
-            {
-               DBGetField(hResult, 0, szBuffer, MAX_DB_STRING);
-               m_ppValueCache[i] = new ItemValue(szBuffer, DBGetFieldULong(hResult, 1));
-            }
-            else
-            {
-               m_ppValueCache[i] = new ItemValue(_T(""), 1);   // Empty value
-            }
+            DBGetField(hResult, 0, szBuffer, MAX_DB_STRING);
+            m_valueCache.set(i, ItemValue(szBuffer, DBGetFieldULong(hResult, 1)));
          }
 
-         // Fill up cache with empty values if we don't have enough values in database
+         // Rest of the cache is already filled with empty values
          if (i < m_requiredCacheSize)
          {
             nxlog_debug_tag(DEBUG_TAG_DC_CACHE, 8, _T("DCItem::reloadCache(dci=\"%s\", node=%s [%d]): %d values missing in DB"),
                      m_name.cstr(), getOwnerName(), m_ownerId, m_requiredCacheSize - i);
-            for(; i < m_requiredCacheSize; i++)
-               m_ppValueCache[i] = new ItemValue(_T(""), 1);
          }
          DBFreeResult(hResult);
       }
-      else
-      {
-         // Error reading data from database, fill cache with empty values
-         for(uint32_t i = 0; i < m_requiredCacheSize; i++)
-            m_ppValueCache[i] = new ItemValue(_T(""), 1);
-      }
 
-      m_cacheSize = m_requiredCacheSize;
       m_cacheLoaded = true;
    }
    else if (hResult != nullptr)
@@ -1495,12 +1423,15 @@ void DCItem::reloadCache(bool forceReload)
 }
 
 /**
- * Get cache memory usage
+ * Get cache memory usage. If legacySize is not null, memory usage for cache with
+ * individually allocated fixed size values (used by previous versions) will be added to it.
  */
-uint64_t DCItem::getCacheMemoryUsage() const
+uint64_t DCItem::getCacheMemoryUsage(uint64_t *legacySize) const
 {
    lock();
-   uint64_t size = m_cacheSize * (sizeof(ItemValue) + sizeof(ItemValue*));
+   uint64_t size = m_valueCache.getMemoryUsage();
+   if (legacySize != nullptr)
+      *legacySize += static_cast<uint64_t>(m_valueCache.size()) * (sizeof(double) + sizeof(int64_t) + sizeof(uint64_t) + sizeof(time_t) + MAX_DB_STRING * sizeof(TCHAR) + sizeof(ItemValue*));
    unlock();
    return size;
 }
@@ -1512,12 +1443,12 @@ void DCItem::fillLastValueMessage(NXCPMessage *msg)
 {
    lock();
    msg->setField(VID_DCI_SOURCE_TYPE, m_source);
-   if (m_cacheSize > 0)
+   if (m_valueCache.size() > 0)
    {
       msg->setField(VID_DCI_DATA_TYPE, static_cast<uint16_t>(m_dataType));
-      msg->setField(VID_VALUE, m_ppValueCache[0]->getString());
+      msg->setField(VID_VALUE, m_valueCache[0].getString());
       msg->setField(VID_RAW_VALUE, m_prevRawValue.getString());
-      msg->setFieldFromTime(VID_TIMESTAMP, m_ppValueCache[0]->getTimeStamp());
+      msg->setFieldFromTime(VID_TIMESTAMP, m_valueCache[0].getTimeStamp());
    }
    else
    {
@@ -1541,11 +1472,11 @@ void DCItem::fillLastValueSummaryMessage(NXCPMessage *msg, uint32_t baseId, cons
    msg->setField(baseId++, m_flags);
    msg->setField(baseId++, m_description);
    msg->setField(baseId++, static_cast<uint16_t>(m_source));
-   if (m_cacheSize > 0)
+   if (m_valueCache.size() > 0)
    {
       msg->setField(baseId++, static_cast<uint16_t>(m_dataType));
-      msg->setField(baseId++, m_ppValueCache[0]->getString());
-      msg->setFieldFromTime(baseId++, m_ppValueCache[0]->getTimeStamp());
+      msg->setField(baseId++, m_valueCache[0].getString());
+      msg->setFieldFromTime(baseId++, m_valueCache[0].getTimeStamp());
    }
    else
    {
@@ -1659,14 +1590,14 @@ NXSL_Value *DCItem::getValueForNXSL(NXSL_VM *vm, int function, int sampleCount)
    {
       case F_LAST:
          // cache placeholders will have timestamp 1
-         value = (m_cacheLoaded && (m_cacheSize > 0) && (m_ppValueCache[0]->getTimeStamp() != 1)) ? vm->createValue(m_ppValueCache[0]->getString()) : vm->createValue();
+         value = (m_cacheLoaded && (m_valueCache.size() > 0) && (m_valueCache[0].getTimeStamp() != 1)) ? vm->createValue(m_valueCache[0].getString()) : vm->createValue();
          CastNXSLValue(value, m_dataType);
          break;
       case F_DIFF:
-         if (m_cacheLoaded && (m_cacheSize >= 2))
+         if (m_cacheLoaded && (m_valueCache.size() >= 2))
          {
             ItemValue result;
-            CalculateItemValueDiff(&result, m_dataType, *m_ppValueCache[0], *m_ppValueCache[1]);
+            CalculateItemValueDiff(&result, m_dataType, m_valueCache[0], m_valueCache[1]);
             value = vm->createValue(result.getString());
          }
          else
@@ -1675,10 +1606,10 @@ NXSL_Value *DCItem::getValueForNXSL(NXSL_VM *vm, int function, int sampleCount)
          }
          break;
       case F_AVERAGE:
-         if (m_cacheLoaded && (m_cacheSize > 0))
+         if (m_cacheLoaded && (m_valueCache.size() > 0))
          {
             ItemValue result;
-            CalculateItemValueAverage(&result, m_dataType, m_ppValueCache, std::min(m_cacheSize, static_cast<uint32_t>(sampleCount)));
+            CalculateItemValueAverage(&result, m_dataType, m_valueCache, std::min(m_valueCache.size(), static_cast<uint32_t>(sampleCount)));
             value = vm->createValue(result.getString());
             CastNXSLValue(value, m_dataType);
          }
@@ -1688,10 +1619,10 @@ NXSL_Value *DCItem::getValueForNXSL(NXSL_VM *vm, int function, int sampleCount)
          }
          break;
       case F_MEAN_DEVIATION:
-         if (m_cacheLoaded && (m_cacheSize > 0))
+         if (m_cacheLoaded && (m_valueCache.size() > 0))
          {
             ItemValue result;
-            CalculateItemValueMeanDeviation(&result, m_dataType, m_ppValueCache, std::min(m_cacheSize, static_cast<uint32_t>(sampleCount)));
+            CalculateItemValueMeanDeviation(&result, m_dataType, m_valueCache, std::min(m_valueCache.size(), static_cast<uint32_t>(sampleCount)));
             value = vm->createValue(result.getString());
          }
          else
@@ -1716,7 +1647,7 @@ NXSL_Value *DCItem::getValueForNXSL(NXSL_VM *vm, int function, int sampleCount)
 const TCHAR *DCItem::getLastValue()
 {
    lock();
-   const TCHAR *v = (m_cacheSize > 0) ? (const TCHAR *)m_ppValueCache[0]->getString() : nullptr;
+   const TCHAR *v = (m_valueCache.size() > 0) ? m_valueCache[0].getString() : nullptr;
    unlock();
    return v;
 }
@@ -1727,7 +1658,7 @@ const TCHAR *DCItem::getLastValue()
 ItemValue *DCItem::getInternalLastValue()
 {
    lock();
-   ItemValue *v = (m_cacheSize > 0) ? new ItemValue(*m_ppValueCache[0]) : nullptr;
+   ItemValue *v = (m_valueCache.size() > 0) ? new ItemValue(m_valueCache[0]) : nullptr;
    unlock();
    return v;
 }
@@ -1871,6 +1802,7 @@ bool DCItem::deleteAllData()
    unlock();
 
    DBConnectionPoolReleaseConnection(hdb);
+   InvalidateAnomalyModels(m_id);
 	return success;
 }
 
@@ -1909,13 +1841,11 @@ bool DCItem::deleteEntry(time_t timestamp)
       return false;
 
    lock();
-   for(uint32_t i = 0; i < m_cacheSize; i++)
+   for(uint32_t i = 0; i < m_valueCache.size(); i++)
    {
-      if (m_ppValueCache[i]->getTimeStamp() == timestamp)
+      if (m_valueCache[i].getTimeStamp() == timestamp)
       {
-         delete m_ppValueCache[i];
-         memmove(&m_ppValueCache[i], &m_ppValueCache[i + 1], sizeof(ItemValue *) * (m_cacheSize - (i + 1)));
-         m_cacheSize--;
+         m_valueCache.remove(i);
          updateCacheSizeInternal(true);
          break;
       }
@@ -1938,6 +1868,8 @@ void DCItem::updateFromTemplate(DCObject *src)
 		return;
 	}
 
+   InvalidateAnomalyModels(m_id);
+
    lock();
 	DCItem *item = static_cast<DCItem*>(src);
 
@@ -2367,11 +2299,9 @@ void DCItem::recalculateValue(ItemValue &value)
       m_prevValueTimeStamp = value.getTimeStamp();
    }
 
-   if ((m_cacheSize > 0) && (value.getTimeStamp() >= m_prevValueTimeStamp))
+   if ((m_valueCache.size() > 0) && (value.getTimeStamp() >= m_prevValueTimeStamp))
    {
-      delete m_ppValueCache[m_cacheSize - 1];
-      memmove(&m_ppValueCache[1], m_ppValueCache, sizeof(ItemValue *) * (m_cacheSize - 1));
-      m_ppValueCache[0] = new ItemValue(value);
+      m_valueCache.shiftIn(value);
    }
 
    m_lastPoll = value.getTimeStamp();
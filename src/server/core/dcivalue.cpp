@@ -26,7 +26,8 @@
  */
 ItemValue::ItemValue()
 {
-   m_string[0] = 0;
+   m_string = m_inlineString;
+   m_inlineString[0] = 0;
    m_int64 = 0;
    m_uint64 = 0;
    m_double = 0;
@@ -38,7 +39,8 @@ ItemValue::ItemValue()
  */
 ItemValue::ItemValue(const TCHAR *value, time_t timestamp)
 {
-   _tcslcpy(m_string, value, MAX_DB_STRING);
+   m_string = m_inlineString;
+   setString(value);
    m_int64 = _tcstoll(m_string, nullptr, 0);
    m_uint64 = _tcstoull(m_string, nullptr, 0);
    m_double = _tcstod(m_string, nullptr);
@@ -50,11 +52,73 @@ ItemValue::ItemValue(const TCHAR *value, time_t timestamp)
  */
 ItemValue::ItemValue(DB_RESULT hResult, int row, int column, bool parseSuffix)
 {
-   DBGetField(hResult, row, column, m_string, MAX_DB_STRING);
+   TCHAR buffer[MAX_DB_STRING];
+   DBGetField(hResult, row, column, buffer, MAX_DB_STRING);
+   m_string = m_inlineString;
+   setString(buffer);
    parseStringValue(parseSuffix);
    m_timestamp = time(nullptr);
 }
 
+/**
+ * Copy constructor
+ */
+ItemValue::ItemValue(const ItemValue& src)
+{
+   m_double = src.m_double;
+   m_int64 = src.m_int64;
+   m_uint64 = src.m_uint64;
+   m_timestamp = src.m_timestamp;
+   m_string = m_inlineString;
+   setString(src.m_string);
+}
+
+/**
+ * Assignment operator
+ */
+ItemValue& ItemValue::operator=(const ItemValue& src)
+{
+   if (&src == this)
+      return *this;
+   m_double = src.m_double;
+   m_int64 = src.m_int64;
+   m_uint64 = src.m_uint64;
+   m_timestamp = src.m_timestamp;
+   setString(src.m_string);
+   return *this;
+}
+
+/**
+ * Set string representation of the value. Short strings are kept in inline buffer,
+ * longer strings (up to MAX_DB_STRING - 1 characters) are allocated on heap.
+ */
+void ItemValue::setString(const TCHAR *value)
+{
+   size_t len = _tcslen(value);
+   if (len >= MAX_DB_STRING)
+      len = MAX_DB_STRING - 1;
+
+   if (len < ITEM_VALUE_INLINE_STRING_SIZE)
+   {
+      memmove(m_inlineString, value, len * sizeof(TCHAR));
+      m_inlineString[len] = 0;
+      if (m_string != m_inlineString)
+      {
+         MemFree(m_string);
+         m_string = m_inlineString;
+      }
+   }
+   else
+   {
+      TCHAR *s = MemAllocString(len + 1);
+      memcpy(s, value, len * sizeof(TCHAR));
+      s[len] = 0;
+      if (m_string != m_inlineString)
+         MemFree(m_string);
+      m_string = s;
+   }
+}
+
 /**
  * Parse string value
  */
@@ -110,7 +174,7 @@ void ItemValue::parseStringValue(bool parseSuffix)
  */
 void ItemValue::set(const TCHAR *value, bool parseSuffix)
 {
-   _tcslcpy(m_string, CHECK_NULL_EX(value), MAX_DB_STRING);
+   setString(CHECK_NULL_EX(value));
    parseStringValue(parseSuffix);
 }
 
@@ -121,9 +185,15 @@ void ItemValue::set(double value, const TCHAR *stringValue)
 {
    m_double = value;
    if (stringValue != nullptr)
-      _tcslcpy(m_string, stringValue, MAX_DB_STRING);
+   {
+      setString(stringValue);
+   }
    else
-      _sntprintf(m_string, MAX_DB_STRING, _T("%f"), m_double);
+   {
+      TCHAR buffer[MAX_DB_STRING];
+      _sntprintf(buffer, MAX_DB_STRING, _T("%f"), m_double);
+      setString(buffer);
+   }
    m_int64 = static_cast<int64_t>(m_double);
    m_uint64 = static_cast<uint64_t>(m_double);
 }
@@ -135,9 +205,14 @@ void ItemValue::set(int32_t value, const TCHAR *stringValue)
 {
    m_int64 = value;
    if (stringValue != nullptr)
-      _tcslcpy(m_string, stringValue, MAX_DB_STRING);
+   {
+      setString(stringValue);
+   }
    else
-      IntegerToString(value, m_string);
+   {
+      TCHAR buffer[64];
+      setString(IntegerToString(value, buffer));
+   }
    m_double = value;
    m_uint64 = value;
 }
@@ -149,9 +224,14 @@ void ItemValue::set(int64_t value, const TCHAR *stringValue)
 {
    m_int64 = value;
    if (stringValue != nullptr)
-      _tcslcpy(m_string, stringValue, MAX_DB_STRING);
+   {
+      setString(stringValue);
+   }
    else
-      IntegerToString(value, m_string);
+   {
+      TCHAR buffer[64];
+      setString(IntegerToString(value, buffer));
+   }
    m_double = static_cast<double>(m_int64);
    m_uint64 = static_cast<uint64_t>(m_int64);
 }
@@ -163,9 +243,14 @@ void ItemValue::set(uint32_t value, const TCHAR *stringValue)
 {
    m_uint64 = value;
    if (stringValue != nullptr)
-      _tcslcpy(m_string, stringValue, MAX_DB_STRING);
+   {
+      setString(stringValue);
+   }
    else
-      IntegerToString(value, m_string);
+   {
+      TCHAR buffer[64];
+      setString(IntegerToString(value, buffer));
+   }
    m_double = value;
    m_int64 = value;
 }
@@ -177,13 +262,136 @@ void ItemValue::set(uint64_t value, const TCHAR *stringValue)
 {
    m_uint64 = value;
    if (stringValue != nullptr)
-      _tcslcpy(m_string, stringValue, MAX_DB_STRING);
+   {
+      setString(stringValue);
+   }
    else
-      IntegerToString(value, m_string);
+   {
+      TCHAR buffer[64];
+      setString(IntegerToString(value, buffer));
+   }
    m_double = static_cast<double>(static_cast<int64_t>(m_uint64));
    m_int64 = static_cast<int64_t>(m_uint64);
 }
 
+/**
+ * Empty value for caches with zero capacity
+ */
+const ItemValue ItemValueCache::s_emptyValue;
+
+/**
+ * Copy values from another cache
+ */
+ItemValueCache& ItemValueCache::operator=(const ItemValueCache& src)
+{
+   if (&src == this)
+      return *this;
+   delete[] m_values;
+   m_capacity = src.m_capacity;
+   m_head = 0;
+   if (m_capacity > 0)
+   {
+      m_values = new ItemValue[m_capacity];
+      for(uint32_t i = 0; i < m_capacity; i++)
+         m_values[i] = src.get(i);
+   }
+   else
+   {
+      m_values = nullptr;
+   }
+   return *this;
+}
+
+/**
+ * Add new value to the cache. Oldest value is discarded.
+ */
+void ItemValueCache::shiftIn(const ItemValue& value)
+{
+   if (m_capacity == 0)
+      return;
+   m_head = (m_head == 0) ? m_capacity - 1 : m_head - 1;
+   m_values[m_head] = value;
+}
+
+/**
+ * Change cache size. Newest values are preserved, new slots are filled with
+ * placeholder values (timestamp 1).
+ */
+void ItemValueCache::resize(uint32_t size)
+{
+   if (size == m_capacity)
+      return;
+
+   if (size == 0)
+   {
+      clear();
+      return;
+   }
+
+   ItemValue *values = new ItemValue[size];
+   uint32_t i;
+   for(i = 0; (i < size) && (i < m_capacity); i++)
+      values[i] = get(i);
+   for(; i < size; i++)
+      values[i].setTimeStamp(1);
+
+   delete[] m_values;
+   m_values = values;
+   m_capacity = size;
+   m_head = 0;
+}
+
+/**
+ * Remove value at given position. Cache size is reduced by one.
+ */
+void ItemValueCache::remove(uint32_t index)
+{
+   if (index >= m_capacity)
+      return;
+
+   if (m_capacity == 1)
+   {
+      clear();
+      return;
+   }
+
+   ItemValue *values = new ItemValue[m_capacity - 1];
+   for(uint32_t i = 0, j = 0; i < m_capacity; i++)
+   {
+      if (i != index)
+         values[j++] = get(i);
+   }
+   delete[] m_values;
+   m_values = values;
+   m_capacity--;
+   m_head = 0;
+}
+
+/**
+ * Remove all values from cache
+ */
+void ItemValueCache::clear()
+{
+   delete[] m_values;
+   m_values = nullptr;
+   m_capacity = 0;
+   m_head = 0;
+}
+
+/**
+ * Get estimated memory usage by cache
+ */
+uint64_t ItemValueCache::getMemoryUsage() const
+{
+   uint64_t size = static_cast<uint64_t>(m_capacity) * sizeof(ItemValue);
+   for(uint32_t i = 0; i < m_capacity; i++)
+   {
+      if (!m_values[i].isStringInline())
+         size += (_tcslen(m_values[i].getString()) + 1) * sizeof(TCHAR);
+   }
+   return size;
+}
+
 /**
  * Signed diff for unsigned int32 values
  */
@@ -234,18 +442,34 @@ void CalculateItemValueDiff(ItemValue *result, int dataType, const ItemValue &cu
    }
 }
 
+/**
+ * Get value from array of value pointers
+ */
+static inline const ItemValue& ValueAt(const ItemValue * const *valueList, size_t index)
+{
+   return *valueList[index];
+}
+
+/**
+ * Get value from value cache
+ */
+static inline const ItemValue& ValueAt(const ItemValueCache& valueList, size_t index)
+{
+   return valueList[static_cast<uint32_t>(index)];
+}
+
 /**
  * Calculate average value for values of given type
  */
-template<typename T> static T CalculateAverage(const ItemValue * const *valueList, size_t sampleCount)
+template<typename T, typename L> static T CalculateAverage(const L& valueList, size_t sampleCount)
 {
    T sum = 0;
    int count = 0;
    for(size_t i = 0; i < sampleCount; i++)
    {
-      if (valueList[i]->getTimeStamp() != 1)
+      if (ValueAt(valueList, i).getTimeStamp() != 1)
       {
-         sum += static_cast<T>(*valueList[i]);
+         sum += static_cast<T>(ValueAt(valueList, i));
          count++;
       }
    }
@@ -255,7 +479,7 @@ template<typename T> static T CalculateAverage(const ItemValue * const *valueLis
 /**
  * Calculate average value for set of values
  */
-void CalculateItemValueAverage(ItemValue *result, int dataType, const ItemValue * const *valueList, size_t sampleCount)
+template<typename L> static void CalculateItemValueAverageInternal(ItemValue *result, int dataType, const L& valueList, size_t sampleCount)
 {
    switch(dataType)
    {
@@ -287,13 +511,13 @@ void CalculateItemValueAverage(ItemValue *result, int dataType, const ItemValue
 /**
  * Calculate total value for values of given type
  */
-template<typename T> static T CalculateSum(const ItemValue * const *valueList, size_t sampleCount)
+template<typename T, typename L> static T CalculateSum(const L& valueList, size_t sampleCount)
 {
    T sum = 0;
    for(size_t i = 0; i < sampleCount; i++)
    {
-      if (valueList[i]->getTimeStamp() != 1)
-         sum += static_cast<T>(*valueList[i]);
+      if (ValueAt(valueList, i).getTimeStamp() != 1)
+         sum += static_cast<T>(ValueAt(valueList, i));
    }
    return sum;
 }
@@ -301,7 +525,7 @@ template<typename T> static T CalculateSum(const ItemValue * const *valueList, s
 /**
  * Calculate total value for set of values
  */
-void CalculateItemValueTotal(ItemValue *result, int dataType, const ItemValue * const *valueList, size_t sampleCount)
+template<typename L> static void CalculateItemValueTotalInternal(ItemValue *result, int dataType, const L& valueList, size_t sampleCount)
 {
    switch(dataType)
    {
@@ -333,15 +557,15 @@ void CalculateItemValueTotal(ItemValue *result, int dataType, const ItemValue *
 /**
  * Calculate mean absolute deviation for values of given type
  */
-template<typename T, T (*ABS)(T)> static T CalculateMeanDeviation(const ItemValue * const *valueList, size_t sampleCount)
+template<typename T, T (*ABS)(T), typename L> static T CalculateMeanDeviation(const L& valueList, size_t sampleCount)
 {
    T mean = 0;
    int count = 0;
    for(size_t i = 0; i < sampleCount; i++)
    {
-      if (valueList[i]->getTimeStamp() != 1)
+      if (ValueAt(valueList, i).getTimeStamp() != 1)
       {
-         mean += static_cast<T>(*valueList[i]);
+         mean += static_cast<T>(ValueAt(valueList, i));
          count++;
       }
    }
@@ -349,8 +573,8 @@ template<typename T, T (*ABS)(T)> static T CalculateMeanDeviation(const ItemValu
    T dev = 0;
    for(size_t i = 0; i < sampleCount; i++)
    {
-      if (valueList[i]->getTimeStamp() != 1)
-         dev += ABS(static_cast<T>(*valueList[i]) - mean);
+      if (ValueAt(valueList, i).getTimeStamp() != 1)
+         dev += ABS(static_cast<T>(ValueAt(valueList, i)) - mean);
    }
    return dev / static_cast<T>(count);
 }
@@ -390,7 +614,7 @@ static uint64_t noop64(uint64_t v)
 /**
  * Calculate mean absolute deviation for set of values
  */
-void CalculateItemValueMeanDeviation(ItemValue *result, int dataType, const ItemValue * const *valueList, size_t sampleCount)
+template<typename L> static void CalculateItemValueMeanDeviationInternal(ItemValue *result, int dataType, const L& valueList, size_t sampleCount)
 {
    switch(dataType)
    {
@@ -422,15 +646,15 @@ void CalculateItemValueMeanDeviation(ItemValue *result, int dataType, const Item
 /**
  * Calculate min value for values of given type
  */
-template<typename T> static T CalculateMin(const ItemValue * const *valueList, size_t sampleCount)
+template<typename T, typename L> static T CalculateMin(const L& valueList, size_t sampleCount)
 {
    bool first = true;
    T value = 0;
    for(size_t i = 0; i < sampleCount; i++)
    {
-      if (valueList[i]->getTimeStamp() != 1)
+      if (ValueAt(valueList, i).getTimeStamp() != 1)
       {
-         T curr = static_cast<T>(*valueList[i]);
+         T curr = static_cast<T>(ValueAt(valueList, i));
          if (first || (curr < value))
          {
             value = curr;
@@ -444,7 +668,7 @@ template<typename T> static T CalculateMin(const ItemValue * const *valueList, s
 /**
  * Calculate min value for set of values
  */
-void CalculateItemValueMin(ItemValue *result, int dataType, const ItemValue * const *valueList, size_t sampleCount)
+template<typename L> static void CalculateItemValueMinInternal(ItemValue *result, int dataType, const L& valueList, size_t sampleCount)
 {
    switch(dataType)
    {
@@ -476,15 +700,15 @@ void CalculateItemValueMin(ItemValue *result, int dataType, const ItemValue * co
 /**
  * Calculate max value for values of given type
  */
-template<typename T> static T CalculateMax(const ItemValue * const *valueList, size_t sampleCount)
+template<typename T, typename L> static T CalculateMax(const L& valueList, size_t sampleCount)
 {
    bool first = true;
    T value = 0;
    for(size_t i = 0; i < sampleCount; i++)
    {
-      if (valueList[i]->getTimeStamp() != 1)
+      if (ValueAt(valueList, i).getTimeStamp() != 1)
       {
-         T curr = static_cast<T>(*valueList[i]);
+         T curr = static_cast<T>(ValueAt(valueList, i));
          if (first || (curr > value))
          {
             value = curr;
@@ -498,7 +722,7 @@ template<typename T> static T CalculateMax(const ItemValue * const *valueList, s
 /**
  * Calculate max value for set of values
  */
-void CalculateItemValueMax(ItemValue *result, int nDataType, const ItemValue * const *valueList, size_t sampleCount)
+template<typename L> static void CalculateItemValueMaxInternal(ItemValue *result, int nDataType, const L& valueList, size_t sampleCount)
 {
    switch(nDataType)
    {
@@ -526,3 +750,83 @@ void CalculateItemValueMax(ItemValue *result, int nDataType, const ItemValue * c
          break;
    }
 }
+
+/**
+ * Calculate average value for set of values
+ */
+void CalculateItemValueAverage(ItemValue *result, int dataType, const ItemValue * const *valueList, size_t sampleCount)
+{
+   CalculateItemValueAverageInternal(result, dataType, valueList, sampleCount);
+}
+
+/**
+ * Calculate average value for cached values
+ */
+void CalculateItemValueAverage(ItemValue *result, int dataType, const ItemValueCache& valueList, size_t sampleCount)
+{
+   CalculateItemValueAverageInternal(result, dataType, valueList, sampleCount);
+}
+
+/**
+ * Calculate mean absolute deviation for set of values
+ */
+void CalculateItemValueMeanDeviation(ItemValue *result, int dataType, const ItemValue * const *valueList, size_t sampleCount)
+{
+   CalculateItemValueMeanDeviationInternal(result, dataType, valueList, sampleCount);
+}
+
+/**
+ * Calculate mean absolute deviation for cached values
+ */
+void CalculateItemValueMeanDeviation(ItemValue *result, int dataType, const ItemValueCache& valueList, size_t sampleCount)
+{
+   CalculateItemValueMeanDeviationInternal(result, dataType, valueList, sampleCount);
+}
+
+/**
+ * Calculate total value for set of values
+ */
+void CalculateItemValueTotal(ItemValue *result, int dataType, const ItemValue * const *valueList, size_t sampleCount)
+{
+   CalculateItemValueTotalInternal(result, dataType, valueList, sampleCount);
+}
+
+/**
+ * Calculate total value for cached values
+ */
+void CalculateItemValueTotal(ItemValue *result, int dataType, const ItemValueCache& valueList, size_t sampleCount)
+{
+   CalculateItemValueTotalInternal(result, dataType, valueList, sampleCount);
+}
+
+/**
+ * Calculate min value for set of values
+ */
+void CalculateItemValueMin(ItemValue *result, int dataType, const ItemValue * const *valueList, size_t sampleCount)
+{
+   CalculateItemValueMinInternal(result, dataType, valueList, sampleCount);
+}
+
+/**
+ * Calculate min value for cached values
+ */
+void CalculateItemValueMin(ItemValue *result, int dataType, const ItemValueCache& valueList, size_t sampleCount)
+{
+   CalculateItemValueMinInternal(result, dataType, valueList, sampleCount);
+}
+
+/**
+ * Calculate max value for set of values
+ */
+void CalculateItemValueMax(ItemValue *result, int dataType, const ItemValue * const *valueList, size_t sampleCount)
+{
+   CalculateItemValueMaxInternal(result, dataType, valueList, sampleCount);
+}
+
+/**
+ * Calculate max value for cached values
+ */
+void CalculateItemValueMax(ItemValue *result, int dataType, const ItemValueCache& valueList, size_t sampleCount)
+{
+   CalculateItemValueMaxInternal(result, dataType, valueList, sampleCount);
+}
@@ -26,6 +26,16 @@
 #define DEBUG_TAG_DC_CONFIG      _T("dc.config")
 #define DEBUG_TAG_DC_SCHEDULER   _T("dc.scheduler")
 
+/**
+ * Re-check interval (in seconds) for objects which cannot be polled because of their configuration or state
+ */
+#define DC_BLOCKED_RECHECK_INTERVAL    60
+
+/**
+ * Re-check interval (in seconds) for objects waiting for cache load
+ */
+#define DC_PENDING_RECHECK_INTERVAL    5
+
 /**
  * Default retention time for collected data
  */
@@ -87,6 +97,8 @@ DCObject::DCObject(const shared_ptr<DataCollectionOwner>& owner) : m_owner(owner
    m_lastValueTimestamp = 0;
    m_schedules = nullptr;
    m_tLastCheck = 0;
+   m_scheduledPollTime = 0;
+   m_scheduleWithSeconds = false;
 	m_flags = 0;
    m_stateFlags = 0;
    m_errorCount = 0;
@@ -135,6 +147,8 @@ DCObject::DCObject(const DCObject *src, bool shadowCopy) :
    m_lastPoll = shadowCopy ? src->m_lastPoll : 0;
    m_lastValueTimestamp = shadowCopy ? src->m_lastValueTimestamp : 0;
    m_tLastCheck = shadowCopy ? src->m_tLastCheck : 0;
+   m_scheduledPollTime = 0;
+   m_scheduleWithSeconds = false;
    m_errorCount = shadowCopy ? src->m_errorCount : 0;
 	m_flags = src->m_flags;
    m_stateFlags = src->m_stateFlags;
@@ -192,6 +206,8 @@ DCObject::DCObject(uint32_t id, const TCHAR *name, int source, BYTE scheduleType
    m_stateFlags = 0;
    m_schedules = nullptr;
    m_tLastCheck = 0;
+   m_scheduledPollTime = 0;
+   m_scheduleWithSeconds = false;
    m_errorCount = 0;
    m_resourceId = 0;
    m_sourceNode = 0;
@@ -259,6 +275,8 @@ DCObject::DCObject(ConfigEntry *config, const shared_ptr<DataCollectionOwner>& o
    m_lastPoll = 0;
    m_lastValueTimestamp = 0;
    m_tLastCheck = 0;
+   m_scheduledPollTime = 0;
+   m_scheduleWithSeconds = false;
    m_errorCount = 0;
    m_resourceId = 0;
    m_sourceNode = 0;
@@ -749,21 +767,24 @@ bool DCObject::isReadyForPolling(time_t currTime)
             memcpy(&tmLastLocal, localtime(&m_tLastCheck), sizeof(struct tm));
 #endif
             result = false;
+            m_scheduleWithSeconds = false;
             for(int i = 0; i < m_schedules->size(); i++)
             {
                bool withSeconds = false;
 
                String schedule = expandSchedule(m_schedules->get(i));
-               if (MatchSchedule(schedule, &withSeconds, &tmCurrLocal, currTime))
+               if (MatchSchedule(schedule, &withSeconds, &tmCurrLocal, currTime) && !result)
                {
                   // TODO: do we have to take care about the schedules with seconds
                   // that trigger polling too often?
                   if (withSeconds || (currTime - m_tLastCheck >= 60) || (tmCurrLocal.tm_min != tmLastLocal.tm_min))
-                  {
                      result = true;
-                     break;
-                  }
                }
+
+               // Scheduler should re-check this object every second while at least one schedule
+               // with seconds matches current minute (all schedules are checked for that reason)
+               if (withSeconds)
+                  m_scheduleWithSeconds = true;
             }
          }
          else
@@ -788,6 +809,54 @@ bool DCObject::isReadyForPolling(time_t currTime)
    return result;
 }
 
+/**
+ * Get time when data collection scheduler should check this object again (by calling isReadyForPolling).
+ * Returned time is always greater than given current time.
+ */
+time_t DCObject::getNextPollCheckTime(time_t currTime)
+{
+   // Same as in isReadyForPolling, do not block scheduler if object is locked
+   if (!tryLock())
+      return currTime + 1;
+
+   time_t next;
+   if (m_busy)
+   {
+      // Data collector will reschedule object when collection completes, this is only a fallback
+      next = currTime + getEffectivePollingInterval();
+   }
+   else if (m_doForcePoll)
+   {
+      next = currTime + 1;
+   }
+   else if ((m_status == ITEM_STATUS_DISABLED) || (m_source == DS_PUSH_AGENT) ||
+            !matchClusterResource() || !hasValue() || (getAgentCacheMode() != AGENT_CACHE_OFF))
+   {
+      next = currTime + DC_BLOCKED_RECHECK_INTERVAL;
+   }
+   else if (!isCacheLoaded())
+   {
+      next = currTime + std::min(getEffectivePollingInterval(), DC_PENDING_RECHECK_INTERVAL);
+   }
+   else if (m_pollingScheduleType == DC_POLLING_SCHEDULE_ADVANCED)
+   {
+      if (m_schedules == nullptr)
+         next = currTime + DC_BLOCKED_RECHECK_INTERVAL;
+      else if (m_scheduleWithSeconds)
+         next = currTime + 1;
+      else
+         next = currTime - currTime % 60 + 60;  // Beginning of next minute
+   }
+   else
+   {
+      next = std::max(m_lastPoll + getEffectivePollingInterval() * ((m_status == ITEM_STATUS_NOT_SUPPORTED) ? 10 : 1), m_startTime);
+      if (next <= currTime)
+         next = currTime + 1;  // Object is due but was not polled (most likely was locked at the moment)
+   }
+   unlock();
+   return next;
+}
+
 /**
  * Returns true if internal cache is loaded. If data collection object
  * does not have cache should return true
@@ -353,6 +353,8 @@ bool DataCollectionOwner::addDCObject(DCObject *object, bool alreadyLocked, bool
       object->clearBusyFlag();
       if (object->getInstanceDiscoveryMethod() != IDM_NONE)
          m_instanceDiscoveryChanges = true;
+      if (isDataCollectionTarget())
+         ScheduleDCObjectPollNow(m_dcObjects.getShared(i));
       success = true;
    }
 
@@ -499,6 +501,7 @@ uint32_t DataCollectionOwner::updateDCObject(uint32_t dcObjectId, const NXCPMess
                m_instanceDiscoveryChanges = true;
             }
 
+            ScheduleDCObjectPollNow(m_dcObjects.getShared(i));
             result = RCC_SUCCESS;
          }
          else
@@ -558,6 +561,7 @@ unique_ptr<IntegerArray<uint32_t>> DataCollectionOwner::setItemStatus(const Inte
             if (m_dcObjects.get(j)->hasAccess(userId))
             {
                m_dcObjects.get(j)->setStatus(status, true, userChange);
+               ScheduleDCObjectPollNow(m_dcObjects.getShared(j));
                result->set(j, RCC_SUCCESS);
                break;
             }
@@ -619,6 +623,7 @@ int DataCollectionOwner::updateMultipleDCObjects(const NXCPMessage& request, uin
                if (!unitName.isNull() && (dci->getType() == DCO_TYPE_ITEM))
                   static_cast<DCItem*>(dci)->setUnitName(unitName);
                NotifyClientsOnDCIUpdate(*this, dci);
+               ScheduleDCObjectPollNow(m_dcObjects.getShared(j));
                count++;
             }
             break;
@@ -997,43 +997,54 @@ bool DataCollectionTarget::isDataCollectionDisabled()
 }
 
 /**
- * Put items which requires polling into the queue
+ * Put given item into data collector queue if it is due for polling. Returns true if item was queued.
  */
-void DataCollectionTarget::queueItemsForPolling()
+bool DataCollectionTarget::queueItemForPolling(const shared_ptr<DCObject>& object, time_t currTime, SNMPCollectionBatchBuilder *snmpBatches)
 {
    if ((m_status == STATUS_UNMANAGED) || isDataCollectionDisabled() || m_isDeleted)
-      return;  // Do not collect data for unmanaged objects or if data collection is disabled
+      return false;  // Do not collect data for unmanaged objects or if data collection is disabled
 
-   time_t currTime = time(nullptr);
+   if (!object->isReadyForPolling(currTime))
+      return false;
 
-   readLockDciAccess();
-   for(int i = 0; i < m_dcObjects.size(); i++)
+   object->setBusyFlag();
+
+   if ((object->getDataSource() == DS_NATIVE_AGENT) ||
+       (object->getDataSource() == DS_WINPERF) ||
+       (object->getDataSource() == DS_SNMP_AGENT) ||
+       (object->getDataSource() == DS_SSH) ||
+       (object->getDataSource() == DS_MODBUS) ||
+       (object->getDataSource() == DS_SMCLP))
    {
-		DCObject *object = m_dcObjects.get(i);
-      if (m_dcObjects.get(i)->isReadyForPolling(currTime))
+      uint32_t sourceNodeId = getEffectiveSourceNode(object.get());
+      uint64_t key = GetDataCollectorSerializationKey((sourceNodeId != 0) ? sourceNodeId : m_id, object->getDataSource());
+      if ((snmpBatches != nullptr) && (object->getDataSource() == DS_SNMP_AGENT) && (object->getType() == DCO_TYPE_ITEM) &&
+          (sourceNodeId == 0) && (getObjectClass() == OBJECT_NODE))
       {
-         object->setBusyFlag();
-
-         if ((object->getDataSource() == DS_NATIVE_AGENT) ||
-             (object->getDataSource() == DS_WINPERF) ||
-             (object->getDataSource() == DS_SNMP_AGENT) ||
-             (object->getDataSource() == DS_SSH) ||
-             (object->getDataSource() == DS_MODBUS) ||
-             (object->getDataSource() == DS_SMCLP))
-         {
-            uint32_t sourceNodeId = getEffectiveSourceNode(object);
-            TCHAR key[32];
-            _sntprintf(key, 32, _T("%08X/%s"), (sourceNodeId != 0) ? sourceNodeId : m_id, object->getDataProviderName());
-            ThreadPoolExecuteSerialized(g_dataCollectorThreadPool, key, DataCollector, m_dcObjects.getShared(i));
-         }
-         else
-         {
-            ThreadPoolExecute(g_dataCollectorThreadPool, DataCollector, m_dcObjects.getShared(i));
-         }
-			nxlog_debug_tag(_T("obj.dc.queue"), 8, _T("DataCollectionTarget(%s)->QueueItemsForPolling(): item %d \"%s\" added to queue"),
-			         m_name, object->getId(), object->getName().cstr());
+         snmpBatches->add(key, object);
+      }
+      else
+      {
+         ThreadPoolExecuteSerialized(g_dataCollectorThreadPool, key, DataCollector, object);
       }
    }
+   else
+   {
+      ThreadPoolExecute(g_dataCollectorThreadPool, DataCollector, object);
+   }
+   nxlog_debug_tag(_T("obj.dc.queue"), 8, _T("DataCollectionTarget(%s)->queueItemForPolling(): item %d \"%s\" added to queue"),
+            m_name, object->getId(), object->getName().cstr());
+   return true;
+}
+
+/**
+ * Request check of all data collection objects by data collection scheduler as soon as possible
+ */
+void DataCollectionTarget::scheduleItemsForPolling()
+{
+   readLockDciAccess();
+   for(int i = 0; i < m_dcObjects.size(); i++)
+      ScheduleDCObjectPollNow(m_dcObjects.getShared(i));
    unlockDciAccess();
 }
 
@@ -1046,6 +1057,7 @@ void DataCollectionTarget::updateDataCollectionTimeIntervals()
    for(int i = 0; i < m_dcObjects.size(); i++)
    {
       m_dcObjects.get(i)->updateTimeIntervals();
+      ScheduleDCObjectPollNow(m_dcObjects.getShared(i));
    }
    unlockDciAccess();
 }
@@ -1990,9 +2002,7 @@ void DataCollectionTarget::leaveMaintenanceMode(uint32_t userId)
 
    if (forcePoll)
    {
-      TCHAR threadKey[32];
-      _sntprintf(threadKey, 32, _T("POLL_%u"), getId());
-      ThreadPoolExecuteSerialized(g_pollerThreadPool, threadKey, static_cast<Pollable*>(this), &Pollable::doForcedStatusPoll, RegisterPoller(PollerType::STATUS, self()));
+      ThreadPoolExecuteSerialized(g_pollerThreadPool, GetPollerSerializationKey(m_id), static_cast<Pollable*>(this), &Pollable::doForcedStatusPoll, RegisterPoller(PollerType::STATUS, self()));
    }
 }
 
@@ -2389,10 +2399,10 @@ bool DataCollectionTarget::lockForInstanceDiscoveryPoll()
    bool success = false;
    lockProperties();
    if (!m_isDeleted && !m_isDeleteInitiated &&
+       (m_instancePollState.isDue(getCustomAttributeAsUInt32(_T("SysConfig:DataCollection.InstancePollingInterval"), g_instancePollingInterval)) || m_instanceDiscoveryPending) &&
        (m_status != STATUS_UNMANAGED) &&
        (!(m_flags & DCF_DISABLE_CONF_POLL)) &&
-       (m_runtimeFlags & ODF_CONFIGURATION_POLL_PASSED) &&
-       (m_instanceDiscoveryPending || (static_cast<uint32_t>(time(nullptr) - m_instancePollState.getLastCompleted()) > getCustomAttributeAsUInt32(_T("SysConfig:DataCollection.InstancePollingInterval"), g_instancePollingInterval))))
+       (m_runtimeFlags & ODF_CONFIGURATION_POLL_PASSED))
    {
       success = m_instancePollState.schedule();
       m_instanceDiscoveryPending = false;
@@ -2747,6 +2757,7 @@ void DataCollectionTarget::onDataCollectionLoad()
 {
    super::onDataCollectionLoad();
    calculateProxyLoad();
+   scheduleItemsForPolling();
 }
 
 /**
@@ -2756,6 +2767,7 @@ void DataCollectionTarget::onDataCollectionChange()
 {
    super::onDataCollectionChange();
    calculateProxyLoad();
+   scheduleItemsForPolling();
 }
 
 /**
@@ -2768,6 +2780,7 @@ void DataCollectionTarget::onInstanceDiscoveryChange()
    lockProperties();
    m_instanceDiscoveryPending = true;
    unlockProperties();
+   SchedulePollNow(this, PollerType::INSTANCE_DISCOVERY);
 }
 
 /**
@@ -2816,9 +2829,10 @@ NXSL_Array *DataCollectionTarget::getTemplatesForNXSL(NXSL_VM *vm)
 }
 
 /**
- * Get cache memory usage
+ * Get cache memory usage. If legacySize is not null, estimated memory usage of
+ * legacy cache layout will be added to it.
  */
-uint64_t DataCollectionTarget::getCacheMemoryUsage()
+uint64_t DataCollectionTarget::getCacheMemoryUsage(uint64_t *legacySize)
 {
    uint64_t cacheSize = 0;
    readLockDciAccess();
@@ -2827,7 +2841,7 @@ uint64_t DataCollectionTarget::getCacheMemoryUsage()
       DCObject *object = m_dcObjects.get(i);
       if (object->getType() == DCO_TYPE_ITEM)
       {
-         cacheSize += static_cast<DCItem*>(object)->getCacheMemoryUsage();
+         cacheSize += static_cast<DCItem*>(object)->getCacheMemoryUsage(legacySize);
       }
    }
    unlockDciAccess();
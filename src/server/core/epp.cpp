@@ -593,50 +593,51 @@ void EPRule::validateConfig() const
    }
 }
 
+/**
+ * Event source constructor
+ */
+EPEventSource::EPEventSource(uint32_t objectId) : m_object(FindObjectById(objectId))
+{
+   m_ancestorsCollected = false;
+}
+
+/**
+ * Check if event source object is given object or it's direct or indirect child
+ */
+bool EPEventSource::isSameOrDescendantOf(uint32_t id)
+{
+   if (m_object->getId() == id)
+      return true;
+
+   if (!m_ancestorsCollected)
+   {
+      m_object->addAllParentIds(&m_ancestors);
+      m_ancestorsCollected = true;
+   }
+   return m_ancestors.contains(id);
+}
+
 /**
  * Check if source object's id match to the rule
  */
-bool EPRule::matchSource(const shared_ptr<NetObj>& object) const
+bool EPRule::matchSource(EPEventSource *source) const
 {
    if (m_sources.isEmpty() && m_sourceExclusions.isEmpty())
       return (m_flags & RF_NEGATED_SOURCE) ? false : true;
 
-   if (object == nullptr)
+   if (source->getObject() == nullptr)
       return (m_flags & RF_NEGATED_SOURCE) ? true : false;
 
-   uint32_t objectId = object->getId();
-   bool exception = false;
    for(int i = 0; i < m_sourceExclusions.size(); i++)
    {
-      uint32_t id = m_sourceExclusions.get(i);
-      if (id == objectId)
-      {
-         exception = true;
-         break;
-      }
-
-      if (object->isParent(id))
-      {
-         exception = true;
-         break;
-      }
-   }
-   if (exception)
-   {
-      return (m_flags & RF_NEGATED_SOURCE) ? true : false;
+      if (source->isSameOrDescendantOf(m_sourceExclusions.get(i)))
+         return (m_flags & RF_NEGATED_SOURCE) ? true : false;
    }
 
    bool match = m_sources.isEmpty();
    for(int i = 0; i < m_sources.size(); i++)
    {
-      uint32_t id = m_sources.get(i);
-      if (id == objectId)
-      {
-         match = true;
-         break;
-      }
-
-      if (object->isParent(id))
+      if (source->isSameOrDescendantOf(m_sources.get(i)))
       {
          match = true;
          break;
@@ -831,7 +832,7 @@ static EnumerationCallbackResult ExecutePstorageSetAction(const TCHAR *key, cons
  * Check if event match to rule and perform required actions if yes
  * Method will return TRUE if event matched and RF_STOP_PROCESSING flag is set
  */
-bool EPRule::processEvent(Event *event) const
+bool EPRule::processEvent(Event *event, EPEventSource *source) const
 {
    if (m_flags & RF_DISABLED)
       return false;
@@ -842,9 +843,9 @@ bool EPRule::processEvent(Event *event) const
    if (!matchSeverity(event->getSeverity()) || !matchEvent(event->getCode()))
       return false;
 
-   shared_ptr<NetObj> object = FindObjectById(event->getSourceId());
-   if (!matchSource(object))
+   if (!matchSource(source))
       return false;
+   const shared_ptr<NetObj>& object = source->getObject();
 
    time_t now = time(nullptr);
    struct tm currLocal;
@@ -1587,6 +1588,9 @@ bool EventPolicy::loadFromDB()
    }
 
    DBConnectionPoolReleaseConnection(hdb);
+
+   if (success)
+      buildEventIndex();
    return success;
 }
 
@@ -1627,18 +1631,68 @@ bool EventPolicy::saveToDB() const
 }
 
 /**
- * Pass event through policy
+ * Build event code index for rules. Must be called with policy write lock held (or before policy is in use).
+ */
+void EventPolicy::buildEventIndex()
+{
+   m_eventIndex.clear();
+   m_wildcardRules.clear();
+   for(int i = 0; i < m_rules.size(); i++)
+   {
+      EPRule *rule = m_rules.get(i);
+      if (rule->isDisabled())
+         continue;
+
+      if (rule->hasEventFilter())
+      {
+         const IntegerArray<uint32_t>& events = rule->getEvents();
+         for(int j = 0; j < events.size(); j++)
+         {
+            IntegerArray<int> *rules = m_eventIndex.get(events.get(j));
+            if (rules == nullptr)
+            {
+               rules = new IntegerArray<int>(16, 16);
+               m_eventIndex.set(events.get(j), rules);
+            }
+            if (rules->isEmpty() || (rules->get(rules->size() - 1) != i))
+               rules->add(i);
+         }
+      }
+      else
+      {
+         m_wildcardRules.add(i);
+      }
+   }
+   nxlog_debug_tag(DEBUG_TAG, 4, _T("Event processing policy index rebuilt (%d rules, %d indexed event codes, %d wildcard rules)"),
+            m_rules.size(), m_eventIndex.size(), m_wildcardRules.size());
+}
+
+/**
+ * Pass event through policy. Only rules indexed by event's code and rules without event
+ * filter are evaluated. Both index lists are sorted, so merging them preserves rule order.
  */
 void EventPolicy::processEvent(Event *pEvent)
 {
 	nxlog_debug_tag(DEBUG_TAG, 7, _T("EPP: processing event ") UINT64_FMT, pEvent->getId());
+   EPEventSource source(pEvent->getSourceId());
    readLock();
-   for(int i = 0; i < m_rules.size(); i++)
-      if (m_rules.get(i)->processEvent(pEvent))
+   const IntegerArray<int> *indexedRules = m_eventIndex.get(pEvent->getCode());
+   int indexedCount = (indexedRules != nullptr) ? indexedRules->size() : 0;
+   int i = 0, j = 0;
+   while((i < indexedCount) || (j < m_wildcardRules.size()))
+   {
+      int ruleIndex;
+      if ((j >= m_wildcardRules.size()) || ((i < indexedCount) && (indexedRules->get(i) < m_wildcardRules.get(j))))
+         ruleIndex = indexedRules->get(i++);
+      else
+         ruleIndex = m_wildcardRules.get(j++);
+
+      if (m_rules.get(ruleIndex)->processEvent(pEvent, &source))
 		{
-			nxlog_debug_tag(DEBUG_TAG, 7, _T("EPP: got \"stop processing\" flag for event ") UINT64_FMT _T(" at rule %d"), pEvent->getId(), i + 1);
+			nxlog_debug_tag(DEBUG_TAG, 7, _T("EPP: got \"stop processing\" flag for event ") UINT64_FMT _T(" at rule %d"), pEvent->getId(), ruleIndex + 1);
          break;   // EPRule::ProcessEvent() return TRUE if we should stop processing this event
 		}
+   }
    unlock();
 }
 
@@ -1675,6 +1729,7 @@ void EventPolicy::replacePolicy(uint32_t numRules, EPRule **ruleList)
          m_rules.add(r);
       }
    }
+   buildEventIndex();
    unlock();
 }
 
@@ -1847,6 +1902,7 @@ void EventPolicy::importRule(EPRule *rule, bool overwrite, ObjectArray<uuid> *ru
       }
    }
 
+   buildEventIndex();
    unlock();
 }
 
@@ -32,6 +32,11 @@
  */
 void ResetScriptErrorEventCounter();
 
+/**
+ * Update event log writer queue latency statistic
+ */
+void UpdateEventLogWriterLatency(const uint32_t *samples, int count);
+
 /**
  * Number of processed events since start
  */
@@ -133,9 +138,27 @@ static bool IsEventWriteAllowed(Event *event)
 }
 
 /**
- * Write event
+ * Serialize event data into reusable buffer. Returns pointer to null-terminated UTF-8 JSON document within buffer.
+ */
+static const char *SerializeEventData(Event *event, ByteStream *buffer)
+{
+   buffer->clear();
+   json_t *json = event->toJson();
+   json_dump_callback(json,
+      [] (const char *data, size_t size, void *context) -> int
+      {
+         static_cast<ByteStream*>(context)->write(data, size);
+         return 0;
+      }, buffer, JSON_COMPACT);
+   json_decref(json);
+   buffer->write('\0');
+   return reinterpret_cast<const char*>(buffer->buffer());
+}
+
+/**
+ * Bind event to prepared INSERT statement
  */
-static inline void WriteEvent(DB_STATEMENT hStmt, Event *event)
+static inline void BindEvent(DB_STATEMENT hStmt, Event *event, ByteStream *jsonBuffer)
 {
    DBBind(hStmt, 1, DB_SQLTYPE_BIGINT, event->getId());
    DBBind(hStmt, 2, DB_SQLTYPE_INTEGER, event->getCode());
@@ -149,9 +172,152 @@ static inline void WriteEvent(DB_STATEMENT hStmt, Event *event)
    DBBind(hStmt, 10, DB_SQLTYPE_VARCHAR, event->getMessage(), DB_BIND_STATIC, MAX_EVENT_MSG_LENGTH);
    DBBind(hStmt, 11, DB_SQLTYPE_BIGINT, event->getRootId());
    DBBind(hStmt, 12, DB_SQLTYPE_VARCHAR, event->getTagsAsList(), DB_BIND_TRANSIENT, 2000);
-   DBBind(hStmt, 13, DB_SQLTYPE_TEXT, event->toJson(), DB_BIND_DYNAMIC);
-   DBExecute(hStmt);
-   nxlog_debug_tag(DEBUG_TAG, 8, _T("EventLogger: DBExecute: id=%d,code=%d"), (int)event->getId(), (int)event->getCode());
+   DBBind(hStmt, 13, DB_SQLTYPE_TEXT, DB_CTYPE_UTF8_STRING, SerializeEventData(event, jsonBuffer), DB_BIND_TRANSIENT);
+}
+
+/**
+ * Append event as row of multi-row INSERT statement
+ */
+static void AppendEventRow(StringBuffer *query, DB_HANDLE hdb, Event *event, ByteStream *jsonBuffer)
+{
+   query->append(_T('('));
+   query->append(event->getId());
+   query->append(_T(','));
+   query->append(event->getCode());
+   query->append(_T(','));
+   if (g_dbSyntax == DB_SYNTAX_TSDB)
+   {
+      query->append(_T("to_timestamp("));
+      query->append(static_cast<uint32_t>(event->getTimestamp()));
+      query->append(_T(')'));
+   }
+   else
+   {
+      query->append(static_cast<uint32_t>(event->getTimestamp()));
+   }
+   query->append(_T(','));
+   query->append(static_cast<int32_t>(event->getOrigin()));
+   query->append(_T(','));
+   query->append(static_cast<uint32_t>(event->getOriginTimestamp()));
+   query->append(_T(','));
+   query->append(event->getSourceId());
+   query->append(_T(','));
+   query->append(event->getZoneUIN());
+   query->append(_T(','));
+   query->append(event->getDciId());
+   query->append(_T(','));
+   query->append(event->getSeverity());
+   query->append(_T(','));
+   query->append(DBPrepareString(hdb, event->getMessage(), MAX_EVENT_MSG_LENGTH));
+   query->append(_T(','));
+   query->append(event->getRootId());
+   query->append(_T(','));
+   query->append(DBPrepareString(hdb, event->getTagsAsList(), 2000));
+   query->append(_T(','));
+   query->append(DBPrepareStringUTF8(hdb, SerializeEventData(event, jsonBuffer)));
+   query->append(_T(')'));
+}
+
+/**
+ * Column list for event_log INSERT
+ */
+#define EVENT_LOG_COLUMNS \
+   _T("event_id,event_code,event_timestamp,origin,origin_timestamp,event_source,zone_uin,dci_id,event_severity,event_message,root_event_id,event_tags,raw_data")
+
+/**
+ * Write events using multi-row INSERT statements (up to maxRecordsPerStmt rows per statement)
+ */
+static bool WriteEventsAsQuery(DB_HANDLE hdb, const ObjectArray<Event>& events, int maxRecordsPerStmt, StringBuffer *query, ByteStream *jsonBuffer)
+{
+   for(int i = 0; i < events.size();)
+   {
+      query->clear(false);
+      query->append(_T("INSERT INTO event_log (") EVENT_LOG_COLUMNS _T(") VALUES "));
+      for(int n = 0; (n < maxRecordsPerStmt) && (i < events.size()); n++, i++)
+      {
+         if (n > 0)
+            query->append(_T(','));
+         AppendEventRow(query, hdb, events.get(i), jsonBuffer);
+      }
+      if (!DBQuery(hdb, *query))
+         return false;
+   }
+   return true;
+}
+
+/**
+ * Write events using prepared statement. Driver side batch is used if supported.
+ */
+static bool WriteEventsPrepared(DB_HANDLE hdb, const ObjectArray<Event>& events, int maxRecordsPerStmt, ByteStream *jsonBuffer)
+{
+   DB_STATEMENT hStmt = DBPrepare(hdb,
+            (g_dbSyntax == DB_SYNTAX_TSDB) ?
+               _T("INSERT INTO event_log (") EVENT_LOG_COLUMNS _T(") VALUES (?,?,to_timestamp(?),?,?,?,?,?,?,?,?,?,?)") :
+               _T("INSERT INTO event_log (") EVENT_LOG_COLUMNS _T(") VALUES (?,?,?,?,?,?,?,?,?,?,?,?,?)"), true);
+   if (hStmt == nullptr)
+      return false;
+
+   bool success = true;
+   for(int i = 0; (i < events.size()) && success;)
+   {
+      if (DBOpenBatch(hStmt))
+      {
+         for(int n = 0; (n < maxRecordsPerStmt) && (i < events.size()); n++, i++)
+         {
+            DBNextBatchRow(hStmt);
+            BindEvent(hStmt, events.get(i), jsonBuffer);
+         }
+      }
+      else
+      {
+         BindEvent(hStmt, events.get(i++), jsonBuffer);
+      }
+      success = DBExecute(hStmt);
+   }
+   DBFreeStatement(hStmt);
+   return success;
+}
+
+/**
+ * Write batch of events to database within single transaction. If transaction fails,
+ * events are written one by one so that single bad record will not cause loss of entire batch.
+ */
+static void WriteEvents(const ObjectArray<Event>& events, int maxRecordsPerStmt, StringBuffer *query, ByteStream *jsonBuffer)
+{
+   // For Oracle and Informix multi-row VALUES clause is not supported, prepared statement (with batch if possible) is used instead
+   bool useQuery = (g_dbSyntax != DB_SYNTAX_ORACLE) && (g_dbSyntax != DB_SYNTAX_INFORMIX);
+
+   DB_HANDLE hdb = DBConnectionPoolAcquireConnection();
+   bool success = false;
+   if (DBBegin(hdb))
+   {
+      success = useQuery ? WriteEventsAsQuery(hdb, events, maxRecordsPerStmt, query, jsonBuffer) : WriteEventsPrepared(hdb, events, maxRecordsPerStmt, jsonBuffer);
+      if (success)
+         success = DBCommit(hdb);
+      else
+         DBRollback(hdb);
+   }
+
+   if (success)
+   {
+      nxlog_debug_tag(DEBUG_TAG, 8, _T("EventLogger: %d events written"), events.size());
+   }
+   else if (events.size() > 1)
+   {
+      nxlog_debug_tag(DEBUG_TAG, 5, _T("EventLogger: failed to write batch of %d events, retrying one by one"), events.size());
+      ObjectArray<Event> single(1, 1, Ownership::False);
+      for(int i = 0; i < events.size(); i++)
+      {
+         single.clear();
+         single.add(events.get(i));
+         if (useQuery)
+            WriteEventsAsQuery(hdb, single, 1, query, jsonBuffer);
+         else
+            WriteEventsPrepared(hdb, single, 1, jsonBuffer);
+      }
+   }
+
+   DBConnectionPoolReleaseConnection(hdb);
 }
 
 /**
@@ -161,95 +327,54 @@ static void EventLogger()
 {
    ThreadSetName("EventLogger");
 
-   while(true)
+   int maxRecordsPerTxn = ConfigReadInt(_T("DBWriter.MaxRecordsPerTransaction"), 1000);
+   int maxRecordsPerStmt = ConfigReadInt(_T("DBWriter.MaxRecordsPerStatement"), 100);
+   if (maxRecordsPerStmt < 1)
+      maxRecordsPerStmt = 1;
+   if (maxRecordsPerTxn < maxRecordsPerStmt)
+      maxRecordsPerTxn = maxRecordsPerStmt;
+
+   ObjectArray<Event> batch(maxRecordsPerTxn, 64, Ownership::True);
+   IntegerArray<uint32_t> latency(maxRecordsPerTxn, 64);
+   ByteStream jsonBuffer(8192);
+   StringBuffer query;
+   query.setAllocationStep(65536);
+
+   bool shutdown = false;
+   while(!shutdown)
    {
       Event *event = s_loggerQueue.getOrBlock();
-      if (event == INVALID_POINTER_VALUE)
-         break;   // Shutdown indicator
-
-      if (!IsEventWriteAllowed(event))
+      int64_t now = GetCurrentTimeMs();
+      while(true)
       {
-         delete event;
-         continue;
+         if (event == INVALID_POINTER_VALUE)
+         {
+            shutdown = true;
+            break;
+         }
+
+         latency.add(static_cast<uint32_t>(std::max(now - event->getQueueTime(), static_cast<int64_t>(0))));
+         if (IsEventWriteAllowed(event))
+            batch.add(event);
+         else
+            delete event;
+
+         if (batch.size() >= maxRecordsPerTxn)
+            break;
+         event = s_loggerQueue.get();
+         if (event == nullptr)
+            break;
       }
 
-		DB_HANDLE hdb = DBConnectionPoolAcquireConnection();
-		int syntaxId = DBGetSyntax(hdb);
-		if (syntaxId == DB_SYNTAX_SQLITE)
-		{ 
-         StringBuffer query = _T("INSERT INTO event_log (event_id,event_code,event_timestamp,event_source,zone_uin,origin,")
-                        _T("origin_timestamp,dci_id,event_severity,event_message,root_event_id,event_tags,raw_data) VALUES (");
-         query.append(event->getId());
-         query.append(_T(','));
-         query.append(event->getCode());
-         query.append(_T(','));
-         query.append((UINT32)event->getTimestamp());
-         query.append(_T(','));
-         query.append(event->getSourceId());
-         query.append(_T(','));
-         query.append(event->getZoneUIN());
-         query.append(_T(','));
-         query.append(static_cast<int32_t>(event->getOrigin()));
-         query.append(_T(','));
-         query.append(static_cast<uint32_t>(event->getOriginTimestamp()));
-         query.append(_T(','));
-         query.append(event->getDciId());
-         query.append(_T(','));
-         query.append(event->getSeverity());
-         query.append(_T(','));
-         query.append(DBPrepareString(hdb, event->getMessage(), MAX_EVENT_MSG_LENGTH));
-         query.append(_T(','));
-         query.append(event->getRootId());
-         query.append(_T(','));
-         query.append(DBPrepareString(hdb, event->getTagsAsList(), 2000));
-         query.append(_T(','));
-         json_t *json = event->toJson();
-         char *jsonText = json_dumps(json, JSON_COMPACT);
-         query.append(DBPrepareStringUTF8(hdb, jsonText));
-         MemFree(jsonText);
-         json_decref(json);
-         query.append(_T(')'));
-
-         DBQuery(hdb, query);
-         nxlog_debug_tag(DEBUG_TAG, 8, _T("EventLogger: DBQuery: id=%d,code=%d"), (int)event->getId(), (int)event->getCode());
-			delete event;
-		}
-		else
-		{
-			DB_STATEMENT hStmt = DBPrepare(hdb,
-			         (g_dbSyntax == DB_SYNTAX_TSDB) ?
-                        _T("INSERT INTO event_log (event_id,event_code,event_timestamp,origin,")
-                        _T("origin_timestamp,event_source,zone_uin,dci_id,event_severity,event_message,root_event_id,event_tags,raw_data) ")
-                        _T("VALUES (?,?,to_timestamp(?),?,?,?,?,?,?,?,?,?,?)") :
-                        _T("INSERT INTO event_log (event_id,event_code,event_timestamp,origin,")
-                        _T("origin_timestamp,event_source,zone_uin,dci_id,event_severity,event_message,root_event_id,event_tags,raw_data) ")
-                        _T("VALUES (?,?,?,?,?,?,?,?,?,?,?,?,?)"), true);
-			if (hStmt != nullptr)
-			{
-			   WriteEvent(hStmt, event);
-			   delete event;
-            event = s_loggerQueue.getOrBlock(500);
-			   while((event != nullptr) && (event != INVALID_POINTER_VALUE))
-				{
-				   if (IsEventWriteAllowed(event))
-				   {
-		            WriteEvent(hStmt, event);
-				   }
-					delete event;
-					event = s_loggerQueue.getOrBlock(500);
-				}
-				DBFreeStatement(hStmt);
-			}
-			else
-			{
-				delete event;
-			}
-		}
+      UpdateEventLogWriterLatency(latency.getBuffer(), latency.size());
+      latency.clear();
 
-		DBConnectionPoolReleaseConnection(hdb);
-		if (event == INVALID_POINTER_VALUE)
-         break;   // Shutdown indicator (need second check if got it in inner loop)
-	}
+      if (!batch.isEmpty())
+      {
+         WriteEvents(batch, maxRecordsPerStmt, &query, &jsonBuffer);
+         batch.clear();
+      }
+   }
 }
 
 /**
@@ -321,6 +446,7 @@ static void ProcessEvent(Event *event, int processorId)
    // Logger will destroy event object after logging
    if (event->getFlags() & EF_LOG)
    {
+      event->setQueueTime(GetCurrentTimeMs());
       s_loggerQueue.put(event);
    }
    else
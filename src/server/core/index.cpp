@@ -383,9 +383,15 @@ void *AbstractIndexBase::get(uint64_t key) const
 {
    if (m_startupMode && m_dirty)
    {
-      qsort(m_primary->elements, m_primary->size, sizeof(INDEX_ELEMENT), IndexCompare);
-      m_primary->maxKey = (m_primary->size > 0) ? m_primary->elements[m_primary->size - 1].key : 0;
-      const_cast<AbstractIndexBase*>(this)->m_dirty = false;   // This is internal marker, changing it does not break const contract
+      // Index can be read by multiple object loader threads at startup
+      m_writerLock.lock();
+      if (m_dirty)
+      {
+         qsort(m_primary->elements, m_primary->size, sizeof(INDEX_ELEMENT), IndexCompare);
+         m_primary->maxKey = (m_primary->size > 0) ? m_primary->elements[m_primary->size - 1].key : 0;
+         const_cast<AbstractIndexBase*>(this)->m_dirty = false;   // This is internal marker, changing it does not break const contract
+      }
+      m_writerLock.unlock();
    }
    INDEX_HEAD *index = acquireIndex();
 	ssize_t pos = findElement(index, key);
@@ -79,6 +79,8 @@ void ShutdownPerfDataStorageDrivers();
 void ImportLocalConfiguration(bool overwrite);
 void RegisterPredictionEngines();
 void ShutdownPredictionEngines();
+void InitAnomalyDetection();
+void ShutdownAnomalyDetection();
 void ExecuteStartupScripts();
 void CloseAgentTunnels();
 void StopDataCollection();
@@ -198,6 +200,7 @@ char g_snmpCodepage[16] = "";
  * Static data
  */
 static THREAD s_pollManagerThread = INVALID_THREAD_HANDLE;
+static SNMP_RequestEngine *s_snmpRequestEngine = nullptr;
 static THREAD s_syncerThread = INVALID_THREAD_HANDLE;
 static THREAD s_clientListenerThread = INVALID_THREAD_HANDLE;
 static THREAD s_mobileDeviceListenerThread = INVALID_THREAD_HANDLE;
@@ -558,6 +561,20 @@ static void LoadGlobalConfig()
 
    SnmpSetDefaultTimeout(ConfigReadInt(_T("SNMP.RequestTimeout"), 1500));
    SnmpSetDefaultRetryCount(ConfigReadInt(_T("SNMP.RetryCount"), 3));
+   SnmpSetDefaultBulkMaxRepetitions(ConfigReadULong(_T("SNMP.BulkWalk.MaxRepetitions"), 20));
+   if (ConfigReadBoolean(_T("SNMP.RequestEngine.Enable"), false))
+   {
+      s_snmpRequestEngine = new SNMP_RequestEngine();
+      if (s_snmpRequestEngine->start())
+      {
+         SnmpSetDefaultRequestEngine(s_snmpRequestEngine);
+      }
+      else
+      {
+         nxlog_write_tag(NXLOG_WARNING, DEBUG_TAG_STARTUP, _T("Cannot start SNMP request engine, SNMP requests will be sent using individual sockets"));
+         delete_and_null(s_snmpRequestEngine);
+      }
+   }
 
    g_clientFirstPacketTimeout = ConfigReadULong(_T("Client.FirstPacketTimeout"), 2000);
    if (g_clientFirstPacketTimeout < 100)
@@ -1133,7 +1150,8 @@ bool NXCORE_EXPORTABLE Initialize()
    g_pollerThreadPool = ThreadPoolCreate( _T("POLLERS"),
          ConfigReadInt(_T("ThreadPool.Poller.BaseSize"), 10),
          ConfigReadInt(_T("ThreadPool.Poller.MaxSize"), 250),
-         256 * 1024);
+         256 * 1024,
+         ConfigReadBoolean(_T("ThreadPool.Poller.WorkStealing"), false) ? THREAD_POOL_WORK_STEALING : 0);
    g_fileTransferThreadPool = ThreadPoolCreate( _T("FILE-TRANSFER"),
          ConfigReadInt(_T("ThreadPool.FileTransfer.BaseSize"), 2),
          ConfigReadInt(_T("ThreadPool.FileTransfer.MaxSize"), 16));
@@ -1163,6 +1181,7 @@ bool NXCORE_EXPORTABLE Initialize()
    if (!LoadNetXMSModules())
       return false;   // Mandatory module not loaded
    RegisterPredictionEngines();
+   InitAnomalyDetection();
 
    // Load users and authentication methods
    LoadTwoFactorAuthenticationMethods();
@@ -1399,6 +1418,7 @@ void NXCORE_EXPORTABLE Shutdown()
 	ShutdownPredictionEngines();
    StopObjectMaintenanceThreads();
    StopDataCollection();
+   ShutdownAnomalyDetection();  // Should be called after data collection stop because thresholds can still use anomaly detection
 
    // Wait for critical threads
    ThreadJoin(s_pollManagerThread);
@@ -1454,6 +1474,11 @@ void NXCORE_EXPORTABLE Shutdown()
    ThreadPoolDestroy(g_clientThreadPool);
    ThreadPoolDestroy(g_agentConnectionThreadPool);
    ThreadPoolDestroy(g_mainThreadPool);
+
+   // Request engine object is not destroyed because some SNMP transports may still refer to it
+   if (s_snmpRequestEngine != nullptr)
+      s_snmpRequestEngine->shutdown();
+
    WatchdogShutdown();
 
    SaveCurrentFreeId();
@@ -176,11 +176,46 @@ int NetObj::getObjectClassByNameA(const char *name)
    return OBJECT_GENERIC;
 }
 
+/**
+ * Queue for deferred object links (non-null only while objects are loaded in parallel at startup)
+ */
+static ObjectArray<DeferredObjectLink> *s_deferredLinks = nullptr;
+static Mutex s_deferredLinksLock(MutexType::FAST);
+
+/**
+ * Set queue for deferred object links. While queue is set, linkObjects() only adds requested links
+ * to the queue and caller is responsible for linking objects later. Intended only for use by startup
+ * object loader, so that objects loaded by multiple threads can be linked in deterministic order.
+ * Passing nullptr disables link deferral.
+ */
+void NetObj::setLinkDeferral(ObjectArray<DeferredObjectLink> *queue)
+{
+   s_deferredLinksLock.lock();
+   s_deferredLinks = queue;
+   s_deferredLinksLock.unlock();
+}
+
 /**
  * Link two objects
  */
 void NetObj::linkObjects(const shared_ptr<NetObj>& parent, const shared_ptr<NetObj>& child)
 {
+   if (s_deferredLinks != nullptr)
+   {
+      s_deferredLinksLock.lock();
+      if (s_deferredLinks != nullptr)
+      {
+         auto link = new DeferredObjectLink();
+         link->parent = parent;
+         link->child = child;
+         link->sequence = static_cast<uint32_t>(s_deferredLinks->size());
+         s_deferredLinks->add(link);
+         s_deferredLinksLock.unlock();
+         return;
+      }
+      s_deferredLinksLock.unlock();
+   }
+
    child->addParentReference(parent);
    parent->addChildReference(child);
    child->markAsModified(MODIFY_RELATIONS);
@@ -780,6 +815,10 @@ void NetObj::onCustomAttributeChange(const TCHAR *name, const TCHAR *value)
    else
       nxlog_debug_tag(DEBUG_TAG_OBJECT_DATA, 7, _T("Object \"%s\" [%u] custom attribute \"%s\" deleted"), m_name, m_id, name);
    setModified(MODIFY_CUSTOM_ATTRIBUTES, name[0] != '$');
+
+   // Polling intervals can be overridden by custom attributes
+   if (!_tcsncmp(name, _T("SysConfig:"), 10) && (getAsPollable() != nullptr))
+      ReschedulePolls(this);
 }
 
 /**
@@ -40,9 +40,14 @@
  */
 extern VolatileCounter64 g_snmpTrapsReceived;
 extern VolatileCounter64 g_syslogMessagesReceived;
+extern VolatileCounter64 g_syslogDropsReceiveBuffer;
+extern VolatileCounter64 g_syslogDropsMalformed;
+extern VolatileCounter64 g_syslogDropsUnknownSource;
 extern VolatileCounter64 g_windowsEventsReceived;
 extern uint32_t g_averageDCIQueuingTime;
 
+int64_t GetSyslogProcessingQueueSize(int processorId);
+
 /**
  * Poller thread pool
  */
@@ -2454,11 +2459,11 @@ bool Node::lockForStatusPoll()
          if (success)
             m_runtimeFlags &= ~ODF_FORCE_STATUS_POLL;
       }
-      else if ((m_status != STATUS_UNMANAGED) &&
+      else if (m_statusPollState.isDue(getCustomAttributeAsUInt32(_T("SysConfig:Objects.StatusPollingInterval"), g_statusPollingInterval)) &&
+               (m_status != STATUS_UNMANAGED) &&
                !(m_flags & DCF_DISABLE_STATUS_POLL) &&
                (getCluster() == nullptr) &&
                !(m_runtimeFlags & ODF_CONFIGURATION_POLL_PENDING) &&
-               (static_cast<uint32_t>(time(nullptr) - m_statusPollState.getLastCompleted()) > getCustomAttributeAsUInt32(_T("SysConfig:Objects.StatusPollingInterval"), g_statusPollingInterval)) &&
                !isAgentRestarting() && !isProxyAgentRestarting())
       {
          success = m_statusPollState.schedule();
@@ -2484,9 +2489,9 @@ bool Node::lockForConfigurationPoll()
          if (success)
             m_runtimeFlags &= ~ODF_FORCE_CONFIGURATION_POLL;
       }
-      else if ((m_status != STATUS_UNMANAGED) &&
+      else if (m_configurationPollState.isDue(getCustomAttributeAsUInt32(_T("SysConfig:Objects.ConfigurationPollingInterval"), g_configurationPollingInterval)) &&
+               (m_status != STATUS_UNMANAGED) &&
                !(m_flags & DCF_DISABLE_CONF_POLL) &&
-               (static_cast<uint32_t>(time(nullptr) - m_configurationPollState.getLastCompleted()) > getCustomAttributeAsUInt32(_T("SysConfig:Objects.ConfigurationPollingInterval"), g_configurationPollingInterval)) &&
                !isAgentRestarting() && !isProxyAgentRestarting())
       {
          success = m_configurationPollState.schedule();
@@ -2504,11 +2509,11 @@ bool Node::lockForDiscoveryPoll()
    bool success = false;
    lockProperties();
    if (!m_isDeleted && !m_isDeleteInitiated &&
+       m_discoveryPollState.isDue(getCustomAttributeAsUInt32(_T("SysConfig:NetworkDiscovery.PassiveDiscovery.Interval"), g_discoveryPollingInterval)) &&
        (g_flags & AF_PASSIVE_NETWORK_DISCOVERY) &&
        (m_status != STATUS_UNMANAGED) &&
        !(m_flags & NF_DISABLE_DISCOVERY_POLL) &&
        (m_runtimeFlags & ODF_CONFIGURATION_POLL_PASSED) &&
-       (static_cast<uint32_t>(time(nullptr) - m_discoveryPollState.getLastCompleted()) > getCustomAttributeAsUInt32(_T("SysConfig:NetworkDiscovery.PassiveDiscovery.Interval"), g_discoveryPollingInterval)) &&
        !isAgentRestarting() && !isProxyAgentRestarting())
    {
       success = m_discoveryPollState.schedule();
@@ -2525,10 +2530,10 @@ bool Node::lockForRoutingTablePoll()
    bool success = false;
    lockProperties();
    if (!m_isDeleted && !m_isDeleteInitiated &&
+       m_routingPollState.isDue(getCustomAttributeAsUInt32(_T("SysConfig:Topology.RoutingTableUpdateInterval"), g_routingTableUpdateInterval)) &&
        (m_status != STATUS_UNMANAGED) &&
        !(m_flags & NF_DISABLE_ROUTE_POLL) &&
        (m_runtimeFlags & ODF_CONFIGURATION_POLL_PASSED) &&
-       (static_cast<uint32_t>(time(nullptr) - m_routingPollState.getLastCompleted()) > getCustomAttributeAsUInt32(_T("SysConfig:Topology.RoutingTableUpdateInterval"), g_routingTableUpdateInterval)) &&
        !isAgentRestarting() && !isProxyAgentRestarting())
    {
       success = m_routingPollState.schedule();
@@ -2545,10 +2550,10 @@ bool Node::lockForTopologyPoll()
    bool success = false;
    lockProperties();
    if (!m_isDeleted && !m_isDeleteInitiated &&
+       m_topologyPollState.isDue(getCustomAttributeAsUInt32(_T("SysConfig:Topology.PollingInterval"), g_topologyPollingInterval)) &&
        (m_status != STATUS_UNMANAGED) &&
        !(m_flags & NF_DISABLE_TOPOLOGY_POLL) &&
        (m_runtimeFlags & ODF_CONFIGURATION_POLL_PASSED) &&
-       (static_cast<uint32_t>(time(nullptr) - m_topologyPollState.getLastCompleted()) > getCustomAttributeAsUInt32(_T("SysConfig:Topology.PollingInterval"), g_topologyPollingInterval)) &&
        !isAgentRestarting() && !isProxyAgentRestarting())
    {
       success = m_topologyPollState.schedule();
@@ -2566,10 +2571,10 @@ bool Node::lockForIcmpPoll()
 
    lockProperties();
    if (!m_isDeleted && !m_isDeleteInitiated &&
+       m_icmpPollState.isDue(getCustomAttributeAsUInt32(_T("SysConfig:ICMP.PollingInterval"), g_icmpPollingInterval)) &&
        (m_status != STATUS_UNMANAGED) &&
        isIcmpStatCollectionEnabled() &&
        !(m_runtimeFlags & ODF_CONFIGURATION_POLL_PENDING) &&
-       (static_cast<uint32_t>(time(nullptr) - m_icmpPollState.getLastCompleted()) > getCustomAttributeAsUInt32(_T("SysConfig:ICMP.PollingInterval"), g_icmpPollingInterval)) &&
        !isProxyAgentRestarting())
    {
       success = m_icmpPollState.schedule();
@@ -7028,6 +7033,52 @@ inline DataCollectionError DCErrorFromSNMPError(UINT32 snmpError)
    }
 }
 
+/**
+ * Convert raw SNMP value to string according to DCI raw value interpretation settings
+ */
+static void RawSNMPValueToString(const BYTE *rawValue, size_t length, int interpretRawValue, TCHAR *buffer, size_t size)
+{
+   switch(interpretRawValue)
+   {
+      case SNMP_RAWTYPE_INT32:
+         IntegerToString(static_cast<int32_t>(ntohl(*reinterpret_cast<const uint32_t*>(rawValue))), buffer);
+         break;
+      case SNMP_RAWTYPE_UINT32:
+         IntegerToString(static_cast<uint32_t>(ntohl(*reinterpret_cast<const uint32_t*>(rawValue))), buffer);
+         break;
+      case SNMP_RAWTYPE_INT64:
+         IntegerToString(static_cast<int64_t>(ntohq(*reinterpret_cast<const uint64_t*>(rawValue))), buffer);
+         break;
+      case SNMP_RAWTYPE_UINT64:
+         IntegerToString(ntohq(*reinterpret_cast<const uint64_t*>(rawValue)), buffer);
+         break;
+      case SNMP_RAWTYPE_DOUBLE:
+         _sntprintf(buffer, size, _T("%f"), ntohd(*reinterpret_cast<const double*>(rawValue)));
+         break;
+      case SNMP_RAWTYPE_IP_ADDR:
+         if (length == 4)
+            IpToStr(ntohl(*reinterpret_cast<const uint32_t*>(rawValue)), buffer);
+         else
+            buffer[0] = 0;
+         break;
+      case SNMP_RAWTYPE_IP6_ADDR:
+         if (length == 16)
+            Ip6ToStr(rawValue, buffer);
+         else
+            buffer[0] = 0;
+         break;
+      case SNMP_RAWTYPE_MAC_ADDR:
+         if ((length == 6) || (length == 8))
+            BinToStrEx(rawValue, length, buffer, _T(':'), 0);
+         else
+            buffer[0] = 0;
+         break;
+      default:
+         buffer[0] = 0;
+         break;
+   }
+}
+
 /**
  * Get DCI value via SNMP. Buffer size should be at least 64 characters.
  */
@@ -7062,47 +7113,7 @@ DataCollectionError Node::getMetricFromSNMP(uint16_t port, SNMP_Version version,
          uint32_t length;
          snmpResult = SnmpGetEx(snmp, name, nullptr, 0, rawValue, 1024, SG_RAW_RESULT, &length);
          if (snmpResult == SNMP_ERR_SUCCESS)
-         {
-            switch(interpretRawValue)
-            {
-               case SNMP_RAWTYPE_INT32:
-                  IntegerToString(static_cast<int32_t>(ntohl(*reinterpret_cast<uint32_t*>(rawValue))), buffer);
-                  break;
-               case SNMP_RAWTYPE_UINT32:
-                  IntegerToString(static_cast<uint32_t>(ntohl(*reinterpret_cast<uint32_t*>(rawValue))), buffer);
-                  break;
-               case SNMP_RAWTYPE_INT64:
-                  IntegerToString(static_cast<int64_t>(ntohq(*reinterpret_cast<uint64_t*>(rawValue))), buffer);
-                  break;
-               case SNMP_RAWTYPE_UINT64:
-                  IntegerToString(ntohq(*reinterpret_cast<uint64_t*>(rawValue)), buffer);
-                  break;
-               case SNMP_RAWTYPE_DOUBLE:
-                  _sntprintf(buffer, size, _T("%f"), ntohd(*reinterpret_cast<double*>(rawValue)));
-                  break;
-               case SNMP_RAWTYPE_IP_ADDR:
-                  if (length == 4)
-                     IpToStr(ntohl(*reinterpret_cast<uint32_t*>(rawValue)), buffer);
-                  else
-                     buffer[0] = 0;
-                  break;
-               case SNMP_RAWTYPE_IP6_ADDR:
-                  if (length == 16)
-                     Ip6ToStr(rawValue, buffer);
-                  else
-                     buffer[0] = 0;
-                  break;
-               case SNMP_RAWTYPE_MAC_ADDR:
-                  if ((length == 6) || (length == 8))
-                     BinToStrEx(rawValue, length, buffer, _T(':'), 0);
-                  else
-                     buffer[0] = 0;
-                  break;
-               default:
-                  buffer[0] = 0;
-                  break;
-            }
-         }
+            RawSNMPValueToString(rawValue, length, interpretRawValue, buffer, size);
       }
       delete snmp;
    }
@@ -7114,6 +7125,135 @@ DataCollectionError Node::getMetricFromSNMP(uint16_t port, SNMP_Version version,
    return DCErrorFromSNMPError(snmpResult);
 }
 
+/**
+ * Set value of batched SNMP metric from response varbind
+ */
+static void SetSNMPMetricValue(SNMPMetricRequest *metric, SNMP_Variable *var)
+{
+   if ((var->getType() == ASN_NO_SUCH_OBJECT) || (var->getType() == ASN_NO_SUCH_INSTANCE) || (var->getType() == ASN_END_OF_MIBVIEW))
+   {
+      metric->error = DCErrorFromSNMPError(SNMP_ERR_NO_OBJECT);
+      return;
+   }
+
+   if (metric->interpretRawValue == SNMP_RAWTYPE_NONE)
+   {
+      bool convert = true;
+      var->getValueAsPrintableString(metric->value, MAX_RESULT_LENGTH, &convert);
+   }
+   else
+   {
+      BYTE rawValue[1024];
+      memset(rawValue, 0, 1024);
+      var->getRawValue(rawValue, 1024);
+      RawSNMPValueToString(rawValue, var->getValueLength(), metric->interpretRawValue, metric->value, MAX_RESULT_LENGTH);
+   }
+   metric->error = DCE_SUCCESS;
+}
+
+/**
+ * Read given metrics with single SNMP GET request. If agent reports that response is too big, request is split in two.
+ * On other errors excludes failed metric (if agent reports one) or falls back to individual requests, so each metric
+ * gets same status as it would with non-batched request. Returns SNMP transport error code.
+ */
+static uint32_t ReadSNMPMetricBatch(SNMP_Transport *snmp, SNMPMetricRequest **metrics, size_t count)
+{
+   SNMP_PDU request(SNMP_GET_REQUEST, SnmpNewRequestId(), snmp->getSnmpVersion());
+   for(size_t i = 0; i < count; i++)
+   {
+      uint32_t oid[MAX_OID_LEN];
+      size_t oidLen = SnmpParseOID(metrics[i]->name, oid, MAX_OID_LEN);
+      request.bindVariable(new SNMP_Variable(oid, oidLen));
+   }
+
+   SNMP_PDU *response;
+   uint32_t rcc = snmp->doRequest(&request, &response);
+   if (rcc != SNMP_ERR_SUCCESS)
+      return rcc;
+
+   SNMP_ErrorCode errorCode = response->getErrorCode();
+   if ((errorCode == SNMP_PDU_ERR_SUCCESS) && (response->getNumVariables() == static_cast<int>(count)))
+   {
+      for(size_t i = 0; i < count; i++)
+         SetSNMPMetricValue(metrics[i], response->getVariable(static_cast<int>(i)));
+      delete response;
+      return SNMP_ERR_SUCCESS;
+   }
+   uint32_t errorIndex = response->getErrorIndex();
+   delete response;
+
+   if (count == 1)
+   {
+      // Same result as from SnmpGetEx
+      metrics[0]->error = DCErrorFromSNMPError((errorCode == SNMP_PDU_ERR_NO_SUCH_NAME) ? SNMP_ERR_NO_OBJECT : SNMP_ERR_AGENT);
+      return SNMP_ERR_SUCCESS;
+   }
+
+   if (errorCode == SNMP_PDU_ERR_TOO_BIG)
+   {
+      size_t half = count / 2;
+      rcc = ReadSNMPMetricBatch(snmp, metrics, half);
+      if (rcc == SNMP_ERR_SUCCESS)
+         rcc = ReadSNMPMetricBatch(snmp, &metrics[half], count - half);
+      return rcc;
+   }
+
+   if ((errorCode == SNMP_PDU_ERR_NO_SUCH_NAME) && (errorIndex > 0) && (errorIndex <= count))
+   {
+      // SNMPv1 agent reports only first missing object, exclude it and retry
+      metrics[errorIndex - 1]->error = DCErrorFromSNMPError(SNMP_ERR_NO_OBJECT);
+      std::swap(metrics[errorIndex - 1], metrics[count - 1]);
+      return ReadSNMPMetricBatch(snmp, metrics, count - 1);
+   }
+
+   for(size_t i = 0; (i < count) && (rcc == SNMP_ERR_SUCCESS); i++)
+      rcc = ReadSNMPMetricBatch(snmp, &metrics[i], 1);
+   return rcc;
+}
+
+/**
+ * Get values for multiple DCIs via SNMP, using up to maxBatchSize varbinds per request.
+ * Result for each metric is stored in metric's error and value fields.
+ */
+void Node::getMetricsFromSNMP(uint16_t port, SNMP_Version version, SNMPMetricRequest *metrics, size_t count, size_t maxBatchSize)
+{
+   for(size_t i = 0; i < count; i++)
+   {
+      metrics[i].error = DCErrorFromSNMPError(SNMP_ERR_COMM);  // Will remain for metrics not processed because of communication error
+      metrics[i].value[0] = 0;
+   }
+
+   if ((((m_state & NSF_SNMP_UNREACHABLE) || !(m_capabilities & NC_IS_SNMP)) && (port == 0)) ||
+       (m_state & DCSF_UNREACHABLE) ||
+       (m_flags & NF_DISABLE_SNMP))
+   {
+      nxlog_debug_tag(DEBUG_TAG_DC_SNMP, 7, _T("Node(%s)->getMetricsFromSNMP(%d metrics): snmpResult=%d"), m_name, static_cast<int>(count), SNMP_ERR_COMM);
+      return;
+   }
+
+   SNMP_Transport *snmp = createSnmpTransport(port, version);
+   if (snmp == nullptr)
+      return;
+
+   Buffer<SNMPMetricRequest*, 256> batch(count);
+   size_t batchSize = 0;
+   for(size_t i = 0; i < count; i++)
+   {
+      uint32_t oid[MAX_OID_LEN];
+      if (SnmpParseOID(metrics[i].name, oid, MAX_OID_LEN) != 0)
+         batch[batchSize++] = &metrics[i];
+      else
+         metrics[i].error = DCErrorFromSNMPError(SNMP_ERR_BAD_OID);
+   }
+
+   uint32_t rcc = SNMP_ERR_SUCCESS;
+   for(size_t i = 0; (i < batchSize) && (rcc == SNMP_ERR_SUCCESS); i += maxBatchSize)
+      rcc = ReadSNMPMetricBatch(snmp, &batch[i], std::min(maxBatchSize, batchSize - i));
+   delete snmp;
+
+   nxlog_debug_tag(DEBUG_TAG_DC_SNMP, 7, _T("Node(%s)->getMetricsFromSNMP(%d metrics): snmpResult=%u"), m_name, static_cast<int>(count), rcc);
+}
+
 /**
  * Read one row for SNMP table
  */
@@ -8185,6 +8325,14 @@ DataCollectionError Node::getInternalMetric(const TCHAR *name, TCHAR *buffer, si
       {
          ret_int(buffer, GetTunnelCount(TunnelCapabilityFilter::ANY, false));
       }
+      else if (!_tcsicmp(name, _T("Server.AnomalyDetection.ModelCache.Size")))
+      {
+         ret_uint(buffer, GetAnomalyModelCacheSize());
+      }
+      else if (!_tcsicmp(name, _T("Server.AnomalyDetection.TrainingTime")))
+      {
+         ret_uint(buffer, GetAnomalyModelTrainingTime());
+      }
       else if (!_tcsicmp(name, _T("Server.AverageDCIQueuingTime")))
       {
          _sntprintf(buffer, size, _T("%u"), g_averageDCIQueuingTime);
@@ -8245,6 +8393,14 @@ DataCollectionError Node::getInternalMetric(const TCHAR *name, TCHAR *buffer, si
          AgentGetParameterArg(name, 1, loginName, 256);
          IntegerToString(GetSessionCount(true, false, CLIENT_TYPE_WEB, loginName), buffer);
       }
+      else if (!_tcsicmp(name, _T("Server.DataCollection.ItemsScheduledLate")))
+      {
+         ret_uint64(buffer, GetLateScheduledDCObjectCount());
+      }
+      else if (!_tcsicmp(name, _T("Server.DataCollection.SchedulingLag")))
+      {
+         ret_uint(buffer, GetDataCollectionSchedulingLag());
+      }
       else if (!_tcsicmp(name, _T("Server.DataCollectionItems")))
       {
          int dciCount = 0;
@@ -8296,6 +8452,10 @@ DataCollectionError Node::getInternalMetric(const TCHAR *name, TCHAR *buffer, si
       {
          IntegerToString(g_rawDataWriteRequests, buffer);
       }
+      else if (MatchString(_T("Server.EventLogWriter.QueueLatency(*)"), name, false))
+      {
+         rc = GetEventLogWriterLatencyStatistic(name, buffer);
+      }
       else if (MatchString(_T("Server.EventProcessor.AverageWaitTime(*)"), name, false))
       {
          rc = GetEventProcessorStatistic(name, 'W', buffer);
@@ -8439,6 +8599,28 @@ DataCollectionError Node::getInternalMetric(const TCHAR *name, TCHAR *buffer, si
       {
          ret_int64(buffer, GetSyncerRunTime(StatisticType::MIN));
       }
+      else if (!_tcsicmp(name, _T("Server.Syslog.Drops.Malformed")))
+      {
+         ret_uint64(buffer, g_syslogDropsMalformed);
+      }
+      else if (!_tcsicmp(name, _T("Server.Syslog.Drops.ReceiveBuffer")))
+      {
+         ret_uint64(buffer, g_syslogDropsReceiveBuffer);
+      }
+      else if (!_tcsicmp(name, _T("Server.Syslog.Drops.UnknownSource")))
+      {
+         ret_uint64(buffer, g_syslogDropsUnknownSource);
+      }
+      else if (MatchString(_T("Server.Syslog.ProcessorQueueSize(*)"), name, false))
+      {
+         TCHAR arg[16] = _T("");
+         AgentGetParameterArg(name, 1, arg, 16);
+         int64_t size = GetSyslogProcessingQueueSize(_tcstol(arg, nullptr, 10));
+         if (size >= 0)
+            ret_int64(buffer, size);
+         else
+            rc = DCE_NO_SUCH_INSTANCE;
+      }
       else if (MatchString(_T("Server.ThreadPool.ActiveRequests(*)"), name, false))
       {
          rc = GetThreadPoolStat(THREAD_POOL_ACTIVE_REQUESTS, name, buffer);
@@ -8866,6 +9048,7 @@ uint32_t Node::modifyFromMessageInternal(const NXCPMessage& msg)
 
          m_primaryHostName = primaryName;
          m_runtimeFlags |= ODF_FORCE_CONFIGURATION_POLL | NDF_RECHECK_CAPABILITIES;
+         SchedulePollNow(this, PollerType::CONFIGURATION);
       }
    }
 
@@ -9722,6 +9905,7 @@ void Node::changeIPAddress(const InetAddress& ipAddr)
 
       setPrimaryIPAddress(ipAddr);
       m_runtimeFlags |= ODF_FORCE_CONFIGURATION_POLL | NDF_RECHECK_CAPABILITIES;
+      SchedulePollNow(this, PollerType::CONFIGURATION);
 
       // Change status of node and all it's children to UNKNOWN
       m_status = STATUS_UNKNOWN;
@@ -9769,6 +9953,7 @@ void Node::changeZone(UINT32 newZoneUIN)
    m_zoneUIN = newZoneUIN;
    m_runtimeFlags |= ODF_FORCE_CONFIGURATION_POLL | NDF_RECHECK_CAPABILITIES;
    unlockProperties();
+   SchedulePollNow(this, PollerType::CONFIGURATION);
 
    // Remove from subnets
    readLockParentList();
@@ -10350,6 +10535,9 @@ SNMP_Transport *Node::createSnmpTransport(uint16_t port, SNMP_Version version, c
    // Set security
    if (transport != nullptr)
    {
+      // GETBULK requests can be disabled for node with broken agent by setting this to 0
+      transport->setBulkMaxRepetitions(getCustomAttributeAsUInt32(_T("SysConfig:SNMP.BulkWalk.MaxRepetitions"), SnmpGetDefaultBulkMaxRepetitions()));
+
       lockProperties();
       SNMP_Version effectiveVersion = (version != SNMP_VERSION_DEFAULT) ? version : m_snmpVersion;
       transport->setSnmpVersion(effectiveVersion);
@@ -674,6 +674,402 @@ NXSL_METHOD_DEFINITION(NetObj, writeMaintenanceJournal)
    return NXSL_ERR_SUCCESS;
 }
 
+/**
+ * NetObj::alarms attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, alarms)
+{
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   NXSL_Value *value;
+   ObjectArray<Alarm> *alarms = GetAlarms(netobj->getId(), true);
+   alarms->setOwner(Ownership::False);
+   NXSL_Array *array = new NXSL_Array(vm);
+   for(int i = 0; i < alarms->size(); i++)
+      array->append(vm->createValue(vm->createObject(&g_nxslAlarmClass, alarms->get(i))));
+   value = vm->createValue(array);
+   delete alarms;
+   return value;
+}
+
+/**
+ * NetObj::alias attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, alias)
+{
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(netobj->getAlias());
+}
+
+/**
+ * NetObj::asset attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, asset)
+{
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   NXSL_Value *value;
+   uint32_t assetId = netobj->getAssetId();
+   if (assetId != 0)
+   {
+      shared_ptr<Asset> asset = static_pointer_cast<Asset>(FindObjectById(assetId, OBJECT_ASSET));
+      value = (asset != nullptr) ? asset->createNXSLObject(vm) : vm->createValue();
+   }
+   else
+   {
+      value = vm->createValue();
+   }
+   return value;
+}
+
+/**
+ * NetObj::assetId attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, assetId)
+{
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(netobj->getAssetId());
+}
+
+/**
+ * NetObj::assetProperties attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, assetProperties)
+{
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   NXSL_Value *value;
+   uint32_t assetId = netobj->getAssetId();
+   if (assetId != 0)
+   {
+      shared_ptr<Asset> asset = static_pointer_cast<Asset>(FindObjectById(assetId, OBJECT_ASSET));
+      value = (asset != nullptr) ? vm->createValue(vm->createObject(&g_nxslAssetPropertiesClass, new shared_ptr<Asset>(asset))) : vm->createValue();
+   }
+   else
+   {
+      value = vm->createValue();
+   }
+   return value;
+}
+
+/**
+ * NetObj::backupZoneProxy attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, backupZoneProxy)
+{
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   NXSL_Value *value;
+   uint32_t id = netobj->getAssignedZoneProxyId(true);
+   if (id != 0)
+   {
+      shared_ptr<NetObj> proxy = FindObjectById(id, OBJECT_NODE);
+      value = (proxy != nullptr) ? proxy->createNXSLObject(vm) : vm->createValue();
+   }
+   else
+   {
+      value = vm->createValue();
+   }
+   return value;
+}
+
+/**
+ * NetObj::backupZoneProxyId attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, backupZoneProxyId)
+{
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(netobj->getAssignedZoneProxyId(true));
+}
+
+/**
+ * NetObj::category attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, category)
+{
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   NXSL_Value *value;
+   if (netobj->getCategoryId() != 0)
+   {
+      shared_ptr<ObjectCategory> category = GetObjectCategory(netobj->getCategoryId());
+      value = (category != nullptr) ? vm->createValue(category->getName()) : vm->createValue();
+   }
+   else
+   {
+      value = vm->createValue();
+   }
+   return value;
+}
+
+/**
+ * NetObj::categoryId attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, categoryId)
+{
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(netobj->getCategoryId());
+}
+
+/**
+ * NetObj::children attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, children)
+{
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   return netobj->getChildrenForNXSL(vm);
+}
+
+/**
+ * NetObj::city attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, city)
+{
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(netobj->getPostalAddress().getCity());
+}
+
+/**
+ * NetObj::comments attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, comments)
+{
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(netobj->getComments());
+}
+
+/**
+ * NetObj::country attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, country)
+{
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(netobj->getPostalAddress().getCountry());
+}
+
+/**
+ * NetObj::creationTime attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, creationTime)
+{
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(static_cast<INT64>(netobj->getCreationTime()));
+}
+
+/**
+ * NetObj::customAttributes attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, customAttributes)
+{
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   return netobj->getCustomAttributesForNXSL(vm);
+}
+
+/**
+ * NetObj::district attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, district)
+{
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(netobj->getPostalAddress().getDistrict());
+}
+
+/**
+ * NetObj::geolocation attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, geolocation)
+{
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   return NXSL_GeoLocationClass::createObject(vm, netobj->getGeoLocation());
+}
+
+/**
+ * NetObj::guid attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, guid)
+{
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   NXSL_Value *value;
+   TCHAR buffer[64];
+   value = vm->createValue(netobj->getGuid().toString(buffer));
+   return value;
+}
+
+/**
+ * NetObj::id attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, id)
+{
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(netobj->getId());
+}
+
+/**
+ * NetObj::ipAddr attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, ipAddr)
+{
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   NXSL_Value *value;
+   TCHAR buffer[64];
+   value = vm->createValue(netobj->getPrimaryIpAddress().toString(buffer));
+   return value;
+}
+
+/**
+ * NetObj::isInMaintenanceMode attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, isInMaintenanceMode)
+{
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(netobj->isInMaintenanceMode());
+}
+
+/**
+ * NetObj::maintenanceInitiator attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, maintenanceInitiator)
+{
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(netobj->getMaintenanceInitiator());
+}
+
+/**
+ * NetObj::mapImage attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, mapImage)
+{
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   NXSL_Value *value;
+   TCHAR buffer[64];
+   value = vm->createValue(netobj->getMapImage().toString(buffer));
+   return value;
+}
+
+/**
+ * NetObj::name attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, name)
+{
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(netobj->getName());
+}
+
+/**
+ * NetObj::nameOnMap attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, nameOnMap)
+{
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(netobj->getNameOnMap());
+}
+
+/**
+ * NetObj::parents attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, parents)
+{
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   return netobj->getParentsForNXSL(vm);
+}
+
+/**
+ * NetObj::postcode attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, postcode)
+{
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(netobj->getPostalAddress().getPostCode());
+}
+
+/**
+ * NetObj::primaryZoneProxy attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, primaryZoneProxy)
+{
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   NXSL_Value *value;
+   UINT32 id = netobj->getAssignedZoneProxyId(false);
+   if (id != 0)
+   {
+      shared_ptr<NetObj> proxy = FindObjectById(id, OBJECT_NODE);
+      value = (proxy != nullptr) ? proxy->createNXSLObject(vm) : vm->createValue();
+   }
+   else
+   {
+      value = vm->createValue();
+   }
+   return value;
+}
+
+/**
+ * NetObj::primaryZoneProxyId attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, primaryZoneProxyId)
+{
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(netobj->getAssignedZoneProxyId(false));
+}
+
+/**
+ * NetObj::region attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, region)
+{
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(netobj->getPostalAddress().getRegion());
+}
+
+/**
+ * NetObj::responsibleUsers attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, responsibleUsers)
+{
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   NXSL_Value *value;
+   NXSL_Array *array = new NXSL_Array(vm);
+   unique_ptr<StructArray<ResponsibleUser>> responsibleUsers = netobj->getAllResponsibleUsers();
+   unique_ptr<ObjectArray<UserDatabaseObject>> userDB = FindUserDBObjects(*responsibleUsers);
+   userDB->setOwner(Ownership::False);
+   for(int i = 0; i < userDB->size(); i++)
+   {
+      array->append(userDB->get(i)->createNXSLObject(vm));
+   }
+   value = vm->createValue(array);
+   return value;
+}
+
+/**
+ * NetObj::state attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, state)
+{
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(netobj->getState());
+}
+
+/**
+ * NetObj::status attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, status)
+{
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue((LONG)netobj->getStatus());
+}
+
+/**
+ * NetObj::streetAddress attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, streetAddress)
+{
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue(netobj->getPostalAddress().getStreetAddress());
+}
+
+/**
+ * NetObj::type attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(NetObj, type)
+{
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   return vm->createValue((LONG)netobj->getObjectClass());
+}
+
 /**
  * NXSL class NetObj: constructor
  */
@@ -712,6 +1108,42 @@ NXSL_NetObjClass::NXSL_NetObjClass() : NXSL_Class()
    NXSL_REGISTER_METHOD(NetObj, unbindFrom, 1);
    NXSL_REGISTER_METHOD(NetObj, unmanage, 0);
    NXSL_REGISTER_METHOD(NetObj, writeMaintenanceJournal, 1);
+
+   NXSL_REGISTER_ATTRIBUTE(NetObj, alarms);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, alias);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, asset);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, assetId);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, assetProperties);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, backupZoneProxy);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, backupZoneProxyId);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, category);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, categoryId);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, children);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, city);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, comments);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, country);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, creationTime);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, customAttributes);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, district);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, geolocation);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, guid);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, id);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, ipAddr);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, isInMaintenanceMode);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, maintenanceInitiator);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, mapImage);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, name);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, nameOnMap);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, parents);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, postcode);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, primaryZoneProxy);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, primaryZoneProxyId);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, region);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, responsibleUsers);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, state);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, status);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, streetAddress);
+   NXSL_REGISTER_ATTRIBUTE(NetObj, type);
 }
 
 /**
@@ -723,229 +1155,32 @@ void NXSL_NetObjClass::onObjectDelete(NXSL_Object *object)
 }
 
 /**
- * NXSL class NetObj: get attribute
+ * NXSL class NetObj: get attribute. Built-in attributes are registered in constructors. Custom attributes
+ * take precedence over built-in attributes registered by derived classes (but not over common NetObj attributes).
  */
-NXSL_Value *NXSL_NetObjClass::getAttr(NXSL_Object *_object, const NXSL_Identifier& attr)
+NXSL_Value *NXSL_NetObjClass::getAttr(NXSL_Object *object, const NXSL_Identifier& attr)
 {
-   NXSL_Value *value = NXSL_Class::getAttr(_object, attr);
-   if (value != nullptr)
-      return value;
+   const NXSL_ExtAttribute *getter = findAttributeGetter(attr);
+   if ((getter != nullptr) && !getter->overridable)
+      return getter->handler(object, object->vm());
 
-   NXSL_VM *vm = _object->vm();
-   auto object = SharedObjectFromData<NetObj>(_object);
-   if (NXSL_COMPARE_ATTRIBUTE_NAME("alarms"))
-   {
-      ObjectArray<Alarm> *alarms = GetAlarms(object->getId(), true);
-      alarms->setOwner(Ownership::False);
-      NXSL_Array *array = new NXSL_Array(vm);
-      for(int i = 0; i < alarms->size(); i++)
-         array->append(vm->createValue(vm->createObject(&g_nxslAlarmClass, alarms->get(i))));
-      value = vm->createValue(array);
-      delete alarms;
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("alias"))
-   {
-      value = vm->createValue(object->getAlias());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("asset"))
+   NXSL_Value *value = nullptr;
+   NetObj *netobj = SharedObjectFromData<NetObj>(object);
+   if (netobj != nullptr)   // Object can be null if attribute scan is running
    {
-      uint32_t assetId = object->getAssetId();
-      if (assetId != 0)
-      {
-         shared_ptr<Asset> asset = static_pointer_cast<Asset>(FindObjectById(assetId, OBJECT_ASSET));
-         value = (asset != nullptr) ? asset->createNXSLObject(vm) : vm->createValue();
-      }
-      else
-      {
-         value = vm->createValue();
-      }
+#ifdef UNICODE
+      WCHAR wattr[MAX_IDENTIFIER_LENGTH];
+      utf8_to_wchar(attr.value, -1, wattr, MAX_IDENTIFIER_LENGTH);
+      wattr[MAX_IDENTIFIER_LENGTH - 1] = 0;
+      value = netobj->getCustomAttributeForNXSL(object->vm(), wattr);
+#else
+      value = netobj->getCustomAttributeForNXSL(object->vm(), attr.value);
+#endif
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("assetId"))
-   {
-      value = vm->createValue(object->getAssetId());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("assetProperties"))
-   {
-      uint32_t assetId = object->getAssetId();
-      if (assetId != 0)
-      {
-         shared_ptr<Asset> asset = static_pointer_cast<Asset>(FindObjectById(assetId, OBJECT_ASSET));
-         value = (asset != nullptr) ? vm->createValue(vm->createObject(&g_nxslAssetPropertiesClass, new shared_ptr<Asset>(asset))) : vm->createValue();
-      }
-      else
-      {
-         value = vm->createValue();
-      }
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("backupZoneProxy"))
-   {
-      uint32_t id = object->getAssignedZoneProxyId(true);
-      if (id != 0)
-      {
-         shared_ptr<NetObj> proxy = FindObjectById(id, OBJECT_NODE);
-         value = (proxy != nullptr) ? proxy->createNXSLObject(vm) : vm->createValue();
-      }
-      else
-      {
-         value = vm->createValue();
-      }
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("backupZoneProxyId"))
-   {
-      value = vm->createValue(object->getAssignedZoneProxyId(true));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("category"))
-   {
-      if (object->getCategoryId() != 0)
-      {
-         shared_ptr<ObjectCategory> category = GetObjectCategory(object->getCategoryId());
-         value = (category != nullptr) ? vm->createValue(category->getName()) : vm->createValue();
-      }
-      else
-      {
-         value = vm->createValue();
-      }
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("categoryId"))
-   {
-      value = vm->createValue(object->getCategoryId());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("children"))
-   {
-      value = object->getChildrenForNXSL(vm);
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("city"))
-   {
-      value = vm->createValue(object->getPostalAddress().getCity());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("comments"))
-   {
-      value = vm->createValue(object->getComments());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("country"))
-   {
-      value = vm->createValue(object->getPostalAddress().getCountry());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("creationTime"))
-   {
-      value = vm->createValue(static_cast<INT64>(object->getCreationTime()));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("customAttributes"))
-   {
-      value = object->getCustomAttributesForNXSL(vm);
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("district"))
-   {
-      value = vm->createValue(object->getPostalAddress().getDistrict());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("geolocation"))
-   {
-      value = NXSL_GeoLocationClass::createObject(vm, object->getGeoLocation());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("guid"))
-   {
-      TCHAR buffer[64];
-      value = vm->createValue(object->getGuid().toString(buffer));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("id"))
-   {
-      value = vm->createValue(object->getId());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("ipAddr"))
-   {
-      TCHAR buffer[64];
-      value = vm->createValue(object->getPrimaryIpAddress().toString(buffer));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isInMaintenanceMode"))
-   {
-      value = vm->createValue(object->isInMaintenanceMode());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("maintenanceInitiator"))
-   {
-      value = vm->createValue(object->getMaintenanceInitiator());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("mapImage"))
-   {
-      TCHAR buffer[64];
-      value = vm->createValue(object->getMapImage().toString(buffer));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("name"))
-   {
-      value = vm->createValue(object->getName());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("nameOnMap"))
-   {
-      value = vm->createValue(object->getNameOnMap());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("parents"))
-   {
-      value = object->getParentsForNXSL(vm);
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("postcode"))
-   {
-      value = vm->createValue(object->getPostalAddress().getPostCode());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("primaryZoneProxy"))
-   {
-      UINT32 id = object->getAssignedZoneProxyId(false);
-      if (id != 0)
-      {
-         shared_ptr<NetObj> proxy = FindObjectById(id, OBJECT_NODE);
-         value = (proxy != nullptr) ? proxy->createNXSLObject(vm) : vm->createValue();
-      }
-      else
-      {
-         value = vm->createValue();
-      }
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("primaryZoneProxyId"))
-   {
-      value = vm->createValue(object->getAssignedZoneProxyId(false));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("region"))
-   {
-      value = vm->createValue(object->getPostalAddress().getRegion());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("responsibleUsers"))
-   {
-      NXSL_Array *array = new NXSL_Array(vm);
-      unique_ptr<StructArray<ResponsibleUser>> responsibleUsers = object->getAllResponsibleUsers();
-      unique_ptr<ObjectArray<UserDatabaseObject>> userDB = FindUserDBObjects(*responsibleUsers);
-      userDB->setOwner(Ownership::False);
-      for(int i = 0; i < userDB->size(); i++)
-      {
-         array->append(userDB->get(i)->createNXSLObject(vm));
-      }
-      value = vm->createValue(array);
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("state"))
-   {
-      value = vm->createValue(object->getState());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("status"))
-   {
-      value = vm->createValue((LONG)object->getStatus());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("streetAddress"))
-   {
-      value = vm->createValue(object->getPostalAddress().getStreetAddress());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("type"))
-   {
-      value = vm->createValue((LONG)object->getObjectClass());
-   }
-   else if (object != nullptr)   // Object can be null if attribute scan is running
-   {
-#ifdef UNICODE
-      WCHAR wattr[MAX_IDENTIFIER_LENGTH];
-      utf8_to_wchar(attr.value, -1, wattr, MAX_IDENTIFIER_LENGTH);
-      wattr[MAX_IDENTIFIER_LENGTH - 1] = 0;
-      value = object->getCustomAttributeForNXSL(vm, wattr);
-#else
-      value = object->getCustomAttributeForNXSL(vm, attr.value);
-#endif
-   }
-   return value;
+   if (value != nullptr)
+      return value;
+
+   return (getter != nullptr) ? getter->handler(object, object->vm()) : NXSL_Class::getAttr(object, attr);
 }
 
 /**
@@ -1270,6 +1505,15 @@ NXSL_METHOD_DEFINITION(DataCollectionTarget, removeTemplate)
    return 0;
 }
 
+/**
+ * DataCollectionTarget::templates attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(DataCollectionTarget, templates)
+{
+   DataCollectionTarget *dcTarget = SharedObjectFromData<DataCollectionTarget>(object);
+   return vm->createValue(dcTarget->getTemplatesForNXSL(vm));
+}
+
 /**
  * NXSL class DataCollectionTarget: constructor
  */
@@ -1283,24 +1527,8 @@ NXSL_DCTargetClass::NXSL_DCTargetClass() : NXSL_NetObjClass()
    NXSL_REGISTER_METHOD(DataCollectionTarget, enableStatusPolling, 1);
    NXSL_REGISTER_METHOD(DataCollectionTarget, readInternalParameter, 1);
    NXSL_REGISTER_METHOD(DataCollectionTarget, removeTemplate, 1);
-}
-
-/**
- * NXSL class Zone: get attribute
- */
-NXSL_Value *NXSL_DCTargetClass::getAttr(NXSL_Object *object, const NXSL_Identifier& attr)
-{
-   NXSL_Value *value = NXSL_NetObjClass::getAttr(object, attr);
-   if (value != nullptr)
-      return value;
 
-   NXSL_VM *vm = object->vm();
-   auto dcTarget = SharedObjectFromData<DataCollectionTarget>(object);
-   if (NXSL_COMPARE_ATTRIBUTE_NAME("templates"))
-   {
-      value = vm->createValue(dcTarget->getTemplatesForNXSL(vm));
-   }
-   return value;
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(DataCollectionTarget, templates);
 }
 
 /**
@@ -1997,47 +2225,6 @@ NXSL_METHOD_DEFINITION(Node, setIfXTableUsageMode)
    return 0;
 }
 
-/**
- * NXSL class Node: constructor
- */
-NXSL_NodeClass::NXSL_NodeClass() : NXSL_DCTargetClass()
-{
-   setName(_T("Node"));
-
-   NXSL_REGISTER_METHOD(Node, callWebService, -1);
-   NXSL_REGISTER_METHOD(Node, createSNMPTransport, -1);
-   NXSL_REGISTER_METHOD(Node, enable8021xStatusPolling, 1);
-   NXSL_REGISTER_METHOD(Node, enableAgent, 1);
-   NXSL_REGISTER_METHOD(Node, enableDiscoveryPolling, 1);
-   NXSL_REGISTER_METHOD(Node, enableEtherNetIP, 1);
-   NXSL_REGISTER_METHOD(Node, enableIcmp, 1);
-   NXSL_REGISTER_METHOD(Node, enableModbusTcp, 1);
-   NXSL_REGISTER_METHOD(Node, enablePrimaryIPPing, 1);
-   NXSL_REGISTER_METHOD(Node, enableRoutingTablePolling, 1);
-   NXSL_REGISTER_METHOD(Node, enableSnmp, 1);
-   NXSL_REGISTER_METHOD(Node, enableSsh, 1);
-   NXSL_REGISTER_METHOD(Node, enableWinPerfCountersCache, 1);
-   NXSL_REGISTER_METHOD(Node, enableTopologyPolling, 1);
-   NXSL_REGISTER_METHOD(Node, executeAgentCommand, -1);
-   NXSL_REGISTER_METHOD(Node, executeAgentCommandWithOutput, -1);
-   NXSL_REGISTER_METHOD(Node, executeSSHCommand, 1);
-   NXSL_REGISTER_METHOD(Node, getInterface, 1);
-   NXSL_REGISTER_METHOD(Node, getInterfaceByIndex, 1);
-   NXSL_REGISTER_METHOD(Node, getInterfaceByMACAddress, 1);
-   NXSL_REGISTER_METHOD(Node, getInterfaceByName, 1);
-   NXSL_REGISTER_METHOD(Node, getInterfaceName, 1);
-   NXSL_REGISTER_METHOD(Node, getWebService, 1);
-   NXSL_REGISTER_METHOD(Node, readAgentList, 1);
-   NXSL_REGISTER_METHOD(Node, readAgentParameter, 1);
-   NXSL_REGISTER_METHOD(Node, readAgentTable, 1);
-   NXSL_REGISTER_METHOD(Node, readDriverParameter, 1);
-   NXSL_REGISTER_METHOD(Node, readInternalParameter, 1);
-   NXSL_REGISTER_METHOD(Node, readInternalTable, 1);
-   NXSL_REGISTER_METHOD(Node, readWebServiceList, 1);
-   NXSL_REGISTER_METHOD(Node, readWebServiceParameter, 1);
-   NXSL_REGISTER_METHOD(Node, setIfXTableUsageMode, 1);
-}
-
 /**
  * Get ICMP statistic for object
  */
@@ -2057,624 +2244,1350 @@ static NXSL_Value *GetNodeIcmpStatistic(Node *node, IcmpStatFunction function, N
 }
 
 /**
- * NXSL class Node: get attribute
+ * Node::agentCertificateMappingData attribute
  */
-NXSL_Value *NXSL_NodeClass::getAttr(NXSL_Object *object, const NXSL_Identifier& attr)
+NXSL_ATTRIBUTE_DEFINITION(Node, agentCertificateMappingData)
 {
-   NXSL_Value *value = NXSL_DCTargetClass::getAttr(object, attr);
-   if (value != nullptr)
-      return value;
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getAgentCertificateMappingData());
+}
 
-   NXSL_VM *vm = object->vm();
-   auto node = SharedObjectFromData<Node>(object);
-   if (NXSL_COMPARE_ATTRIBUTE_NAME("agentCertificateMappingData"))
-   {
-      value = vm->createValue(node->getAgentCertificateMappingData());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("agentCertificateMappingMethod"))
-   {
-      value = vm->createValue(static_cast<int32_t>(node->getAgentCertificateMappingMethod()));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("agentCertificateSubject"))
-   {
-      value = vm->createValue(node->getAgentCertificateSubject());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("agentId"))
-   {
-      TCHAR buffer[64];
-      value = vm->createValue(node->getAgentId().toString(buffer));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("agentProxy"))
-   {
-      shared_ptr<NetObj> object = FindObjectById(node->getAgentProxy());
-      if (object != nullptr)
-      {
-         value = object->createNXSLObject(vm);
-      }
-      else
-      {
-         value = vm->createValue();
-      }
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("agentVersion"))
-   {
-      value = vm->createValue(node->getAgentVersion());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("bootTime"))
-   {
-      value = vm->createValue(static_cast<INT64>(node->getBootTime()));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("bridgeBaseAddress"))
-   {
-      TCHAR buffer[64];
-      value = vm->createValue(BinToStr(node->getBridgeId(), MAC_ADDR_LENGTH, buffer));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("capabilities"))
-   {
-      value = vm->createValue(node->getCapabilities());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("cipDeviceType"))
-   {
-      value = vm->createValue(node->getCipDeviceType());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("cipDeviceTypeAsText"))
-   {
-      value = vm->createValue(CIP_DeviceTypeNameFromCode(node->getCipDeviceType()));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("cipExtendedStatus"))
-   {
-      value = vm->createValue((node->getCipStatus() & CIP_DEVICE_STATUS_EXTENDED_STATUS_MASK) >> 4);
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("cipExtendedStatusAsText"))
-   {
-      value = vm->createValue(CIP_DecodeExtendedDeviceStatus(node->getCipStatus()));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("cipStatus"))
-   {
-      value = vm->createValue(node->getCipStatus());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("cipStatusAsText"))
-   {
-      value = vm->createValue(CIP_DecodeDeviceStatus(node->getCipStatus()));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("cipState"))
-   {
-      value = vm->createValue(node->getCipState());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("cipStateAsText"))
-   {
-      value = vm->createValue(CIP_DeviceStateTextFromCode(node->getCipState()));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("cipVendorCode"))
+/**
+ * Node::agentCertificateMappingMethod attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, agentCertificateMappingMethod)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(static_cast<int32_t>(node->getAgentCertificateMappingMethod()));
+}
+
+/**
+ * Node::agentCertificateSubject attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, agentCertificateSubject)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getAgentCertificateSubject());
+}
+
+/**
+ * Node::agentId attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, agentId)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value;
+   TCHAR buffer[64];
+   value = vm->createValue(node->getAgentId().toString(buffer));
+   return value;
+}
+
+/**
+ * Node::agentProxy attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, agentProxy)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value;
+   shared_ptr<NetObj> proxy = FindObjectById(node->getAgentProxy());
+   if (proxy != nullptr)
    {
-      value = vm->createValue(node->getCipVendorCode());
+      value = proxy->createNXSLObject(vm);
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("cluster"))
+   else
    {
-      shared_ptr<Cluster> cluster = node->getCluster();
-      value = (cluster != nullptr) ? cluster->createNXSLObject(vm) : vm->createValue();
+      value = vm->createValue();
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("components"))
-   {
-      shared_ptr<ComponentTree> components = node->getComponents();
-      if (components != nullptr)
-      {
-         value = ComponentTree::getRootForNXSL(vm, components);
-      }
-      else
-      {
-         value = vm->createValue();
-      }
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("dependentNodes"))
-   {
-      unique_ptr<StructArray<DependentNode>> dependencies = GetNodeDependencies(node->getId());
-      NXSL_Array *a = new NXSL_Array(vm);
-      for(int i = 0; i < dependencies->size(); i++)
-      {
-         a->append(vm->createValue(vm->createObject(&g_nxslNodeDependencyClass, new DependentNode(*dependencies->get(i)))));
-      }
-      value = vm->createValue(a);
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("driver"))
-   {
-      value = vm->createValue(node->getDriverName());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("downSince"))
-   {
-      value = vm->createValue(static_cast<INT64>(node->getDownSince()));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("effectiveAgentProxy"))
-   {
-      shared_ptr<NetObj> object = FindObjectById(node->getEffectiveAgentProxy());
-      if (object != nullptr)
-      {
-         value = object->createNXSLObject(vm);
-      }
-      else
-      {
-         value = vm->createValue();
-      }
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("effectiveIcmpProxy"))
-   {
-      shared_ptr<NetObj> object = FindObjectById(node->getEffectiveIcmpProxy());
-      if (object != nullptr)
-      {
-         value = object->createNXSLObject(vm);
-      }
-      else
-      {
-         value = vm->createValue();
-      }
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("effectiveSnmpProxy"))
+   return value;
+}
+
+/**
+ * Node::agentVersion attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, agentVersion)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getAgentVersion());
+}
+
+/**
+ * Node::bootTime attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, bootTime)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(static_cast<INT64>(node->getBootTime()));
+}
+
+/**
+ * Node::bridgeBaseAddress attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, bridgeBaseAddress)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value;
+   TCHAR buffer[64];
+   value = vm->createValue(BinToStr(node->getBridgeId(), MAC_ADDR_LENGTH, buffer));
+   return value;
+}
+
+/**
+ * Node::capabilities attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, capabilities)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getCapabilities());
+}
+
+/**
+ * Node::cipDeviceType attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, cipDeviceType)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getCipDeviceType());
+}
+
+/**
+ * Node::cipDeviceTypeAsText attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, cipDeviceTypeAsText)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(CIP_DeviceTypeNameFromCode(node->getCipDeviceType()));
+}
+
+/**
+ * Node::cipExtendedStatus attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, cipExtendedStatus)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue((node->getCipStatus() & CIP_DEVICE_STATUS_EXTENDED_STATUS_MASK) >> 4);
+}
+
+/**
+ * Node::cipExtendedStatusAsText attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, cipExtendedStatusAsText)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(CIP_DecodeExtendedDeviceStatus(node->getCipStatus()));
+}
+
+/**
+ * Node::cipStatus attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, cipStatus)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getCipStatus());
+}
+
+/**
+ * Node::cipStatusAsText attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, cipStatusAsText)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(CIP_DecodeDeviceStatus(node->getCipStatus()));
+}
+
+/**
+ * Node::cipState attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, cipState)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getCipState());
+}
+
+/**
+ * Node::cipStateAsText attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, cipStateAsText)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(CIP_DeviceStateTextFromCode(node->getCipState()));
+}
+
+/**
+ * Node::cipVendorCode attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, cipVendorCode)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getCipVendorCode());
+}
+
+/**
+ * Node::cluster attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, cluster)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value;
+   shared_ptr<Cluster> cluster = node->getCluster();
+   value = (cluster != nullptr) ? cluster->createNXSLObject(vm) : vm->createValue();
+   return value;
+}
+
+/**
+ * Node::components attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, components)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value;
+   shared_ptr<ComponentTree> components = node->getComponents();
+   if (components != nullptr)
    {
-      shared_ptr<NetObj> object = FindObjectById(node->getEffectiveSnmpProxy());
-      if (object != nullptr)
-      {
-         value = object->createNXSLObject(vm);
-      }
-      else
-      {
-         value = vm->createValue();
-      }
+      value = ComponentTree::getRootForNXSL(vm, components);
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("flags"))
+   else
    {
-		value = vm->createValue(node->getFlags());
+      value = vm->createValue();
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("hasAgentIfXCounters"))
+   return value;
+}
+
+/**
+ * Node::dependentNodes attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, dependentNodes)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value;
+   unique_ptr<StructArray<DependentNode>> dependencies = GetNodeDependencies(node->getId());
+   NXSL_Array *a = new NXSL_Array(vm);
+   for(int i = 0; i < dependencies->size(); i++)
    {
-      value = vm->createValue(is_bit_set(node->getCapabilities(), NC_HAS_AGENT_IFXCOUNTERS));
+      a->append(vm->createValue(vm->createObject(&g_nxslNodeDependencyClass, new DependentNode(*dependencies->get(i)))));
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("hasEntityMIB"))
+   value = vm->createValue(a);
+   return value;
+}
+
+/**
+ * Node::driver attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, driver)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getDriverName());
+}
+
+/**
+ * Node::downSince attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, downSince)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(static_cast<INT64>(node->getDownSince()));
+}
+
+/**
+ * Node::effectiveAgentProxy attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, effectiveAgentProxy)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value;
+   shared_ptr<NetObj> proxy = FindObjectById(node->getEffectiveAgentProxy());
+   if (proxy != nullptr)
    {
-      value = vm->createValue(is_bit_set(node->getCapabilities(), NC_HAS_ENTITY_MIB));
+      value = proxy->createNXSLObject(vm);
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("hasIfXTable"))
+   else
    {
-      value = vm->createValue(is_bit_set(node->getCapabilities(), NC_HAS_IFXTABLE));
+      value = vm->createValue();
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("hasUserAgent"))
+   return value;
+}
+
+/**
+ * Node::effectiveIcmpProxy attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, effectiveIcmpProxy)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value;
+   shared_ptr<NetObj> proxy = FindObjectById(node->getEffectiveIcmpProxy());
+   if (proxy != nullptr)
    {
-      value = vm->createValue(is_bit_set(node->getCapabilities(), NC_HAS_USER_AGENT));
+      value = proxy->createNXSLObject(vm);
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("hasVLANs"))
+   else
    {
-      value = vm->createValue(is_bit_set(node->getCapabilities(), NC_HAS_VLANS));
+      value = vm->createValue();
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("hardwareId"))
+   return value;
+}
+
+/**
+ * Node::effectiveSnmpProxy attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, effectiveSnmpProxy)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value;
+   shared_ptr<NetObj> proxy = FindObjectById(node->getEffectiveSnmpProxy());
+   if (proxy != nullptr)
    {
-      TCHAR buffer[HARDWARE_ID_LENGTH * 2 + 1];
-      value = vm->createValue(BinToStr(node->getHardwareId().value(), HARDWARE_ID_LENGTH, buffer));
+      value = proxy->createNXSLObject(vm);
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("hardwareComponents"))
+   else
    {
-      value = node->getHardwareComponentsForNXSL(vm);
+      value = vm->createValue();
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("hasWinPDH"))
+   return value;
+}
+
+/**
+ * Node::flags attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, flags)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getFlags());
+}
+
+/**
+ * Node::hasAgentIfXCounters attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, hasAgentIfXCounters)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(is_bit_set(node->getCapabilities(), NC_HAS_AGENT_IFXCOUNTERS));
+}
+
+/**
+ * Node::hasEntityMIB attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, hasEntityMIB)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(is_bit_set(node->getCapabilities(), NC_HAS_ENTITY_MIB));
+}
+
+/**
+ * Node::hasIfXTable attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, hasIfXTable)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(is_bit_set(node->getCapabilities(), NC_HAS_IFXTABLE));
+}
+
+/**
+ * Node::hasUserAgent attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, hasUserAgent)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(is_bit_set(node->getCapabilities(), NC_HAS_USER_AGENT));
+}
+
+/**
+ * Node::hasVLANs attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, hasVLANs)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(is_bit_set(node->getCapabilities(), NC_HAS_VLANS));
+}
+
+/**
+ * Node::hardwareId attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, hardwareId)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value;
+   TCHAR buffer[HARDWARE_ID_LENGTH * 2 + 1];
+   value = vm->createValue(BinToStr(node->getHardwareId().value(), HARDWARE_ID_LENGTH, buffer));
+   return value;
+}
+
+/**
+ * Node::hardwareComponents attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, hardwareComponents)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return node->getHardwareComponentsForNXSL(vm);
+}
+
+/**
+ * Node::hasWinPDH attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, hasWinPDH)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(is_bit_set(node->getCapabilities(), NC_HAS_WINPDH));
+}
+
+/**
+ * Node::hypervisorInfo attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, hypervisorInfo)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getHypervisorInfo());
+}
+
+/**
+ * Node::hypervisorType attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, hypervisorType)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getHypervisorType());
+}
+
+/**
+ * Node::icmpAverageRTT attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, icmpAverageRTT)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return GetNodeIcmpStatistic(node, IcmpStatFunction::AVERAGE, vm);
+}
+
+/**
+ * Node::icmpLastRTT attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, icmpLastRTT)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return GetNodeIcmpStatistic(node, IcmpStatFunction::LAST, vm);
+}
+
+/**
+ * Node::icmpMaxRTT attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, icmpMaxRTT)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return GetNodeIcmpStatistic(node, IcmpStatFunction::MAX, vm);
+}
+
+/**
+ * Node::icmpMinRTT attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, icmpMinRTT)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return GetNodeIcmpStatistic(node, IcmpStatFunction::MIN, vm);
+}
+
+/**
+ * Node::icmpPacketLoss attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, icmpPacketLoss)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return GetNodeIcmpStatistic(node, IcmpStatFunction::LOSS, vm);
+}
+
+/**
+ * Node::icmpProxy attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, icmpProxy)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value;
+   shared_ptr<NetObj> proxy = FindObjectById(node->getIcmpProxy());
+   if (proxy != nullptr)
    {
-      value = vm->createValue(is_bit_set(node->getCapabilities(), NC_HAS_WINPDH));
+      value = proxy->createNXSLObject(vm);
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("hypervisorInfo"))
+   else
    {
-      value = vm->createValue(node->getHypervisorInfo());
+      value = vm->createValue();
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("hypervisorType"))
-   {
-      value = vm->createValue(node->getHypervisorType());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("icmpAverageRTT"))
-   {
-      value = GetNodeIcmpStatistic(node, IcmpStatFunction::AVERAGE, vm);
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("icmpLastRTT"))
-   {
-      value = GetNodeIcmpStatistic(node, IcmpStatFunction::LAST, vm);
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("icmpMaxRTT"))
-   {
-      value = GetNodeIcmpStatistic(node, IcmpStatFunction::MAX, vm);
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("icmpMinRTT"))
-   {
-      value = GetNodeIcmpStatistic(node, IcmpStatFunction::MIN, vm);
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("icmpPacketLoss"))
-   {
-      value = GetNodeIcmpStatistic(node, IcmpStatFunction::LOSS, vm);
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("icmpProxy"))
-   {
-      shared_ptr<NetObj> object = FindObjectById(node->getIcmpProxy());
-      if (object != nullptr)
-      {
-         value = object->createNXSLObject(vm);
-      }
-      else
-      {
-         value = vm->createValue();
-      }
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("interfaces"))
-   {
-      value = node->getInterfacesForNXSL(vm);
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isAgent"))
-   {
-      value = vm->createValue(node->isNativeAgent());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isBridge"))
-   {
-      value = vm->createValue(node->isBridge());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isCDP"))
-   {
-      value = vm->createValue(is_bit_set(node->getCapabilities(), NC_IS_CDP));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isEtherNetIP"))
-   {
-      value = vm->createValue(node->isEthernetIPSupported());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isInMaintenanceMode"))
-   {
-      value = vm->createValue(node->isInMaintenanceMode());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isLLDP"))
-   {
-      value = vm->createValue(is_bit_set(node->getCapabilities(), NC_IS_LLDP));
-   }
-	else if (NXSL_COMPARE_ATTRIBUTE_NAME("isLocalMgmt") || NXSL_COMPARE_ATTRIBUTE_NAME("isLocalManagement"))
-	{
-		value = vm->createValue(node->isLocalManagement());
-	}
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isModbusTCP"))
-   {
-      value = vm->createValue(node->isModbusTCPSupported());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isOSPF"))
-   {
-      value = vm->createValue(node->isOSPFSupported());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isPAE") || NXSL_COMPARE_ATTRIBUTE_NAME("is802_1x"))
-   {
-      value = vm->createValue(is_bit_set(node->getCapabilities(), NC_IS_8021X));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isPrinter"))
-   {
-      value = vm->createValue(is_bit_set(node->getCapabilities(), NC_IS_PRINTER));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isProfiNet"))
-   {
-      value = vm->createValue(node->isProfiNetSupported());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isRemotelyManaged") || NXSL_COMPARE_ATTRIBUTE_NAME("isExternalGateway"))
-   {
-      value = vm->createValue(is_bit_set(node->getFlags(), NF_EXTERNAL_GATEWAY));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isRouter"))
-   {
-      value = vm->createValue(node->isRouter());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isSMCLP"))
-   {
-      value = vm->createValue(is_bit_set(node->getCapabilities(), NC_IS_SMCLP));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isSNMP"))
-   {
-      value = vm->createValue(node->isSNMPSupported());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isSSH"))
-   {
-      value = vm->createValue(node->isSSHSupported());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isSONMP") || NXSL_COMPARE_ATTRIBUTE_NAME("isNDP"))
-   {
-      value = vm->createValue(is_bit_set(node->getCapabilities(), NC_IS_NDP));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isSTP"))
-   {
-      value = vm->createValue(is_bit_set(node->getCapabilities(), NC_IS_STP));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isVirtual"))
-   {
-      value = vm->createValue(node->isVirtual());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isVRRP"))
-   {
-      value = vm->createValue(is_bit_set(node->getCapabilities(), NC_IS_VRRP));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isWirelessAP"))
-   {
-      value = vm->createValue(node->isWirelessAccessPoint());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("isWirelessController"))
-   {
-      value = vm->createValue(node->isWirelessController());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("lastAgentCommTime"))
-   {
-      value = vm->createValue(static_cast<int64_t>(node->getLastAgentCommTime()));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("modbusProxy"))
-   {
-      shared_ptr<NetObj> object = FindObjectById(node->getModbusProxy());
-      if (object != nullptr)
-      {
-         value = object->createNXSLObject(vm);
-      }
-      else
-      {
-         value = vm->createValue();
-      }
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("modbusProxyId"))
-   {
-      value = vm->createValue(node->getModbusProxy());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("modbusTCPPort"))
-   {
-      value = vm->createValue(node->getModbusTcpPort());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("modbusUnitId"))
-   {
-      value = vm->createValue(node->getModbusUnitId());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("nodeSubType"))
-   {
-      value = vm->createValue(node->getSubType());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("nodeType"))
-   {
-      value = vm->createValue(static_cast<int32_t>(node->getType()));
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("ospfAreas"))
-   {
-      value = node->isOSPFSupported() ? node->getOSPFAreasForNXSL(vm) : vm->createValue();
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("ospfNeighbors"))
-   {
-      value = node->isOSPFSupported() ? node->getOSPFNeighborsForNXSL(vm) : vm->createValue();
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("ospfRouterId"))
-   {
-      TCHAR buffer[16];
-      value = node->isOSPFSupported() ? vm->createValue(IpToStr(node->getOSPFRouterId(), buffer)) : vm->createValue();
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("physicalContainer"))
-   {
-      shared_ptr<NetObj> object = FindObjectById(node->getPhysicalContainerId());
-      if (object != nullptr)
-      {
-         value = object->createNXSLObject(vm);
-      }
-      else
-      {
-         value = vm->createValue();
-      }
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("physicalContainerId"))
-   {
-      value = vm->createValue(node->getPhysicalContainerId());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("platformName"))
-   {
-      value = vm->createValue(node->getPlatformName());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("primaryHostName"))
-   {
-      value = vm->createValue(node->getPrimaryHostName());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("productCode"))
-   {
-      value = vm->createValue(node->getProductCode());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("productName"))
-   {
-      value = vm->createValue(node->getProductName());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("productVersion"))
-   {
-      value = vm->createValue(node->getProductVersion());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("rack"))
-   {
-      shared_ptr<NetObj> rack = FindObjectById(node->getPhysicalContainerId(), OBJECT_RACK);
-      if (rack != nullptr)
-      {
-         value = rack->createNXSLObject(vm);
-      }
-      else
-      {
-         value = vm->createValue();
-      }
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("rackId"))
-   {
-      if (FindObjectById(node->getPhysicalContainerId(), OBJECT_RACK) != nullptr)
-      {
-         value = vm->createValue(node->getPhysicalContainerId());
-      }
-      else
-      {
-         value = vm->createValue(0);
-      }
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("rackHeight"))
-   {
-      value = vm->createValue(node->getRackHeight());
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("rackPosition"))
+   return value;
+}
+
+/**
+ * Node::interfaces attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, interfaces)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return node->getInterfacesForNXSL(vm);
+}
+
+/**
+ * Node::isAgent attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isAgent)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->isNativeAgent());
+}
+
+/**
+ * Node::isBridge attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isBridge)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->isBridge());
+}
+
+/**
+ * Node::isCDP attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isCDP)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(is_bit_set(node->getCapabilities(), NC_IS_CDP));
+}
+
+/**
+ * Node::isEtherNetIP attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isEtherNetIP)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->isEthernetIPSupported());
+}
+
+/**
+ * Node::isLLDP attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isLLDP)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(is_bit_set(node->getCapabilities(), NC_IS_LLDP));
+}
+
+/**
+ * Node::isLocalMgmt attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isLocalMgmt)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->isLocalManagement());
+}
+
+/**
+ * Node::isModbusTCP attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isModbusTCP)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->isModbusTCPSupported());
+}
+
+/**
+ * Node::isOSPF attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isOSPF)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->isOSPFSupported());
+}
+
+/**
+ * Node::isPAE attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isPAE)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(is_bit_set(node->getCapabilities(), NC_IS_8021X));
+}
+
+/**
+ * Node::isPrinter attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isPrinter)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(is_bit_set(node->getCapabilities(), NC_IS_PRINTER));
+}
+
+/**
+ * Node::isProfiNet attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isProfiNet)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->isProfiNetSupported());
+}
+
+/**
+ * Node::isRemotelyManaged attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isRemotelyManaged)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(is_bit_set(node->getFlags(), NF_EXTERNAL_GATEWAY));
+}
+
+/**
+ * Node::isRouter attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isRouter)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->isRouter());
+}
+
+/**
+ * Node::isSMCLP attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isSMCLP)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(is_bit_set(node->getCapabilities(), NC_IS_SMCLP));
+}
+
+/**
+ * Node::isSNMP attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isSNMP)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->isSNMPSupported());
+}
+
+/**
+ * Node::isSSH attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isSSH)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->isSSHSupported());
+}
+
+/**
+ * Node::isSONMP attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isSONMP)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(is_bit_set(node->getCapabilities(), NC_IS_NDP));
+}
+
+/**
+ * Node::isSTP attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isSTP)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(is_bit_set(node->getCapabilities(), NC_IS_STP));
+}
+
+/**
+ * Node::isVirtual attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isVirtual)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->isVirtual());
+}
+
+/**
+ * Node::isVRRP attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isVRRP)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(is_bit_set(node->getCapabilities(), NC_IS_VRRP));
+}
+
+/**
+ * Node::isWirelessAP attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isWirelessAP)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->isWirelessAccessPoint());
+}
+
+/**
+ * Node::isWirelessController attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, isWirelessController)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->isWirelessController());
+}
+
+/**
+ * Node::lastAgentCommTime attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, lastAgentCommTime)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(static_cast<int64_t>(node->getLastAgentCommTime()));
+}
+
+/**
+ * Node::modbusProxy attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, modbusProxy)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value;
+   shared_ptr<NetObj> proxy = FindObjectById(node->getModbusProxy());
+   if (proxy != nullptr)
    {
-      value = vm->createValue(node->getRackPosition());
+      value = proxy->createNXSLObject(vm);
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("runtimeFlags"))
+   else
    {
-      value = vm->createValue(node->getRuntimeFlags());
+      value = vm->createValue();
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("serialNumber"))
+   return value;
+}
+
+/**
+ * Node::modbusProxyId attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, modbusProxyId)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getModbusProxy());
+}
+
+/**
+ * Node::modbusTCPPort attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, modbusTCPPort)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getModbusTcpPort());
+}
+
+/**
+ * Node::modbusUnitId attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, modbusUnitId)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getModbusUnitId());
+}
+
+/**
+ * Node::nodeSubType attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, nodeSubType)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getSubType());
+}
+
+/**
+ * Node::nodeType attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, nodeType)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(static_cast<int32_t>(node->getType()));
+}
+
+/**
+ * Node::ospfAreas attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, ospfAreas)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return node->isOSPFSupported() ? node->getOSPFAreasForNXSL(vm) : vm->createValue();
+}
+
+/**
+ * Node::ospfNeighbors attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, ospfNeighbors)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return node->isOSPFSupported() ? node->getOSPFNeighborsForNXSL(vm) : vm->createValue();
+}
+
+/**
+ * Node::ospfRouterId attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, ospfRouterId)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value;
+   TCHAR buffer[16];
+   value = node->isOSPFSupported() ? vm->createValue(IpToStr(node->getOSPFRouterId(), buffer)) : vm->createValue();
+   return value;
+}
+
+/**
+ * Node::physicalContainer attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, physicalContainer)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value;
+   shared_ptr<NetObj> container = FindObjectById(node->getPhysicalContainerId());
+   if (container != nullptr)
    {
-      value = vm->createValue(node->getSerialNumber());
+      value = container->createNXSLObject(vm);
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("snmpOID"))
+   else
    {
-      value = vm->createValue(node->getSNMPObjectId().toString());   // FIXME: use object representation
+      value = vm->createValue();
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("snmpProxy"))
-   {
-      shared_ptr<NetObj> object = FindObjectById(node->getSNMPProxy());
-      if (object != nullptr)
-      {
-         value = object->createNXSLObject(vm);
-      }
-      else
-      {
-         value = vm->createValue();
-      }
+   return value;
+}
+
+/**
+ * Node::physicalContainerId attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, physicalContainerId)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getPhysicalContainerId());
+}
+
+/**
+ * Node::platformName attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, platformName)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getPlatformName());
+}
+
+/**
+ * Node::primaryHostName attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, primaryHostName)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getPrimaryHostName());
+}
+
+/**
+ * Node::productCode attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, productCode)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getProductCode());
+}
+
+/**
+ * Node::productName attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, productName)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getProductName());
+}
+
+/**
+ * Node::productVersion attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, productVersion)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getProductVersion());
+}
+
+/**
+ * Node::rack attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, rack)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value;
+   shared_ptr<NetObj> rack = FindObjectById(node->getPhysicalContainerId(), OBJECT_RACK);
+   if (rack != nullptr)
+   {
+      value = rack->createNXSLObject(vm);
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("snmpProxyId"))
+   else
    {
-      value = vm->createValue(node->getSNMPProxy());
+      value = vm->createValue();
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("snmpSysContact"))
+   return value;
+}
+
+/**
+ * Node::rackId attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, rackId)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value;
+   if (FindObjectById(node->getPhysicalContainerId(), OBJECT_RACK) != nullptr)
    {
-      value = vm->createValue(node->getSysContact());
+      value = vm->createValue(node->getPhysicalContainerId());
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("snmpSysLocation"))
+   else
    {
-      value = vm->createValue(node->getSysLocation());
+      value = vm->createValue(0);
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("snmpSysName"))
+   return value;
+}
+
+/**
+ * Node::rackHeight attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, rackHeight)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getRackHeight());
+}
+
+/**
+ * Node::rackPosition attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, rackPosition)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getRackPosition());
+}
+
+/**
+ * Node::runtimeFlags attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, runtimeFlags)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getRuntimeFlags());
+}
+
+/**
+ * Node::serialNumber attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, serialNumber)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getSerialNumber());
+}
+
+/**
+ * Node::snmpOID attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, snmpOID)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getSNMPObjectId().toString());   // FIXME: use object representation
+}
+
+/**
+ * Node::snmpProxy attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, snmpProxy)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value;
+   shared_ptr<NetObj> proxy = FindObjectById(node->getSNMPProxy());
+   if (proxy != nullptr)
    {
-      value = vm->createValue(node->getSysName());
+      value = proxy->createNXSLObject(vm);
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("snmpVersion"))
+   else
    {
-      value = vm->createValue((LONG)node->getSNMPVersion());
+      value = vm->createValue();
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("softwarePackages"))
+   return value;
+}
+
+/**
+ * Node::snmpProxyId attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, snmpProxyId)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getSNMPProxy());
+}
+
+/**
+ * Node::snmpSysContact attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, snmpSysContact)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getSysContact());
+}
+
+/**
+ * Node::snmpSysLocation attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, snmpSysLocation)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getSysLocation());
+}
+
+/**
+ * Node::snmpSysName attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, snmpSysName)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getSysName());
+}
+
+/**
+ * Node::snmpVersion attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, snmpVersion)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue((LONG)node->getSNMPVersion());
+}
+
+/**
+ * Node::softwarePackages attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, softwarePackages)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return node->getSoftwarePackagesForNXSL(vm);
+}
+
+/**
+ * Node::sysDescription attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, sysDescription)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getSysDescription());
+}
+
+/**
+ * Node::tunnel attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, tunnel)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value;
+   shared_ptr<AgentTunnel> tunnel = GetTunnelForNode(node->getId());
+   if (tunnel != nullptr)
+      value = vm->createValue(vm->createObject(&g_nxslTunnelClass, new shared_ptr<AgentTunnel>(tunnel)));
+   else
+      value = vm->createValue();
+   return value;
+}
+
+/**
+ * Node::vendor attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, vendor)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getVendor());
+}
+
+/**
+ * Node::vlans attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, vlans)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value;
+   shared_ptr<VlanList> vlans = node->getVlans();
+   if (vlans != nullptr)
    {
-      value = node->getSoftwarePackagesForNXSL(vm);
+      NXSL_Array *a = new NXSL_Array(vm);
+      for(int i = 0; i < vlans->size(); i++)
+      {
+         a->append(vm->createValue(vm->createObject(&g_nxslVlanClass, new VlanInfo(vlans->get(i), node->getId()))));
+      }
+      value = vm->createValue(a);
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("sysDescription"))
+   else
    {
-      value = vm->createValue(node->getSysDescription());
+      value = vm->createValue();
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("tunnel"))
+   return value;
+}
+
+/**
+ * Node::wirelessDomain attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, wirelessDomain)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value;
+   shared_ptr<WirelessDomain> wirelessDomain = node->getWirelessDomain();
+   value = (wirelessDomain != nullptr) ? wirelessDomain->createNXSLObject(vm) : vm->createValue();
+   return value;
+}
+
+/**
+ * Node::wirelessDomainId attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, wirelessDomainId)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value;
+   shared_ptr<WirelessDomain> wirelessDomain = node->getWirelessDomain();
+   value = (wirelessDomain != nullptr) ? vm->createValue(wirelessDomain->getId()) : vm->createValue(static_cast<uint32_t>(0));
+   return value;
+}
+
+/**
+ * Node::wirelessStations attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, wirelessStations)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value;
+   if (node->getCapabilities() & (NC_IS_WIFI_AP | NC_IS_WIFI_CONTROLLER))
    {
-      shared_ptr<AgentTunnel> tunnel = GetTunnelForNode(node->getId());
-      if (tunnel != nullptr)
-         value = vm->createValue(vm->createObject(&g_nxslTunnelClass, new shared_ptr<AgentTunnel>(tunnel)));
-      else
-         value = vm->createValue();
+      value = node->getWirelessStationsForNXSL(vm);
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("vendor"))
+   else
    {
-      value = vm->createValue(node->getVendor());
+      value = vm->createValue();
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("vlans"))
+   return value;
+}
+
+/**
+ * Node::zone attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, zone)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value;
+   if (IsZoningEnabled())
    {
-      shared_ptr<VlanList> vlans = node->getVlans();
-      if (vlans != nullptr)
+      shared_ptr<Zone> zone = FindZoneByUIN(node->getZoneUIN());
+      if (zone != nullptr)
       {
-         NXSL_Array *a = new NXSL_Array(vm);
-         for(int i = 0; i < vlans->size(); i++)
-         {
-            a->append(vm->createValue(vm->createObject(&g_nxslVlanClass, new VlanInfo(vlans->get(i), node->getId()))));
-         }
-         value = vm->createValue(a);
+         value = zone->createNXSLObject(vm);
       }
       else
       {
          value = vm->createValue();
       }
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("wirelessDomain"))
-   {
-      shared_ptr<WirelessDomain> wirelessDomain = node->getWirelessDomain();
-      value = (wirelessDomain != nullptr) ? wirelessDomain->createNXSLObject(vm) : vm->createValue();
-   }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("wirelessDomainId"))
+   else
    {
-      shared_ptr<WirelessDomain> wirelessDomain = node->getWirelessDomain();
-      value = (wirelessDomain != nullptr) ? vm->createValue(wirelessDomain->getId()) : vm->createValue(static_cast<uint32_t>(0));
+      value = vm->createValue();
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("wirelessStations"))
+   return value;
+}
+
+/**
+ * Node::zoneProxyAssignments attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, zoneProxyAssignments)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value;
+   if (IsZoningEnabled())
    {
-      if (node->getCapabilities() & (NC_IS_WIFI_AP | NC_IS_WIFI_CONTROLLER))
+      shared_ptr<Zone> zone = FindZoneByProxyId(node->getId());
+      if (zone != nullptr)
       {
-         value = node->getWirelessStationsForNXSL(vm);
+         value = vm->createValue(zone->getProxyNodeAssignments(node->getId()));
       }
       else
       {
-         value = vm->createValue();
+         value = vm->createValue(0);
       }
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("zone"))
-	{
-      if (IsZoningEnabled())
-      {
-         shared_ptr<Zone> zone = FindZoneByUIN(node->getZoneUIN());
-		   if (zone != nullptr)
-		   {
-			   value = zone->createNXSLObject(vm);
-		   }
-		   else
-		   {
-			   value = vm->createValue();
-		   }
-	   }
-	   else
-	   {
-		   value = vm->createValue();
-	   }
-	}
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("zoneProxyAssignments"))
+   else
    {
-      if (IsZoningEnabled())
-      {
-         shared_ptr<Zone> zone = FindZoneByProxyId(node->getId());
-         if (zone != nullptr)
-         {
-            value = vm->createValue(zone->getProxyNodeAssignments(node->getId()));
-         }
-         else
-         {
-            value = vm->createValue(0);
-         }
-      }
-      else
-      {
-         value = vm->createValue(0);
-      }
+      value = vm->createValue(0);
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("zoneProxyStatus"))
+   return value;
+}
+
+/**
+ * Node::zoneProxyStatus attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, zoneProxyStatus)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   NXSL_Value *value;
+   if (IsZoningEnabled())
    {
-      if (IsZoningEnabled())
+      shared_ptr<Zone> zone = FindZoneByProxyId(node->getId());
+      if (zone != nullptr)
       {
-         shared_ptr<Zone> zone = FindZoneByProxyId(node->getId());
-         if (zone != nullptr)
-         {
-            value = vm->createValue(zone->isProxyNodeAvailable(node->getId()));
-         }
-         else
-         {
-            value = vm->createValue(0);
-         }
+         value = vm->createValue(zone->isProxyNodeAvailable(node->getId()));
       }
       else
       {
          value = vm->createValue(0);
       }
    }
-   else if (NXSL_COMPARE_ATTRIBUTE_NAME("zoneUIN"))
-	{
-      value = vm->createValue(node->getZoneUIN());
+   else
+   {
+      value = vm->createValue(0);
    }
    return value;
 }
 
+/**
+ * Node::zoneUIN attribute
+ */
+NXSL_ATTRIBUTE_DEFINITION(Node, zoneUIN)
+{
+   Node *node = SharedObjectFromData<Node>(object);
+   return vm->createValue(node->getZoneUIN());
+}
+
+/**
+ * NXSL class Node: constructor
+ */
+NXSL_NodeClass::NXSL_NodeClass() : NXSL_DCTargetClass()
+{
+   setName(_T("Node"));
+
+   NXSL_REGISTER_METHOD(Node, callWebService, -1);
+   NXSL_REGISTER_METHOD(Node, createSNMPTransport, -1);
+   NXSL_REGISTER_METHOD(Node, enable8021xStatusPolling, 1);
+   NXSL_REGISTER_METHOD(Node, enableAgent, 1);
+   NXSL_REGISTER_METHOD(Node, enableDiscoveryPolling, 1);
+   NXSL_REGISTER_METHOD(Node, enableEtherNetIP, 1);
+   NXSL_REGISTER_METHOD(Node, enableIcmp, 1);
+   NXSL_REGISTER_METHOD(Node, enableModbusTcp, 1);
+   NXSL_REGISTER_METHOD(Node, enablePrimaryIPPing, 1);
+   NXSL_REGISTER_METHOD(Node, enableRoutingTablePolling, 1);
+   NXSL_REGISTER_METHOD(Node, enableSnmp, 1);
+   NXSL_REGISTER_METHOD(Node, enableSsh, 1);
+   NXSL_REGISTER_METHOD(Node, enableWinPerfCountersCache, 1);
+   NXSL_REGISTER_METHOD(Node, enableTopologyPolling, 1);
+   NXSL_REGISTER_METHOD(Node, executeAgentCommand, -1);
+   NXSL_REGISTER_METHOD(Node, executeAgentCommandWithOutput, -1);
+   NXSL_REGISTER_METHOD(Node, executeSSHCommand, 1);
+   NXSL_REGISTER_METHOD(Node, getInterface, 1);
+   NXSL_REGISTER_METHOD(Node, getInterfaceByIndex, 1);
+   NXSL_REGISTER_METHOD(Node, getInterfaceByMACAddress, 1);
+   NXSL_REGISTER_METHOD(Node, getInterfaceByName, 1);
+   NXSL_REGISTER_METHOD(Node, getInterfaceName, 1);
+   NXSL_REGISTER_METHOD(Node, getWebService, 1);
+   NXSL_REGISTER_METHOD(Node, readAgentList, 1);
+   NXSL_REGISTER_METHOD(Node, readAgentParameter, 1);
+   NXSL_REGISTER_METHOD(Node, readAgentTable, 1);
+   NXSL_REGISTER_METHOD(Node, readDriverParameter, 1);
+   NXSL_REGISTER_METHOD(Node, readInternalParameter, 1);
+   NXSL_REGISTER_METHOD(Node, readInternalTable, 1);
+   NXSL_REGISTER_METHOD(Node, readWebServiceList, 1);
+   NXSL_REGISTER_METHOD(Node, readWebServiceParameter, 1);
+   NXSL_REGISTER_METHOD(Node, setIfXTableUsageMode, 1);
+
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, agentCertificateMappingData);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, agentCertificateMappingMethod);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, agentCertificateSubject);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, agentId);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, agentProxy);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, agentVersion);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, bootTime);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, bridgeBaseAddress);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, capabilities);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, cipDeviceType);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, cipDeviceTypeAsText);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, cipExtendedStatus);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, cipExtendedStatusAsText);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, cipStatus);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, cipStatusAsText);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, cipState);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, cipStateAsText);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, cipVendorCode);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, cluster);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, components);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, dependentNodes);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, driver);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, downSince);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, effectiveAgentProxy);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, effectiveIcmpProxy);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, effectiveSnmpProxy);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, flags);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, hasAgentIfXCounters);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, hasEntityMIB);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, hasIfXTable);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, hasUserAgent);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, hasVLANs);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, hardwareId);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, hardwareComponents);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, hasWinPDH);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, hypervisorInfo);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, hypervisorType);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, icmpAverageRTT);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, icmpLastRTT);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, icmpMaxRTT);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, icmpMinRTT);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, icmpPacketLoss);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, icmpProxy);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, interfaces);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, isAgent);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, isBridge);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, isCDP);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, isEtherNetIP);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, isLLDP);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, isLocalMgmt);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE_ALIAS(Node, isLocalMgmt, isLocalManagement);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, isModbusTCP);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, isOSPF);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, isPAE);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE_ALIAS(Node, isPAE, is802_1x);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, isPrinter);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, isProfiNet);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, isRemotelyManaged);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE_ALIAS(Node, isRemotelyManaged, isExternalGateway);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, isRouter);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, isSMCLP);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, isSNMP);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, isSSH);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, isSONMP);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE_ALIAS(Node, isSONMP, isNDP);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, isSTP);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, isVirtual);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, isVRRP);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, isWirelessAP);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, isWirelessController);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, lastAgentCommTime);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, modbusProxy);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, modbusProxyId);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, modbusTCPPort);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, modbusUnitId);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, nodeSubType);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, nodeType);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, ospfAreas);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, ospfNeighbors);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, ospfRouterId);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, physicalContainer);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, physicalContainerId);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, platformName);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, primaryHostName);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, productCode);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, productName);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, productVersion);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, rack);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, rackId);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, rackHeight);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, rackPosition);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, runtimeFlags);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, serialNumber);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, snmpOID);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, snmpProxy);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, snmpProxyId);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, snmpSysContact);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, snmpSysLocation);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, snmpSysName);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, snmpVersion);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, softwarePackages);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, sysDescription);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, tunnel);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, vendor);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, vlans);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, wirelessDomain);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, wirelessDomainId);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, wirelessStations);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, zone);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, zoneProxyAssignments);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, zoneProxyStatus);
+   NXSL_REGISTER_OVERRIDABLE_ATTRIBUTE(Node, zoneUIN);
+}
+
 /**
  * Interface::enableAgentStatusPolling(enabled) method
  */
@@ -5096,6 +6009,7 @@ NXSL_METHOD_DEFINITION(DCI, forcePoll)
       if (dcObject != nullptr)
       {
          dcObject->requestForcePoll(nullptr);
+         ScheduleDCObjectPollNow(dcObject);
       }
    }
    *result = vm->createValue();
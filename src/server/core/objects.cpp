@@ -302,6 +302,9 @@ void NetObjInsert(const shared_ptr<NetObj>& object, bool newObject, bool importe
 	g_idxObjectById.put(object->getId(), object);
 	g_idxObjectByGUID.put(object->getGuid(), object);
 
+   if (object->getAsPollable() != nullptr)
+      SchedulePolls(object.get());
+
    if (!object->isDeleted())
    {
       switch(object->getObjectClass())
@@ -1406,6 +1409,28 @@ uint32_t FindLocalMgmtNode()
 	return (object != nullptr) ? object->getId() : 0;
 }
 
+/**
+ * Maximum number of object loader threads
+ */
+#define MAX_OBJECT_LOADER_THREADS   32
+
+/**
+ * Maximum number of in-memory databases (shards) used for caching object configuration tables
+ * (limited by maximum number of attached databases in SQLite)
+ */
+#define MAX_CACHE_DB_SHARDS         8
+
+/**
+ * Minimal number of objects in table for parallel loading
+ */
+#define MIN_PARALLEL_LOAD_COUNT     64
+
+/**
+ * Additional database connections for object loader threads
+ */
+static DB_HANDLE s_loaderConnections[MAX_OBJECT_LOADER_THREADS];
+static int s_loaderConnectionCount = 0;
+
 /**
  * Template function for loading objects from database
  * 
@@ -1415,43 +1440,421 @@ uint32_t FindLocalMgmtNode()
  * @param index        clearing startup mode for specific object index
  * @param beforeInsert function called before object insertion in indexes
  * @param afterInsert  function called after object insertion in indexes
+ * @param parallel     allow loading objects in parallel (objects should not depend on other objects of same class during load)
  */
-template<typename T> static void LoadObjectsFromTable(const TCHAR *className, DB_HANDLE hdb, const TCHAR* query, void (*beforeInsert)(const shared_ptr<T>& obj) = nullptr, void (*afterInsert)(const shared_ptr<T>& obj) = nullptr)
+template<typename T> static void LoadObjectsFromTable(const TCHAR *className, DB_HANDLE hdb, const TCHAR* query, void (*beforeInsert)(const shared_ptr<T>& obj) = nullptr,
+         void (*afterInsert)(const shared_ptr<T>& obj) = nullptr, bool parallel = false)
 {
    nxlog_debug_tag(DEBUG_TAG_OBJECT_INIT, 2, _T("Loading %s%s..."), className, _tcscmp(className, _T("chassis")) ? _T("s") : _T(""));
+   int64_t startTime = GetCurrentTimeMs();
    DB_RESULT hResult = DBSelectFormatted(hdb, _T("SELECT id FROM %s"), query);
-   if (hResult != nullptr)
+   if (hResult == nullptr)
+      return;
+
+   auto registerObject = [className, beforeInsert, afterInsert] (const shared_ptr<T>& object, uint32_t id, bool loaded) -> void
+   {
+      if (loaded)
+      {
+         // In case we need some logic before inserting object to indexes
+         if (beforeInsert != nullptr)
+         {
+            beforeInsert(object);
+         }
+
+         // Insert into indexes
+         NetObjInsert(object, false, false);
+
+         // In case we need some logic after inserting object to indexes
+         if (afterInsert != nullptr)
+         {
+            afterInsert(object);
+         }
+      }
+      else     // Object load failed
+      {
+         object->destroy();
+         nxlog_write_tag(NXLOG_ERROR, DEBUG_TAG_OBJECT_INIT, _T("Failed to load %s object with ID %u from database"), className, id);
+      }
+   };
+
+   int count = DBGetNumRows(hResult);
+   if (parallel && (s_loaderConnectionCount > 0) && (count >= MIN_PARALLEL_LOAD_COUNT))
+   {
+      uint32_t *ids = MemAllocArrayNoInit<uint32_t>(count);
+      for(int i = 0; i < count; i++)
+         ids[i] = DBGetFieldULong(hResult, i, 0);
+      DBFreeResult(hResult);
+
+      // Objects are loaded by loader threads and calling thread, each using own database connection.
+      // Links between objects requested during load are deferred and applied by calling thread.
+      ObjectArray<DeferredObjectLink> deferredLinks(0, 1024, Ownership::True);
+      NetObj::setLinkDeferral(&deferredLinks);
+      shared_ptr<T> *objects = new shared_ptr<T>[count];
+      bool *loaded = MemAllocArray<bool>(count);
+      VolatileCounter nextIndex = -1;
+      auto loader = [count, ids, objects, loaded, &nextIndex] (DB_HANDLE conn) -> void
+      {
+         int i;
+         while((i = InterlockedIncrement(&nextIndex)) < count)
+         {
+            objects[i] = make_shared<T>();
+            loaded[i] = objects[i]->loadFromDatabase(conn, ids[i]);
+         }
+      };
+
+      THREAD threads[MAX_OBJECT_LOADER_THREADS];
+      for(int i = 0; i < s_loaderConnectionCount; i++)
+      {
+         DB_HANDLE conn = s_loaderConnections[i];
+         threads[i] = ThreadCreateEx([loader, conn] () -> void { loader(conn); });
+      }
+      loader(hdb);
+      for(int i = 0; i < s_loaderConnectionCount; i++)
+         ThreadJoin(threads[i]);
+      NetObj::setLinkDeferral(nullptr);
+
+      // Order deferred links by position of child object in load order (links of each object are requested
+      // by single thread, so request sequence preserves original order for same object). Links where child
+      // is not one of loaded objects are applied first.
+      std::vector<std::pair<const NetObj*, int>> positions(count);
+      for(int i = 0; i < count; i++)
+         positions[i] = std::pair<const NetObj*, int>(objects[i].get(), i);
+      std::sort(positions.begin(), positions.end());
+      std::vector<std::pair<int, DeferredObjectLink*>> links;
+      links.reserve(deferredLinks.size());
+      for(int i = 0; i < deferredLinks.size(); i++)
+      {
+         DeferredObjectLink *link = deferredLinks.get(i);
+         auto it = std::lower_bound(positions.begin(), positions.end(), std::pair<const NetObj*, int>(link->child.get(), 0));
+         links.emplace_back(((it != positions.end()) && (it->first == link->child.get())) ? it->second : -1, link);
+      }
+      std::sort(links.begin(), links.end(),
+         [] (const std::pair<int, DeferredObjectLink*>& a, const std::pair<int, DeferredObjectLink*>& b) -> bool
+         {
+            return (a.first < b.first) || ((a.first == b.first) && (a.second->sequence < b.second->sequence));
+         });
+
+      // Link objects and insert them into indexes in original order
+      size_t nextLink = 0;
+      for(; (nextLink < links.size()) && (links[nextLink].first < 0); nextLink++)
+         NetObj::linkObjects(links[nextLink].second->parent, links[nextLink].second->child);
+      for(int i = 0; i < count; i++)
+      {
+         for(; (nextLink < links.size()) && (links[nextLink].first == i); nextLink++)
+            NetObj::linkObjects(links[nextLink].second->parent, links[nextLink].second->child);
+         registerObject(objects[i], ids[i], loaded[i]);
+      }
+
+      delete[] objects;
+      MemFree(loaded);
+      MemFree(ids);
+   }
+   else
    {
-      int count = DBGetNumRows(hResult);
       for (int i = 0; i < count; i++)
       {
          uint32_t id = DBGetFieldULong(hResult, i, 0);
          auto object = make_shared<T>();
-         if (object->loadFromDatabase(hdb, id))
-         {
-            // In case we need some logic before inserting object to indexes
-            if (beforeInsert != nullptr)
-            {
-               beforeInsert(object);
-            }
+         registerObject(object, id, object->loadFromDatabase(hdb, id));
+      }
+      DBFreeResult(hResult);
+   }
 
-            // Insert into indexes
-            NetObjInsert(object, false, false);
+   nxlog_debug_tag(DEBUG_TAG_OBJECT_INIT, 3, _T("%d %s object%s loaded in %u ms"), count, className, (count == 1) ? _T("") : _T("s"),
+      static_cast<uint32_t>(GetCurrentTimeMs() - startTime));
+}
+
+/**
+ * Integer columns in cached tables
+ */
+static const TCHAR *s_cacheIntColumns[] = { _T("condition_id"), _T("sequence_number"), _T("dci_id"), _T("node_id"), _T("dci_func"), _T("num_pols"),
+                                            _T("dashboard_id"), _T("element_id"), _T("element_type"), _T("threshold_id"), _T("item_id"),
+                                            _T("check_function"), _T("check_operation"), _T("sample_count"), _T("event_code"), _T("rearm_event_code"),
+                                            _T("repeat_interval"), _T("current_state"), _T("current_severity"), _T("match_count"),
+                                            _T("last_event_timestamp"), _T("table_id"), _T("flags"), _T("id"), _T("activation_event"),
+                                            _T("deactivation_event"), _T("group_id"), _T("iface_id"), _T("vlan_id"), _T("object_id"),
+                                            _T("asset_id"), _T("owner_id"), _T("radio_index"), nullptr };
+
+/**
+ * Object configuration tables cached at startup
+ */
+static struct
+{
+   const TCHAR *name;
+   const TCHAR *key;
+   bool intColumns;
+   const TCHAR *indexColumn;  // Column for additional index
+} s_cachedTables[] =
+{
+   { _T("object_properties"), _T("object_id"), false, nullptr },
+   { _T("object_custom_attributes"), _T("object_id,attr_name"), false, nullptr },
+   { _T("object_urls"), _T("object_id,url_id"), false, nullptr },
+   { _T("responsible_users"), _T("object_id,user_id"), false, nullptr },
+   { _T("nodes"), _T("id"), false, nullptr },
+   { _T("zones"), _T("id"), false, nullptr },
+   { _T("zone_proxies"), _T("object_id,proxy_node"), false, nullptr },
+   { _T("conditions"), _T("id"), false, nullptr },
+   { _T("cond_dci_map"), _T("condition_id,sequence_number"), true, nullptr },
+   { _T("subnets"), _T("id"), false, nullptr },
+   { _T("nsmap"), _T("subnet_id,node_id"), false, nullptr },
+   { _T("racks"), _T("id"), false, nullptr },
+   { _T("rack_passive_elements"), _T("id"), false, nullptr },
+   { _T("physical_links"), _T("id"), false, nullptr },
+   { _T("chassis"), _T("id"), false, nullptr },
+   { _T("mobile_devices"), _T("id"), false, nullptr },
+   { _T("sensors"), _T("id"), false, nullptr },
+   { _T("access_points"), _T("id"), false, nullptr },
+   { _T("radios"), _T("owner_id,radio_index,bssid"), true, nullptr },
+   { _T("interfaces"), _T("id"), true, nullptr },
+   { _T("interface_address_list"), _T("iface_id,ip_addr"), true, nullptr },
+   { _T("interface_vlan_list"), _T("iface_id,vlan_id"), true, nullptr },
+   { _T("network_services"), _T("id"), false, nullptr },
+   { _T("vpn_connectors"), _T("id"), false, nullptr },
+   { _T("vpn_connector_networks"), _T("vpn_id,ip_addr"), false, nullptr },
+   { _T("clusters"), _T("id"), false, nullptr },
+   { _T("cluster_members"), _T("cluster_id,node_id"), false, nullptr },
+   { _T("cluster_sync_subnets"), _T("cluster_id,subnet_addr"), false, nullptr },
+   { _T("cluster_resources"), _T("cluster_id,resource_id"), false, nullptr },
+   { _T("templates"), _T("id"), false, nullptr },
+   { _T("items"), _T("item_id"), false, _T("node_id") },
+   { _T("thresholds"), _T("threshold_id"), true, _T("item_id") },
+   { _T("raw_dci_values"), _T("item_id"), false, nullptr },
+   { _T("dc_tables"), _T("item_id"), false, _T("node_id") },
+   { _T("dc_table_columns"), _T("table_id,column_name"), true, nullptr },
+   { _T("dc_targets"), _T("id"), true, nullptr },
+   { _T("dct_thresholds"), _T("id"), true, _T("table_id") },
+   { _T("dct_threshold_conditions"), _T("threshold_id,group_id,sequence_number"), false, nullptr },
+   { _T("dct_threshold_instances"), _T("threshold_id,instance_id"), false, nullptr },
+   { _T("dct_node_map"), _T("template_id,node_id"), true, nullptr },
+   { _T("dci_delete_list"), _T("node_id,dci_id"), false, nullptr },
+   { _T("dci_schedules"), _T("item_id,schedule_id"), false, nullptr },
+   { _T("dci_access"), _T("dci_id,user_id"), false, nullptr },
+   { _T("ap_common"), _T("guid"), false, nullptr },
+   { _T("network_maps"), _T("id"), false, nullptr },
+   { _T("network_map_deleted_nodes"), _T("map_id,object_id"), false, nullptr },
+   { _T("network_map_elements"), _T("map_id,element_id"), false, nullptr },
+   { _T("network_map_links"), _T("map_id,link_id"), false, nullptr },
+   { _T("network_map_seed_nodes"), _T("map_id,seed_node_id"), false, nullptr },
+   { _T("node_components"), _T("node_id,component_index"), false, nullptr },
+   { _T("object_containers"), _T("id"), true, nullptr },
+   { _T("ospf_areas"), _T("node_id,area_id"), true, nullptr },
+   { _T("ospf_neighbors"), _T("node_id,router_id,if_index,ip_address"), true, nullptr },
+   { _T("container_members"), _T("container_id,object_id"), true, nullptr },
+   { _T("dashboards"), _T("id"), true, nullptr },
+   { _T("dashboard_elements"), _T("dashboard_id,element_id"), true, nullptr },
+   { _T("dashboard_associations"), _T("object_id,dashboard_id"), true, nullptr },
+   { _T("business_service_checks"), _T("id"), true, nullptr },
+   { _T("business_services"), _T("id"), true, nullptr },
+   { _T("business_service_prototypes"), _T("id"), true, nullptr },
+   { _T("acl"), _T("object_id,user_id"), true, nullptr },
+   { _T("trusted_objects"), _T("object_id,trusted_object_id"), false, nullptr },
+   { _T("auto_bind_target"), _T("object_id"), true, nullptr },
+   { _T("icmp_statistics"), _T("object_id,poll_target"), true, nullptr },
+   { _T("icmp_target_address_list"), _T("node_id,ip_addr"), true, nullptr },
+   { _T("software_inventory"), _T("node_id,name,version"), true, nullptr },
+   { _T("hardware_inventory"), _T("node_id,category,component_index"), true, nullptr },
+   { _T("versionable_object"), _T("object_id"), true, nullptr },
+   { _T("pollable_objects"), _T("id"), true, nullptr },
+   { _T("assets"), _T("id"), true, nullptr },
+   { _T("asset_properties"), _T("asset_id,attr_name"), false, nullptr },
+   { nullptr, nullptr, false, nullptr }
+};
 
-            // In case we need some logic after inserting object to indexes
-            if (afterInsert != nullptr)
-            {
-               afterInsert(object);
-            }
+/**
+ * Cache object configuration table
+ */
+static bool CacheObjectTable(DB_HANDLE cachedb, DB_HANDLE sourceDB, int index)
+{
+   auto table = &s_cachedTables[index];
+   if (!DBCacheTable(cachedb, sourceDB, table->name, table->key, _T("*"), table->intColumns ? s_cacheIntColumns : nullptr))
+      return false;
+
+   if (table->indexColumn != nullptr)
+   {
+      TCHAR query[256];
+      _sntprintf(query, 256, _T("CREATE INDEX idx_%s_%s ON %s(%s)"), table->name, table->indexColumn, table->name, table->indexColumn);
+      DBQuery(cachedb, query);
+   }
+   return true;
+}
+
+/**
+ * Close in-memory databases used for caching object configuration tables
+ */
+static void CloseCacheShards(DB_HANDLE *shards, int count)
+{
+   for(int i = 0; i < count; i++)
+      if (shards[i] != nullptr)
+         DBCloseInMemoryDatabase(shards[i]);
+}
+
+/**
+ * Cache object configuration tables. If more than one shard requested, tables are distributed between
+ * named in-memory databases which are filled in parallel, each by separate thread with own source database
+ * connection. Returns true on success.
+ */
+static bool CacheObjectTables(DB_HANDLE *shards, int shardCount, DB_HANDLE mainDB)
+{
+   if (shardCount == 1)
+   {
+      shards[0] = DBOpenInMemoryDatabase();
+      if (shards[0] == nullptr)
+         return false;
+      for(int i = 0; s_cachedTables[i].name != nullptr; i++)
+      {
+         if (!CacheObjectTable(shards[0], mainDB, i))
+         {
+            CloseCacheShards(shards, 1);
+            return false;
          }
-         else     // Object load failed
+      }
+      return true;
+   }
+
+   for(int i = 0; i < shardCount; i++)
+   {
+      TCHAR name[32];
+      _sntprintf(name, 32, _T("objcache%d"), i);
+      shards[i] = DBOpenInMemoryDatabase(name);
+      if (shards[i] == nullptr)
+      {
+         CloseCacheShards(shards, i);
+         return false;
+      }
+   }
+
+   VolatileCounter nextTable = -1;
+   VolatileCounter failures = 0;
+   auto worker = [&nextTable, &failures] (DB_HANDLE cachedb, DB_HANDLE sourceDB) -> void
+   {
+      int i;
+      while((i = InterlockedIncrement(&nextTable)) < static_cast<int>(sizeof(s_cachedTables) / sizeof(s_cachedTables[0])) - 1)
+      {
+         if (!CacheObjectTable(cachedb, sourceDB, i))
          {
-            object->destroy();
-            nxlog_write_tag(NXLOG_ERROR, DEBUG_TAG_OBJECT_INIT, _T("Failed to load %s object with ID %u from database"), className, id);
+            nxlog_debug_tag(DEBUG_TAG_OBJECT_INIT, 1, _T("Cannot cache table %s"), s_cachedTables[i].name);
+            InterlockedIncrement(&failures);
          }
       }
+   };
+
+   THREAD threads[MAX_CACHE_DB_SHARDS];
+   for(int i = 1; i < shardCount; i++)
+   {
+      DB_HANDLE cachedb = shards[i];
+      threads[i] = ThreadCreateEx(
+         [worker, cachedb] () -> void
+         {
+            // Do not wait for pool connection - if pool is exhausted remaining tables will be cached by other workers
+            DB_HANDLE sourceDB = DBConnectionPoolTryAcquireConnection();
+            if (sourceDB == nullptr)
+               return;
+            worker(cachedb, sourceDB);
+            DBConnectionPoolReleaseConnection(sourceDB);
+         });
+   }
+   worker(shards[0], mainDB);
+   for(int i = 1; i < shardCount; i++)
+      ThreadJoin(threads[i]);
+
+   if (failures > 0)
+   {
+      CloseCacheShards(shards, shardCount);
+      return false;
+   }
+   return true;
+}
+
+/**
+ * Open connection to cached object configuration tables distributed between given number of shards
+ */
+static DB_HANDLE OpenObjectCacheConnection(int shardCount)
+{
+   DB_HANDLE hdb = DBOpenInMemoryDatabase();
+   if (hdb == nullptr)
+      return nullptr;
+
+   for(int i = 0; i < shardCount; i++)
+   {
+      TCHAR name[32];
+      _sntprintf(name, 32, _T("objcache%d"), i);
+      if (!DBAttachInMemoryDatabase(hdb, name))
+      {
+         DBCloseInMemoryDatabase(hdb);
+         return nullptr;
+      }
+   }
+   return hdb;
+}
+
+/**
+ * Copy cached object configuration tables from attached shards into private in-memory database of given
+ * connection and detach shards. Access to shared cache tables is serialized by SQLite, so loader threads
+ * working on private copies do not block each other. On failure connection is left unchanged.
+ */
+static bool MakePrivateCacheCopy(DB_HANDLE hdb, int shardCount)
+{
+   if (!DBBegin(hdb))
+      return false;
+
+   bool success = true;
+   for(int i = 0; (i < shardCount) && success; i++)
+   {
+      TCHAR query[256];
+      _sntprintf(query, 256, _T("SELECT name,sql FROM objcache%d.sqlite_master WHERE type='table'"), i);
+      DB_RESULT hResult = DBSelect(hdb, query);
+      if (hResult == nullptr)
+      {
+         success = false;
+         break;
+      }
+
+      int count = DBGetNumRows(hResult);
+      for(int j = 0; (j < count) && success; j++)
+      {
+         TCHAR name[128];
+         DBGetField(hResult, j, 0, name, 128);
+         String createStatement = DBGetFieldAsString(hResult, j, 1);
+         StringBuffer copyStatement(_T("INSERT INTO main."));
+         copyStatement.append(name);
+         copyStatement.append(_T(" SELECT * FROM objcache"));
+         copyStatement.append(i);
+         copyStatement.append(_T('.'));
+         copyStatement.append(name);
+         success = DBQuery(hdb, createStatement) && DBQuery(hdb, copyStatement);
+      }
       DBFreeResult(hResult);
    }
+
+   if (!success)
+   {
+      DBRollback(hdb);
+      return false;
+   }
+   DBCommit(hdb);
+
+   for(int i = 0; i < shardCount; i++)
+   {
+      TCHAR query[64];
+      _sntprintf(query, 64, _T("DETACH DATABASE objcache%d"), i);
+      DBQuery(hdb, query);
+   }
+   return true;
+}
+
+/**
+ * Release database connections used by object loader threads
+ */
+static void ReleaseLoaderConnections(bool cache)
+{
+   for(int i = 0; i < s_loaderConnectionCount; i++)
+   {
+      if (cache)
+         DBCloseInMemoryDatabase(s_loaderConnections[i]);
+      else
+         DBConnectionPoolReleaseConnection(s_loaderConnections[i]);
+   }
+   s_loaderConnectionCount = 0;
 }
 
 /**
@@ -1485,105 +1888,77 @@ bool LoadObjects()
    delete uinList;
    MemFree(uinHistory);
 
+   int loaderThreads = ConfigReadInt(_T("Objects.StartupLoaderThreads"), 4);
+   if (loaderThreads < 1)
+      loaderThreads = 1;
+   else if (loaderThreads > MAX_OBJECT_LOADER_THREADS)
+      loaderThreads = MAX_OBJECT_LOADER_THREADS;
+
+   int64_t startTime = GetCurrentTimeMs();
    DB_HANDLE mainDB = DBConnectionPoolAcquireConnection();
    DB_HANDLE hdb = mainDB;
-   DB_HANDLE cachedb = (g_flags & AF_CACHE_DB_ON_STARTUP) ? DBOpenInMemoryDatabase() : nullptr;
-   if (cachedb != nullptr)
+   DB_HANDLE cachedb = nullptr;
+   DB_HANDLE cacheShards[MAX_CACHE_DB_SHARDS];
+   int cacheShardCount = 0;
+   if (g_flags & AF_CACHE_DB_ON_STARTUP)
    {
-      static const TCHAR *intColumns[] = { _T("condition_id"), _T("sequence_number"), _T("dci_id"), _T("node_id"), _T("dci_func"), _T("num_pols"),
-                                           _T("dashboard_id"), _T("element_id"), _T("element_type"), _T("threshold_id"), _T("item_id"),
-                                           _T("check_function"), _T("check_operation"), _T("sample_count"), _T("event_code"), _T("rearm_event_code"),
-                                           _T("repeat_interval"), _T("current_state"), _T("current_severity"), _T("match_count"),
-                                           _T("last_event_timestamp"), _T("table_id"), _T("flags"), _T("id"), _T("activation_event"),
-                                           _T("deactivation_event"), _T("group_id"), _T("iface_id"), _T("vlan_id"), _T("object_id"),
-                                           _T("asset_id"), _T("owner_id"), _T("radio_index"), nullptr };
-
       nxlog_debug_tag(DEBUG_TAG_OBJECT_INIT, 1, _T("Caching object configuration tables"));
-      bool success =
-               DBCacheTable(cachedb, mainDB, _T("object_properties"), _T("object_id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("object_custom_attributes"), _T("object_id,attr_name"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("object_urls"), _T("object_id,url_id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("responsible_users"), _T("object_id,user_id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("nodes"), _T("id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("zones"), _T("id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("zone_proxies"), _T("object_id,proxy_node"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("conditions"), _T("id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("cond_dci_map"), _T("condition_id,sequence_number"), _T("*"), intColumns) &&
-               DBCacheTable(cachedb, mainDB, _T("subnets"), _T("id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("nsmap"), _T("subnet_id,node_id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("racks"), _T("id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("rack_passive_elements"), _T("id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("physical_links"), _T("id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("chassis"), _T("id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("mobile_devices"), _T("id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("sensors"), _T("id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("access_points"), _T("id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("radios"), _T("owner_id,radio_index,bssid"), _T("*"), intColumns) &&
-               DBCacheTable(cachedb, mainDB, _T("interfaces"), _T("id"), _T("*"), intColumns) &&
-               DBCacheTable(cachedb, mainDB, _T("interface_address_list"), _T("iface_id,ip_addr"), _T("*"), intColumns) &&
-               DBCacheTable(cachedb, mainDB, _T("interface_vlan_list"), _T("iface_id,vlan_id"), _T("*"), intColumns) &&
-               DBCacheTable(cachedb, mainDB, _T("network_services"), _T("id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("vpn_connectors"), _T("id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("vpn_connector_networks"), _T("vpn_id,ip_addr"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("clusters"), _T("id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("cluster_members"), _T("cluster_id,node_id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("cluster_sync_subnets"), _T("cluster_id,subnet_addr"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("cluster_resources"), _T("cluster_id,resource_id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("templates"), _T("id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("items"), _T("item_id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("thresholds"), _T("threshold_id"), _T("*"), intColumns) &&
-               DBCacheTable(cachedb, mainDB, _T("raw_dci_values"), _T("item_id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("dc_tables"), _T("item_id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("dc_table_columns"), _T("table_id,column_name"), _T("*"), intColumns) &&
-               DBCacheTable(cachedb, mainDB, _T("dc_targets"), _T("id"), _T("*"), intColumns) &&
-               DBCacheTable(cachedb, mainDB, _T("dct_thresholds"), _T("id"), _T("*"), intColumns) &&
-               DBCacheTable(cachedb, mainDB, _T("dct_threshold_conditions"), _T("threshold_id,group_id,sequence_number"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("dct_threshold_instances"), _T("threshold_id,instance_id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("dct_node_map"), _T("template_id,node_id"), _T("*"), intColumns) &&
-               DBCacheTable(cachedb, mainDB, _T("dci_delete_list"), _T("node_id,dci_id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("dci_schedules"), _T("item_id,schedule_id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("dci_access"), _T("dci_id,user_id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("ap_common"), _T("guid"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("network_maps"), _T("id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("network_map_deleted_nodes"), _T("map_id,object_id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("network_map_elements"), _T("map_id,element_id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("network_map_links"), _T("map_id,link_id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("network_map_seed_nodes"), _T("map_id,seed_node_id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("node_components"), _T("node_id,component_index"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("object_containers"), _T("id"), _T("*"), intColumns) &&
-               DBCacheTable(cachedb, mainDB, _T("ospf_areas"), _T("node_id,area_id"), _T("*"), intColumns) &&
-               DBCacheTable(cachedb, mainDB, _T("ospf_neighbors"), _T("node_id,router_id,if_index,ip_address"), _T("*"), intColumns) &&
-               DBCacheTable(cachedb, mainDB, _T("container_members"), _T("container_id,object_id"), _T("*"), intColumns) &&
-               DBCacheTable(cachedb, mainDB, _T("dashboards"), _T("id"), _T("*"), intColumns) &&
-               DBCacheTable(cachedb, mainDB, _T("dashboard_elements"), _T("dashboard_id,element_id"), _T("*"), intColumns) &&
-               DBCacheTable(cachedb, mainDB, _T("dashboard_associations"), _T("object_id,dashboard_id"), _T("*"), intColumns) &&
-               DBCacheTable(cachedb, mainDB, _T("business_service_checks"), _T("id"), _T("*"), intColumns) &&
-               DBCacheTable(cachedb, mainDB, _T("business_services"), _T("id"), _T("*"), intColumns) &&
-               DBCacheTable(cachedb, mainDB, _T("business_service_prototypes"), _T("id"), _T("*"), intColumns) &&
-               DBCacheTable(cachedb, mainDB, _T("acl"), _T("object_id,user_id"), _T("*"), intColumns) &&
-               DBCacheTable(cachedb, mainDB, _T("trusted_objects"), _T("object_id,trusted_object_id"), _T("*")) &&
-               DBCacheTable(cachedb, mainDB, _T("auto_bind_target"), _T("object_id"), _T("*"), intColumns) &&
-               DBCacheTable(cachedb, mainDB, _T("icmp_statistics"), _T("object_id,poll_target"), _T("*"), intColumns) &&
-               DBCacheTable(cachedb, mainDB, _T("icmp_target_address_list"), _T("node_id,ip_addr"), _T("*"), intColumns) &&
-               DBCacheTable(cachedb, mainDB, _T("software_inventory"), _T("node_id,name,version"), _T("*"), intColumns) &&
-               DBCacheTable(cachedb, mainDB, _T("hardware_inventory"), _T("node_id,category,component_index"), _T("*"), intColumns) &&
-               DBCacheTable(cachedb, mainDB, _T("versionable_object"), _T("object_id"), _T("*"), intColumns) &&
-               DBCacheTable(cachedb, mainDB, _T("pollable_objects"), _T("id"), _T("*"), intColumns) &&
-               DBCacheTable(cachedb, mainDB, _T("assets"), _T("id"), _T("*"), intColumns) &&
-               DBCacheTable(cachedb, mainDB, _T("asset_properties"), _T("asset_id,attr_name"), _T("*"));
-
-      if (success)
+      int shardCount = std::min(loaderThreads, MAX_CACHE_DB_SHARDS);
+      if (CacheObjectTables(cacheShards, shardCount, mainDB))
+      {
+         cacheShardCount = shardCount;
+         cachedb = (shardCount > 1) ? OpenObjectCacheConnection(shardCount) : cacheShards[0];
+         if (cachedb != nullptr)
+         {
+            hdb = cachedb;
+            nxlog_write_tag(NXLOG_INFO, DEBUG_TAG_OBJECT_INIT, _T("Object configuration tables cached in %u ms using %d thread%s"),
+               static_cast<uint32_t>(GetCurrentTimeMs() - startTime), shardCount, (shardCount > 1) ? _T("s") : _T(""));
+         }
+         else
+         {
+            CloseCacheShards(cacheShards, cacheShardCount);
+            cacheShardCount = 0;
+         }
+      }
+      else
       {
-         hdb = cachedb;
+         nxlog_write_tag(NXLOG_WARNING, DEBUG_TAG_OBJECT_INIT, _T("Cannot cache object configuration tables, objects will be loaded directly from database"));
+      }
+   }
+
+   // Open database connections for object loader threads. Pool connections are acquired without waiting,
+   // so number of loader threads is limited by number of connections available in pool.
+   for(int i = 1; i < loaderThreads; i++)
+   {
+      DB_HANDLE conn = (cachedb != nullptr) ? OpenObjectCacheConnection(cacheShardCount) : DBConnectionPoolTryAcquireConnection();
+      if (conn == nullptr)
+         break;
+      s_loaderConnections[s_loaderConnectionCount++] = conn;
+   }
 
-         // create additional indexes
-         DBQuery(cachedb, _T("CREATE INDEX idx_items_node_id ON items(node_id)"));
-         DBQuery(cachedb, _T("CREATE INDEX idx_thresholds_item_id ON thresholds(item_id)"));
-         DBQuery(cachedb, _T("CREATE INDEX idx_dc_tables_node_id ON dc_tables(node_id)"));
-         DBQuery(cachedb, _T("CREATE INDEX idx_dct_thresholds_table_id ON dct_thresholds(table_id)"));
+   // Give each loader thread private copy of sharded cache (in-memory copy is much faster than caching from
+   // database, and calling thread remains only user of shared cache). Each copy contains all cached tables
+   // (including items and thresholds, which are used by parallel loaded nodes and templates), so memory used
+   // by cache at startup is multiplied by number of loader threads until objects are loaded.
+   if ((cacheShardCount > 1) && (s_loaderConnectionCount > 0))
+   {
+      THREAD threads[MAX_OBJECT_LOADER_THREADS];
+      for(int i = 0; i < s_loaderConnectionCount; i++)
+      {
+         DB_HANDLE conn = s_loaderConnections[i];
+         threads[i] = ThreadCreateEx(
+            [conn, cacheShardCount] () -> void
+            {
+               if (!MakePrivateCacheCopy(conn, cacheShardCount))
+                  nxlog_debug_tag(DEBUG_TAG_OBJECT_INIT, 3, _T("Cannot create private copy of object configuration cache, shared cache will be used"));
+            });
       }
+      for(int i = 0; i < s_loaderConnectionCount; i++)
+         ThreadJoin(threads[i]);
    }
 
+   int64_t loadStartTime = GetCurrentTimeMs();
+
    // Load built-in object properties
    nxlog_debug_tag(DEBUG_TAG_OBJECT_INIT, 2, _T("Loading built-in object properties..."));
    g_entireNetwork->loadFromDatabase(hdb);
@@ -1667,9 +2042,9 @@ bool LoadObjects()
    LoadObjectsFromTable<Rack>(_T("rack"), hdb, _T("racks"));
    LoadObjectsFromTable<Chassis>(_T("chassis"), hdb, _T("chassis"));
    g_idxChassisById.setStartupMode(false);
-   LoadObjectsFromTable<MobileDevice>(_T("mobile device"), hdb, _T("mobile_devices"));
+   LoadObjectsFromTable<MobileDevice>(_T("mobile device"), hdb, _T("mobile_devices"), nullptr, nullptr, true);
    g_idxMobileDeviceById.setStartupMode(false);
-   LoadObjectsFromTable<Sensor>(_T("sensor"), hdb, _T("sensors"));
+   LoadObjectsFromTable<Sensor>(_T("sensor"), hdb, _T("sensors"), nullptr, nullptr, true);
    g_idxSensorById.setStartupMode(false);
 
    LoadObjectsFromTable<Node>(_T("node"), hdb, _T("nodes"), nullptr,
@@ -1682,15 +2057,15 @@ bool LoadObjects()
                zone->updateProxyStatus(node, false);
             }
          }
-      : static_cast<void (*)(const std::shared_ptr<Node>&)>(nullptr));
+      : static_cast<void (*)(const std::shared_ptr<Node>&)>(nullptr), true);
    g_idxNodeById.setStartupMode(false);
 
    LoadObjectsFromTable<WirelessDomain>(_T("wireless domain"), hdb, _T("object_containers WHERE object_class=") AS_STRING(OBJECT_WIRELESSDOMAIN));
-   LoadObjectsFromTable<AccessPoint>(_T("access point"), hdb, _T("access_points"));
+   LoadObjectsFromTable<AccessPoint>(_T("access point"), hdb, _T("access_points"), nullptr, nullptr, true);
    g_idxAccessPointById.setStartupMode(false);
-   LoadObjectsFromTable<Interface>(_T("interface"), hdb, _T("interfaces"));
-   LoadObjectsFromTable<NetworkService>(_T("network service"), hdb, _T("network_services"));
-   LoadObjectsFromTable<VPNConnector>(_T("VPN connector"), hdb, _T("vpn_connectors"));
+   LoadObjectsFromTable<Interface>(_T("interface"), hdb, _T("interfaces"), nullptr, nullptr, true);
+   LoadObjectsFromTable<NetworkService>(_T("network service"), hdb, _T("network_services"), nullptr, nullptr, true);
+   LoadObjectsFromTable<VPNConnector>(_T("VPN connector"), hdb, _T("vpn_connectors"), nullptr, nullptr, true);
    LoadObjectsFromTable<Cluster>(_T("cluster"), hdb, _T("clusters"));
    g_idxClusterById.setStartupMode(false);
    LoadObjectsFromTable<Collector>(_T("collector"), hdb, _T("object_containers WHERE object_class=") AS_STRING(OBJECT_COLLECTOR));
@@ -1706,7 +2081,7 @@ bool LoadObjects()
    g_idxAssetById.setStartupMode(false);
    LoadObjectsFromTable<AssetGroup>(_T("asset group"), hdb, _T("object_containers WHERE object_class=") AS_STRING(OBJECT_ASSETGROUP));
 
-   LoadObjectsFromTable<Template>(_T("template"), hdb, _T("templates"), nullptr, [](const shared_ptr<Template>& t) { t->calculateCompoundStatus(); });
+   LoadObjectsFromTable<Template>(_T("template"), hdb, _T("templates"), nullptr, [](const shared_ptr<Template>& t) { t->calculateCompoundStatus(); }, true);
    LoadObjectsFromTable<NetworkMap>(_T("network map"), hdb, _T("network_maps"));
    g_idxNetMapById.setStartupMode(false);
    LoadObjectsFromTable<Container>(_T("container"), hdb, _T("object_containers WHERE object_class=") AS_STRING(OBJECT_CONTAINER));
@@ -1720,12 +2095,19 @@ bool LoadObjects()
    g_idxBusinessServicesById.setStartupMode(false);
    g_idxObjectById.setStartupMode(false);
 
+   int usedLoaderThreads = s_loaderConnectionCount + 1;  // Actual number can be lower than configured if pool connections are exhausted
+   ReleaseLoaderConnections(cachedb != nullptr);
+   nxlog_write_tag(NXLOG_INFO, DEBUG_TAG_OBJECT_INIT, _T("Objects loaded from database in %u ms using %d thread%s"),
+      static_cast<uint32_t>(GetCurrentTimeMs() - loadStartTime), usedLoaderThreads, (usedLoaderThreads > 1) ? _T("s") : _T(""));
+
 	// Load custom object classes provided by modules
    CALL_ALL_MODULES(pfLoadObjects, ());
 
    // Execute post-load hooks on objects
    nxlog_debug_tag(DEBUG_TAG_OBJECT_INIT, 2, _T("Executing post-load object hooks..."));
+   int64_t postLoadStartTime = GetCurrentTimeMs();
 	g_idxObjectById.forEach([] (NetObj *object) { object->postLoad(); });
+   nxlog_write_tag(NXLOG_INFO, DEBUG_TAG_OBJECT_INIT, _T("Post-load object hooks executed in %u ms"), static_cast<uint32_t>(GetCurrentTimeMs() - postLoadStartTime));
 
 	// Link custom object classes provided by modules
    CALL_ALL_MODULES(pfLinkObjects, ());
@@ -1741,8 +2123,9 @@ bool LoadObjects()
    }
    DBConnectionPoolReleaseConnection(mainDB);
 
-   if (cachedb != nullptr)
+   if ((cachedb != nullptr) && (cacheShardCount > 1))
       DBCloseInMemoryDatabase(cachedb);
+   CloseCacheShards(cacheShards, cacheShardCount);
 
    // Recalculate status for built-in objects
    g_entireNetwork->calculateCompoundStatus();
@@ -1806,6 +2189,7 @@ bool LoadObjects()
          }
       });
 
+   nxlog_write_tag(NXLOG_INFO, DEBUG_TAG_OBJECT_INIT, _T("Object initialization completed in %u ms"), static_cast<uint32_t>(GetCurrentTimeMs() - startTime));
    return true;
 }
 
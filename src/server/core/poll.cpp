@@ -21,9 +21,25 @@
 **/
 
 #include "nxcore.h"
+#include <queue>
 
 #define DEBUG_TAG_POLL_MANAGER   _T("poll.manager")
 
+/**
+ * Recheck interval (in seconds) for pending polls and objects with unknown polling interval
+ */
+#define POLL_RECHECK_INTERVAL          5
+
+/**
+ * Maximum recheck interval (in seconds) for objects where poll is due but cannot be started
+ */
+#define POLL_BLOCKED_RECHECK_INTERVAL  60
+
+/**
+ * Number of poller types
+ */
+#define POLLER_TYPE_COUNT  9
+
 void ActiveDiscoveryPoller();
 void WakeupActiveDiscoveryThread();
 
@@ -65,18 +81,166 @@ PollerInfo *RegisterPoller(PollerType type, const shared_ptr<NetObj>& object)
    return p;
 }
 
+/**
+ * Poll type descriptor
+ */
+struct PollTypeDescriptor
+{
+   const TCHAR *shortName;
+   const TCHAR *name;
+   bool (Pollable::*isAvailable)() const;
+   bool (Pollable::*lock)();
+   void (Pollable::*execute)(PollerInfo*);
+};
+
+/**
+ * Poll types (indexed by PollerType)
+ */
+static const PollTypeDescriptor s_pollTypes[POLLER_TYPE_COUNT] =
+{
+   { _T("STAT"), _T("status"), &Pollable::isStatusPollAvailable, &Pollable::lockForStatusPoll, &Pollable::doStatusPoll },
+   { _T("CONF"), _T("configuration"), &Pollable::isConfigurationPollAvailable, &Pollable::lockForConfigurationPoll, &Pollable::doConfigurationPoll },
+   { _T("INST"), _T("instance discovery"), &Pollable::isInstanceDiscoveryPollAvailable, &Pollable::lockForInstanceDiscoveryPoll, &Pollable::doInstanceDiscoveryPoll },
+   { _T("ROUT"), _T("routing table"), &Pollable::isRoutingTablePollAvailable, &Pollable::lockForRoutingTablePoll, &Pollable::doRoutingTablePoll },
+   { _T("DISC"), _T("discovery"), &Pollable::isDiscoveryPollAvailable, &Pollable::lockForDiscoveryPoll, &Pollable::doDiscoveryPoll },
+   { _T("TOPO"), _T("topology"), &Pollable::isTopologyPollAvailable, &Pollable::lockForTopologyPoll, &Pollable::doTopologyPoll },
+   { _T("ICMP"), _T("ICMP"), &Pollable::isIcmpPollAvailable, &Pollable::lockForIcmpPoll, &Pollable::doIcmpPoll },
+   { _T("BIND"), _T("autobind"), &Pollable::isAutobindPollAvailable, &Pollable::lockForAutobindPoll, &Pollable::doAutobindPoll },
+   { _T("MAP "), _T("map update"), &Pollable::isMapUpdatePollAvailable, &Pollable::lockForMapUpdatePoll, &Pollable::doMapUpdatePoll }
+};
+
+/**
+ * Poll schedule entry
+ */
+struct PollScheduleEntry
+{
+   time_t due;
+   uint32_t objectId;
+   PollerType type;
+};
+
+/**
+ * Comparator for poll schedule entries (earliest entry on top)
+ */
+struct PollScheduleEntryComparator
+{
+   bool operator()(const PollScheduleEntry& e1, const PollScheduleEntry& e2) const
+   {
+      return e1.due > e2.due;
+   }
+};
+
+/**
+ * Poll lateness statistics
+ */
+struct PollLatenessStatistics
+{
+   uint64_t count;
+   uint64_t total;
+   uint32_t max;
+};
+
+/**
+ * Poll schedule. Each (object, poll type) pair has one active entry; entries with due time
+ * not matching next check time in object's poll state are stale and ignored.
+ */
+static std::priority_queue<PollScheduleEntry, std::vector<PollScheduleEntry>, PollScheduleEntryComparator> s_pollSchedule;
+static HashSet<uint32_t> s_scheduledObjects;
+static PollLatenessStatistics s_latenessStatistics[POLLER_TYPE_COUNT];
+static Mutex s_pollScheduleLock(MutexType::FAST);
+
+/**
+ * Add entry to poll schedule. Should be called with schedule lock held.
+ */
+static inline void AddScheduleEntry(PollState *state, uint32_t objectId, PollerType type, time_t due)
+{
+   state->setNextCheckTime(due);
+   PollScheduleEntry e;
+   e.due = due;
+   e.objectId = objectId;
+   e.type = type;
+   s_pollSchedule.push(e);
+}
+
+/**
+ * Add all available polls for given object to poll schedule
+ */
+void SchedulePolls(NetObj *object)
+{
+   Pollable *pollable = object->getAsPollable();
+   if (pollable == nullptr)
+      return;
+
+   time_t now = time(nullptr);
+   s_pollScheduleLock.lock();
+   if (!s_scheduledObjects.contains(object->getId()))
+   {
+      s_scheduledObjects.put(object->getId());
+      for(int i = 0; i < POLLER_TYPE_COUNT; i++)
+      {
+         if ((pollable->*s_pollTypes[i].isAvailable)())
+            AddScheduleEntry(pollable->getPollState(static_cast<PollerType>(i)), object->getId(), static_cast<PollerType>(i), now);
+      }
+   }
+   s_pollScheduleLock.unlock();
+}
+
+/**
+ * Request check of given poll type for given object as soon as possible (intended for use when poll is forced by setting object flags)
+ */
+void SchedulePollNow(NetObj *object, PollerType type)
+{
+   Pollable *pollable = object->getAsPollable();
+   if ((pollable == nullptr) || !(pollable->*s_pollTypes[static_cast<int>(type)].isAvailable)())
+      return;
+
+   time_t now = time(nullptr);
+   s_pollScheduleLock.lock();
+   PollState *state = pollable->getPollState(type);
+   if (s_scheduledObjects.contains(object->getId()) && (state->getNextCheckTime() > now))
+      AddScheduleEntry(state, object->getId(), type, now);
+   s_pollScheduleLock.unlock();
+}
+
+/**
+ * Re-evaluate all scheduled polls for given object (intended for use when object's polling intervals are changed)
+ */
+void ReschedulePolls(NetObj *object)
+{
+   for(int i = 0; i < POLLER_TYPE_COUNT; i++)
+      SchedulePollNow(object, static_cast<PollerType>(i));
+}
+
+/**
+ * Re-evaluate scheduled polls of given type for all objects (intended for use when global polling interval is changed)
+ */
+void RescheduleAllPolls(PollerType type)
+{
+   IntegerArray<uint32_t> objects;
+   s_pollScheduleLock.lock();
+   for(const uint32_t *id : s_scheduledObjects)
+      objects.add(*id);
+   s_pollScheduleLock.unlock();
+
+   for(int i = 0; i < objects.size(); i++)
+   {
+      shared_ptr<NetObj> object = FindObjectById(objects.get(i));
+      if (object != nullptr)
+         SchedulePollNow(object.get(), type);
+   }
+   nxlog_debug_tag(DEBUG_TAG_POLL_MANAGER, 4, _T("%s polls rescheduled for %d objects"), s_pollTypes[static_cast<int>(type)].name, objects.size());
+}
+
 /**
  * Show poller information on console
  */
 static EnumerationCallbackResult ShowPollerInfo(const uint64_t& key, PollerInfo *poller, ServerConsole *console)
 {
-   static const TCHAR *pollerType[] = { _T("STAT"), _T("CONF"), _T("INST"), _T("ROUT"), _T("DISC"), _T("TOPO"), _T("ICMP"), _T("BIND"), _T("MAP ") };
-
    NetObj *o = poller->getObject();
 
    TCHAR name[32];
    _tcslcpy(name, o->getName(), 31);
-   console->printf(_T("%s | %9d | %-30s | %s\n"), pollerType[static_cast<int>(poller->getType())], o->getId(), name, poller->getStatus());
+   console->printf(_T("%s | %9d | %-30s | %s\n"), s_pollTypes[static_cast<int>(poller->getType())].shortName, o->getId(), name, poller->getStatus());
 
    return _CONTINUE;
 }
@@ -91,6 +255,19 @@ void ShowPollers(ServerConsole *console)
    s_pollerLock.lock();
    s_pollers.forEach(ShowPollerInfo, console);
    s_pollerLock.unlock();
+
+   ConsoleWrite(console, _T("\nType | Scheduled polls | Avg lateness | Max lateness\n")
+                         _T("-----+-----------------+--------------+-------------\n"));
+   s_pollScheduleLock.lock();
+   for(int i = 0; i < POLLER_TYPE_COUNT; i++)
+   {
+      const PollLatenessStatistics& s = s_latenessStatistics[i];
+      console->printf(_T("%s | %15") UINT64_FMT _T(" | %10.2f s | %10u s\n"), s_pollTypes[i].shortName, s.count,
+               (s.count > 0) ? static_cast<double>(s.total) / static_cast<double>(s.count) : 0.0, s.max);
+   }
+   size_t scheduleSize = s_pollSchedule.size();
+   s_pollScheduleLock.unlock();
+   console->printf(_T("\nPoll schedule size: %u\n"), static_cast<uint32_t>(scheduleSize));
 }
 
 /**
@@ -225,78 +402,117 @@ void CheckForMgmtNode()
 }
 
 /**
- * Callback for queuing objects for polling
+ * Process poll schedule entry
  */
-static void QueueForPolling(NetObj *object, void *data)
+static void ProcessScheduleEntry(const PollScheduleEntry& e, time_t now)
 {
-   WatchdogNotify(*static_cast<uint32_t*>(data));
-   if (IsShutdownInProgress())
+   shared_ptr<NetObj> object = FindObjectById(e.objectId);
+   if ((object == nullptr) || object->isDeleted())
+   {
+      // Object is gone, drop entry
+      s_pollScheduleLock.lock();
+      s_scheduledObjects.remove(e.objectId);
+      s_pollScheduleLock.unlock();
       return;
+   }
 
-   // Only objects that are not yet completed construction or being
-   // prepared for deletion are hidden, so any kind of polling should not be scheduled
-   if (object->isHidden())
-      return;
+   Pollable *pollable = object->getAsPollable();
+   PollState *state = pollable->getPollState(e.type);
 
-   Pollable* pollableObject = object->getAsPollable();
-   if (pollableObject == nullptr)
+   s_pollScheduleLock.lock();
+   bool stale = (state->getNextCheckTime() != e.due);
+   s_pollScheduleLock.unlock();
+   if (stale)
       return;
 
-   TCHAR threadKey[32];
-   _sntprintf(threadKey, 32, _T("POLL_%u"), object->getId());
+   const PollTypeDescriptor& pt = s_pollTypes[static_cast<int>(e.type)];
 
-   if (pollableObject->isStatusPollAvailable() && pollableObject->lockForStatusPoll())
+   // Only objects that are not yet completed construction or being
+   // prepared for deletion are hidden, so any kind of polling should not be scheduled
+   bool locked = false;
+   if (!object->isHidden())
    {
-      nxlog_debug_tag(DEBUG_TAG_POLL_MANAGER, 6, _T("%s %s [%u] queued for status poll"), object->getObjectClassName(), object->getName(), object->getId());
-      ThreadPoolExecuteSerialized(g_pollerThreadPool, threadKey, pollableObject, &Pollable::doStatusPoll, RegisterPoller(PollerType::STATUS, object->self()));
-   }
+      time_t lastCompleted = state->getLastCompleted();
+      if ((pollable->*pt.lock)())
+      {
+         locked = true;
+         nxlog_debug_tag(DEBUG_TAG_POLL_MANAGER, 6, _T("%s %s [%u] queued for %s poll"), object->getObjectClassName(), object->getName(), object->getId(), pt.name);
 
-   if (pollableObject->isConfigurationPollAvailable() && pollableObject->lockForConfigurationPoll())
-   {
-      nxlog_debug_tag(DEBUG_TAG_POLL_MANAGER, 6, _T("%s %s [%u] queued for configuration poll"), object->getObjectClassName(), object->getName(), object->getId());
-      ThreadPoolExecuteSerialized(g_pollerThreadPool, threadKey, pollableObject, &Pollable::doConfigurationPoll, RegisterPoller(PollerType::CONFIGURATION, object->self()));
-   }
+         ThreadPoolExecuteSerialized(g_pollerThreadPool, GetPollerSerializationKey(object->getId()), pollable, pt.execute, RegisterPoller(e.type, object));
 
-   if (pollableObject->isInstanceDiscoveryPollAvailable() && pollableObject->lockForInstanceDiscoveryPoll())
-   {
-      nxlog_debug_tag(DEBUG_TAG_POLL_MANAGER, 6, _T("%s %s [%u] queued for instance discovery poll"), object->getObjectClassName(), object->getName(), object->getId());
-      ThreadPoolExecuteSerialized(g_pollerThreadPool, threadKey, pollableObject, &Pollable::doInstanceDiscoveryPoll, RegisterPoller(PollerType::INSTANCE_DISCOVERY, object->self()));
+         // Update lateness statistics (only for regular polls with known due time)
+         uint32_t interval = state->getInterval();
+         if ((interval > 0) && (lastCompleted != TIMESTAMP_NEVER))
+         {
+            time_t dueTime = lastCompleted + interval + 1;
+            if (dueTime <= now)
+            {
+               uint32_t lateness = static_cast<uint32_t>(now - dueTime);
+               s_pollScheduleLock.lock();
+               PollLatenessStatistics& s = s_latenessStatistics[static_cast<int>(e.type)];
+               s.count++;
+               s.total += lateness;
+               if (lateness > s.max)
+                  s.max = lateness;
+               s_pollScheduleLock.unlock();
+            }
+         }
+      }
    }
 
-   if (pollableObject->isTopologyPollAvailable() && pollableObject->lockForTopologyPoll())
+   // Calculate next check time
+   time_t next;
+   uint32_t interval = state->getInterval();
+   if (interval == 0)
    {
-      nxlog_debug_tag(DEBUG_TAG_POLL_MANAGER, 6, _T("%s %s [%u] queued for topology poll"), object->getObjectClassName(), object->getName(), object->getId());
-      ThreadPoolExecuteSerialized(g_pollerThreadPool, threadKey, pollableObject, &Pollable::doTopologyPoll, RegisterPoller(PollerType::TOPOLOGY, object->self()));
+      next = now + POLL_RECHECK_INTERVAL;
    }
-
-   if (pollableObject->isRoutingTablePollAvailable() && pollableObject->lockForRoutingTablePoll())
+   else if (locked)
    {
-      nxlog_debug_tag(DEBUG_TAG_POLL_MANAGER, 6, _T("%s %s [%u] queued for routing table poll"), object->getObjectClassName(), object->getName(), object->getId());
-      ThreadPoolExecuteSerialized(g_pollerThreadPool, threadKey, pollableObject, &Pollable::doRoutingTablePoll, RegisterPoller(PollerType::ROUTING_TABLE, object->self()));
+      next = now + interval;
    }
-
-   if (pollableObject->isDiscoveryPollAvailable() && pollableObject->lockForDiscoveryPoll())
+   else if (state->isPending())
    {
-      nxlog_debug_tag(DEBUG_TAG_POLL_MANAGER, 6, _T("%s %s [%u] queued for discovery poll"), object->getObjectClassName(), object->getName(), object->getId());
-      ThreadPoolExecuteSerialized(g_pollerThreadPool, threadKey, pollableObject, &Pollable::doDiscoveryPoll, RegisterPoller(PollerType::DISCOVERY, object->self()));
+      next = now + std::min(interval, static_cast<uint32_t>(POLL_RECHECK_INTERVAL));
    }
-
-   if (pollableObject->isIcmpPollAvailable() && pollableObject->lockForIcmpPoll())
+   else
    {
-      nxlog_debug_tag(DEBUG_TAG_POLL_MANAGER, 6, _T("%s %s [%u] queued for ICMP poll"), object->getObjectClassName(), object->getName(), object->getId());
-      ThreadPoolExecuteSerialized(g_pollerThreadPool, threadKey, pollableObject, &Pollable::doIcmpPoll, RegisterPoller(PollerType::ICMP, object->self()));
+      next = state->getLastCompleted() + interval + 1;
+      if (next <= now)
+      {
+         // Poll is due but blocked by object state. Objects that were never polled (usually newly created ones)
+         // are rechecked more often so that first poll starts soon after object becomes ready.
+         uint32_t recheckInterval = (state->getLastCompleted() == TIMESTAMP_NEVER) ? POLL_RECHECK_INTERVAL : POLL_BLOCKED_RECHECK_INTERVAL;
+         next = now + std::min(interval, recheckInterval);
+      }
    }
 
-   if (pollableObject->isAutobindPollAvailable() && pollableObject->lockForAutobindPoll())
-   {
-      nxlog_debug_tag(DEBUG_TAG_POLL_MANAGER, 6, _T("%s %s [%u] queued for autobind poll"), object->getObjectClassName(), object->getName(), object->getId());
-      ThreadPoolExecuteSerialized(g_pollerThreadPool, threadKey, pollableObject, &Pollable::doAutobindPoll, RegisterPoller(PollerType::AUTOBIND, object->self()));
-   }
+   s_pollScheduleLock.lock();
+   if (state->getNextCheckTime() == e.due)   // could be rescheduled by SchedulePollNow while entry was processed
+      AddScheduleEntry(state, e.objectId, e.type, next);
+   s_pollScheduleLock.unlock();
+}
 
-   if (pollableObject->isMapUpdatePollAvailable() && pollableObject->lockForMapUpdatePoll())
+/**
+ * Process all poll schedule entries that are due
+ */
+static void ProcessPollSchedule(uint32_t watchdogId)
+{
+   time_t now = time(nullptr);
+   while(!IsShutdownInProgress())
    {
-      nxlog_debug_tag(DEBUG_TAG_POLL_MANAGER, 6, _T("%s %s [%u] queued for map update poll"), object->getObjectClassName(), object->getName(), object->getId());
-      ThreadPoolExecuteSerialized(g_pollerThreadPool, threadKey, pollableObject, &Pollable::doMapUpdatePoll, RegisterPoller(PollerType::MAP_UPDATE, object->self()));
+      s_pollScheduleLock.lock();
+      if (s_pollSchedule.empty() || (s_pollSchedule.top().due > now))
+      {
+         s_pollScheduleLock.unlock();
+         break;
+      }
+      PollScheduleEntry e = s_pollSchedule.top();
+      s_pollSchedule.pop();
+      s_pollScheduleLock.unlock();
+
+      ProcessScheduleEntry(e, now);
+      WatchdogNotify(watchdogId);
    }
 }
 
@@ -316,21 +532,20 @@ void PollManager(Condition *startCondition)
    startCondition->set();
 
    WatchdogStartSleep(watchdogId);
-   while(!SleepAndCheckForShutdown(5))
+   while(!SleepAndCheckForShutdown(1))
    {
       WatchdogNotify(watchdogId);
 
       // Check for management node every 10 minutes
       counter++;
-      if (counter % 120 == 0)
+      if (counter % 600 == 0)
       {
          counter = 0;
          CheckForMgmtNode();
       }
 
-      // Walk through objects and queue them for status
-      // and/or configuration poll
-		g_idxObjectById.forEach(QueueForPolling, &watchdogId);
+      // Queue objects that are due for polling
+      ProcessPollSchedule(watchdogId);
 	   WatchdogStartSleep(watchdogId);
    }
 
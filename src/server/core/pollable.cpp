@@ -85,10 +85,10 @@ bool Pollable::lockForStatusPoll()
          if (success)
             m_this->m_runtimeFlags &= ~ODF_FORCE_STATUS_POLL;
       }
-      else if ((m_this->m_status != STATUS_UNMANAGED) &&
+      else if (m_statusPollState.isDue(m_this->getCustomAttributeAsUInt32(_T("SysConfig:Objects.StatusPollingInterval"), g_statusPollingInterval)) &&
+               (m_this->m_status != STATUS_UNMANAGED) &&
                !(m_this->m_flags & DCF_DISABLE_STATUS_POLL) &&
-               !(m_this->m_runtimeFlags & ODF_CONFIGURATION_POLL_PENDING) &&
-               (static_cast<uint32_t>(time(nullptr) - m_statusPollState.getLastCompleted()) > m_this->getCustomAttributeAsUInt32(_T("SysConfig:Objects.StatusPollingInterval"), g_statusPollingInterval)))
+               !(m_this->m_runtimeFlags & ODF_CONFIGURATION_POLL_PENDING))
       {
          success = m_statusPollState.schedule();
       }
@@ -133,9 +133,9 @@ bool Pollable::lockForConfigurationPoll()
          if (success)
             m_this->m_runtimeFlags &= ~ODF_FORCE_CONFIGURATION_POLL;
       }
-      else if ((m_this->m_status != STATUS_UNMANAGED) &&
-               (!(m_this->m_flags & DCF_DISABLE_CONF_POLL)) &&
-               (static_cast<uint32_t>(time(nullptr) - m_configurationPollState.getLastCompleted()) > m_this->getCustomAttributeAsUInt32(_T("SysConfig:Objects.ConfigurationPollingInterval"), g_configurationPollingInterval)))
+      else if (m_configurationPollState.isDue(m_this->getCustomAttributeAsUInt32(_T("SysConfig:Objects.ConfigurationPollingInterval"), g_configurationPollingInterval)) &&
+               (m_this->m_status != STATUS_UNMANAGED) &&
+               (!(m_this->m_flags & DCF_DISABLE_CONF_POLL)))
       {
          success = m_configurationPollState.schedule();
       }
@@ -267,8 +267,8 @@ bool Pollable::lockForAutobindPoll()
    bool success = false;
    m_this->lockProperties();
    if (!m_this->m_isDeleted && !m_this->m_isDeleteInitiated &&
-       (m_this->m_status != STATUS_UNMANAGED) &&
-       (static_cast<uint32_t>(time(nullptr) - m_autobindPollState.getLastCompleted()) > m_this->getCustomAttributeAsUInt32(_T("SysConfig:Objects.AutobindPollingInterval"), g_autobindPollingInterval)))
+       m_autobindPollState.isDue(m_this->getCustomAttributeAsUInt32(_T("SysConfig:Objects.AutobindPollingInterval"), g_autobindPollingInterval)) &&
+       (m_this->m_status != STATUS_UNMANAGED))
    {
       success = m_autobindPollState.schedule();
    }
@@ -305,8 +305,8 @@ bool Pollable::lockForMapUpdatePoll()
    bool success = false;
    m_this->lockProperties();
    if (!m_this->m_isDeleted && !m_this->m_isDeleteInitiated &&
-       (m_this->m_status != STATUS_UNMANAGED) &&
-       (static_cast<uint32_t>(time(nullptr) - m_mapUpdatePollState.getLastCompleted()) > m_this->getCustomAttributeAsUInt32(_T("SysConfig:Objects.NetworkMaps.UpdateInterval"), g_mapUpdatePollingInterval)))
+       m_mapUpdatePollState.isDue(m_this->getCustomAttributeAsUInt32(_T("SysConfig:Objects.NetworkMaps.UpdateInterval"), g_mapUpdatePollingInterval)) &&
+       (m_this->m_status != STATUS_UNMANAGED))
    {
       success = m_mapUpdatePollState.schedule();
    }
@@ -314,6 +314,35 @@ bool Pollable::lockForMapUpdatePoll()
    return success;
 }
 
+/**
+ * Get poll state for given poller type
+ */
+PollState *Pollable::getPollState(PollerType type)
+{
+   switch(type)
+   {
+      case PollerType::STATUS:
+         return &m_statusPollState;
+      case PollerType::CONFIGURATION:
+         return &m_configurationPollState;
+      case PollerType::INSTANCE_DISCOVERY:
+         return &m_instancePollState;
+      case PollerType::ROUTING_TABLE:
+         return &m_routingPollState;
+      case PollerType::DISCOVERY:
+         return &m_discoveryPollState;
+      case PollerType::TOPOLOGY:
+         return &m_topologyPollState;
+      case PollerType::ICMP:
+         return &m_icmpPollState;
+      case PollerType::AUTOBIND:
+         return &m_autobindPollState;
+      case PollerType::MAP_UPDATE:
+         return &m_mapUpdatePollState;
+   }
+   return nullptr;
+}
+
 /**
  * Reset poll timers
  */
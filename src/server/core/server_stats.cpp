@@ -43,7 +43,6 @@ struct SnmpTrap;
  */
 extern ObjectQueue<SnmpTrap> g_snmpTrapProcessorQueue;
 extern ObjectQueue<SnmpTrap> g_snmpTrapWriterQueue;
-extern ObjectQueue<SyslogMessage> g_syslogProcessingQueue;
 extern ObjectQueue<SyslogMessage> g_syslogWriteQueue;
 extern ObjectQueue<WindowsEvent> g_windowsEventProcessingQueue;
 extern ObjectQueue<WindowsEvent> g_windowsEventWriterQueue;
@@ -53,6 +52,20 @@ extern ThreadPool *g_schedulerThreadPool;
 
 int64_t GetEventLogWriterQueueSize();
 int64_t GetEventProcessorQueueSize();
+int64_t GetSyslogProcessingQueueSize();
+
+/**
+ * Number of stored event log writer queue latency samples
+ */
+#define LATENCY_SAMPLE_COUNT  4096
+
+/**
+ * Event log writer queue latency samples (in milliseconds)
+ */
+static uint32_t s_eventLogWriterLatency[LATENCY_SAMPLE_COUNT];
+static int s_eventLogWriterLatencyPos = 0;
+static int s_eventLogWriterLatencyCount = 0;
+static Mutex s_eventLogWriterLatencyLock(MutexType::FAST);
 
 /**
  * Internal queue statistic
@@ -129,7 +142,7 @@ void ServerStatCollector()
    AddQueueToCollector(_T("Scheduler"), g_schedulerThreadPool);
    AddQueueToCollector(_T("SNMPTrapProcessor"), &g_snmpTrapProcessorQueue);
    AddQueueToCollector(_T("SNMPTrapWriter"), &g_snmpTrapWriterQueue);
-   AddQueueToCollector(_T("SyslogProcessor"), &g_syslogProcessingQueue);
+   AddQueueToCollector(_T("SyslogProcessor"), GetSyslogProcessingQueueSize);
    AddQueueToCollector(_T("SyslogWriter"), &g_syslogWriteQueue);
    AddQueueToCollector(_T("TemplateUpdater"), &g_templateUpdateQueue);
    AddQueueToCollector(_T("WindowsEventProcessor"), &g_windowsEventProcessingQueue);
@@ -207,23 +220,89 @@ DataCollectionError GetQueueStatistic(const TCHAR *parameter, StatisticType type
    return DCE_SUCCESS;
 }
 
+/**
+ * Update event log writer queue latency statistic with new samples (in milliseconds)
+ */
+void UpdateEventLogWriterLatency(const uint32_t *samples, int count)
+{
+   if (count == 0)
+      return;
+
+   s_eventLogWriterLatencyLock.lock();
+   for(int i = 0; i < count; i++)
+   {
+      s_eventLogWriterLatency[s_eventLogWriterLatencyPos++] = samples[i];
+      if (s_eventLogWriterLatencyPos == LATENCY_SAMPLE_COUNT)
+         s_eventLogWriterLatencyPos = 0;
+   }
+   s_eventLogWriterLatencyCount = std::min(s_eventLogWriterLatencyCount + count, LATENCY_SAMPLE_COUNT);
+   s_eventLogWriterLatencyLock.unlock();
+}
+
+/**
+ * Get event log writer queue latency percentile (in milliseconds) over last LATENCY_SAMPLE_COUNT events.
+ * Percentile is passed as metric argument.
+ */
+DataCollectionError GetEventLogWriterLatencyStatistic(const TCHAR *parameter, TCHAR *value)
+{
+   TCHAR arg[32];
+   if (!AgentGetParameterArg(parameter, 1, arg, 32))
+      return DCE_NOT_SUPPORTED;
+
+   TCHAR *eptr;
+   double percentile = _tcstod(arg, &eptr);
+   if ((*eptr != 0) || (percentile < 0) || (percentile > 100))
+      return DCE_NOT_SUPPORTED;
+
+   uint32_t *samples = MemAllocArrayNoInit<uint32_t>(LATENCY_SAMPLE_COUNT);
+   s_eventLogWriterLatencyLock.lock();
+   int count = s_eventLogWriterLatencyCount;
+   memcpy(samples, s_eventLogWriterLatency, count * sizeof(uint32_t));
+   s_eventLogWriterLatencyLock.unlock();
+
+   if (count > 0)
+   {
+      int index = static_cast<int>((count - 1) * percentile / 100 + 0.5);
+      std::nth_element(samples, samples + index, samples + count);
+      ret_uint(value, samples[index]);
+   }
+   else
+   {
+      ret_uint(value, 0);
+   }
+   MemFree(samples);
+   return DCE_SUCCESS;
+}
+
+/**
+ * DCI cache memory usage calculation context
+ */
+struct CacheMemoryUsage
+{
+   uint64_t actual;
+   uint64_t legacy;
+};
+
 /**
  * DCI cache memory usage calculation callback
  */
-static void GetCacheMemoryUsage(NetObj *object, uint64_t *size)
+static void GetCacheMemoryUsage(NetObj *object, CacheMemoryUsage *usage)
 {
    if (object->isDataCollectionTarget())
-      *size += static_cast<DataCollectionTarget*>(object)->getCacheMemoryUsage();
+      usage->actual += static_cast<DataCollectionTarget*>(object)->getCacheMemoryUsage(&usage->legacy);
 }
 
 /**
- * Get amount of memory used by DCI cache
+ * Get amount of memory used by DCI cache. If legacySize is not null, it will be set to
+ * estimated amount of memory that would be used by cache with fixed size heap allocated values.
  */
-uint64_t GetDCICacheMemoryUsage()
+uint64_t GetDCICacheMemoryUsage(uint64_t *legacySize)
 {
-   uint64_t dciCache = 0;
-   g_idxObjectById.forEach(GetCacheMemoryUsage, &dciCache);
-   return dciCache;
+   CacheMemoryUsage usage = { 0, 0 };
+   g_idxObjectById.forEach(GetCacheMemoryUsage, &usage);
+   if (legacySize != nullptr)
+      *legacySize = usage.legacy;
+   return usage.actual;
 }
 
 /**
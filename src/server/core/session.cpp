@@ -4760,6 +4760,7 @@ void ClientSession::forceDCIPoll(const NXCPMessage& request)
 				   if (dci->hasAccess(m_userId))
 				   {
                   dci->requestForcePoll(this);
+                  ScheduleDCObjectPollNow(dci);
                   response.setField(VID_RCC, RCC_SUCCESS);
                   debugPrintf(4, _T("ForceDCIPoll: DCI %d at node %d"), dciId, object->getId());
                   writeAuditLog(AUDIT_OBJECTS, true, object->getId(), _T("Forced DCI poll initiated for DCI \"%s\" [%u]"), dci->getDescription().cstr(), dci->getId());
@@ -32,10 +32,14 @@
  */
 #define MAX_SYSLOG_MSG_LEN    1024
 
+/**
+ * Max number of messages read from socket at once
+ */
+#define SYSLOG_RECEIVE_BATCH_SIZE   64
+
 /**
  * Queues
  */
-ObjectQueue<SyslogMessage> g_syslogProcessingQueue(1024, Ownership::False);
 ObjectQueue<SyslogMessage> g_syslogWriteQueue(1024, Ownership::False);
 
 /**
@@ -43,6 +47,30 @@ ObjectQueue<SyslogMessage> g_syslogWriteQueue(1024, Ownership::False);
  */
 VolatileCounter64 g_syslogMessagesReceived = 0;
 
+/**
+ * Dropped syslog message counters
+ */
+VolatileCounter64 g_syslogDropsReceiveBuffer = 0;  // Dropped by OS because of socket receive buffer overflow
+VolatileCounter64 g_syslogDropsMalformed = 0;      // Messages that cannot be parsed
+VolatileCounter64 g_syslogDropsUnknownSource = 0;  // Messages from unknown sources
+
+/**
+ * Syslog processor. Message processing is sharded by source address, so messages from same source
+ * are always processed by same processor in order of arrival. All processors share single parser
+ * instance (rule contexts and counters can span messages from different sources), so only parser
+ * matching is serialized.
+ */
+struct SyslogProcessor
+{
+   ObjectQueue<SyslogMessage> queue;
+   THREAD thread;
+
+   SyslogProcessor() : queue(1024, Ownership::False)
+   {
+      thread = INVALID_THREAD_HANDLE;
+   }
+};
+
 /**
  * Node matching policy
  */
@@ -55,12 +83,14 @@ enum NodeMatchingPolicy
 /**
  * Static data
  */
-static uint64_t s_msgId = 1;  // Next available message ID
+static VolatileCounter64 s_msgId = 1;  // Next available message ID
 static LogParser *s_parser = nullptr;
 static Mutex s_parserLock(MutexType::FAST);
+static SyslogProcessor *s_processors = nullptr;
+static int s_processorCount = 0;
 static NodeMatchingPolicy s_nodeMatchingPolicy = SOURCE_IP_THEN_HOSTNAME;
-static THREAD s_receiverThread = INVALID_THREAD_HANDLE;
-static THREAD s_processingThread = INVALID_THREAD_HANDLE;
+static THREAD *s_receiverThreads = nullptr;
+static int s_receiverCount = 0;
 static THREAD s_writerThread = INVALID_THREAD_HANDLE;
 static bool s_running = true;
 static bool s_alwaysUseServerTime = false;
@@ -439,11 +469,12 @@ static void ProcessSyslogMessage(SyslogMessage *msg)
       if (!msg->bindToNode() && !s_allowUnknownSources)
       {
          nxlog_debug_tag(DEBUG_TAG, 6, _T("ProcessSyslogMessage: message from unknown source ignored"));
+         InterlockedIncrement64(&g_syslogDropsUnknownSource);
          delete msg;
          return;
       }
 
-      msg->setId(s_msgId++);
+      msg->setId(InterlockedIncrement64(&s_msgId) - 1);
       const char *codepage = (s_syslogCodepage[0] != 0) ? s_syslogCodepage : nullptr;
       if (msg->getNodeId() != 0)
       {
@@ -489,6 +520,7 @@ static void ProcessSyslogMessage(SyslogMessage *msg)
 	else
 	{
 		nxlog_debug_tag(DEBUG_TAG, 6, _T("ProcessSyslogMessage: Cannot parse syslog message"));
+		InterlockedIncrement64(&g_syslogDropsMalformed);
 		delete msg;
 	}
 }
@@ -496,12 +528,12 @@ static void ProcessSyslogMessage(SyslogMessage *msg)
 /**
  * Syslog processing thread
  */
-static void SyslogProcessingThread()
+static void SyslogProcessingThread(SyslogProcessor *processor)
 {
    ThreadSetName("SyslogProcessor");
    while(true)
    {
-      SyslogMessage *msg = g_syslogProcessingQueue.getOrBlock();
+      SyslogMessage *msg = processor->queue.getOrBlock();
       if (msg == INVALID_POINTER_VALUE)
          break;
 
@@ -509,12 +541,38 @@ static void SyslogProcessingThread()
    }
 }
 
+/**
+ * Select processor for given source address
+ */
+static inline SyslogProcessor *GetProcessorForSource(const InetAddress& addr)
+{
+   if (s_processorCount == 1)
+      return &s_processors[0];
+
+   uint32_t hash;
+   if (addr.getFamily() == AF_INET)
+   {
+      hash = addr.getAddressV4();
+   }
+   else
+   {
+      hash = 0;
+      const BYTE *a = addr.getAddressV6();
+      for(int i = 0; i < 16; i++)
+         hash = hash * 31 + a[i];
+   }
+   hash ^= hash >> 16;
+   hash *= 0x45D9F3B;
+   hash ^= hash >> 16;
+   return &s_processors[hash % s_processorCount];
+}
+
 /**
  * Queue syslog message for processing
  */
 static void QueueSyslogMessage(char *msg, int msgLen, const InetAddress& sourceAddr)
 {
-   g_syslogProcessingQueue.put(new SyslogMessage(sourceAddr, msg, msgLen));
+   GetProcessorForSource(sourceAddr)->queue.put(new SyslogMessage(sourceAddr, msg, msgLen));
 }
 
 /**
@@ -522,7 +580,35 @@ static void QueueSyslogMessage(char *msg, int msgLen, const InetAddress& sourceA
  */
 void QueueProxiedSyslogMessage(const InetAddress &addr, int32_t zoneUIN, uint32_t nodeId, time_t timestamp, const char *msg, int msgLen)
 {
-   g_syslogProcessingQueue.put(new SyslogMessage(addr, timestamp, zoneUIN, nodeId, msg, msgLen));
+   if (s_processors != nullptr)
+      GetProcessorForSource(addr)->queue.put(new SyslogMessage(addr, timestamp, zoneUIN, nodeId, msg, msgLen));
+}
+
+/**
+ * Get total size of syslog processing queues
+ */
+int64_t GetSyslogProcessingQueueSize()
+{
+   int64_t size = 0;
+   for(int i = 0; i < s_processorCount; i++)
+      size += s_processors[i].queue.size();
+   return size;
+}
+
+/**
+ * Get size of processing queue for given syslog processor (processors are numbered from 1). Returns -1 if processor ID is invalid.
+ */
+int64_t GetSyslogProcessingQueueSize(int processorId)
+{
+   return ((processorId > 0) && (processorId <= s_processorCount)) ? s_processors[processorId - 1].queue.size() : -1;
+}
+
+/**
+ * Get number of syslog processors
+ */
+int GetSyslogProcessorCount()
+{
+   return s_processorCount;
 }
 
 /**
@@ -596,9 +682,127 @@ static void CreateParserFromConfig()
 }
 
 /**
- * Syslog messages receiver thread
+ * Receive buffers for syslog receiver thread
+ */
+struct SyslogReceiveBuffers
+{
+   char data[SYSLOG_RECEIVE_BATCH_SIZE][MAX_SYSLOG_MSG_LEN + 1];
+   SockAddrBuffer addr[SYSLOG_RECEIVE_BATCH_SIZE];
+#if HAVE_RECVMMSG
+   struct mmsghdr headers[SYSLOG_RECEIVE_BATCH_SIZE];
+   struct iovec iov[SYSLOG_RECEIVE_BATCH_SIZE];
+#ifdef SO_RXQ_OVFL
+   char control[SYSLOG_RECEIVE_BATCH_SIZE][CMSG_SPACE(sizeof(uint32_t))];
+#endif
+#endif
+};
+
+/**
+ * Set additional options on syslog receiver socket
+ */
+static void SetReceiverSocketOptions(SOCKET s)
+{
+#ifdef SO_REUSEPORT
+   if (s_receiverCount > 1)
+   {
+      int on = 1;
+      setsockopt(s, SOL_SOCKET, SO_REUSEPORT, (char *)&on, sizeof(int));
+   }
+#endif
+#ifdef SO_RXQ_OVFL
+   int on = 1;
+   setsockopt(s, SOL_SOCKET, SO_RXQ_OVFL, (char *)&on, sizeof(int));
+#endif
+}
+
+/**
+ * Read pending messages from socket (up to batch size) and queue them for processing.
+ * Returns number of received messages or -1 on error. Last known number of messages dropped
+ * by OS on this socket is kept in dropCount.
  */
-static void SyslogReceiver()
+static int ReceiveSyslogMessages(SOCKET s, SyslogReceiveBuffers *buffers, uint32_t *dropCount)
+{
+#if HAVE_RECVMMSG
+   for(int i = 0; i < SYSLOG_RECEIVE_BATCH_SIZE; i++)
+   {
+      buffers->iov[i].iov_base = buffers->data[i];
+      buffers->iov[i].iov_len = MAX_SYSLOG_MSG_LEN;
+
+      struct msghdr *h = &buffers->headers[i].msg_hdr;
+      h->msg_name = &buffers->addr[i];
+      h->msg_namelen = sizeof(SockAddrBuffer);
+      h->msg_iov = &buffers->iov[i];
+      h->msg_iovlen = 1;
+#ifdef SO_RXQ_OVFL
+      h->msg_control = buffers->control[i];
+      h->msg_controllen = sizeof(buffers->control[i]);
+#else
+      h->msg_control = nullptr;
+      h->msg_controllen = 0;
+#endif
+      h->msg_flags = 0;
+   }
+
+   int count = recvmmsg(s, buffers->headers, SYSLOG_RECEIVE_BATCH_SIZE, MSG_DONTWAIT, nullptr);
+   if (count < 0)
+      return ((errno == EAGAIN) || (errno == EWOULDBLOCK)) ? 0 : -1;
+
+   for(int i = 0; i < count; i++)
+   {
+      struct msghdr *h = &buffers->headers[i].msg_hdr;
+#ifdef SO_RXQ_OVFL
+      for(struct cmsghdr *cmsg = CMSG_FIRSTHDR(h); cmsg != nullptr; cmsg = CMSG_NXTHDR(h, cmsg))
+      {
+         if ((cmsg->cmsg_level == SOL_SOCKET) && (cmsg->cmsg_type == SO_RXQ_OVFL))
+         {
+            uint32_t drops;
+            memcpy(&drops, CMSG_DATA(cmsg), sizeof(uint32_t));
+            if (drops != *dropCount)
+            {
+               InterlockedAdd64(&g_syslogDropsReceiveBuffer, drops - *dropCount);
+               *dropCount = drops;
+            }
+         }
+      }
+#endif
+      int bytes = static_cast<int>(buffers->headers[i].msg_len);
+      if (bytes > 0)
+      {
+         buffers->data[i][bytes] = 0;
+         QueueSyslogMessage(buffers->data[i], bytes, InetAddress::createFromSockaddr((struct sockaddr *)&buffers->addr[i]));
+      }
+   }
+   return count;
+#else
+   int count = 0;
+   while(count < SYSLOG_RECEIVE_BATCH_SIZE)
+   {
+      socklen_t addrLen = sizeof(SockAddrBuffer);
+#ifdef MSG_DONTWAIT
+      int bytes = recvfrom(s, buffers->data[count], MAX_SYSLOG_MSG_LEN, (count > 0) ? MSG_DONTWAIT : 0, (struct sockaddr *)&buffers->addr[count], &addrLen);
+#else
+      int bytes = recvfrom(s, buffers->data[count], MAX_SYSLOG_MSG_LEN, 0, (struct sockaddr *)&buffers->addr[count], &addrLen);
+#endif
+      if (bytes <= 0)
+         break;
+
+      buffers->data[count][bytes] = 0;
+      QueueSyslogMessage(buffers->data[count], bytes, InetAddress::createFromSockaddr((struct sockaddr *)&buffers->addr[count]));
+      count++;
+
+#ifndef MSG_DONTWAIT
+      break;   // Cannot check for more messages without blocking
+#endif
+   }
+   return (count > 0) ? count : -1;
+#endif
+}
+
+/**
+ * Syslog messages receiver thread. When multiple receivers are configured, each receiver
+ * binds its own sockets with SO_REUSEPORT and kernel distributes incoming datagrams between them.
+ */
+static void SyslogReceiver(int receiverId)
 {
    ThreadSetName("SyslogReceiver");
 
@@ -620,6 +824,7 @@ static void SyslogReceiver()
 
 	SetSocketExclusiveAddrUse(hSocket);
 	SetSocketReuseFlag(hSocket);
+	SetReceiverSocketOptions(hSocket);
 #ifndef _WIN32
    fcntl(hSocket, F_SETFD, fcntl(hSocket, F_GETFD) | FD_CLOEXEC);
 #endif
@@ -627,6 +832,7 @@ static void SyslogReceiver()
 #ifdef WITH_IPV6
    SetSocketExclusiveAddrUse(hSocket6);
    SetSocketReuseFlag(hSocket6);
+   SetReceiverSocketOptions(hSocket6);
 #ifndef _WIN32
    fcntl(hSocket6, F_SETFD, fcntl(hSocket6, F_GETFD) | FD_CLOEXEC);
 #endif
@@ -724,13 +930,13 @@ static void SyslogReceiver()
       return;
    }
 
-   if (hSocket != INVALID_SOCKET)
+   if ((hSocket != INVALID_SOCKET) && (receiverId == 0))
    {
       TCHAR ipAddrText[64];
       nxlog_write(NXLOG_INFO, _T("Listening for syslog messages on UDP socket %s:%u"), InetAddress(ntohl(servAddr.sin_addr.s_addr)).toString(ipAddrText), port);
    }
 #ifdef WITH_IPV6
-   if (hSocket6 != INVALID_SOCKET)
+   if ((hSocket6 != INVALID_SOCKET) && (receiverId == 0))
    {
       TCHAR ipAddrText[64];
       nxlog_write(NXLOG_INFO, _T("Listening for syslog messages on UDP socket %s:%u"), InetAddress(servAddr6.sin6_addr.s6_addr).toString(ipAddrText), port);
@@ -738,8 +944,13 @@ static void SyslogReceiver()
 #endif
 
    SocketPoller sp;
+   SyslogReceiveBuffers *buffers = MemAllocStruct<SyslogReceiveBuffers>();
+   uint32_t dropCount = 0;
+#ifdef WITH_IPV6
+   uint32_t dropCount6 = 0;
+#endif
 
-   nxlog_debug_tag(DEBUG_TAG, 1, _T("Syslog receiver thread started"));
+   nxlog_debug_tag(DEBUG_TAG, 1, _T("Syslog receiver thread #%d started"), receiverId);
 
    // Wait for packets
    while(s_running)
@@ -755,21 +966,20 @@ static void SyslogReceiver()
       int rc = sp.poll(1000);
       if (rc > 0)
       {
-         char syslogMessage[MAX_SYSLOG_MSG_LEN + 1];
-         SockAddrBuffer addr;
-         socklen_t addrLen = sizeof(SockAddrBuffer);
+         bool error = false;
+         if ((hSocket != INVALID_SOCKET) && sp.isSet(hSocket))
+         {
+            if (ReceiveSyslogMessages(hSocket, buffers, &dropCount) < 0)
+               error = true;
+         }
 #ifdef WITH_IPV6
-         SOCKET s = sp.isSet(hSocket) ? hSocket : hSocket6;
-#else
-         SOCKET s = hSocket;
-#endif
-         int bytes = recvfrom(s, syslogMessage, MAX_SYSLOG_MSG_LEN, 0, (struct sockaddr *)&addr, &addrLen);
-         if (bytes > 0)
+         if ((hSocket6 != INVALID_SOCKET) && sp.isSet(hSocket6))
          {
-            syslogMessage[bytes] = 0;
-            QueueSyslogMessage(syslogMessage, bytes, InetAddress::createFromSockaddr((struct sockaddr *)&addr));
+            if (ReceiveSyslogMessages(hSocket6, buffers, &dropCount6) < 0)
+               error = true;
          }
-         else
+#endif
+         if (error)
          {
             // Sleep on error
             ThreadSleepMs(100);
@@ -789,7 +999,8 @@ static void SyslogReceiver()
       closesocket(hSocket6);
 #endif
 
-   nxlog_debug_tag(DEBUG_TAG, 1, _T("Syslog receiver thread stopped"));
+   MemFree(buffers);
+   nxlog_debug_tag(DEBUG_TAG, 1, _T("Syslog receiver thread #%d stopped"), receiverId);
 }
 
 /**
@@ -916,8 +1127,8 @@ void StartSyslogServer()
    s_nodeMatchingPolicy = static_cast<NodeMatchingPolicy>(ConfigReadInt(_T("Syslog.NodeMatchingPolicy"), SOURCE_IP_THEN_HOSTNAME));
 
    // Determine first available message id
-   uint64_t id = ConfigReadUInt64(_T("FirstFreeSyslogId"), s_msgId);
-   if (id > s_msgId)
+   uint64_t id = ConfigReadUInt64(_T("FirstFreeSyslogId"), 1);
+   if (id > static_cast<uint64_t>(s_msgId))
       s_msgId = id;
    DB_HANDLE hdb = DBConnectionPoolAcquireConnection();
    DB_RESULT hResult = DBSelect(hdb, _T("SELECT max(msg_id) FROM syslog"));
@@ -925,7 +1136,7 @@ void StartSyslogServer()
    {
       if (DBGetNumRows(hResult) > 0)
       {
-         s_msgId = std::max(DBGetFieldUInt64(hResult, 0, 0) + 1, s_msgId);
+         s_msgId = std::max(DBGetFieldUInt64(hResult, 0, 0) + 1, static_cast<uint64_t>(s_msgId));
       }
       DBFreeResult(hResult);
    }
@@ -933,15 +1144,29 @@ void StartSyslogServer()
 
    InitLogParserLibrary();
 
-   // Create message parser
+   // Create message processors and parser
+   int processorCount = std::min(std::max(ConfigReadInt(_T("Syslog.ProcessingThreads"), 1), 1), 64);
+   s_processors = new SyslogProcessor[processorCount];
+   s_processorCount = processorCount;
    CreateParserFromConfig();
 
-   // Start processing thread
-   s_processingThread = ThreadCreateEx(SyslogProcessingThread);
+   // Start processing threads
+   for(int i = 0; i < s_processorCount; i++)
+      s_processors[i].thread = ThreadCreateEx(SyslogProcessingThread, &s_processors[i]);
    s_writerThread = ThreadCreateEx(SyslogWriterThread);
+   nxlog_debug_tag(DEBUG_TAG, 2, _T("%d syslog processing threads started"), s_processorCount);
 
    if (ConfigReadBoolean(_T("Syslog.EnableListener"), false))
-      s_receiverThread = ThreadCreateEx(SyslogReceiver);
+   {
+#ifdef SO_REUSEPORT
+      s_receiverCount = std::min(std::max(ConfigReadInt(_T("Syslog.ReceiverThreads"), 1), 1), 64);
+#else
+      s_receiverCount = 1;
+#endif
+      s_receiverThreads = new THREAD[s_receiverCount];
+      for(int i = 0; i < s_receiverCount; i++)
+         s_receiverThreads[i] = ThreadCreateEx(SyslogReceiver, i);
+   }
 }
 
 /**
@@ -950,17 +1175,23 @@ void StartSyslogServer()
 void StopSyslogServer()
 {
    s_running = false;
-   ThreadJoin(s_receiverThread);
+   for(int i = 0; i < s_receiverCount; i++)
+      ThreadJoin(s_receiverThreads[i]);
 
-   // Stop processing thread
-   g_syslogProcessingQueue.put(INVALID_POINTER_VALUE);
-   ThreadJoin(s_processingThread);
+   // Stop processing threads
+   for(int i = 0; i < s_processorCount; i++)
+      s_processors[i].queue.put(INVALID_POINTER_VALUE);
+   for(int i = 0; i < s_processorCount; i++)
+      ThreadJoin(s_processors[i].thread);
 
-   // Stop writer thread - it must be done after processing thread already finished
+   // Stop writer thread - it must be done after processing threads already finished
    g_syslogWriteQueue.put(INVALID_POINTER_VALUE);
    ThreadJoin(s_writerThread);
 
-   delete s_parser;
+   // Processor array is kept because proxied messages still can be queued by agent connections
+   s_parserLock.lock();
+   delete_and_null(s_parser);
+   s_parserLock.unlock();
    CleanupLogParserLibrary();
 }
 
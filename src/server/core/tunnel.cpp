@@ -49,7 +49,7 @@ static VolatileCounter s_activeSetupCalls = 0;  // Number of tunnel setup calls
  * Socket pollers
  */
 static ObjectArray<BackgroundSocketPollerHandle> s_pollers(64, 64, Ownership::True);
-static uint32_t s_maxTunnelsPerPoller = MIN(SOCKET_POLLER_MAX_SOCKETS - 1, 256);
+static uint32_t s_maxTunnelsPerPoller = MIN(BACKGROUND_SOCKET_POLLER_MAX_SOCKETS - 1, 256);
 static Mutex s_pollerListLock(MutexType::FAST);
 
 /**
@@ -1799,8 +1799,8 @@ void TunnelListenerThread()
    }
 
    s_maxTunnelsPerPoller = ConfigReadULong(_T("AgentTunnels.MaxTunnelsPerPoller"), s_maxTunnelsPerPoller);
-   if (s_maxTunnelsPerPoller > SOCKET_POLLER_MAX_SOCKETS - 1)
-      s_maxTunnelsPerPoller = SOCKET_POLLER_MAX_SOCKETS - 1;
+   if (s_maxTunnelsPerPoller > BACKGROUND_SOCKET_POLLER_MAX_SOCKETS - 1)
+      s_maxTunnelsPerPoller = BACKGROUND_SOCKET_POLLER_MAX_SOCKETS - 1;
 
    s_tunnelListenerLock.lock();
    uint16_t listenPort = static_cast<uint16_t>(ConfigReadULong(_T("AgentTunnels.ListenPort"), 4703));
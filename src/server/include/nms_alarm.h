@@ -195,6 +195,225 @@ class AlarmComment
    const TCHAR *getText() const { return m_text; }
 };
 
+/**
+ * Alarm list entry in ID index
+ */
+struct AlarmListEntry
+{
+   Alarm *alarm;
+   int index;     // Position in alarm list
+};
+
+/**
+ * Active alarm list. Alarms are kept in order of creation. Removed alarms leave empty slot (get() returns nullptr
+ * for such slots), which are compacted when write lock is acquired and number of empty slots is large enough, so
+ * removal is O(1) and does not change order of remaining alarms. All modifications (including changes to
+ * individual alarms) should be done under write lock, read lock is sufficient for read-only access.
+ */
+class AlarmList
+{
+private:
+   RWLock m_lock;
+   ObjectArray<Alarm> m_list;
+   StringObjectMap<Alarm> m_keyIndex;
+   HashMap<uint32_t, AlarmListEntry> m_idIndex;
+   HashMap<uint32_t, ObjectArray<Alarm>> m_sourceIndex;
+   int m_severityCount[5];
+   int m_emptySlots;
+
+   void addToSourceIndex(Alarm *alarm)
+   {
+      ObjectArray<Alarm> *alarms = m_sourceIndex.get(alarm->getSourceObject());
+      if (alarms == nullptr)
+      {
+         alarms = new ObjectArray<Alarm>(4, 4, Ownership::False);
+         m_sourceIndex.set(alarm->getSourceObject(), alarms);
+      }
+      alarms->add(alarm);
+   }
+
+   void removeFromSourceIndex(Alarm *alarm, uint32_t sourceObject)
+   {
+      ObjectArray<Alarm> *alarms = m_sourceIndex.get(sourceObject);
+      if (alarms == nullptr)
+         return;
+      alarms->remove(alarm);
+      if (alarms->isEmpty())
+         m_sourceIndex.remove(sourceObject);
+   }
+
+   void countSeverity(int severity, int delta)
+   {
+      if ((severity >= 0) && (severity < 5))
+         m_severityCount[severity] += delta;
+   }
+
+   /**
+    * Remove empty slots from list. Should only be called when list is locked for writing and not iterated.
+    */
+   void compact()
+   {
+      m_list.setOwner(Ownership::False);
+      int j = 0;
+      for(int i = 0; i < m_list.size(); i++)
+      {
+         Alarm *alarm = m_list.get(i);
+         if (alarm == nullptr)
+            continue;
+         if (i != j)
+         {
+            m_list.replace(j, alarm);
+            m_idIndex.get(alarm->getAlarmId())->index = j;
+         }
+         j++;
+      }
+      m_list.shrinkTo(j);
+      m_list.setOwner(Ownership::True);
+      m_emptySlots = 0;
+   }
+
+public:
+   AlarmList() : m_list(256, 256, Ownership::True), m_keyIndex(Ownership::False), m_idIndex(Ownership::True), m_sourceIndex(Ownership::True)
+   {
+      memset(m_severityCount, 0, sizeof(m_severityCount));
+      m_emptySlots = 0;
+   }
+   ~AlarmList() { }
+
+   void readLock() { m_lock.readLock(); }
+   void writeLock()
+   {
+      m_lock.writeLock();
+      if ((m_emptySlots >= 256) && (m_emptySlots >= m_list.size() / 4))
+         compact();
+   }
+   void unlock() { m_lock.unlock(); }
+
+   /**
+    * Get number of slots in the list (including empty slots left by removed alarms)
+    */
+   int size() const { return m_list.size(); }
+
+   /**
+    * Get number of active alarms
+    */
+   int count() const { return m_list.size() - m_emptySlots; }
+
+   int getSeverityCount(int severity) const { return ((severity >= 0) && (severity < 5)) ? m_severityCount[severity] : 0; }
+
+   uint64_t memoryUsage()
+   {
+      uint64_t memUsage = sizeof(AlarmList);
+      readLock();
+      for(int i = 0; i < m_list.size(); i++)
+      {
+         Alarm *alarm = m_list.get(i);
+         if (alarm != nullptr)
+            memUsage += alarm->getMemoryUsage();
+      }
+      memUsage += static_cast<uint64_t>(m_list.size()) * sizeof(void*) + static_cast<uint64_t>(count()) * (sizeof(AlarmListEntry) + sizeof(void*));
+      unlock();
+      return memUsage;
+   }
+
+   /**
+    * Get alarm at given position. Returns nullptr for empty slots.
+    */
+   Alarm *get(int index) { return m_list.get(index); }
+
+   Alarm *find(const TCHAR *key) { return m_keyIndex.get(key); }
+   Alarm *find(uint32_t id)
+   {
+      AlarmListEntry *e = m_idIndex.get(id);
+      return (e != nullptr) ? e->alarm : nullptr;
+   }
+
+   /**
+    * Get alarms for given source object (returns nullptr if there are no active alarms for that object)
+    */
+   const ObjectArray<Alarm> *getObjectAlarms(uint32_t objectId) { return m_sourceIndex.get(objectId); }
+
+   void add(Alarm *alarm)
+   {
+      auto e = new AlarmListEntry;
+      e->alarm = alarm;
+      e->index = m_list.add(alarm);
+      m_idIndex.set(alarm->getAlarmId(), e);
+      if (*alarm->getKey() != 0)
+         m_keyIndex.set(alarm->getKey(), alarm);
+      addToSourceIndex(alarm);
+      countSeverity(alarm->getCurrentSeverity(), 1);
+   }
+
+   /**
+    * Update indexes after change of source object or severity of given alarm
+    */
+   void update(Alarm *alarm, uint32_t oldSourceObject, int oldSeverity)
+   {
+      if (alarm->getSourceObject() != oldSourceObject)
+      {
+         removeFromSourceIndex(alarm, oldSourceObject);
+         addToSourceIndex(alarm);
+      }
+      if (alarm->getCurrentSeverity() != oldSeverity)
+      {
+         countSeverity(oldSeverity, -1);
+         countSeverity(alarm->getCurrentSeverity(), 1);
+      }
+   }
+
+   /**
+    * Remove alarm at given index. Slot is left empty, so positions of other alarms are not changed.
+    */
+   void remove(int index)
+   {
+      Alarm *alarm = m_list.get(index);
+      if (alarm == nullptr)
+         return;
+
+      if (alarm->getParentAlarmId() != 0)
+      {
+         Alarm *parent = find(alarm->getParentAlarmId());
+         if (parent != nullptr)
+            parent->removeSubordinateAlarm(alarm->getAlarmId());
+      }
+      if (*alarm->getKey() != 0)
+         m_keyIndex.remove(alarm->getKey());
+      removeFromSourceIndex(alarm, alarm->getSourceObject());
+      countSeverity(alarm->getCurrentSeverity(), -1);
+      m_idIndex.remove(alarm->getAlarmId());
+
+      if (index == m_list.size() - 1)
+      {
+         m_list.remove(index);
+      }
+      else
+      {
+         m_list.replace(index, nullptr);   // Will destroy removed alarm
+         m_emptySlots++;
+      }
+   }
+
+   void remove(Alarm *alarm)
+   {
+      AlarmListEntry *e = m_idIndex.get(alarm->getAlarmId());
+      if ((e != nullptr) && (e->alarm == alarm))
+         remove(e->index);
+   }
+
+   /**
+    * Remove alarm with given ID. Returns true if alarm was found.
+    */
+   bool removeById(uint32_t id)
+   {
+      AlarmListEntry *e = m_idIndex.get(id);
+      if (e == nullptr)
+         return false;
+      remove(e->index);
+      return true;
+   }
+};
+
 /**
  * Functions
  */
@@ -28,6 +28,11 @@
  */
 #define MAX_NPE_NAME_LEN            16
 
+/**
+ * Size of inline string buffer in ItemValue (longer values are allocated on heap)
+ */
+#define ITEM_VALUE_INLINE_STRING_SIZE  24
+
 /**
  * Interface for objects that can be searched
  */
@@ -93,14 +98,22 @@ class NXCORE_EXPORTABLE ItemValue
    int64_t m_int64;
    uint64_t m_uint64;
    time_t m_timestamp;
-   TCHAR m_string[MAX_DB_STRING];
+   TCHAR *m_string;  // Points either to m_inlineString or to heap allocated buffer for long strings
+   TCHAR m_inlineString[ITEM_VALUE_INLINE_STRING_SIZE];
 
    void parseStringValue(bool parseSuffix);
+   void setString(const TCHAR *value);
 
 public:
    ItemValue();
    ItemValue(const TCHAR *value, time_t timestamp);
    ItemValue(DB_RESULT hResult, int row, int column, bool parseSuffix);
+   ItemValue(const ItemValue& src);
+   ~ItemValue()
+   {
+      if (m_string != m_inlineString)
+         MemFree(m_string);
+   }
 
    void setTimeStamp(time_t timestamp) { m_timestamp = timestamp; }
    time_t getTimeStamp() const { return m_timestamp; }
@@ -111,6 +124,7 @@ class NXCORE_EXPORTABLE ItemValue
    uint64_t getUInt64() const { return m_uint64; }
    double getDouble() const { return m_double; }
    const TCHAR *getString() const { return m_string; }
+   bool isStringInline() const { return m_string == m_inlineString; }
 
    void set(const TCHAR *stringValue, bool parseSuffix = false);
    void set(double value, const TCHAR *stringValue = nullptr);
@@ -126,7 +140,7 @@ class NXCORE_EXPORTABLE ItemValue
    operator int64_t() const { return m_int64; }
    operator const TCHAR*() const { return m_string; }
 
-   ItemValue& operator=(const ItemValue &src) = default;
+   ItemValue& operator=(const ItemValue &src);
    ItemValue& operator=(const TCHAR *value) { set(value); return *this; }
    ItemValue& operator=(double value) { set(value); return *this; }
    ItemValue& operator=(int32_t value) { set(value); return *this; }
@@ -135,6 +149,51 @@ class NXCORE_EXPORTABLE ItemValue
    ItemValue& operator=(uint64_t value) { set(value); return *this; }
 };
 
+/**
+ * Fixed capacity cache of DCI values. Values are stored in circular buffer, newest value has index 0.
+ */
+class NXCORE_EXPORTABLE ItemValueCache
+{
+private:
+   ItemValue *m_values;
+   uint32_t m_capacity;
+   uint32_t m_head;  // Position of newest value
+
+   static const ItemValue s_emptyValue;   // Returned by get() when cache has zero capacity
+
+public:
+   ItemValueCache()
+   {
+      m_values = nullptr;
+      m_capacity = 0;
+      m_head = 0;
+   }
+   ItemValueCache(const ItemValueCache& src) = delete;
+   ~ItemValueCache()
+   {
+      delete[] m_values;
+   }
+
+   ItemValueCache& operator=(const ItemValueCache& src);
+
+   uint32_t size() const { return m_capacity; }
+   const ItemValue& get(uint32_t index) const { return (m_capacity > 0) ? m_values[(m_head + index) % m_capacity] : s_emptyValue; }
+   void set(uint32_t index, const ItemValue& value)
+   {
+      if (m_capacity > 0)
+         m_values[(m_head + index) % m_capacity] = value;
+   }
+   const ItemValue& operator[](uint32_t index) const { return get(index); }
+   const ItemValue& last() const { return get(m_capacity - 1); }
+
+   void shiftIn(const ItemValue& value);
+   void resize(uint32_t size);
+   void remove(uint32_t index);
+   void clear();
+
+   uint64_t getMemoryUsage() const;
+};
+
 class DCItem;
 class DataCollectionTarget;
 
@@ -169,10 +228,10 @@ class NXCORE_EXPORTABLE Threshold
 	TCHAR *m_lastEventMessage;
 
    const ItemValue& value() const { return m_value; }
-   void calculateAverage(ItemValue *result, const ItemValue &lastValue, ItemValue **ppPrevValues);
-   void calculateTotal(ItemValue *result, const ItemValue &lastValue, ItemValue **ppPrevValues);
-   void calculateAbsoluteDeviation(ItemValue *result, const ItemValue &lastValue, ItemValue **ppPrevValues);
-   void calculateMeanDeviation(ItemValue *result, const ItemValue &lastValue, ItemValue **ppPrevValues);
+   void calculateAverage(ItemValue *result, const ItemValue &lastValue, const ItemValueCache &prevValues);
+   void calculateTotal(ItemValue *result, const ItemValue &lastValue, const ItemValueCache &prevValues);
+   void calculateAbsoluteDeviation(ItemValue *result, const ItemValue &lastValue, const ItemValueCache &prevValues);
+   void calculateMeanDeviation(ItemValue *result, const ItemValue &lastValue, const ItemValueCache &prevValues);
    void setScript(TCHAR *script);
 
 public:
@@ -207,7 +266,7 @@ class NXCORE_EXPORTABLE Threshold
    void setLastCheckedValue(const ItemValue &value) { m_lastCheckValue = value; }
 
    bool saveToDB(DB_HANDLE hdb, uint32_t index);
-   ThresholdCheckResult check(ItemValue &value, ItemValue **ppPrevValues, ItemValue &fvalue, ItemValue &tvalue, shared_ptr<NetObj> target, DCItem *dci);
+   ThresholdCheckResult check(ItemValue &value, const ItemValueCache &prevValues, ItemValue &fvalue, ItemValue &tvalue, shared_ptr<NetObj> target, DCItem *dci);
    ThresholdCheckResult checkError(uint32_t errorCount);
 
    void fillMessage(NXCPMessage *msg, uint32_t baseId) const;
@@ -306,6 +365,8 @@ class NXCORE_EXPORTABLE DCObject : public enable_shared_from_this<DCObject>, pub
    Mutex m_mutex;
    StringList *m_schedules;
    time_t m_tLastCheck;          // Last schedule checking time
+   time_t m_scheduledPollTime;   // Time of next check by data collection scheduler (protected by scheduler lock)
+   bool m_scheduleWithSeconds;   // true if at least one advanced schedule with seconds matched current minute on last check
    uint32_t m_errorCount;        // Consequtive collection error count
    uint32_t m_resourceId;	   	// Associated cluster resource ID
    uint32_t m_sourceNode;        // Source node ID or 0 to disable
@@ -420,6 +481,9 @@ class NXCORE_EXPORTABLE DCObject : public enable_shared_from_this<DCObject>, pub
 
 	bool matchClusterResource();
    bool isReadyForPolling(time_t currTime);
+   time_t getNextPollCheckTime(time_t currTime);
+   time_t getScheduledPollTime() const { return m_scheduledPollTime; }
+   void setScheduledPollTime(time_t t) { m_scheduledPollTime = t; }
 	bool isScheduledForDeletion() const { return m_scheduledForDeletion ? true : false; }
    void setLastPollTime(time_t lastPoll) { m_lastPoll = lastPoll; }
    void setStatus(int status, bool generateEvent, bool userChange = false);
@@ -491,9 +555,8 @@ class NXCORE_EXPORTABLE DCItem : public DCObject
    BYTE m_dataType;
 	int m_sampleCount;            // Number of samples required to calculate value
 	ObjectArray<Threshold> *m_thresholds;
-   uint32_t m_cacheSize;          // Number of items in cache
    uint32_t m_requiredCacheSize;
-   ItemValue **m_ppValueCache;
+   ItemValueCache m_valueCache;
    ItemValue m_prevRawValue;     // Previous raw value (used for delta calculation)
    time_t m_prevValueTimeStamp;
    bool m_cacheLoaded;
@@ -567,7 +630,7 @@ class NXCORE_EXPORTABLE DCItem : public DCObject
 	SharedString getUnitName() const { return GetAttributeWithLock(m_unitName, m_mutex); }
 	bool isAnomalyDetected() const { return m_anomalyDetected; }
 
-	uint64_t getCacheMemoryUsage() const;
+	uint64_t getCacheMemoryUsage(uint64_t *legacySize = nullptr) const;
 
    bool processNewValue(time_t nTimeStamp, const TCHAR *value, bool *updateStatus);
 
@@ -978,10 +1041,38 @@ static inline uint32_t RCCFromDCIError(DataCollectionError error)
    }
 }
 
+/**
+ * Builder for batches of SNMP DCIs collected from same node with single request.
+ * DCIs are grouped by data collector queue key and submitted to data collector thread pool by dispatch().
+ */
+class SNMPCollectionBatchBuilder
+{
+private:
+   HashMap<uint64_t, SharedObjectArray<DCObject>> m_batches;
+
+public:
+   SNMPCollectionBatchBuilder() : m_batches(Ownership::False) { }
+   ~SNMPCollectionBatchBuilder() { dispatch(); }
+
+   void add(uint64_t key, const shared_ptr<DCObject>& dcObject);
+   void dispatch();
+};
+
+/**
+ * Get key for serialized execution of data collection tasks for given source node and data source
+ */
+static inline uint64_t GetDataCollectorSerializationKey(uint32_t nodeId, int dataSource)
+{
+   return (static_cast<uint64_t>(nodeId) << 8) | static_cast<uint64_t>(dataSource & 0xFF);
+}
+
 /**
  * Functions
  */
 void InitDataCollector();
+void ScheduleDCObjectPollNow(const shared_ptr<DCObject>& dcObject);
+uint64_t GetLateScheduledDCObjectCount();
+uint32_t GetDataCollectionSchedulingLag();
 void WriteFullParamListToMessage(NXCPMessage *msg, int origin, uint16_t flags);
 int GetDCObjectType(uint32_t nodeId, uint32_t dciId);
 
@@ -993,13 +1084,22 @@ void CalculateItemValueMeanDeviation(ItemValue *result, int dataType, const Item
 void CalculateItemValueTotal(ItemValue *result, int dataType, const ItemValue *const *valueList, size_t sampleCount);
 void CalculateItemValueMin(ItemValue *result, int dataType, const ItemValue *const *valueList, size_t sampleCount);
 void CalculateItemValueMax(ItemValue *result, int dataType, const ItemValue *const *valueList, size_t sampleCount);
+void CalculateItemValueAverage(ItemValue *result, int dataType, const ItemValueCache& valueList, size_t sampleCount);
+void CalculateItemValueMeanDeviation(ItemValue *result, int dataType, const ItemValueCache& valueList, size_t sampleCount);
+void CalculateItemValueTotal(ItemValue *result, int dataType, const ItemValueCache& valueList, size_t sampleCount);
+void CalculateItemValueMin(ItemValue *result, int dataType, const ItemValueCache& valueList, size_t sampleCount);
+void CalculateItemValueMax(ItemValue *result, int dataType, const ItemValueCache& valueList, size_t sampleCount);
 
 unique_ptr<StructArray<ScoredDciValue>> DetectAnomalies(const DataCollectionTarget& dcTarget, uint32_t dciId, time_t timeFrom, time_t timeTo, double threshold = 0.75);
 bool IsAnomalousValue(const DataCollectionTarget& dcTarget, const DCObject& dci, double value, double threshold, int period, int depth, int width);
+void InvalidateAnomalyModels(uint32_t dciId);
+uint32_t GetAnomalyModelCacheSize();
+uint32_t GetAnomalyModelTrainingTime();
 
 DataCollectionError GetQueueStatistic(const TCHAR *parameter, StatisticType type, TCHAR *value);
+DataCollectionError GetEventLogWriterLatencyStatistic(const TCHAR *parameter, TCHAR *value);
 
-uint64_t GetDCICacheMemoryUsage();
+uint64_t GetDCICacheMemoryUsage(uint64_t *legacySize = nullptr);
 
 /**
  * DCI cache loader queue
@@ -606,6 +606,25 @@ class TimeFrame
    uint64_t getDateFilter() const { return m_dateFilter; }
 };
 
+/**
+ * Event source information shared between all rules evaluated for single event.
+ * Set of source object's ancestors is collected on first use, so each rule's
+ * source filter check is reduced to set lookups instead of walking object tree.
+ */
+class EPEventSource
+{
+private:
+   shared_ptr<NetObj> m_object;
+   HashSet<uint32_t> m_ancestors;
+   bool m_ancestorsCollected;
+
+public:
+   EPEventSource(uint32_t objectId);
+
+   const shared_ptr<NetObj>& getObject() const { return m_object; }
+   bool isSameOrDescendantOf(uint32_t id);
+};
+
 /**
  * Event policy rule
  */
@@ -643,7 +662,7 @@ class EPRule
    StringMap m_customAttributeSetActions;
    StringList m_customAttributeDeleteActions;
 
-   bool matchSource(const shared_ptr<NetObj>& object) const;
+   bool matchSource(EPEventSource *source) const;
    bool matchEvent(uint32_t eventCode) const;
    bool matchSeverity(uint32_t severity) const;
    bool matchScript(Event *event) const;
@@ -664,7 +683,7 @@ class EPRule
    void setId(uint32_t newId) { m_id = newId; }
    bool loadFromDB(DB_HANDLE hdb);
 	bool saveToDB(DB_HANDLE hdb) const;
-   bool processEvent(Event *event) const;
+   bool processEvent(Event *event, EPEventSource *source) const;
    void createMessage(NXCPMessage *msg) const;
    void createExportRecord(TextFileWriter& xml) const;
    void createOrderingExportRecord(TextFileWriter& xml) const;
@@ -675,6 +694,9 @@ class EPRule
    bool isCategoryInUse(uint32_t categoryId) const { return m_alarmCategoryList.contains(categoryId); }
 
    bool isUsingEvent(uint32_t eventCode) const { return m_events.contains(eventCode); }
+   bool isDisabled() const { return (m_flags & RF_DISABLED) != 0; }
+   bool hasEventFilter() const { return !m_events.isEmpty() && !(m_flags & RF_NEGATED_EVENTS); }
+   const IntegerArray<uint32_t>& getEvents() const { return m_events; }
    const TCHAR *getComments() const { return m_comments; }
 };
 
@@ -778,15 +800,18 @@ class EventPolicy
 {
 private:
    ObjectArray<EPRule> m_rules;
+   HashMap<uint32_t, IntegerArray<int>> m_eventIndex;  // Indexes of rules with explicit event filter by event code
+   IntegerArray<int> m_wildcardRules;  // Indexes of rules without event filter or with negated event filter
    RWLock m_rwlock;
 
    void readLock() const { m_rwlock.readLock(); }
    void writeLock() { m_rwlock.writeLock(); }
    void unlock() const { m_rwlock.unlock(); }
    int findRuleIndexByGuid(const uuid& guid, int shift = 0) const;
+   void buildEventIndex();
 
 public:
-   EventPolicy() : m_rules(128, 128, Ownership::True) { }
+   EventPolicy() : m_rules(128, 128, Ownership::True), m_eventIndex(Ownership::True), m_wildcardRules(128, 128) { }
 
    uint32_t getNumRules() const { return m_rules.size(); }
    bool loadFromDB();
@@ -965,6 +965,8 @@ class NXCORE_EXPORTABLE PollState
    Mutex m_lock;
    bool m_saveNeeded;
    const TCHAR *m_name;
+   uint32_t m_interval;       // Last known effective polling interval (0 if unknown)
+   time_t m_nextCheckTime;    // Time of next check by poll manager (managed by poll manager)
 
 public:
    PollState(const TCHAR *name, bool saveNeeded = false) : m_timer(name, 1, 1000), m_lock(MutexType::FAST)
@@ -973,6 +975,41 @@ class NXCORE_EXPORTABLE PollState
       m_pollerCount = 0;
       m_lastCompleted = TIMESTAMP_NEVER;
       m_saveNeeded = saveNeeded;
+      m_interval = 0;
+      m_nextCheckTime = 0;
+   }
+
+   /**
+    * Check if poll is due according to given polling interval. Interval is remembered for use by poll manager.
+    */
+   bool isDue(uint32_t interval)
+   {
+      m_interval = interval;
+      return static_cast<uint32_t>(time(nullptr) - getLastCompleted()) > interval;
+   }
+
+   /**
+    * Get last known effective polling interval (0 if not known yet)
+    */
+   uint32_t getInterval() const
+   {
+      return m_interval;
+   }
+
+   /**
+    * Get time of next check by poll manager
+    */
+   time_t getNextCheckTime() const
+   {
+      return m_nextCheckTime;
+   }
+
+   /**
+    * Set time of next check by poll manager
+    */
+   void setNextCheckTime(time_t t)
+   {
+      m_nextCheckTime = t;
    }
 
    /**
@@ -1196,6 +1233,16 @@ struct ResponsibleUser
 
 class ObjectIndex;
 
+/**
+ * Object link requested while link deferral was active (used by parallel object loader)
+ */
+struct DeferredObjectLink
+{
+   shared_ptr<NetObj> parent;
+   shared_ptr<NetObj> child;
+   uint32_t sequence;   // Order in which links were requested
+};
+
 /**
  * Base class for network objects
  */
@@ -1492,6 +1539,7 @@ class NXCORE_EXPORTABLE NetObj : public NObject
 
    static void linkObjects(const shared_ptr<NetObj>& parent, const shared_ptr<NetObj>& child);
    static void unlinkObjects(NetObj *parent, NetObj *child);
+   static void setLinkDeferral(ObjectArray<DeferredObjectLink> *queue);
 
    static const WCHAR *getObjectClassNameW(int objectClass);
    static const char *getObjectClassNameA(int objectClass);
@@ -1539,6 +1587,11 @@ enum class PollerType
    MAP_UPDATE = 8
 };
 
+void SchedulePolls(NetObj *object);
+void SchedulePollNow(NetObj *object, PollerType type);
+void ReschedulePolls(NetObj *object);
+void RescheduleAllPolls(PollerType type);
+
 /**
  * Poller information
  */
@@ -1693,6 +1746,7 @@ class NXCORE_EXPORTABLE Pollable
    virtual bool lockForMapUpdatePoll();
 
    void resetPollTimers();
+   PollState *getPollState(PollerType type);
 
    DataCollectionError getInternalMetric(const TCHAR *name, TCHAR *buffer, size_t size);
    bool saveToDatabase(DB_HANDLE hdb);
@@ -2648,14 +2702,16 @@ class NXCORE_EXPORTABLE DataCollectionTarget : public DataCollectionOwner, publi
    int getDciThreshold(uint32_t dciId);
    void findDcis(const SearchQuery &query, uint32_t userId, SharedObjectArray<DCObject> *result);
 
-   uint64_t getCacheMemoryUsage();
+   uint64_t getCacheMemoryUsage(uint64_t *legacySize = nullptr);
 
    void updateDciCache();
    void updateDCItemCacheSize(uint32_t dciId);
    void reloadDCItemCache(uint32_t dciId);
    void cleanDCIData(DB_HANDLE hdb);
    void calculateDciCutoffTimes(time_t *cutoffTimeIData, time_t *cutoffTimeTData);
-   void queueItemsForPolling();
+   bool queueItemForPolling(const shared_ptr<DCObject>& object, time_t currTime, SNMPCollectionBatchBuilder *snmpBatches = nullptr);
+   bool isDataCollectionActive() { return (m_status != STATUS_UNMANAGED) && !isDataCollectionDisabled() && !m_isDeleted; }
+   void scheduleItemsForPolling();
    bool processNewDCValue(const shared_ptr<DCObject>& dco, time_t currTime, const TCHAR *itemValue, const shared_ptr<Table>& tableValue);
    void scheduleItemDataCleanup(uint32_t dciId);
    void scheduleTableDataCleanup(uint32_t dciId);
@@ -3320,6 +3376,17 @@ template class NXCORE_TEMPLATE_EXPORTABLE StructArray<OSPFArea>;
 template class NXCORE_TEMPLATE_EXPORTABLE StructArray<OSPFNeighbor>;
 #endif
 
+/**
+ * Single metric in batched SNMP data collection request
+ */
+struct SNMPMetricRequest
+{
+   const TCHAR *name;
+   int interpretRawValue;
+   DataCollectionError error;
+   TCHAR value[MAX_RESULT_LENGTH];
+};
+
 /**
  * Node
  */
@@ -3815,7 +3882,13 @@ class NXCORE_EXPORTABLE Node : public DataCollectionTarget
    void updateInterfaceNames(ClientSession *pSession, UINT32 dwRqId);
    void checkSubnetBinding();
 
-   void forceConfigurationPoll() { lockProperties(); m_runtimeFlags |= ODF_FORCE_CONFIGURATION_POLL; unlockProperties(); }
+   void forceConfigurationPoll()
+   {
+      lockProperties();
+      m_runtimeFlags |= ODF_FORCE_CONFIGURATION_POLL;
+      unlockProperties();
+      SchedulePollNow(this, PollerType::CONFIGURATION);
+   }
 
    virtual bool setMgmtStatus(bool isManaged) override;
    virtual void calculateCompoundStatus(bool forcedRecalc = false) override;
@@ -3835,6 +3908,7 @@ class NXCORE_EXPORTABLE Node : public DataCollectionTarget
    virtual DataCollectionError getInternalTable(const TCHAR *name, shared_ptr<Table> *result) override;
 
    DataCollectionError getMetricFromSNMP(uint16_t port, SNMP_Version version, const TCHAR *metric, TCHAR *buffer, size_t size, int interpretRawValue);
+   void getMetricsFromSNMP(uint16_t port, SNMP_Version version, SNMPMetricRequest *metrics, size_t count, size_t maxBatchSize);
    DataCollectionError getTableFromSNMP(uint16_t port, SNMP_Version version, const TCHAR *oid, const ObjectArray<DCTableColumn> &columns, shared_ptr<Table> *table);
    DataCollectionError getListFromSNMP(uint16_t port, SNMP_Version version, const TCHAR *oid, StringList **list);
    DataCollectionError getOIDSuffixListFromSNMP(uint16_t port, SNMP_Version version, const TCHAR *oid, StringMap **values);
@@ -5481,6 +5555,14 @@ int GetDefaultStatusCalculation(int *pnSingleThreshold, int **ppnThresholds);
 PollerInfo *RegisterPoller(PollerType type, const shared_ptr<NetObj>& object);
 void ShowPollers(ServerConsole *console);
 
+/**
+ * Get key for serialized execution of polls for given object in poller thread pool
+ */
+static inline uint64_t GetPollerSerializationKey(uint32_t objectId)
+{
+   return objectId;
+}
+
 void InitUserAgentNotifications();
 void DeleteExpiredUserAgentNotifications(DB_HANDLE hdb,UINT32 retentionTime);
 void FillUserAgentNotificationsAll(NXCPMessage *msg, Node *node);
@@ -657,6 +657,7 @@ class LIBNXSRV_EXPORTABLE NObject : public enable_shared_from_this<NObject>
    bool isDirectChild(uint32_t id) const;
    bool isParent(uint32_t id) const;
    bool isDirectParent(uint32_t id) const;
+   void addAllParentIds(HashSet<uint32_t> *ids) const;
 
    int getChildCount() const { return m_childList.size(); }
    int getParentCount() const { return m_parentList.size(); }
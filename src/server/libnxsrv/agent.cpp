@@ -55,7 +55,7 @@ static int m_iDefaultEncryptionPolicy = ENCRYPTION_ALLOWED;
 static ObjectArray<BackgroundSocketPollerHandle> s_pollers(64, 64, Ownership::True);
 static Mutex s_pollerListLock(MutexType::FAST);
 static bool s_shutdownMode = false;
-static uint32_t s_maxConnectionsPerPoller = std::min(256, SOCKET_POLLER_MAX_SOCKETS - 1);
+static uint32_t s_maxConnectionsPerPoller = std::min(256, BACKGROUND_SOCKET_POLLER_MAX_SOCKETS - 1);
 
 /**
  * Set default encryption policy for agent communication
@@ -221,6 +221,26 @@ bool NObject::isParent(uint32_t id) const
    return result;
 }
 
+/**
+ * Add IDs of all direct and indirect parents to given set
+ *
+ * @param ids set to add parent IDs to
+ */
+void NObject::addAllParentIds(HashSet<uint32_t> *ids) const
+{
+   readLockParentList();
+   for(int i = 0; i < m_parentList.size(); i++)
+   {
+      NObject *parent = m_parentList.get(i);
+      if (!ids->contains(parent->getId()))
+      {
+         ids->put(parent->getId());
+         parent->addAllParentIds(ids);
+      }
+   }
+   unlockParentList();
+}
+
 /**
  * Check if given object is our direct parent
  *
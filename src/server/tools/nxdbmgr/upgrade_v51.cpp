@@ -23,6 +23,176 @@
 #include "nxdbmgr.h"
 #include <nxevent.h>
 
+/**
+ * Upgrade from 51.22 to 51.23
+ */
+static bool H_UpgradeFromV22()
+{
+   CHK_EXEC(SQLQuery(_T("UPDATE config SET description='Number of threads used for caching object configuration tables and loading objects from database at server startup. If configuration tables are cached (DBCacheConfigurationTables is set in server configuration file), each additional loader thread holds private in-memory copy of all cached tables (including DCI and threshold configuration) while objects are loaded, so peak memory usage at startup grows with number of threads. Actual number of loader threads can be lower if database connection pool does not have enough free connections.' WHERE var_name='Objects.StartupLoaderThreads'")));
+   CHK_EXEC(SetMinorSchemaVersion(23));
+   return true;
+}
+
+/**
+ * Upgrade from 51.21 to 51.22
+ */
+static bool H_UpgradeFromV21()
+{
+   CHK_EXEC(SQLQuery(_T("DELETE FROM config WHERE var_name IN ('Objects.Snapshot.Enable','Objects.Snapshot.Interval')")));
+   CHK_EXEC(SQLQuery(_T("DELETE FROM metadata WHERE var_name='ObjectSnapshotMarker'")));
+   CHK_EXEC(SetMinorSchemaVersion(22));
+   return true;
+}
+
+/**
+ * Upgrade from 51.20 to 51.21
+ */
+static bool H_UpgradeFromV20()
+{
+   CHK_EXEC(SQLQuery(_T("UPDATE config SET var_value='0',default_value='0' WHERE var_name='SNMP.RequestEngine.Enable'")));
+   CHK_EXEC(SetMinorSchemaVersion(21));
+   return true;
+}
+
+/**
+ * Upgrade from 51.19 to 51.20
+ */
+static bool H_UpgradeFromV19()
+{
+   CHK_EXEC(SQLQuery(_T("UPDATE config SET description='Maximum number of trained anomaly detection models in cache. Value of 0 disables model caching (model is trained for each new value).',units='' WHERE var_name='DataCollection.AnomalyDetection.ModelCacheSize'")));
+   CHK_EXEC(SetMinorSchemaVersion(20));
+   return true;
+}
+
+/**
+ * Upgrade from 51.18 to 51.19
+ */
+static bool H_UpgradeFromV18()
+{
+   CHK_EXEC(CreateConfigParam(_T("ThreadPool.DataCollector.WorkStealing"),
+                              _T("0"),
+                              _T("Enable/disable work stealing execution mode for data collector thread pool."),
+                              nullptr, 'B', true, true, false, false));
+   CHK_EXEC(CreateConfigParam(_T("ThreadPool.Poller.WorkStealing"),
+                              _T("0"),
+                              _T("Enable/disable work stealing execution mode for poller thread pool."),
+                              nullptr, 'B', true, true, false, false));
+   CHK_EXEC(SetMinorSchemaVersion(19));
+   return true;
+}
+
+/**
+ * Upgrade from 51.17 to 51.18
+ */
+static bool H_UpgradeFromV17()
+{
+   CHK_EXEC(CreateConfigParam(_T("Objects.Snapshot.Enable"),
+                              _T("0"),
+                              _T("Enable/disable writing snapshot of object configuration to local file on server shutdown and loading objects from it on next startup if database was not modified in between."),
+                              nullptr, 'B', true, false, false, false));
+   CHK_EXEC(CreateConfigParam(_T("Objects.Snapshot.Interval"),
+                              _T("0"),
+                              _T("Interval in seconds between writing object configuration snapshot by syncer. Value of 0 disables periodic snapshots (snapshot is only written on server shutdown)."),
+                              _T("seconds"), 'I', true, true, false, false));
+   CHK_EXEC(SetMinorSchemaVersion(18));
+   return true;
+}
+
+/**
+ * Upgrade from 51.16 to 51.17
+ */
+static bool H_UpgradeFromV16()
+{
+   CHK_EXEC(CreateConfigParam(_T("Objects.StartupLoaderThreads"),
+                              _T("4"),
+                              _T("Number of threads used for caching object configuration tables and loading objects from database at server startup."),
+                              nullptr, 'I', true, true, false, false));
+   CHK_EXEC(SetMinorSchemaVersion(17));
+   return true;
+}
+
+/**
+ * Upgrade from 51.15 to 51.16
+ */
+static bool H_UpgradeFromV15()
+{
+   CHK_EXEC(CreateConfigParam(_T("DataCollection.AnomalyDetection.ModelCacheSize"),
+                              _T("256"),
+                              _T("Memory limit for cache of trained anomaly detection models. Value of 0 disables model caching (model is trained for each new value)."),
+                              _T("MB"), 'I', true, true, false, false));
+   CHK_EXEC(SetMinorSchemaVersion(16));
+   return true;
+}
+
+/**
+ * Upgrade from 51.14 to 51.15
+ */
+static bool H_UpgradeFromV14()
+{
+   CHK_EXEC(CreateConfigParam(_T("Syslog.ProcessingThreads"),
+                              _T("1"),
+                              _T("Number of syslog processing threads. Messages are distributed between threads by source address, so messages from same source are always processed in order. Syslog parser rules are still matched by one thread at a time, because rule contexts and counters are shared between all sources."),
+                              nullptr, 'I', true, true, false, false));
+   CHK_EXEC(CreateConfigParam(_T("Syslog.ReceiverThreads"),
+                              _T("1"),
+                              _T("Number of syslog receiver threads (each with own socket bound with SO_REUSEPORT). Has no effect on platforms without SO_REUSEPORT support."),
+                              nullptr, 'I', true, true, false, false));
+   CHK_EXEC(SetMinorSchemaVersion(15));
+   return true;
+}
+
+/**
+ * Upgrade from 51.13 to 51.14
+ */
+static bool H_UpgradeFromV13()
+{
+   CHK_EXEC(CreateConfigParam(_T("SNMP.RequestEngine.Enable"),
+                              _T("1"),
+                              _T("Enable/disable asynchronous SNMP request engine (send all SNMP requests over shared sockets instead of separate socket for each request)."),
+                              nullptr, 'B', true, true, false, false));
+   CHK_EXEC(SetMinorSchemaVersion(14));
+   return true;
+}
+
+/**
+ * Upgrade from 51.12 to 51.13
+ */
+static bool H_UpgradeFromV12()
+{
+   CHK_EXEC(CreateConfigParam(_T("SNMP.BulkWalk.MaxRepetitions"),
+                              _T("20"),
+                              _T("Maximum number of repetitions in SNMP GETBULK requests used for MIB walk (SNMPv2c and SNMPv3 only). Value of 0 disables GETBULK requests."),
+                              nullptr, 'I', true, true, false, false));
+   CHK_EXEC(SetMinorSchemaVersion(13));
+   return true;
+}
+
+/**
+ * Upgrade from 51.11 to 51.12
+ */
+static bool H_UpgradeFromV11()
+{
+   CHK_EXEC(CreateConfigParam(_T("DataCollection.SNMP.BatchSize"),
+                              _T("32"),
+                              _T("Maximum number of SNMP DCIs from same node collected with single request. Value of 1 disables request batching."),
+                              nullptr, 'I', true, true, false, false));
+   CHK_EXEC(SetMinorSchemaVersion(12));
+   return true;
+}
+
+/**
+ * Upgrade from 51.10 to 51.11
+ */
+static bool H_UpgradeFromV10()
+{
+   CHK_EXEC(CreateConfigParam(_T("DBWriter.UseBulkCopy"),
+                              _T("1"),
+                              _T("Use bulk copy (COPY FROM STDIN) instead of multi-row INSERT for DCI data writes if supported by database driver."),
+                              nullptr, 'B', true, true, false, false));
+   CHK_EXEC(SetMinorSchemaVersion(11));
+   return true;
+}
+
 /**
  * Upgrade from 51.9 to 51.10
  */
@@ -249,6 +419,19 @@ static struct
    int nextMinor;
    bool (*upgradeProc)();
 } s_dbUpgradeMap[] = {
+   { 22, 51, 23, H_UpgradeFromV22 },
+   { 21, 51, 22, H_UpgradeFromV21 },
+   { 20, 51, 21, H_UpgradeFromV20 },
+   { 19, 51, 20, H_UpgradeFromV19 },
+   { 18, 51, 19, H_UpgradeFromV18 },
+   { 17, 51, 18, H_UpgradeFromV17 },
+   { 16, 51, 17, H_UpgradeFromV16 },
+   { 15, 51, 16, H_UpgradeFromV15 },
+   { 14, 51, 15, H_UpgradeFromV14 },
+   { 13, 51, 14, H_UpgradeFromV13 },
+   { 12, 51, 13, H_UpgradeFromV12 },
+   { 11, 51, 12, H_UpgradeFromV11 },
+   { 10, 51, 11, H_UpgradeFromV10 },
    { 9,  51, 10, H_UpgradeFromV9  },
    { 8,  51, 9,  H_UpgradeFromV8  },
    { 7,  51, 8,  H_UpgradeFromV7  },
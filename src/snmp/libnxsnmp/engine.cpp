@@ -0,0 +1,647 @@
+/*
+** NetXMS - Network Management System
+** SNMP support library
+** Copyright (C) 2003-2024 Victor Kirhenshtein
+**
+** This program is free software; you can redistribute it and/or modify
+** it under the terms of the GNU Lesser General Public License as published by
+** the Free Software Foundation; either version 3 of the License, or
+** (at your option) any later version.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+**
+** File: engine.cpp
+**
+**/
+
+#include "libnxsnmp.h"
+#include <algorithm>
+
+#define DEBUG_TAG _T("snmp.engine")
+
+/**
+ * Socket receive buffer size for shared sockets
+ */
+#define ENGINE_SOCKET_BUFFER_SIZE   (4 * 1024 * 1024)
+
+/**
+ * Maximum number of datagrams read from one socket before timers are checked again
+ */
+#define MAX_DATAGRAMS_PER_WAKEUP    256
+
+/**
+ * Default request engine
+ */
+static SNMP_RequestEngine *s_defaultEngine = nullptr;
+
+/**
+ * Set default request engine (used by UDP transports created after this call). Engine should not be destroyed while
+ * any transport created with it still exists.
+ */
+void LIBNXSNMP_EXPORTABLE SnmpSetDefaultRequestEngine(SNMP_RequestEngine *engine)
+{
+   s_defaultEngine = engine;
+}
+
+/**
+ * Get default request engine
+ */
+SNMP_RequestEngine LIBNXSNMP_EXPORTABLE *SnmpGetDefaultRequestEngine()
+{
+   return s_defaultEngine;
+}
+
+/**
+ * Pending request
+ */
+struct SNMP_PendingRequest
+{
+   uint64_t serial;
+   uint32_t key;
+   SOCKET socket;
+   SockAddrBuffer addr;
+   BYTE *packet;
+   size_t packetSize;
+   SNMP_SecurityContext *securityContext;
+   bool engineIdAutoupdate;
+   uint32_t timeout;
+   int retries;   // Remaining retransmissions
+   SNMP_ResponseCallback callback;
+   SNMP_PendingRequest *next;   // Next request with same key
+
+   ~SNMP_PendingRequest()
+   {
+      MemFree(packet);
+      delete securityContext;
+   }
+};
+
+/**
+ * Completed request (response or error) to be reported to caller
+ */
+struct SNMP_CompletedRequest
+{
+   SNMP_PendingRequest *request;
+   uint32_t rcc;
+   SNMP_PDU *response;
+};
+
+/**
+ * Find pending request by key and serial number (engine lock must be held)
+ */
+static SNMP_PendingRequest *FindRequest(HashMap<uint32_t, SNMP_PendingRequest> *requests, uint32_t key, uint64_t serial)
+{
+   for(SNMP_PendingRequest *r = requests->get(key); r != nullptr; r = r->next)
+      if (r->serial == serial)
+         return r;
+   return nullptr;
+}
+
+/**
+ * Add request to pending request list. Requests with same key (sent by different transports) are chained. Engine lock must be held.
+ */
+static void LinkRequest(HashMap<uint32_t, SNMP_PendingRequest> *requests, SNMP_PendingRequest *request)
+{
+   request->next = requests->get(request->key);
+   requests->set(request->key, request);
+}
+
+/**
+ * Remove request from pending request list (engine lock must be held)
+ */
+static void UnlinkRequest(HashMap<uint32_t, SNMP_PendingRequest> *requests, SNMP_PendingRequest *request)
+{
+   SNMP_PendingRequest *head = requests->get(request->key);
+   if (head == request)
+   {
+      if (request->next != nullptr)
+         requests->set(request->key, request->next);
+      else
+         requests->unlink(request->key);
+   }
+   else
+   {
+      for(SNMP_PendingRequest *r = head; r != nullptr; r = r->next)
+      {
+         if (r->next == request)
+         {
+            r->next = request->next;
+            break;
+         }
+      }
+   }
+   request->next = nullptr;
+}
+
+/**
+ * Comparator for timer heap (earliest timer on top)
+ */
+static inline bool TimerHeapCompare(const SNMP_RequestTimer& t1, const SNMP_RequestTimer& t2)
+{
+   return t1.due > t2.due;
+}
+
+/**
+ * Get matching key (request ID for SNMPv1/v2c or message ID for SNMPv3) from raw message without full parsing
+ */
+static bool GetMessageKey(const BYTE *message, size_t size, uint32_t *key)
+{
+   uint32_t type;
+   size_t length, idLength;
+   const BYTE *content;
+
+   if (!BER_DecodeIdentifier(message, size, &type, &length, &content, &idLength) || (type != ASN_SEQUENCE))
+      return false;
+   size_t remaining = length;
+
+   // Version
+   const BYTE *curr = content;
+   if (!BER_DecodeIdentifier(curr, remaining, &type, &length, &content, &idLength) || (type != ASN_INTEGER))
+      return false;
+   uint32_t version;
+   if (!BER_DecodeContent(type, content, length, reinterpret_cast<BYTE*>(&version)))
+      return false;
+   remaining -= length + idLength;
+   curr = content + length;
+
+   if (version == SNMP_VERSION_3)
+   {
+      // Message ID is first element of header
+      if (!BER_DecodeIdentifier(curr, remaining, &type, &length, &content, &idLength) || (type != ASN_SEQUENCE))
+         return false;
+      remaining = length;
+      curr = content;
+   }
+   else
+   {
+      // Skip community string and go into PDU
+      if (!BER_DecodeIdentifier(curr, remaining, &type, &length, &content, &idLength) || (type != ASN_OCTET_STRING))
+         return false;
+      remaining -= length + idLength;
+      curr = content + length;
+      if (!BER_DecodeIdentifier(curr, remaining, &type, &length, &content, &idLength))
+         return false;
+      remaining = length;
+      curr = content;
+   }
+
+   if (!BER_DecodeIdentifier(curr, remaining, &type, &length, &content, &idLength) || (type != ASN_INTEGER))
+      return false;
+   return BER_DecodeContent(type, content, length, reinterpret_cast<BYTE*>(key));
+}
+
+/**
+ * Create shared socket for given address family
+ */
+static SOCKET CreateEngineSocket(int family)
+{
+   SOCKET s = CreateSocket(family, SOCK_DGRAM, 0);
+   if (s == INVALID_SOCKET)
+      return INVALID_SOCKET;
+
+   SockAddrBuffer localAddr;
+   memset(&localAddr, 0, sizeof(SockAddrBuffer));
+   if (family == AF_INET)
+   {
+      localAddr.sa4.sin_family = AF_INET;
+      localAddr.sa4.sin_addr.s_addr = htonl(INADDR_ANY);
+   }
+#ifdef WITH_IPV6
+   else
+   {
+      localAddr.sa6.sin6_family = AF_INET6;
+   }
+#endif
+   if (bind(s, (struct sockaddr *)&localAddr, SA_LEN((struct sockaddr *)&localAddr)) != 0)
+   {
+      closesocket(s);
+      return INVALID_SOCKET;
+   }
+
+   int bufferSize = ENGINE_SOCKET_BUFFER_SIZE;
+   setsockopt(s, SOL_SOCKET, SO_RCVBUF, (char *)&bufferSize, sizeof(int));
+   SetSocketNonBlocking(s);
+   return s;
+}
+
+/**
+ * Request engine constructor
+ */
+SNMP_RequestEngine::SNMP_RequestEngine() : m_mutex(MutexType::FAST), m_requests(Ownership::False)
+{
+   m_sockets[0] = INVALID_SOCKET;
+   m_sockets[1] = INVALID_SOCKET;
+   m_controlSockets[0] = INVALID_SOCKET;
+   m_controlSockets[1] = INVALID_SOCKET;
+   m_workerThread = INVALID_THREAD_HANDLE;
+   m_serial = 0;
+   m_running = false;
+   m_shutdown = false;
+   m_retransmissions = 0;
+   m_timeouts = 0;
+}
+
+/**
+ * Request engine destructor
+ */
+SNMP_RequestEngine::~SNMP_RequestEngine()
+{
+   shutdown();
+   for(int i = 0; i < 2; i++)
+   {
+      if (m_sockets[i] != INVALID_SOCKET)
+         closesocket(m_sockets[i]);
+      if (m_controlSockets[i] != INVALID_SOCKET)
+         closesocket(m_controlSockets[i]);
+   }
+}
+
+/**
+ * Start engine. Returns true on success.
+ */
+bool SNMP_RequestEngine::start()
+{
+   if (m_running || m_shutdown)
+      return m_running;
+
+   m_sockets[0] = CreateEngineSocket(AF_INET);
+#ifdef WITH_IPV6
+   m_sockets[1] = CreateEngineSocket(AF_INET6);
+#endif
+   if ((m_sockets[0] == INVALID_SOCKET) && (m_sockets[1] == INVALID_SOCKET))
+   {
+      nxlog_debug_tag(DEBUG_TAG, 1, _T("SNMP request engine: cannot create sockets"));
+      return false;
+   }
+
+#ifdef _WIN32
+   m_controlSockets[0] = CreateSocket(AF_INET, SOCK_DGRAM, 0);
+   m_controlSockets[1] = CreateSocket(AF_INET, SOCK_DGRAM, 0);
+   if ((m_controlSockets[0] != INVALID_SOCKET) && (m_controlSockets[1] != INVALID_SOCKET))
+   {
+      struct sockaddr_in servAddr;
+      memset(&servAddr, 0, sizeof(struct sockaddr_in));
+      servAddr.sin_family = AF_INET;
+      servAddr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+      servAddr.sin_port = 0;  // Dynamic port assignment
+      if (bind(m_controlSockets[0], (struct sockaddr *)&servAddr, sizeof(struct sockaddr_in)) == 0)
+      {
+         int len = sizeof(struct sockaddr_in);
+         if (getsockname(m_controlSockets[0], (struct sockaddr *)&servAddr, &len) == 0)
+            connect(m_controlSockets[1], (struct sockaddr *)&servAddr, sizeof(struct sockaddr_in));
+      }
+   }
+#else
+   if (pipe(m_controlSockets) != 0)
+   {
+      m_controlSockets[0] = INVALID_SOCKET;
+      m_controlSockets[1] = INVALID_SOCKET;
+   }
+#endif
+   if (m_controlSockets[0] == INVALID_SOCKET)
+   {
+      nxlog_debug_tag(DEBUG_TAG, 1, _T("SNMP request engine: cannot create control sockets"));
+      return false;
+   }
+
+   m_running = true;
+   m_workerThread = ThreadCreateEx(this, &SNMP_RequestEngine::workerThread);
+   nxlog_debug_tag(DEBUG_TAG, 2, _T("SNMP request engine started (IPv4 %s, IPv6 %s)"),
+            (m_sockets[0] != INVALID_SOCKET) ? _T("enabled") : _T("disabled"), (m_sockets[1] != INVALID_SOCKET) ? _T("enabled") : _T("disabled"));
+   return true;
+}
+
+/**
+ * Shutdown engine. All pending requests are completed with SNMP_ERR_ABORTED.
+ */
+void SNMP_RequestEngine::shutdown()
+{
+   m_mutex.lock();
+   if (m_shutdown)
+   {
+      m_mutex.unlock();
+      return;
+   }
+   m_shutdown = true;
+   m_mutex.unlock();
+
+   notifyWorkerThread();
+   ThreadJoin(m_workerThread);
+   m_workerThread = INVALID_THREAD_HANDLE;
+   m_running = false;
+
+   m_mutex.lock();
+   ObjectArray<SNMP_PendingRequest> requests(m_requests.size(), 16, Ownership::True);
+   m_requests.forEach(
+      [&requests] (const uint32_t& key, SNMP_PendingRequest *r) -> EnumerationCallbackResult
+      {
+         for(; r != nullptr; r = r->next)
+            requests.add(r);
+         return _CONTINUE;
+      });
+   m_requests.clear();
+   m_timers.clear();
+   m_mutex.unlock();
+
+   for(int i = 0; i < requests.size(); i++)
+   {
+      SNMP_PendingRequest *r = requests.get(i);
+      if (r->callback)
+         r->callback(SNMP_ERR_ABORTED, nullptr);
+   }
+   nxlog_debug_tag(DEBUG_TAG, 2, _T("SNMP request engine stopped"));
+}
+
+/**
+ * Wake up worker thread
+ */
+void SNMP_RequestEngine::notifyWorkerThread()
+{
+   if (m_controlSockets[1] != INVALID_SOCKET)
+   {
+      char data = 'W';
+#ifdef _WIN32
+      send(m_controlSockets[1], &data, 1, 0);
+#else
+      write(m_controlSockets[1], &data, 1);
+#endif
+   }
+}
+
+/**
+ * Send request to given address. Response is matched by request ID (or message ID for SNMPv3). Callback is called
+ * from engine's worker thread when response is received or request times out (after all retransmissions), so it
+ * should not block. Callback is not called if request cannot be sent. Security context is copied and original object
+ * is not used after this call. Requests with same ID can be sent to different peers. If serial is not null, serial number
+ * assigned to request is stored there (it should be passed to cancelRequest together with request ID).
+ * Returns number of bytes sent or -1 on error.
+ */
+int SNMP_RequestEngine::sendRequest(SNMP_PDU *request, const InetAddress& addr, uint16_t port, SNMP_SecurityContext *securityContext,
+         SNMP_ResponseCallback callback, uint32_t timeout, int numRetries, bool engineIdAutoupdate, uint64_t *serial)
+{
+   SockAddrBuffer sa;
+   if (addr.fillSockAddr(&sa, port) == nullptr)
+      return -1;
+   return sendRequest(request, reinterpret_cast<struct sockaddr*>(&sa), securityContext, callback, timeout, numRetries, engineIdAutoupdate, serial);
+}
+
+/**
+ * Send request to given address (see description of main variant)
+ */
+int SNMP_RequestEngine::sendRequest(SNMP_PDU *request, const struct sockaddr *addr, SNMP_SecurityContext *securityContext,
+         SNMP_ResponseCallback callback, uint32_t timeout, int numRetries, bool engineIdAutoupdate, uint64_t *serial)
+{
+   SOCKET s = (addr->sa_family == AF_INET) ? m_sockets[0] : m_sockets[1];
+   if (!m_running || (s == INVALID_SOCKET))
+      return -1;
+
+   SNMP_PendingRequest *r = new SNMP_PendingRequest();
+   r->securityContext = (securityContext != nullptr) ? new SNMP_SecurityContext(securityContext) : new SNMP_SecurityContext();
+   r->packetSize = request->encode(&r->packet, r->securityContext);
+   if (r->packetSize == 0)
+   {
+      r->packet = nullptr;
+      delete r;
+      return -1;
+   }
+
+   memcpy(&r->addr, addr, SA_LEN(addr));
+   r->socket = s;
+   r->key = (request->getVersion() == SNMP_VERSION_3) ? request->getMessageId() : request->getRequestId();
+   r->engineIdAutoupdate = engineIdAutoupdate;
+   r->timeout = (timeout != 0) ? timeout : SnmpGetDefaultTimeout();
+   r->retries = ((numRetries > 0) ? numRetries : SnmpGetDefaultRetryCount()) - 1;
+   r->callback = callback;
+   r->next = nullptr;
+
+   if (!callback)
+   {
+      // No response expected
+      int bytes = static_cast<int>(sendto(s, (char *)r->packet, (int)r->packetSize, 0, (struct sockaddr *)&r->addr, SA_LEN((struct sockaddr *)&r->addr)));
+      delete r;
+      return bytes;
+   }
+
+   m_mutex.lock();
+   if (m_shutdown)
+   {
+      m_mutex.unlock();
+      delete r;
+      return -1;
+   }
+
+   r->serial = ++m_serial;
+   LinkRequest(&m_requests, r);
+   int64_t due = GetCurrentTimeMs() + r->timeout;
+   bool wakeup = m_timers.empty() || (due < m_timers.front().due);
+   m_timers.push_back({ due, r->serial, r->key });
+   std::push_heap(m_timers.begin(), m_timers.end(), TimerHeapCompare);
+
+   // Send under lock so that response cannot be processed before request is registered and still valid
+   int bytes = static_cast<int>(sendto(s, (char *)r->packet, (int)r->packetSize, 0, (struct sockaddr *)&r->addr, SA_LEN((struct sockaddr *)&r->addr)));
+   if (bytes <= 0)
+   {
+      UnlinkRequest(&m_requests, r);   // Timer entry will be ignored
+      m_mutex.unlock();
+      delete r;
+      return -1;
+   }
+   if (serial != nullptr)
+      *serial = r->serial;
+   m_mutex.unlock();
+
+   if (wakeup)
+      notifyWorkerThread();
+   return bytes;
+}
+
+/**
+ * Cancel pending request identified by request ID (or message ID for SNMPv3) and serial number returned by sendRequest.
+ * Callback will not be called after this method returns, unless it is already running. Does nothing if request
+ * is already completed.
+ */
+void SNMP_RequestEngine::cancelRequest(uint32_t key, uint64_t serial)
+{
+   m_mutex.lock();
+   SNMP_PendingRequest *r = FindRequest(&m_requests, key, serial);
+   if (r != nullptr)
+      UnlinkRequest(&m_requests, r);
+   m_mutex.unlock();
+   delete r;
+}
+
+/**
+ * Get number of pending requests
+ */
+int SNMP_RequestEngine::getPendingRequestCount()
+{
+   int count = 0;
+   m_mutex.lock();
+   m_requests.forEach(
+      [&count] (const uint32_t& key, SNMP_PendingRequest *r) -> EnumerationCallbackResult
+      {
+         for(; r != nullptr; r = r->next)
+            count++;
+         return _CONTINUE;
+      });
+   m_mutex.unlock();
+   return count;
+}
+
+/**
+ * Process expired timers. Returns time in milliseconds until next timer.
+ */
+uint32_t SNMP_RequestEngine::processTimers(int64_t now, StructArray<SNMP_CompletedRequest> *completed)
+{
+   uint32_t waitTime = 1000;
+   m_mutex.lock();
+   while(!m_timers.empty())
+   {
+      const SNMP_RequestTimer& t = m_timers.front();
+      if (t.due > now)
+      {
+         waitTime = std::min(waitTime, static_cast<uint32_t>(t.due - now));
+         break;
+      }
+
+      uint32_t key = t.key;
+      uint64_t serial = t.serial;
+      std::pop_heap(m_timers.begin(), m_timers.end(), TimerHeapCompare);
+      m_timers.pop_back();
+
+      SNMP_PendingRequest *r = FindRequest(&m_requests, key, serial);
+      if (r == nullptr)
+         continue;   // Request already completed or cancelled
+
+      if (r->retries > 0)
+      {
+         r->retries--;
+         m_retransmissions++;
+         if (sendto(r->socket, (char *)r->packet, (int)r->packetSize, 0, (struct sockaddr *)&r->addr, SA_LEN((struct sockaddr *)&r->addr)) > 0)
+         {
+            m_timers.push_back({ now + r->timeout, serial, key });
+            std::push_heap(m_timers.begin(), m_timers.end(), TimerHeapCompare);
+         }
+         else
+         {
+            UnlinkRequest(&m_requests, r);
+            completed->add({ r, SNMP_ERR_COMM, nullptr });
+         }
+      }
+      else
+      {
+         m_timeouts++;
+         UnlinkRequest(&m_requests, r);
+         completed->add({ r, SNMP_ERR_TIMEOUT, nullptr });
+      }
+   }
+   m_mutex.unlock();
+   return waitTime;
+}
+
+/**
+ * Read and match all available responses from given socket
+ */
+void SNMP_RequestEngine::receiveResponses(SOCKET s, BYTE *buffer, StructArray<SNMP_CompletedRequest> *completed)
+{
+   for(int i = 0; i < MAX_DATAGRAMS_PER_WAKEUP; i++)
+   {
+      SockAddrBuffer sender;
+      socklen_t addrLen = sizeof(sender);
+      int bytes = static_cast<int>(recvfrom(s, (char *)buffer, SNMP_DEFAULT_MSG_MAX_SIZE, 0, (struct sockaddr *)&sender, &addrLen));
+      if (bytes <= 0)
+         break;   // No more data (or socket error)
+
+      uint32_t key;
+      if (!GetMessageKey(buffer, bytes, &key))
+         continue;
+
+      m_mutex.lock();
+      // Only IP address is checked because some devices respond from different port
+      SNMP_PendingRequest *r = m_requests.get(key);
+      while((r != nullptr) && !SocketAddressEquals((struct sockaddr *)&sender, (struct sockaddr *)&r->addr))
+         r = r->next;
+      if (r == nullptr)
+      {
+         m_mutex.unlock();
+         continue;
+      }
+      UnlinkRequest(&m_requests, r);
+      m_mutex.unlock();
+
+      SNMP_PDU *response = new SNMP_PDU();
+      if (response->parse(buffer, bytes, r->securityContext, r->engineIdAutoupdate))
+      {
+         completed->add({ r, SNMP_ERR_SUCCESS, response });
+      }
+      else
+      {
+         delete response;
+         completed->add({ r, SNMP_ERR_PARSE, nullptr });
+      }
+   }
+}
+
+/**
+ * Worker thread
+ */
+void SNMP_RequestEngine::workerThread()
+{
+   ThreadSetName("SNMPEngine");
+
+   BYTE *buffer = MemAllocArrayNoInit<BYTE>(SNMP_DEFAULT_MSG_MAX_SIZE);
+   StructArray<SNMP_CompletedRequest> completed(0, 256);
+   SocketPoller sp;
+   while(true)
+   {
+      uint32_t waitTime = processTimers(GetCurrentTimeMs(), &completed);
+
+      if (completed.isEmpty())
+      {
+         sp.reset();
+         sp.add(m_controlSockets[0]);
+         for(int i = 0; i < 2; i++)
+            if (m_sockets[i] != INVALID_SOCKET)
+               sp.add(m_sockets[i]);
+
+         int rc = sp.poll(waitTime);
+         if (m_shutdown)
+            break;
+         if (rc > 0)
+         {
+            if (sp.isSet(m_controlSockets[0]))
+            {
+               char data[64];
+#ifdef _WIN32
+               recv(m_controlSockets[0], data, sizeof(data), 0);
+#else
+               read(m_controlSockets[0], data, sizeof(data));
+#endif
+            }
+            for(int i = 0; i < 2; i++)
+               if ((m_sockets[i] != INVALID_SOCKET) && sp.isSet(m_sockets[i]))
+                  receiveResponses(m_sockets[i], buffer, &completed);
+         }
+      }
+
+      // Report results outside of lock
+      for(int i = 0; i < completed.size(); i++)
+      {
+         SNMP_CompletedRequest *c = completed.get(i);
+         c->request->callback(c->rcc, c->response);
+         delete c->request;
+      }
+      completed.clear();
+
+      if (m_shutdown)
+         break;
+   }
+   MemFree(buffer);
+}
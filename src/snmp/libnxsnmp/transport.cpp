@@ -78,6 +78,7 @@ SNMP_Transport::SNMP_Transport()
 	m_updatePeerOnRecv = false;
 	m_reliable = false;
 	m_snmpVersion = SNMP_VERSION_2C;
+   m_bulkMaxRepetitions = SnmpGetDefaultBulkMaxRepetitions();
 }
 
 /**
@@ -375,6 +376,38 @@ uint32_t SNMP_Transport::sendTrap(SNMP_PDU *trap, uint32_t timeout, int numRetri
    return (sendMessage(trap, timeout) > 0) ? SNMP_ERR_SUCCESS : SNMP_ERR_COMM;
 }
 
+/**
+ * Response slot for UDP transport working over request engine
+ */
+struct SNMP_EngineResponse
+{
+   Mutex mutex;
+   Condition condition;
+   uint64_t serial;         // Serial number of last sent request within this slot
+   uint64_t engineSerial;   // Serial number assigned to last sent request by engine
+   uint32_t key;            // Matching key of last sent request
+   bool pending;
+   bool completed;
+   uint32_t rcc;
+   SNMP_PDU *pdu;
+
+   SNMP_EngineResponse() : mutex(MutexType::FAST), condition(false)
+   {
+      serial = 0;
+      engineSerial = 0;
+      key = 0;
+      pending = false;
+      completed = false;
+      rcc = SNMP_ERR_SUCCESS;
+      pdu = nullptr;
+   }
+
+   ~SNMP_EngineResponse()
+   {
+      delete pdu;
+   }
+};
+
 /**
  * SNMP_UDPTransport default constructor
  */
@@ -387,6 +420,7 @@ SNMP_UDPTransport::SNMP_UDPTransport() : SNMP_Transport()
    m_dwBytesInBuffer = 0;
    m_pBuffer = (BYTE *)MemAlloc(m_dwBufferSize);
 	m_connected = false;
+   m_engine = nullptr;
 }
 
 /**
@@ -401,6 +435,7 @@ SNMP_UDPTransport::SNMP_UDPTransport(SOCKET hSocket) : SNMP_Transport()
    m_dwBytesInBuffer = 0;
    m_pBuffer = (BYTE *)MemAlloc(m_dwBufferSize);
 	m_connected = false;
+   m_engine = nullptr;
 }
 
 /**
@@ -422,6 +457,18 @@ uint32_t SNMP_UDPTransport::createUDPTransport(const InetAddress& hostAddr, uint
    m_port = port;
    hostAddr.fillSockAddr(&m_peerAddr, port);
 
+   // Use shared sockets of request engine if available
+   SNMP_RequestEngine *engine = SnmpGetDefaultRequestEngine();
+   if ((engine != nullptr) && engine->isRunning() && engine->isAddressFamilySupported(hostAddr.getFamily()))
+   {
+      m_engine = engine;
+      m_engineResponse = make_shared<SNMP_EngineResponse>();
+      MemFree(m_pBuffer);  // Receive buffer is not needed
+      m_pBuffer = nullptr;
+      m_connected = true;
+      return SNMP_ERR_SUCCESS;
+   }
+
    uint32_t result;
 
    // Create and connect socket
@@ -559,6 +606,9 @@ size_t SNMP_UDPTransport::preParsePDU()
 int SNMP_UDPTransport::readMessage(SNMP_PDU **pdu, uint32_t timeout, struct sockaddr *sender,
          socklen_t *addrSize, SNMP_SecurityContext* (*contextFinder)(struct sockaddr *, socklen_t))
 {
+   if (m_engine != nullptr)
+      return readMessageFromEngine(pdu, timeout);
+
    if (m_dwBytesInBuffer < 2)
    {
       int bytes = recvData(timeout, sender, addrSize);
@@ -622,6 +672,9 @@ int SNMP_UDPTransport::readMessage(SNMP_PDU **pdu, uint32_t timeout, struct sock
  */
 int SNMP_UDPTransport::sendMessage(SNMP_PDU *pdu, uint32_t timeout)
 {
+   if (m_engine != nullptr)
+      return sendMessageViaEngine(pdu, timeout);
+
    int bytes = 0;
    BYTE *buffer;
    size_t size = pdu->encode(&buffer, m_securityContext);
@@ -633,6 +686,94 @@ int SNMP_UDPTransport::sendMessage(SNMP_PDU *pdu, uint32_t timeout)
    return bytes;
 }
 
+/**
+ * Send PDU via request engine. Response (if expected) will be available to readMessageFromEngine().
+ */
+int SNMP_UDPTransport::sendMessageViaEngine(SNMP_PDU *pdu, uint32_t timeout)
+{
+   if ((pdu->getCommand() == SNMP_TRAP) || (pdu->getCommand() == SNMP_RESPONSE) || (pdu->getCommand() == SNMP_REPORT))
+      return m_engine->sendRequest(pdu, reinterpret_cast<struct sockaddr*>(&m_peerAddr), m_securityContext, nullptr);
+
+   shared_ptr<SNMP_EngineResponse> slot = m_engineResponse;
+   slot->mutex.lock();
+   if (slot->pending)
+      m_engine->cancelRequest(slot->key, slot->engineSerial);  // Previous request was abandoned by caller
+   uint64_t serial = ++slot->serial;
+   slot->key = (pdu->getVersion() == SNMP_VERSION_3) ? pdu->getMessageId() : pdu->getRequestId();
+   slot->pending = true;
+   slot->completed = false;
+   delete_and_null(slot->pdu);
+   slot->engineSerial = 0;
+   slot->condition.reset();
+   slot->mutex.unlock();
+
+   // Retransmissions are handled by caller
+   uint64_t engineSerial = 0;
+   int bytes = m_engine->sendRequest(pdu, reinterpret_cast<struct sockaddr*>(&m_peerAddr), m_securityContext,
+      [slot, serial] (uint32_t rcc, SNMP_PDU *response) -> void
+      {
+         slot->mutex.lock();
+         if (slot->serial == serial)
+         {
+            slot->pending = false;
+            slot->rcc = rcc;
+            slot->pdu = response;
+            slot->completed = true;
+            slot->condition.set();
+         }
+         else
+         {
+            delete response;  // Response to abandoned request
+         }
+         slot->mutex.unlock();
+      }, (timeout != INFINITE) ? timeout : SnmpGetDefaultTimeout(), 1, m_enableEngineIdAutoupdate, &engineSerial);
+
+   slot->mutex.lock();
+   if (slot->serial == serial)
+   {
+      if (bytes > 0)
+         slot->engineSerial = engineSerial;
+      else
+         slot->pending = false;
+   }
+   slot->mutex.unlock();
+   return bytes;
+}
+
+/**
+ * Wait for response to request sent via request engine
+ */
+int SNMP_UDPTransport::readMessageFromEngine(SNMP_PDU **pdu, uint32_t timeout)
+{
+   shared_ptr<SNMP_EngineResponse> slot = m_engineResponse;
+
+   // Engine will report timeout by itself, additional wait time is only safety measure
+   slot->condition.wait((timeout != INFINITE) ? timeout + 1000 : INFINITE);
+
+   slot->mutex.lock();
+   if (!slot->completed)
+   {
+      slot->mutex.unlock();
+      return 0;
+   }
+   slot->completed = false;
+   uint32_t rcc = slot->rcc;
+   *pdu = slot->pdu;
+   slot->pdu = nullptr;
+   slot->mutex.unlock();
+
+   if (rcc == SNMP_ERR_SUCCESS)
+   {
+      // Engine parses response using copy of security context, so update original one
+      if (m_enableEngineIdAutoupdate && (m_securityContext != nullptr) && ((*pdu)->getAuthoritativeEngine().getIdLen() > 0))
+         m_securityContext->setAuthoritativeEngine((*pdu)->getAuthoritativeEngine());
+      return 1;
+   }
+   if (rcc == SNMP_ERR_PARSE)
+      return 1;   // Caller will detect parse error by missing PDU
+   return (rcc == SNMP_ERR_TIMEOUT) ? 0 : -1;
+}
+
 /**
  * Get peer IPv4 address (in host byte order)
  */
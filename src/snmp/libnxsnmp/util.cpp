@@ -57,6 +57,28 @@ uint32_t LIBNXSNMP_EXPORTABLE SnmpGetDefaultTimeout()
    return s_snmpTimeout;
 }
 
+/**
+ * Default max repetitions for GETBULK requests in MIB walk (0 to use GETNEXT requests)
+ */
+static uint32_t s_bulkMaxRepetitions = 0;
+
+/**
+ * Set default max repetitions for GETBULK requests in MIB walk
+ */
+void LIBNXSNMP_EXPORTABLE SnmpSetDefaultBulkMaxRepetitions(uint32_t maxRepetitions)
+{
+   s_bulkMaxRepetitions = maxRepetitions;
+   nxlog_debug_tag(LIBNXSNMP_DEBUG_TAG, 4, _T("SNMP default max repetitions for bulk requests set to %u"), s_bulkMaxRepetitions);
+}
+
+/**
+ * Get default max repetitions for GETBULK requests in MIB walk
+ */
+uint32_t LIBNXSNMP_EXPORTABLE SnmpGetDefaultBulkMaxRepetitions()
+{
+   return s_bulkMaxRepetitions;
+}
+
 /**
  * Get value for SNMP variable
  * If szOidStr is not NULL, string representation of OID is used, otherwise -
@@ -319,9 +341,13 @@ uint32_t LIBNXSNMP_EXPORTABLE SnmpWalk(SNMP_Transport *transport, const uint32_t
    memcpy(pdwName, rootOid, rootOidLen * sizeof(UINT32));
    size_t nameLength = rootOidLen;
 
+   // Use GETBULK requests for SNMPv2c and SNMPv3 unless disabled for this transport
+   uint32_t maxRepetitions = (transport->getSnmpVersion() != SNMP_VERSION_1) ? transport->getBulkMaxRepetitions() : 0;
+
    // Walk the MIB
    uint32_t result;
    bool running = true;
+   bool timeoutRetryDone = false;
    uint32_t firstObjectName[MAX_OID_LEN];
    size_t firstObjectNameLen = 0;
    while(running)
@@ -332,54 +358,90 @@ uint32_t LIBNXSNMP_EXPORTABLE SnmpWalk(SNMP_Transport *transport, const uint32_t
          break;
       }
 
-      SNMP_PDU requestPDU(SNMP_GET_NEXT_REQUEST, static_cast<uint32_t>(InterlockedIncrement(&s_requestId)) & 0x7FFFFFFF, transport->getSnmpVersion());
+      SNMP_PDU requestPDU((maxRepetitions > 0) ? SNMP_GET_BULK_REQUEST : SNMP_GET_NEXT_REQUEST, static_cast<uint32_t>(InterlockedIncrement(&s_requestId)) & 0x7FFFFFFF, transport->getSnmpVersion());
+      if (maxRepetitions > 0)
+         requestPDU.setBulkParameters(0, maxRepetitions);
       requestPDU.bindVariable(new SNMP_Variable(pdwName, nameLength));
       SNMP_PDU *responsePDU;
       result = transport->doRequest(&requestPDU, &responsePDU);
 
+      if (maxRepetitions > 0)
+      {
+         // Reduce number of repetitions if response is too big or lost (possibly because of fragmentation),
+         // and fall back to GETNEXT requests if agent cannot handle GETBULK requests at all.
+         // Timeout on first request most likely means that agent is unreachable, so walk fails immediately,
+         // and request that timed out in the middle of the walk is retried only once with reduced number of repetitions.
+         uint32_t newMaxRepetitions = maxRepetitions;
+         if (result == SNMP_ERR_SUCCESS)
+         {
+            if (responsePDU->getErrorCode() == SNMP_PDU_ERR_TOO_BIG)
+               newMaxRepetitions = maxRepetitions / 2;
+            else if ((responsePDU->getErrorCode() != SNMP_PDU_ERR_SUCCESS) || (responsePDU->getNumVariables() == 0))
+               newMaxRepetitions = 0;
+         }
+         else if ((result == SNMP_ERR_TIMEOUT) && (firstObjectNameLen > 0) && !timeoutRetryDone)
+         {
+            newMaxRepetitions = maxRepetitions / 2;
+            timeoutRetryDone = true;
+         }
+
+         if (newMaxRepetitions != maxRepetitions)
+         {
+            if (result == SNMP_ERR_SUCCESS)
+               delete responsePDU;
+            nxlog_debug_tag(LIBNXSNMP_DEBUG_TAG, 6, _T("SnmpWalk: bulk request failed (result=%u), max repetitions changed from %u to %u"), result, maxRepetitions, newMaxRepetitions);
+            maxRepetitions = newMaxRepetitions;
+            transport->setBulkMaxRepetitions(maxRepetitions);  // Subsequent walks over same transport will start with reduced value
+            continue;
+         }
+      }
+
       // Analyze response
       if (result == SNMP_ERR_SUCCESS)
       {
          if ((responsePDU->getNumVariables() > 0) &&
              (responsePDU->getErrorCode() == SNMP_PDU_ERR_SUCCESS))
          {
-            SNMP_Variable *var = responsePDU->getVariable(0);
-
-            if ((var->getType() != ASN_NO_SUCH_OBJECT) &&
-                (var->getType() != ASN_NO_SUCH_INSTANCE) &&
-                (var->getType() != ASN_END_OF_MIBVIEW))
+            for(int i = 0; (i < responsePDU->getNumVariables()) && running; i++)
             {
-               // Should we stop walking?
-               // Some buggy SNMP agents may return first value after last one
-               // (Toshiba Strata CTX do that for example), so last check is here
-               if ((var->getName().length() < rootOidLen) ||
-                   (memcmp(rootOid, var->getName().value(), rootOidLen * sizeof(UINT32))) ||
-                   (var->getName().compare(pdwName, nameLength) == OID_EQUAL) ||
-                   (var->getName().compare(firstObjectName, firstObjectNameLen) == OID_EQUAL))
-               {
-                  delete responsePDU;
-                  break;
-               }
-               nameLength = var->getName().length();
-               memcpy(pdwName, var->getName().value(), nameLength * sizeof(UINT32));
-               if (firstObjectNameLen == 0)
+               SNMP_Variable *var = responsePDU->getVariable(i);
+
+               if ((var->getType() != ASN_NO_SUCH_OBJECT) &&
+                   (var->getType() != ASN_NO_SUCH_INSTANCE) &&
+                   (var->getType() != ASN_END_OF_MIBVIEW))
                {
-                  firstObjectNameLen = nameLength;
-                  memcpy(firstObjectName, pdwName, nameLength * sizeof(UINT32));
-               }
+                  // Should we stop walking?
+                  // Some buggy SNMP agents may return first value after last one
+                  // (Toshiba Strata CTX do that for example), so last check is here
+                  if ((var->getName().length() < rootOidLen) ||
+                      (memcmp(rootOid, var->getName().value(), rootOidLen * sizeof(UINT32))) ||
+                      (var->getName().compare(pdwName, nameLength) == OID_EQUAL) ||
+                      (var->getName().compare(firstObjectName, firstObjectNameLen) == OID_EQUAL))
+                  {
+                     running = false;
+                     break;
+                  }
+                  nameLength = var->getName().length();
+                  memcpy(pdwName, var->getName().value(), nameLength * sizeof(UINT32));
+                  if (firstObjectNameLen == 0)
+                  {
+                     firstObjectNameLen = nameLength;
+                     memcpy(firstObjectName, pdwName, nameLength * sizeof(UINT32));
+                  }
 
-               // Call user's callback function for processing
-               result = handler(var);
-               if (result != SNMP_ERR_SUCCESS)
+                  // Call user's callback function for processing
+                  result = handler(var);
+                  if (result != SNMP_ERR_SUCCESS)
+                  {
+                     running = false;
+                  }
+               }
+               else
                {
+                  // Consider no object/no instance as end of walk signal instead of failure
                   running = false;
                }
             }
-            else
-            {
-               // Consider no object/no instance as end of walk signal instead of failure
-               running = false;
-            }
          }
          else
          {
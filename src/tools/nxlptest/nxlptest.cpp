@@ -40,6 +40,7 @@ static TCHAR m_helpText[] =
    _T("Usage:\n")
    _T("   nxlptest [options] parser\n\n")
    _T("Where valid options are:\n")
+   _T("   -b passes  : Benchmark mode - match all lines from input file given number of times with and without rule prefilter\n")
    _T("   -D level   : Set debug level\n")
    _T("   -f file    : Input file (overrides parser settings)\n")
    _T("   -h         : Show this help\n")
@@ -70,6 +71,49 @@ static void ParserThread(LogParser *parser, off_t startOffset)
 	parser->monitorFile(startOffset);
 }
 
+/**
+ * Match all lines from input file against parser rules given number of times and show elapsed time
+ */
+static int RunBenchmark(LogParser *parser, int passes)
+{
+   FILE *f = _tfopen(parser->getFileName(), _T("r"));
+   if (f == nullptr)
+   {
+      _tprintf(_T("ERROR: cannot open input file %s (%s)\n"), parser->getFileName(), _tcserror(errno));
+      return 2;
+   }
+
+   StringList lines;
+   char buffer[8192];
+   while(fgets(buffer, sizeof(buffer), f) != nullptr)
+   {
+      char *eol = strpbrk(buffer, "\r\n");
+      if (eol != nullptr)
+         *eol = 0;
+      lines.addMBString(buffer);
+   }
+   fclose(f);
+
+   _tprintf(_T("Benchmark started\nFile: %s\nLines: %d\nPasses: %d\n\n"), parser->getFileName(), lines.size(), passes);
+   for(int mode = 0; mode < 2; mode++)
+   {
+      parser->setPrefilterEnabled(mode == 1);
+      int matchedBefore = parser->getMatchedRecordsCount();
+      int64_t startTime = GetCurrentTimeMs();
+      for(int p = 0; p < passes; p++)
+      {
+         for(int i = 0; i < lines.size(); i++)
+            parser->matchLine(lines.get(i), parser->getFileName());
+      }
+      int64_t elapsed = GetCurrentTimeMs() - startTime;
+      int64_t total = static_cast<int64_t>(lines.size()) * passes;
+      _tprintf(_T("Prefilter %-8s: %6d matched, ") INT64_FMT _T(" ms, ") INT64_FMT _T(" lines/sec\n"),
+            (mode == 1) ? _T("enabled") : _T("disabled"), parser->getMatchedRecordsCount() - matchedBefore, elapsed,
+            (elapsed > 0) ? total * 1000 / elapsed : total);
+   }
+   return 0;
+}
+
 #ifndef _WIN32
 
 bool s_stop = false;
@@ -81,6 +125,37 @@ static void OnBreak(int sig)
 
 #endif
 
+/**
+ * Monitor file until stopped by user
+ */
+static void MonitorFile(LogParser *parser, off_t startOffset)
+{
+   THREAD thread = ThreadCreateEx(ParserThread, parser, startOffset);
+#ifdef _WIN32
+   _tprintf(_T("Parser started. Press ESC to stop.\nFile: %s\nDebug level: %d\n\n"), parser->getFileName(), nxlog_get_debug_level());
+   while(1)
+   {
+      int ch = _getch();
+      if (ch == 27)
+         break;
+   }
+#else
+   _tprintf(_T("Parser started. Press Ctrl+C to stop.\nFile: %s\nDebug level: %d\n\n"), parser->getFileName(), nxlog_get_debug_level());
+
+   signal(SIGINT, OnBreak);
+
+   sigset_t signals;
+   sigemptyset(&signals);
+   sigaddset(&signals, SIGINT);
+   pthread_sigmask(SIG_UNBLOCK, &signals, NULL);
+
+   while(!s_stop)
+      ThreadSleepMs(500);
+#endif
+   parser->stop();
+   ThreadJoin(thread);
+}
+
 /**
  * main()
  */
@@ -89,6 +164,7 @@ int main(int argc, char *argv[])
 	int rc = 0;
 	TCHAR *inputFile = nullptr;
    off_t startOffset = -1;
+   int benchmarkPasses = 0;
 #ifdef _WIN32
    bool vssSnapshots = false;
 #endif
@@ -98,10 +174,15 @@ int main(int argc, char *argv[])
    // Parse command line
    opterr = 1;
    int ch;
-   while((ch = getopt(argc, argv, "D:f:hio:sv")) != -1)
+   while((ch = getopt(argc, argv, "b:D:f:hio:sv")) != -1)
    {
       switch(ch)
       {
+         case 'b':
+            benchmarkPasses = strtol(optarg, nullptr, 0);
+            if (benchmarkPasses < 1)
+               benchmarkPasses = 1;
+            break;
          case 'D':
             nxlog_set_debug_level(strtol(optarg, nullptr, 0));
             break;
@@ -173,30 +254,10 @@ int main(int argc, char *argv[])
             parser->setSnapshotMode(true);
 #endif
 
-			THREAD thread = ThreadCreateEx(ParserThread, parser, startOffset);
-#ifdef _WIN32
-			_tprintf(_T("Parser started. Press ESC to stop.\nFile: %s\nDebug level: %d\n\n"), parser->getFileName(), nxlog_get_debug_level());
-			while(1)
-			{
-				ch = _getch();
-				if (ch == 27)
-					break;
-			}
-#else
-			_tprintf(_T("Parser started. Press Ctrl+C to stop.\nFile: %s\nDebug level: %d\n\n"), parser->getFileName(), nxlog_get_debug_level());
-
-         signal(SIGINT, OnBreak);
-
-         sigset_t signals;
-         sigemptyset(&signals);
-         sigaddset(&signals, SIGINT);
-         pthread_sigmask(SIG_UNBLOCK, &signals, NULL);
-
-			while(!s_stop)
-            ThreadSleepMs(500);
-#endif
-         parser->stop();
-         ThreadJoin(thread);
+         if (benchmarkPasses > 0)
+            rc = RunBenchmark(parser, benchmarkPasses);
+         else
+            MonitorFile(parser, startOffset);
          delete parser;
 		}
 		else
@@ -0,0 +1,202 @@
+#include <nms_common.h>
+#include <nms_util.h>
+#include <testtools.h>
+
+#ifndef _WIN32
+
+#include <sys/resource.h>
+
+/**
+ * Number of socket pairs for background socket poller stress test
+ */
+const int STRESS_TEST_SOCKET_PAIRS = 50000;
+
+/**
+ * Poll results
+ */
+static VolatileCounter s_pollSuccess = 0;
+static VolatileCounter s_pollTimeout = 0;
+static VolatileCounter s_pollCancelled = 0;
+static VolatileCounter s_pollShutdown = 0;
+static VolatileCounter s_pollFailure = 0;
+
+/**
+ * Poll callback
+ */
+static void PollCallback(BackgroundSocketPollResult result, SOCKET s, void *context)
+{
+   switch(result)
+   {
+      case BackgroundSocketPollResult::SUCCESS:
+         InterlockedIncrement(&s_pollSuccess);
+         break;
+      case BackgroundSocketPollResult::TIMEOUT:
+         InterlockedIncrement(&s_pollTimeout);
+         break;
+      case BackgroundSocketPollResult::CANCELLED:
+         InterlockedIncrement(&s_pollCancelled);
+         break;
+      case BackgroundSocketPollResult::SHUTDOWN:
+         InterlockedIncrement(&s_pollShutdown);
+         break;
+      default:
+         InterlockedIncrement(&s_pollFailure);
+         break;
+   }
+}
+
+/**
+ * Wait until given counter reaches expected value
+ */
+static void WaitForCounter(VolatileCounter *counter, int expected, uint32_t timeout)
+{
+   int64_t startTime = GetCurrentTimeMs();
+   while((*counter < expected) && (GetCurrentTimeMs() - startTime < timeout))
+      ThreadSleepMs(10);
+}
+
+/**
+ * Callback for failure test - records thread ID of the caller
+ */
+static void FailureTestCallback(BackgroundSocketPollResult result, SOCKET s, uint32_t *threadId)
+{
+   *threadId = GetCurrentThreadId();
+   PollCallback(result, s, nullptr);
+}
+
+/**
+ * Test background socket poller
+ */
+void TestBackgroundSocketPoller()
+{
+   StartTest(_T("Background socket poller - stress"));
+
+   // Each socket pair uses two descriptors, so try to raise descriptor limit
+   struct rlimit rl;
+   getrlimit(RLIMIT_NOFILE, &rl);
+   rlim_t required = STRESS_TEST_SOCKET_PAIRS * 2 + 256;
+   if (rl.rlim_cur < required)
+   {
+      rl.rlim_cur = std::min(required, rl.rlim_max);
+      setrlimit(RLIMIT_NOFILE, &rl);
+      getrlimit(RLIMIT_NOFILE, &rl);
+   }
+   int pairs = static_cast<int>(std::min(static_cast<rlim_t>(STRESS_TEST_SOCKET_PAIRS), (rl.rlim_cur - 256) / 2));
+   AssertTrue(pairs > 0);
+
+   SOCKET *sockets = MemAllocArray<SOCKET>(pairs * 2);
+   for(int i = 0; i < pairs; i++)
+      AssertEquals(socketpair(AF_UNIX, SOCK_STREAM, 0, &sockets[i * 2]), 0);
+
+   int socketsPerPoller = BACKGROUND_SOCKET_POLLER_MAX_SOCKETS - 1;
+   int pollerCount = (pairs + socketsPerPoller - 1) / socketsPerPoller;
+   BackgroundSocketPoller *pollers = new BackgroundSocketPoller[pollerCount];
+   for(int i = 0; i < pollerCount; i++)
+      AssertTrue(pollers[i].isValid());
+
+   int64_t startTime = GetCurrentTimeMs();
+
+   // Sockets with even index will become readable, sockets with odd index should time out
+   for(int i = 0; i < pairs; i++)
+      pollers[i / socketsPerPoller].poll(sockets[i * 2], ((i % 2) == 0) ? 60000 : 1000, PollCallback, nullptr);
+   for(int i = 0; i < pairs; i += 2)
+      AssertEquals(write(sockets[i * 2 + 1], "X", 1), static_cast<ssize_t>(1));
+   WaitForCounter(&s_pollSuccess, (pairs + 1) / 2, 60000);
+   WaitForCounter(&s_pollTimeout, pairs / 2, 60000);
+   AssertEquals(static_cast<int>(s_pollSuccess), (pairs + 1) / 2);
+   AssertEquals(static_cast<int>(s_pollTimeout), pairs / 2);
+
+   // Cancel requests for sockets without data
+   for(int i = 1; i < pairs; i += 2)
+      pollers[i / socketsPerPoller].poll(sockets[i * 2], 60000, PollCallback, nullptr);
+   for(int i = 1; i < pairs; i += 2)
+      pollers[i / socketsPerPoller].cancel(sockets[i * 2]);
+   WaitForCounter(&s_pollCancelled, pairs / 2, 60000);
+   AssertEquals(static_cast<int>(s_pollCancelled), pairs / 2);
+
+   int64_t elapsed = GetCurrentTimeMs() - startTime;
+
+   // Outstanding requests should be completed on poller destruction
+   for(int i = 1; i < pairs; i += 2)
+      pollers[i / socketsPerPoller].poll(sockets[i * 2], 60000, PollCallback, nullptr);
+   delete[] pollers;
+   AssertEquals(static_cast<int>(s_pollShutdown), pairs / 2);
+   AssertEquals(static_cast<int>(s_pollSuccess), (pairs + 1) / 2);
+   AssertEquals(static_cast<int>(s_pollFailure), 0);
+
+   for(int i = 0; i < pairs * 2; i++)
+      closesocket(sockets[i]);
+   MemFree(sockets);
+
+   EndTest(elapsed);
+
+   StartTest(_T("Background socket poller - failures"));
+   BackgroundSocketPoller poller;
+   AssertTrue(poller.isValid());
+   s_pollFailure = 0;
+   s_pollTimeout = 0;
+
+   // Failure for descriptor that cannot be polled should be reported from worker thread
+   SOCKET pair[2];
+   AssertEquals(socketpair(AF_UNIX, SOCK_STREAM, 0, pair), 0);
+   closesocket(pair[0]);
+   closesocket(pair[1]);
+   uint32_t callbackThreadId = 0;
+   poller.poll(pair[0], 500, FailureTestCallback, &callbackThreadId);
+   WaitForCounter(&s_pollFailure, 1, 5000);
+   AssertEquals(static_cast<int>(s_pollFailure), 1);
+   AssertTrue(callbackThreadId != GetCurrentThreadId());
+
+   // Socket closed while being polled should be reported as failure and not as timeout
+   AssertEquals(socketpair(AF_UNIX, SOCK_STREAM, 0, pair), 0);
+   poller.poll(pair[0], 500, PollCallback, nullptr);
+   closesocket(pair[0]);
+   WaitForCounter(&s_pollFailure, 2, 5000);
+   AssertEquals(static_cast<int>(s_pollFailure), 2);
+   AssertEquals(static_cast<int>(s_pollTimeout), 0);
+   closesocket(pair[1]);
+
+   EndTest();
+
+   StartTest(_T("Background socket poller - stale events"));
+   s_pollSuccess = 0;
+   s_pollTimeout = 0;
+   s_pollCancelled = 0;
+   s_pollFailure = 0;
+
+   // Old socket is kept open by duplicate descriptor after its original descriptor is closed,
+   // so it may stay registered for polling after request is cancelled
+   SOCKET oldPair[2];
+   AssertEquals(socketpair(AF_UNIX, SOCK_STREAM, 0, oldPair), 0);
+   SOCKET oldDup = dup(oldPair[0]);
+   AssertTrue(oldDup != INVALID_SOCKET);
+   poller.poll(oldPair[0], 60000, PollCallback, nullptr);
+   closesocket(oldPair[0]);
+   poller.cancel(oldPair[0]);
+   WaitForCounter(&s_pollCancelled, 1, 5000);
+   AssertEquals(static_cast<int>(s_pollCancelled), 1);
+
+   // New socket with same descriptor number should not be reported as ready when old socket becomes readable
+   SOCKET newPair[2];
+   AssertEquals(socketpair(AF_UNIX, SOCK_STREAM, 0, newPair), 0);
+   if (newPair[0] != oldPair[0])   // Descriptor number is most likely already reused by socketpair()
+   {
+      AssertEquals(dup2(newPair[0], oldPair[0]), oldPair[0]);
+      closesocket(newPair[0]);
+   }
+   poller.poll(oldPair[0], 500, PollCallback, nullptr);
+   AssertEquals(write(oldPair[1], "X", 1), static_cast<ssize_t>(1));
+   WaitForCounter(&s_pollTimeout, 1, 5000);
+   AssertEquals(static_cast<int>(s_pollTimeout), 1);
+   AssertEquals(static_cast<int>(s_pollSuccess), 0);
+   AssertEquals(static_cast<int>(s_pollFailure), 0);
+
+   closesocket(oldPair[0]);
+   closesocket(oldPair[1]);
+   closesocket(oldDup);
+   closesocket(newPair[1]);
+
+   EndTest();
+}
+
+#endif
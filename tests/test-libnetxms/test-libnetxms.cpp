@@ -16,6 +16,8 @@ void TestMemoryPool();
 void TestObjectMemoryPool();
 void TestThreadPool();
 void TestThreadPoolDelayedExecution();
+void TestThreadPoolThroughput();
+void TestBackgroundSocketPoller();
 void TestQueue();
 void TestSharedObjectQueue();
 void TestMsgWaitQueue();
@@ -2978,6 +2980,10 @@ int main(int argc, char *argv[])
    TestThreadPool();
    TestThreadPoolDelayedExecution();
    TestThreadCountAndMaxWaitTime();
+   TestThreadPoolThroughput();
+#ifndef _WIN32
+   TestBackgroundSocketPoller();
+#endif
 
    InitiateProcessShutdown();
 
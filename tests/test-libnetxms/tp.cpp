@@ -193,4 +193,127 @@ void TestThreadCountAndMaxWaitTime()
 
    ThreadPoolDestroy(threadPool);
    EndTest();
+
+   StartTest(_T("Thread pool - serialized count and max wait time (integer keys)"));
+   threadPool = ThreadPoolCreate(_T("MAIN"), 8, 256);
+
+   s_waitTimeTestLock1.lock();
+   s_waitTimeTestLock2.lock();
+
+   ThreadPoolExecuteSerialized(threadPool, static_cast<uint64_t>(1), CountAndMaxWaitThread, &s_waitTimeTestLock1);
+   ThreadPoolExecuteSerialized(threadPool, static_cast<uint64_t>(2), CountAndMaxWaitThread, &s_waitTimeTestLock1);
+   ThreadPoolExecuteSerialized(threadPool, static_cast<uint64_t>(1), CountAndMaxWaitThread, &s_waitTimeTestLock1);
+   ThreadPoolExecuteSerialized(threadPool, static_cast<uint64_t>(1), CountAndMaxWaitThread, &s_waitTimeTestLock2);
+
+   ThreadSleepMs(100);  // yield CPU
+
+   AssertEquals(ThreadPoolGetSerializedRequestCount(threadPool, static_cast<uint64_t>(1)), 2);
+   AssertEquals(ThreadPoolGetSerializedRequestCount(threadPool, static_cast<uint64_t>(2)), 0);
+   AssertEquals(ThreadPoolGetSerializedRequestCount(threadPool, static_cast<uint64_t>(3)), 0);
+
+   s_waitTimeTestLock1.unlock();
+   ThreadSleepMs(100);
+   AssertTrue(ThreadPoolGetSerializedRequestMaxWaitTime(threadPool, static_cast<uint64_t>(1)) >= 140);
+
+   s_waitTimeTestLock2.unlock();
+   ThreadSleepMs(200);
+   AssertEquals(ThreadPoolGetSerializedRequestCount(threadPool, static_cast<uint64_t>(1)), 0);
+   AssertEquals(ThreadPoolGetSerializedRequestCount(threadPool, static_cast<uint64_t>(2)), 0);
+   AssertEquals(ThreadPoolGetSerializedRequestMaxWaitTime(threadPool, static_cast<uint64_t>(1)), static_cast<uint32_t>(0));
+
+   ThreadPoolDestroy(threadPool);
+   EndTest();
+}
+
+static VolatileCounter64 s_throughputTestCounter;
+
+const int THROUGHPUT_TEST_ROOT_TASKS = 1000;
+const int THROUGHPUT_TEST_CHILD_TASKS = 100;
+const int64_t THROUGHPUT_TEST_TOTAL_TASKS = THROUGHPUT_TEST_ROOT_TASKS * (THROUGHPUT_TEST_CHILD_TASKS + 1);
+
+static void ThroughputChildTask(ThreadPool *p)
+{
+   InterlockedIncrement64(&s_throughputTestCounter);
+}
+
+static void ThroughputRootTask(ThreadPool *p)
+{
+   for(int i = 0; i < THROUGHPUT_TEST_CHILD_TASKS; i++)
+      ThreadPoolExecute(p, ThroughputChildTask, p);
+   InterlockedIncrement64(&s_throughputTestCounter);
+}
+
+static void TestThreadPoolThroughput(int threads, uint32_t flags)
+{
+   TCHAR name[128];
+   _sntprintf(name, 128, _T("Thread pool - throughput, %d threads (%s)"), threads, (flags & THREAD_POOL_WORK_STEALING) ? _T("work stealing") : _T("shared queue"));
+   StartTest(name);
+
+   ThreadPool *p = ThreadPoolCreate(_T("BENCH"), threads, threads, 0, flags);
+   s_throughputTestCounter = 0;
+   int64_t startTime = GetCurrentTimeMs();
+   for(int i = 0; i < THROUGHPUT_TEST_ROOT_TASKS; i++)
+      ThreadPoolExecute(p, ThroughputRootTask, p);
+   while(s_throughputTestCounter < THROUGHPUT_TEST_TOTAL_TASKS)
+      ThreadSleepMs(1);
+   int64_t elapsed = GetCurrentTimeMs() - startTime;
+
+   ThreadPoolInfo info;
+   ThreadPoolGetInfo(p, &info);
+   AssertEquals(info.totalRequests, static_cast<uint64_t>(THROUGHPUT_TEST_TOTAL_TASKS));
+   ThreadPoolDestroy(p);
+   AssertEquals(static_cast<int64_t>(s_throughputTestCounter), THROUGHPUT_TEST_TOTAL_TASKS);
+
+   EndTest(elapsed);
+}
+
+static VolatileCounter s_burstTestCounter;
+
+const int BURST_TEST_THREADS = 8;
+
+static void BurstChildTask(ThreadPool *p)
+{
+   ThreadSleepMs(200);
+   InterlockedIncrement(&s_burstTestCounter);
+}
+
+static void BurstRootTask(ThreadPool *p)
+{
+   for(int i = 0; i < BURST_TEST_THREADS - 1; i++)
+      ThreadPoolExecute(p, BurstChildTask, p);
+   ThreadSleepMs(200);
+   InterlockedIncrement(&s_burstTestCounter);
+}
+
+/**
+ * Burst of requests pushed to worker's local deque should wake all idle workers
+ */
+static void TestThreadPoolBurstWakeup()
+{
+   StartTest(_T("Thread pool - burst wakeup (work stealing)"));
+
+   ThreadPool *p = ThreadPoolCreate(_T("BURST"), BURST_TEST_THREADS, BURST_TEST_THREADS, 0, THREAD_POOL_WORK_STEALING);
+   ThreadSleepMs(100);  // Let all workers become idle
+   s_burstTestCounter = 0;
+   int64_t startTime = GetCurrentTimeMs();
+   ThreadPoolExecute(p, BurstRootTask, p);
+   while((s_burstTestCounter < BURST_TEST_THREADS) && (GetCurrentTimeMs() - startTime < 5000))
+      ThreadSleepMs(1);
+   int64_t elapsed = GetCurrentTimeMs() - startTime;
+   ThreadPoolDestroy(p);
+
+   AssertEquals(static_cast<int>(s_burstTestCounter), BURST_TEST_THREADS);
+   AssertTrue(elapsed < 600);   // All requests should run in parallel (sequential execution takes at least 1600 ms)
+   EndTest(elapsed);
+}
+
+void TestThreadPoolThroughput()
+{
+   static const int threadCounts[] = { 1, 8, 64, 256 };
+   for(int i = 0; i < 4; i++)
+   {
+      TestThreadPoolThroughput(threadCounts[i], 0);
+      TestThreadPoolThroughput(threadCounts[i], THREAD_POOL_WORK_STEALING);
+   }
+   TestThreadPoolBurstWakeup();
 }
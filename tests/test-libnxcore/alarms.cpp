@@ -0,0 +1,178 @@
+#include <nms_core.h>
+#include <nms_alarm.h>
+#include <testtools.h>
+
+/**
+ * Number of different source objects for test alarms
+ */
+#define SOURCE_OBJECT_COUNT   1000
+
+/**
+ * Create test alarm
+ */
+static Alarm *CreateTestAlarm(uint32_t sourceObject, int seq)
+{
+   json_t *json = json_pack("{s:I, s:I, s:i, s:s, s:I, s:i, s:i, s:i, s:i, s:s, s:o}",
+            "id", static_cast<json_int_t>(seq), "rootId", static_cast<json_int_t>(0), "code", 1, "name", "SYS_TEST",
+            "timestamp", static_cast<json_int_t>(time(nullptr)), "source", static_cast<int>(sourceObject), "zone", 0, "dci", 0,
+            "severity", SEVERITY_MINOR, "message", "Test alarm", "tags", json_array());
+   Event *event = Event::createFromJson(json);
+   json_decref(json);
+
+   TCHAR key[64];
+   _sntprintf(key, 64, _T("TEST_%d"), seq);
+   IntegerArray<uint32_t> categories;
+   Alarm *alarm = new Alarm(event, 0, nullptr, uuid(), _T(""), _T("Test alarm"), key, _T(""), SEVERITY_MINOR + (seq % 3), 0, 0, 0, categories);
+   delete event;
+   return alarm;
+}
+
+/**
+ * Check that alarms in list are in order of creation
+ */
+static bool IsListOrdered(AlarmList *list)
+{
+   uint32_t lastId = 0;
+   for(int i = 0; i < list->size(); i++)
+   {
+      Alarm *alarm = list->get(i);
+      if (alarm == nullptr)
+         continue;
+      if (alarm->getAlarmId() <= lastId)
+         return false;
+      lastId = alarm->getAlarmId();
+   }
+   return true;
+}
+
+/**
+ * Alarm list benchmark
+ */
+static void BenchmarkAlarmList(int count)
+{
+   TCHAR name[128];
+   AlarmList *list = new AlarmList();
+   uint32_t *ids = MemAllocArrayNoInit<uint32_t>(count);
+
+   _sntprintf(name, 128, _T("Alarm list: add %d alarms"), count);
+   StartTest(name);
+   int64_t start = GetCurrentTimeMs();
+   list->writeLock();
+   for(int i = 0; i < count; i++)
+   {
+      Alarm *alarm = CreateTestAlarm(1000 + i % SOURCE_OBJECT_COUNT, i);
+      ids[i] = alarm->getAlarmId();
+      list->add(alarm);
+   }
+   list->unlock();
+   AssertEquals(list->count(), count);
+   EndTest(GetCurrentTimeMs() - start);
+
+   _sntprintf(name, 128, _T("Alarm list: find %d alarms by ID and key"), count);
+   StartTest(name);
+   start = GetCurrentTimeMs();
+   list->readLock();
+   for(int i = 0; i < count; i++)
+   {
+      Alarm *alarm = list->find(ids[i]);
+      AssertNotNull(alarm);
+      TCHAR key[64];
+      _sntprintf(key, 64, _T("TEST_%d"), i);
+      AssertTrue(list->find(key) == alarm);
+   }
+   list->unlock();
+   EndTest(GetCurrentTimeMs() - start);
+
+   _sntprintf(name, 128, _T("Alarm list: iterate %d alarms"), count);
+   StartTest(name);
+   start = GetCurrentTimeMs();
+   list->readLock();
+   int severityCount[5] = { 0, 0, 0, 0, 0 };
+   for(int i = 0; i < list->size(); i++)
+   {
+      Alarm *alarm = list->get(i);
+      if (alarm != nullptr)
+         severityCount[alarm->getCurrentSeverity()]++;
+   }
+   list->unlock();
+   for(int s = 0; s < 5; s++)
+      AssertEquals(severityCount[s], list->getSeverityCount(s));
+   EndTest(GetCurrentTimeMs() - start);
+
+   // Remove every other alarm, interleaved with write lock acquisition to trigger compaction
+   _sntprintf(name, 128, _T("Alarm list: remove %d alarms"), count / 2);
+   StartTest(name);
+   start = GetCurrentTimeMs();
+   for(int i = 0; i < count; i += 2)
+   {
+      list->writeLock();
+      AssertTrue(list->removeById(ids[i]));
+      list->unlock();
+   }
+   AssertEquals(list->count(), count - (count + 1) / 2);
+   AssertTrue(IsListOrdered(list));
+   EndTest(GetCurrentTimeMs() - start);
+
+   _sntprintf(name, 128, _T("Alarm list: remove remaining %d alarms"), count / 2);
+   StartTest(name);
+   start = GetCurrentTimeMs();
+   for(int i = 1; i < count; i += 2)
+   {
+      list->writeLock();
+      AssertTrue(list->removeById(ids[i]));
+      list->unlock();
+   }
+   AssertEquals(list->count(), 0);
+   for(uint32_t source = 1000; source < 1000 + SOURCE_OBJECT_COUNT; source++)
+      AssertNull(list->getObjectAlarms(source));
+   EndTest(GetCurrentTimeMs() - start);
+
+   MemFree(ids);
+   delete list;
+}
+
+/**
+ * Test active alarm list
+ */
+void TestAlarmList()
+{
+   StartTest(_T("Alarm list: order preserved on removal"));
+   AlarmList *list = new AlarmList();
+   list->writeLock();
+   uint32_t ids[1000];
+   for(int i = 0; i < 1000; i++)
+   {
+      Alarm *alarm = CreateTestAlarm(1000 + i % 10, i);
+      ids[i] = alarm->getAlarmId();
+      list->add(alarm);
+   }
+   list->unlock();
+   for(int i = 0; i < 1000; i += 3)
+   {
+      list->writeLock();
+      list->removeById(ids[i]);
+      list->unlock();
+   }
+   AssertEquals(list->count(), 666);
+   AssertTrue(IsListOrdered(list));
+   AssertTrue(list->find(ids[1]) == list->get(0));   // Compaction should have moved first alarm to the beginning
+   for(int i = 0; i < 1000; i++)
+   {
+      if (i % 3 == 0)
+      {
+         AssertNull(list->find(ids[i]));
+      }
+      else
+      {
+         AssertNotNull(list->find(ids[i]));
+      }
+   }
+   const ObjectArray<Alarm> *objectAlarms = list->getObjectAlarms(1001);
+   AssertNotNull(objectAlarms);
+   AssertEquals(objectAlarms->size(), 67);
+   delete list;
+   EndTest();
+
+   BenchmarkAlarmList(100000);
+   BenchmarkAlarmList(1000000);
+}
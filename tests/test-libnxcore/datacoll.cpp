@@ -0,0 +1,28 @@
+#include <nms_core.h>
+#include <nms_objects.h>
+#include <testtools.h>
+
+/**
+ * Test data collection scheduler
+ */
+void TestDataCollectionScheduler()
+{
+   StartTest(_T("Data collection scheduler - new DCI"));
+   shared_ptr<Node> node = make_shared<Node>();
+   DCItem *dci = new DCItem(1, _T("Test"), DS_INTERNAL, DCI_DT_INT, DC_POLLING_SCHEDULE_DEFAULT, nullptr,
+            DC_RETENTION_DEFAULT, nullptr, node);
+   AssertEquals(static_cast<int64_t>(dci->getScheduledPollTime()), static_cast<int64_t>(0));
+   time_t now = time(nullptr);
+   AssertTrue(node->addDCObject(dci, false, false));
+   AssertTrue(dci->getScheduledPollTime() != 0);
+   AssertTrue(dci->getScheduledPollTime() <= now + 2);   // Should be scheduled for immediate check
+   EndTest();
+
+   StartTest(_T("Data collection scheduler - DCI on template"));
+   shared_ptr<Template> dcTemplate = make_shared<Template>();
+   dci = new DCItem(2, _T("Test"), DS_INTERNAL, DCI_DT_INT, DC_POLLING_SCHEDULE_DEFAULT, nullptr,
+            DC_RETENTION_DEFAULT, nullptr, dcTemplate);
+   AssertTrue(dcTemplate->addDCObject(dci, false, false));
+   AssertEquals(static_cast<int64_t>(dci->getScheduledPollTime()), static_cast<int64_t>(0));   // Template DCIs are never scheduled
+   EndTest();
+}
@@ -0,0 +1,21 @@
+#include <nms_common.h>
+#include <nms_util.h>
+#include <testtools.h>
+#include <netxms-version.h>
+
+NETXMS_EXECUTABLE_HEADER(test-libnxcore)
+
+void TestAlarmList();
+void TestDataCollectionScheduler();
+
+/**
+ * main()
+ */
+int main(int argc, char *argv[])
+{
+   InitNetXMSProcess(true);
+
+   TestDataCollectionScheduler();
+   TestAlarmList();
+   return 0;
+}
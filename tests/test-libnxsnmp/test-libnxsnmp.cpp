@@ -195,6 +195,195 @@ static void TestVariableClass()
    EndTest();
 }
 
+/**
+ * Result of request sent via request engine
+ */
+struct EngineRequestResult
+{
+   Condition completed;
+   uint32_t rcc;
+   SNMP_PDU *response;
+   int callCount;
+
+   EngineRequestResult() : completed(true)
+   {
+      rcc = SNMP_ERR_SUCCESS;
+      response = nullptr;
+      callCount = 0;
+   }
+
+   ~EngineRequestResult()
+   {
+      delete response;
+   }
+
+   SNMP_ResponseCallback callback()
+   {
+      return [this] (uint32_t rcc, SNMP_PDU *response) -> void
+      {
+         this->rcc = rcc;
+         delete this->response;
+         this->response = response;
+         callCount++;
+         completed.set();
+      };
+   }
+};
+
+/**
+ * Create UDP socket on loopback address emulating SNMP agent
+ */
+static SOCKET CreateAgentSocket(InetAddress *addr, uint16_t *port)
+{
+   SOCKET s = CreateSocket(AF_INET, SOCK_DGRAM, 0);
+   if (s == INVALID_SOCKET)
+      return INVALID_SOCKET;
+
+   struct sockaddr_in sa;
+   memset(&sa, 0, sizeof(sa));
+   sa.sin_family = AF_INET;
+   sa.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+   if (bind(s, reinterpret_cast<struct sockaddr*>(&sa), sizeof(sa)) != 0)
+   {
+      closesocket(s);
+      return INVALID_SOCKET;
+   }
+
+   socklen_t len = sizeof(sa);
+   getsockname(s, reinterpret_cast<struct sockaddr*>(&sa), &len);
+   *addr = InetAddress::createFromSockaddr(reinterpret_cast<struct sockaddr*>(&sa));
+   *port = ntohs(sa.sin_port);
+   return s;
+}
+
+/**
+ * Receive one request on emulated agent socket and send response with same request ID
+ */
+static bool RespondToRequest(SOCKET s, uint32_t expectedRequestId)
+{
+   SocketPoller sp;
+   sp.add(s);
+   if (sp.poll(2000) <= 0)
+      return false;
+
+   BYTE *buffer = MemAllocArrayNoInit<BYTE>(SNMP_DEFAULT_MSG_MAX_SIZE);
+   SockAddrBuffer sender;
+   socklen_t addrLen = sizeof(sender);
+   int bytes = static_cast<int>(recvfrom(s, (char *)buffer, SNMP_DEFAULT_MSG_MAX_SIZE, 0, reinterpret_cast<struct sockaddr*>(&sender), &addrLen));
+
+   bool success = false;
+   SNMP_SecurityContext context("public");
+   SNMP_PDU request;
+   if ((bytes > 0) && request.parse(buffer, bytes, &context, false) && (request.getRequestId() == expectedRequestId))
+   {
+      SNMP_PDU response(SNMP_RESPONSE, request.getRequestId(), request.getVersion());
+      SNMP_Variable *v = new SNMP_Variable(s_oidSysDescription);
+      v->setValueFromString(ASN_OCTET_STRING, _T("Test agent"));
+      response.bindVariable(v);
+      BYTE *packet;
+      size_t size = response.encode(&packet, &context);
+      if (size > 0)
+      {
+         success = (sendto(s, (char *)packet, (int)size, 0, reinterpret_cast<struct sockaddr*>(&sender), addrLen) > 0);
+         MemFree(packet);
+      }
+   }
+   MemFree(buffer);
+   return success;
+}
+
+/**
+ * Create GET request for sysDescr
+ */
+static SNMP_PDU *CreateTestRequest(uint32_t requestId)
+{
+   SNMP_PDU *request = new SNMP_PDU(SNMP_GET_REQUEST, requestId, SNMP_VERSION_2C);
+   request->bindVariable(new SNMP_Variable(s_oidSysDescription));
+   return request;
+}
+
+/**
+ * Test SNMP request engine on loopback interface
+ */
+static void TestRequestEngine()
+{
+   StartTest(_T("SNMP_RequestEngine::start"));
+   SNMP_RequestEngine engine;
+   AssertTrue(engine.start());
+   AssertTrue(engine.isRunning());
+   InetAddress agentAddr;
+   uint16_t agentPort;
+   SOCKET agent = CreateAgentSocket(&agentAddr, &agentPort);
+   AssertTrue(agent != INVALID_SOCKET);
+   SNMP_SecurityContext context("public");
+   EndTest();
+
+   StartTest(_T("SNMP_RequestEngine - request and response"));
+   SNMP_PDU *request = CreateTestRequest(1001);
+   EngineRequestResult r1;
+   AssertTrue(engine.sendRequest(request, agentAddr, agentPort, &context, r1.callback(), 2000, 1) > 0);
+   delete request;
+   AssertTrue(RespondToRequest(agent, 1001));
+   AssertTrue(r1.completed.wait(2000));
+   AssertTrue(r1.rcc == SNMP_ERR_SUCCESS);
+   AssertNotNull(r1.response);
+   AssertEquals(r1.response->getRequestId(), 1001u);
+   AssertEquals(r1.response->getNumVariables(), 1);
+   AssertEquals(engine.getPendingRequestCount(), 0);
+   EndTest();
+
+   StartTest(_T("SNMP_RequestEngine - same request ID"));
+   EngineRequestResult r2, r3;
+   uint64_t serial2 = 0, serial3 = 0;
+   request = CreateTestRequest(1002);
+   AssertTrue(engine.sendRequest(request, agentAddr, agentPort, &context, r2.callback(), 2000, 1, false, &serial2) > 0);
+   AssertTrue(engine.sendRequest(request, agentAddr, agentPort, &context, r3.callback(), 2000, 1, false, &serial3) > 0);
+   delete request;
+   AssertTrue(serial2 != 0);
+   AssertTrue(serial3 != 0);
+   AssertTrue(serial2 != serial3);
+   AssertEquals(engine.getPendingRequestCount(), 2);
+   engine.cancelRequest(1002, serial3 + 1000);  // Unknown serial should not cancel anything
+   AssertEquals(engine.getPendingRequestCount(), 2);
+   engine.cancelRequest(1002, serial2);
+   AssertEquals(engine.getPendingRequestCount(), 1);
+   AssertTrue(RespondToRequest(agent, 1002));
+   AssertTrue(RespondToRequest(agent, 1002));
+   AssertTrue(r3.completed.wait(2000));
+   AssertTrue(r3.rcc == SNMP_ERR_SUCCESS);
+   AssertFalse(r2.completed.wait(500));   // Cancelled request should not be completed by second response
+   AssertEquals(r2.callCount, 0);
+   AssertEquals(r3.callCount, 1);
+   AssertEquals(engine.getPendingRequestCount(), 0);
+   EndTest();
+
+   StartTest(_T("SNMP_RequestEngine - timeout"));
+   EngineRequestResult r4;
+   request = CreateTestRequest(1003);
+   int64_t startTime = GetCurrentTimeMs();
+   AssertTrue(engine.sendRequest(request, agentAddr, agentPort, &context, r4.callback(), 200, 2) > 0);
+   delete request;
+   AssertTrue(r4.completed.wait(3000));
+   AssertTrue(r4.rcc == SNMP_ERR_TIMEOUT);
+   AssertNull(r4.response);
+   AssertTrue(GetCurrentTimeMs() - startTime >= 400);   // Request should be retransmitted once
+   AssertEquals(engine.getRetransmissionCount(), static_cast<uint64_t>(1));
+   AssertEquals(engine.getTimeoutCount(), static_cast<uint64_t>(1));
+   EndTest();
+
+   StartTest(_T("SNMP_RequestEngine::shutdown"));
+   EngineRequestResult r5;
+   request = CreateTestRequest(1004);
+   AssertTrue(engine.sendRequest(request, agentAddr, agentPort, &context, r5.callback(), 10000, 1) > 0);
+   delete request;
+   engine.shutdown();
+   AssertEquals(r5.callCount, 1);
+   AssertTrue(r5.rcc == SNMP_ERR_ABORTED);
+   AssertFalse(engine.isRunning());
+   closesocket(agent);
+   EndTest();
+}
+
 /**
  * main()
  */
@@ -205,5 +394,6 @@ int main(int argc, char *argv[])
    TestOidConversion();
    TestOidClass();
    TestVariableClass();
+   TestRequestEngine();
    return 0;
 }